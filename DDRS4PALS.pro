@@ -76,10 +76,17 @@ DEFINES+= USE_DRS_QT_MUTEX
 SOURCES += main.cpp\
     DRS/drs507/DRS.cpp \
     DRS/drs507/averager.cpp\
+    DRS/drs507/drstransport.cpp\
     DRS/drs507/musbstd.c\
     DRS/drs507/mxml.c\
     DRS/drs507/strlcpy.c\
     drs4worker.cpp \
+    drs4pulsepairkernel.cpp \
+    drs4analysisthreadpool.cpp \
+    drs4hotpathtiming.cpp \
+    drs4baselinecorrection.cpp \
+    drs4readoutdevice.cpp \
+    drs4pulseshapefilterenvelope.cpp \
     GUI/drs4scopedlg.cpp \
     drs4boardmanager.cpp \
     drs4settingsmanager.cpp \
@@ -101,6 +108,7 @@ SOURCES += main.cpp\
     GUI/drs4statelogdlg.cpp \
     GUI/drs4pulsesaverangedlg.cpp \
     GUI/drs4calculatordlg.cpp \
+    GUI/drs4hotpathtimingdlg.cpp \
     GUI/drs4cfdalgorithmdlg.cpp \
     DQuickLTFit/settings.cpp \
     DQuickLTFit/projectmanager.cpp \
@@ -118,6 +126,7 @@ SOURCES += main.cpp\
 
 HEADERS  += DRS/drs507/DRS.h \
     DRS/drs507/averager.h\
+    DRS/drs507/drstransport.h\
     DRS/drs507/usb.h \
     DRS/drs507/musbstd.h\
     DRS/drs507/mxml.h\
@@ -125,6 +134,13 @@ HEADERS  += DRS/drs507/DRS.h \
     include/libusb-1.0/libusb.h \
     include/DLTPulseGenerator/DLTPulseGenerator.h \
     drs4worker.h \
+    drs4eventring.h \
+    drs4pulsepairkernel.h \
+    drs4analysisthreadpool.h \
+    drs4hotpathtiming.h \
+    drs4baselinecorrection.h \
+    drs4readoutdevice.h \
+    drs4pulseshapefilterenvelope.h \
     GUI/drs4scopedlg.h \
     drs4boardmanager.h \
     drs4settingsmanager.h \
@@ -132,6 +148,7 @@ HEADERS  += DRS/drs507/DRS.h \
     Fit/mpfit_DISCLAIMER \
     Fit/fitengine.h \
     Fit/dspline.h \
+    Fit/droispline.h \
     GUI/drs4addinfodlg.h \
     GUI/drs4boardinfodlg.h \
     Stream/drs4streammanager.h \
@@ -148,6 +165,7 @@ HEADERS  += DRS/drs507/DRS.h \
     GUI/drs4statelogdlg.h \
     GUI/drs4pulsesaverangedlg.h \
     GUI/drs4calculatordlg.h \
+    GUI/drs4hotpathtimingdlg.h \
     GUI/drs4cfdalgorithmdlg.h \
     DQuickLTFit/settings.h \
     DQuickLTFit/projectmanager.h \
@@ -172,6 +190,7 @@ FORMS    += GUI/drs4scopedlg.ui \
     GUI/drs4statelogdlg.ui \
     GUI/drs4pulsesaverangedlg.ui \
     GUI/drs4calculatordlg.ui \
+    GUI/drs4hotpathtimingdlg.ui \
     GUI/drs4cfdalgorithmdlg.ui \
     GUI/drs4licensetextbox.ui \
     GUI/drs4boardcalibrationdlg.ui \
@@ -1,5 +1,7 @@
 #include "dmedianfilter.h"
 
+#include <QtGlobal>
+
 DMedianFilter::DMedianFilter() {}
 DMedianFilter::~DMedianFilter() {}
 
@@ -65,11 +67,166 @@ bool DMedianFilter::apply(float *data_1d, int size, int windowSize)
 }
 #endif
 
+/* compare-exchange pairs (i < j) of the networks selecting the median of 3 ... __DMEDIANFILTER_NETWORK_MAX_WINDOW values */
+class DMedianNetworks {
+public:
+    int m_pairs[__DMEDIANFILTER_NETWORK_MAX_WINDOW + 1][64][2];
+    int m_count[__DMEDIANFILTER_NETWORK_MAX_WINDOW + 1];
+
+    DMedianNetworks() {
+        for ( int n = 0 ; n <= __DMEDIANFILTER_NETWORK_MAX_WINDOW ; ++ n ) {
+            m_count[n] = 0;
+
+            if ( n >= 3 )
+                build(n);
+        }
+    }
+
+private:
+    void build(int n) {
+        int pairs[64][2];
+        int count = 0;
+
+        int size = 1;
+
+        while ( size < n )
+            size <<= 1;
+
+        /* Batcher's odd-even merge sort of 'size' values: the values >= n are +inf (never moved), i.e. the pairs (i, j >= n) are no-ops */
+        for ( int p = 1 ; p < size ; p <<= 1 ) {
+            for ( int k = p ; k >= 1 ; k >>= 1 ) {
+                for ( int j = k%p ; j + k < size ; j += 2*k ) {
+                    for ( int i = 0 ; i < qMin(k, size - j - k) ; ++ i ) {
+                        if ( (i + j)/(2*p) == (i + j + k)/(2*p)
+                             && (i + j + k) < n ) {
+                            pairs[count][0] = i + j;
+                            pairs[count][1] = i + j + k;
+
+                            count ++;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* prune the pairs which do not contribute to the median (backwards) */
+        bool needed[__DMEDIANFILTER_NETWORK_MAX_WINDOW] = {false};
+        bool kept[64] = {false};
+
+        needed[n/2] = true;
+
+        for ( int c = count - 1 ; c >= 0 ; -- c ) {
+            if ( needed[pairs[c][0]] || needed[pairs[c][1]] ) {
+                needed[pairs[c][0]] = needed[pairs[c][1]] = true;
+                kept[c] = true;
+            }
+        }
+
+        for ( int c = 0 ; c < count ; ++ c ) {
+            if ( !kept[c] )
+                continue;
+
+            m_pairs[n][m_count[n]][0] = pairs[c][0];
+            m_pairs[n][m_count[n]][1] = pairs[c][1];
+
+            m_count[n] ++;
+        }
+    }
+};
+
 bool DMedianFilter::apply(float *data_1d, int size, int windowSize)
+{
+    return apply(data_1d, size, windowSize, 0, size);
+}
+
+bool DMedianFilter::apply(float *data_1d, int size, int windowSize, int first, int last)
 {
     if (!data_1d || size <= 3 || windowSize < 3)
         return false;
 
+    first = qMax(0, first);
+    last = qMin(size, last);
+
+    if (first >= last)
+        return true;
+
+    /* the window spans windowSize/2 values on each side, i.e. even sizes are extended by one */
+    if ((windowSize/2)*2 + 1 <= __DMEDIANFILTER_NETWORK_MAX_WINDOW)
+        applyNetwork(data_1d, size, windowSize, first, last);
+    else
+        applyHistogram(data_1d, size, windowSize, first, last);
+
+    return true;
+}
+
+void DMedianFilter::applyNetwork(float *data_1d, int size, int windowSize, int first, int last)
+{
+    static const DMedianNetworks networks;
+
+    const int halfWindow = windowSize/2;
+    const int n = 2*halfWindow + 1;
+
+    const int (*pairs)[2] = networks.m_pairs[n];
+    const int pairsCount = networks.m_count[n];
+
+    const int outputs = last - first;
+    const int blocks = (outputs + __DMEDIANFILTER_NETWORK_LANES - 1)/__DMEDIANFILTER_NETWORK_LANES;
+    const int inputs = blocks*__DMEDIANFILTER_NETWORK_LANES + n - 1;
+
+    /* copy of the inputs of [first ; last[ incl. the borders: filter in place */
+    alignas(32) float stackBuffer[2048];
+    std::vector<float> heapBuffer;
+
+    float *input = stackBuffer;
+
+    if (inputs > 2048) {
+        heapBuffer.resize(inputs);
+        input = heapBuffer.data();
+    }
+
+    for ( int i = 0 ; i < inputs ; ++ i ) {
+        const int index = qBound(0, first - halfWindow + i, size - 1);
+
+        input[i] = data_1d[index];
+    }
+
+    alignas(32) float lanes[__DMEDIANFILTER_NETWORK_MAX_WINDOW][__DMEDIANFILTER_NETWORK_LANES];
+
+    for ( int block = 0 ; block < blocks ; ++ block ) {
+        const int offset = block*__DMEDIANFILTER_NETWORK_LANES;
+
+        for ( int k = 0 ; k < n ; ++ k ) {
+            for ( int l = 0 ; l < __DMEDIANFILTER_NETWORK_LANES ; ++ l )
+                lanes[k][l] = input[offset + l + k];
+        }
+
+        for ( int c = 0 ; c < pairsCount ; ++ c ) {
+            float *a = lanes[pairs[c][0]];
+            float *b = lanes[pairs[c][1]];
+
+            float minV[__DMEDIANFILTER_NETWORK_LANES];
+            float maxV[__DMEDIANFILTER_NETWORK_LANES];
+
+            for ( int l = 0 ; l < __DMEDIANFILTER_NETWORK_LANES ; ++ l ) {
+                minV[l] = qMin(a[l], b[l]);
+                maxV[l] = qMax(a[l], b[l]);
+            }
+
+            for ( int l = 0 ; l < __DMEDIANFILTER_NETWORK_LANES ; ++ l ) {
+                a[l] = minV[l];
+                b[l] = maxV[l];
+            }
+        }
+
+        const int count = qMin(__DMEDIANFILTER_NETWORK_LANES, outputs - offset);
+
+        for ( int l = 0 ; l < count ; ++ l )
+            data_1d[first + offset + l] = lanes[halfWindow][l];
+    }
+}
+
+void DMedianFilter::applyHistogram(float *data_1d, int size, int windowSize, int first, int last)
+{
     TMedianFilter1D<float> filter(windowSize);
 
     std::vector<float> data(size);
@@ -79,11 +236,6 @@ bool DMedianFilter::apply(float *data_1d, int size, int windowSize)
 
     filter.Execute(data);
 
-    for ( int i = 0 ; i < filter.Count() ; ++ i )
+    for ( int i = first ; i < last && i < filter.Count() ; ++ i )
         data_1d[i] = filter[i];
-
-
-    return true;
 }
-
-
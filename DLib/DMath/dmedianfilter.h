@@ -148,12 +148,28 @@ private:
     }
 };
 
+#define __DMEDIANFILTER_NETWORK_MAX_WINDOW 15 // [#] larger windows fall back to the histogram filter
+#define __DMEDIANFILTER_NETWORK_LANES 8 // [#] outputs per pass through the network
+
+/* median filter of the window [i - windowSize/2 ; i + windowSize/2] (the first/last sample is repeated at the borders):
+ *
+ * - small windows (<= __DMEDIANFILTER_NETWORK_MAX_WINDOW): compare-exchange network (Batcher's odd-even merge sort, pruned to the median),
+ *   which is evaluated for __DMEDIANFILTER_NETWORK_LANES neighboring outputs at once, i.e. the min/max of the lanes are vectorized by the compiler.
+ *   The data is filtered in place using an aligned copy on the stack.
+ * - large windows: histogram filter (TMedianFilter1D). */
 class DMedianFilter {
     DMedianFilter();
     virtual ~DMedianFilter();
 
 public:
     static bool apply(float *data_1d, int size, int windowSize);
+
+    /* filters the range [first ; last[ only: the remaining data is left unchanged */
+    static bool apply(float *data_1d, int size, int windowSize, int first, int last);
+
+private:
+    static void applyNetwork(float *data_1d, int size, int windowSize, int first, int last);
+    static void applyHistogram(float *data_1d, int size, int windowSize, int first, int last);
 };
 
 #endif // DMEDIANFILTER_H
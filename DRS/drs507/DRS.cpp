@@ -380,6 +380,20 @@ DRS::DRS()
 
 /*------------------------------------------------------------------*/
 
+DRS::DRS(DRSBoard *b)
+:  fNumberOfBoards(0)
+#ifdef HAVE_VME
+    , fVmeInterface(0)
+#endif
+{
+   // no USB or VME interface is opened
+   memset(fError, 0, sizeof(fError));
+
+   AddBoard(b);
+}
+
+/*------------------------------------------------------------------*/
+
 DRS::~DRS()
 {
    int i;
@@ -395,7 +409,8 @@ DRS::~DRS()
 #endif
 
 #ifdef HAVE_VME
-   mvme_close(fVmeInterface);
+   if (fVmeInterface)
+      mvme_close(fVmeInterface);
 #endif
 }
 
@@ -424,6 +439,20 @@ void DRS::SetBoard(int i, DRSBoard *b)
 
 /*------------------------------------------------------------------*/
 
+int DRS::AddBoard(DRSBoard *b)
+{
+   // boards which are not found by the scan, e.g. on a DRSReplayTransport
+   if (fNumberOfBoards >= kMaxNumberOfBoards) {
+      delete b;
+      return -1;
+   }
+
+   fBoard[fNumberOfBoards] = b;
+   return fNumberOfBoards++;
+}
+
+/*------------------------------------------------------------------*/
+
 bool DRS::GetError(char *str, int size)
 {
    if (fError[0])
@@ -515,6 +544,8 @@ DRSBoard::DRSBoard(MUSB_INTERFACE * musb_interface, int usb_slot)
    memset(fStopCell, 0, sizeof(fStopCell));
    memset(fStopWSR, 0, sizeof(fStopWSR));
    fTriggerBus = 0;
+   fTransportLayer = NULL;
+   fRecorder = NULL;
    ConstructBoard();
 }
 
@@ -597,6 +628,8 @@ DRSBoard::DRSBoard(MVME_INTERFACE * mvme_interface, mvme_addr_t base_address, in
 , fDebug(0)
 , fTriggerStartBin(0)
 {
+   fTransportLayer = NULL;
+   fRecorder = NULL;
    ConstructBoard();
 }
 
@@ -604,14 +637,106 @@ DRSBoard::DRSBoard(MVME_INTERFACE * mvme_interface, mvme_addr_t base_address, in
 
 /*------------------------------------------------------------------*/
 
+/* Board behind a transport layer, e.g. a DRSReplayTransport, which owns it */
+
+DRSBoard::DRSBoard(DRSTransport *transport, int slot)
+:  fDAC_COFSA(0)
+    , fDAC_COFSB(0)
+    , fDAC_DRA(0)
+    , fDAC_DSA(0)
+    , fDAC_TLEVEL(0)
+    , fDAC_ACALIB(0)
+    , fDAC_DSB(0)
+    , fDAC_DRB(0)
+    , fDAC_COFS(0)
+    , fDAC_ADCOFS(0)
+    , fDAC_CLKOFS(0)
+    , fDAC_ROFS_1(0)
+    , fDAC_ROFS_2(0)
+    , fDAC_INOFS(0)
+    , fDAC_BIAS(0)
+    , fDRSType(0)
+    , fBoardType(0)
+    , fRequiredFirmwareVersion(0)
+    , fFirmwareVersion(0)
+    , fBoardSerialNumber(0)
+    , fHasMultiBuffer(0)
+    , fCtrlBits(0)
+    , fNumberOfReadoutChannels(0)
+    , fReadoutChannelConfig(0)
+    , fADCClkPhase(0)
+    , fADCClkInvert(0)
+    , fExternalClockFrequency(0)
+#ifdef HAVE_USB
+    , fUsbInterface(0)
+#endif
+#ifdef HAVE_VME
+    , fVmeInterface(0)
+    , fBaseAddress(0)
+#endif
+    , fTransportLayer(transport)
+    , fRecorder(0)
+    , fSlotNumber(slot)
+    , fNominalFrequency(0)
+    , fRefClock(0)
+    , fMultiBuffer(0)
+    , fDominoMode(0)
+    , fDominoActive(0)
+    , fChannelConfig(0)
+    , fChannelCascading(1)
+    , fChannelDepth(1024)
+    , fWSRLoop(0)
+    , fReadoutMode(0)
+    , fReadPointer(0)
+    , fNMultiBuffer(0)
+    , fTriggerEnable1(0)
+    , fTriggerEnable2(0)
+    , fTriggerSource(0)
+    , fTriggerDelay(0)
+    , fTriggerDelayNs(0)
+    , fSyncDelay(0)
+    , fDelayedStart(0)
+    , fTranspMode(0)
+    , fDecimation(0)
+    , fRange(0)
+    , fCommonMode(0.8)
+    , fAcalMode(0)
+    , fAcalVolt(0)
+    , fTcalFreq(0)
+    , fTcalLevel(0)
+    , fTcalPhase(0)
+    , fTcalSource(0)
+    , fRefclk(0)
+    , fMaxChips(0)
+    , fResponseCalibration(0)
+    , fVoltageCalibrationValid(false)
+    , fCellCalibratedRange(0)
+    , fCellCalibratedTemperature(0)
+    , fTimeData(0)
+    , fNumberOfTimeData(0)
+    , fDebug(0)
+    , fTriggerStartBin(0)
+{
+   fTransport = transport->GetTransportType();
+   memset(fStopCell, 0, sizeof(fStopCell));
+   memset(fStopWSR, 0, sizeof(fStopWSR));
+   fTriggerBus = 0;
+   ConstructBoard();
+}
+
+/*------------------------------------------------------------------*/
+
 DRSBoard::~DRSBoard()
 {
    int i;
 #ifdef HAVE_USB
-   if (fTransport == TR_USB || fTransport == TR_USB2)
+   if ((fTransport == TR_USB || fTransport == TR_USB2) && fUsbInterface)
       musb_close(fUsbInterface);
 #endif
 
+   // Transport layer
+   delete fTransportLayer;
+
 #ifdef USE_DRS_MUTEX
    if (s_drsMutex)
       delete s_drsMutex;
@@ -626,6 +751,14 @@ DRSBoard::~DRSBoard()
       delete fTimeData[i];
    }
    delete[]fTimeData;
+
+   // Time axis cache
+   for (i = 0; i < kNumberOfChipsMax * kNumberOfChannelsMax; i++) {
+      delete[]fTimeAxis[i];
+      delete[]fTimeAxisValid[i];
+   }
+
+   delete[]fMultiBufferWaves;
 }
 
 /*------------------------------------------------------------------*/
@@ -641,6 +774,13 @@ void DRSBoard::ConstructBoard()
 
    fExternalClockFrequency = 1000. / 30.;
    strcpy(fCalibDirectory, ".");
+   InvalidateCalibrationTables();
+   memset(fTimeAxis, 0, sizeof(fTimeAxis));
+   memset(fTimeAxisValid, 0, sizeof(fTimeAxisValid));
+   fTimeAxisFrequency = 0;
+   fTimeAxisCalibratedFrequency = 0;
+   fMultiBufferWaves = NULL;
+   fMultiBufferWavesSize = 0;
 
    /* check board communication */
    if (Read(T_STATUS, buffer, REG_MAGIC, 2) < 0) {
@@ -854,6 +994,8 @@ void DRSBoard::ReadCalibration(void)
    memset(fCellGain,    0, sizeof(fCellGain));
    memset(fCellOffset2, 0, sizeof(fCellOffset2));
    memset(fCellDT,      0, sizeof(fCellDT));
+   InvalidateCalibrationTables();
+   InvalidateTimeAxes();
 
    /* read offsets and gain from eeprom */
    if (fBoardType == 9) {
@@ -1065,7 +1207,53 @@ void DRSBoard::ReadCalibration(void)
    fTimingCalibratedFrequency = buf[6] / 1000.0;
    WriteEEPROM(0, buf, sizeof(buf));
 #endif
-   
+
+   InvalidateTimeAxes();
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSBoard::InvalidateCalibrationTables(void)
+{
+   memset(fCalibTableValid, 0, sizeof(fCalibTableValid));
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSBoard::InvalidateTimeAxes(void)
+{
+   // keep the allocated axes, only mark them for recomputation
+   int i;
+
+   for (i = 0; i < kNumberOfChipsMax * kNumberOfChannelsMax; i++)
+      if (fTimeAxisValid[i])
+         memset(fTimeAxisValid[i], 0, kNumberOfBins * sizeof(bool));
+
+   fTimeAxisFrequency = fNominalFrequency;
+   fTimeAxisCalibratedFrequency = fTimingCalibratedFrequency;
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSBoard::UpdateCalibrationTable(int index)
+{
+   // Tables of the calibration fast path for one calibration channel: the
+   // calibration data as doubles, the arithmetic stays in CalibrateSpan() in the
+   // order of the scalar path (no constants folded in, same rounding)
+   int j;
+
+   fCalibNumberOfStuckCells[index] = 0;
+
+   for (j = 0; j < kNumberOfBins; j++) {
+      fCalibTableOffset[index][j]  = fCellOffset[index][j];
+      fCalibTableGain[index][j]    = fCellGain[index][j];
+      fCalibTableOffset2[index][j] = fCellOffset2[index][j];
+
+      if (fCellOffset[index][j] == 0)
+         fCalibStuckCell[index][fCalibNumberOfStuckCells[index]++] = (unsigned short) j;
+   }
+
+   fCalibTableValid[index] = true;
 }
 
 /*------------------------------------------------------------------*/
@@ -1082,7 +1270,7 @@ int DRSBoard::InitFPGA(void)
 {
 
 #ifdef HAVE_USB
-   if (fTransport == TR_USB2) {
+   if (fTransport == TR_USB2 && fUsbInterface) {
       unsigned char buffer[1];
       int i, status;
 
@@ -1113,6 +1301,8 @@ int DRSBoard::InitFPGA(void)
 
 int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
 {
+   int n;
+
 #ifdef USE_DRS_QT_MUTEX
     QMutexLocker locker(&m_mutex);
 #endif
@@ -1125,6 +1315,23 @@ int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
    s_drsMutex->Lock();
 #endif
 
+   if (fTransportLayer)
+      n = fTransportLayer->Write(type, addr, data, size);
+   else
+      n = WriteDevice(type, addr, data, size);
+
+#ifdef USE_DRS_MUTEX
+   s_drsMutex->Unlock();
+#endif
+   return n;
+}
+
+/*------------------------------------------------------------------*/
+
+/* Direct write to VME or USB, used by Write() without transport layer and by DRSDeviceTransport */
+
+int DRSBoard::WriteDevice(int type, unsigned int addr, void *data, int size)
+{
    if (fTransport == TR_VME) {
 
 #ifdef HAVE_VME
@@ -1156,9 +1363,6 @@ int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
          mvme_write(fVmeInterface, base_addr + addr, static_cast < mvme_locaddr_t * >(data), size);
       }
 
-#ifdef USE_DRS_MUTEX
-      s_drsMutex->Unlock();
-#endif
       return size;
 #endif                          // HAVE_VME
 
@@ -1212,9 +1416,6 @@ int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
             }
 
             if (ack == 1) {
-#ifdef USE_DRS_MUTEX
-               s_drsMutex->Unlock();
-#endif
                return size;
             }
 
@@ -1251,9 +1452,6 @@ int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
             }
          }
 
-#ifdef USE_DRS_MUTEX
-         s_drsMutex->Unlock();
-#endif
          return size;
       }
 #endif                          // HAVE_USB
@@ -1314,16 +1512,10 @@ int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
       if (i != 10 + size)
          printf("musb_write error: %d\n", i);
 
-#ifdef USE_DRS_MUTEX
-      s_drsMutex->Unlock();
-#endif
       return i;
 #endif                          // HAVE_USB
    }
 
-#ifdef USE_DRS_MUTEX
-   s_drsMutex->Unlock();
-#endif
    return 0;
 }
 
@@ -1333,6 +1525,8 @@ int DRSBoard::Write(int type, unsigned int addr, void *data, int size)
 
 int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
 {
+   int n;
+
 #ifdef USE_DRS_QT_MUTEX
     QMutexLocker locker(&m_mutex);
 #endif
@@ -1345,6 +1539,23 @@ int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
    s_drsMutex->Lock();
 #endif
 
+   if (fTransportLayer)
+      n = fTransportLayer->Read(type, data, addr, size);
+   else
+      n = ReadDevice(type, data, addr, size);
+
+#ifdef USE_DRS_MUTEX
+   s_drsMutex->Unlock();
+#endif
+   return n;
+}
+
+/*------------------------------------------------------------------*/
+
+/* Direct read from VME or USB, used by Read() without transport layer and by DRSDeviceTransport */
+
+int DRSBoard::ReadDevice(int type, void *data, unsigned int addr, int size)
+{
    memset(data, 0, size);
  
    if (fTransport == TR_VME) {
@@ -1397,10 +1608,6 @@ int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
          //   mvme_read(fVmeInterface, (mvme_locaddr_t *)((char *)data+i), base_addr + addr+i, 4);
       }
 
-#ifdef USE_DRS_MUTEX
-      s_drsMutex->Unlock();
-#endif
-
       return n;
 
 #endif                          // HAVE_VME
@@ -1438,9 +1645,6 @@ int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
          musb_write(fUsbInterface, 2, buffer, 2 + size, USB_TIMEOUT);
          i = musb_read(fUsbInterface, 1, data, size, USB_TIMEOUT);
 
-#ifdef USE_DRS_MUTEX
-         s_drsMutex->Unlock();
-#endif
          if (i != size)
             return 0;
 
@@ -1469,9 +1673,6 @@ int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
                /* try again */
                ret = musb_read(fUsbInterface, 1, buffer, n, USB_TIMEOUT);
                if (ret != n) {
-#ifdef USE_DRS_MUTEX
-                  s_drsMutex->Unlock();
-#endif
                   return 0;
                }
             }
@@ -1480,9 +1681,6 @@ int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
                *((unsigned char *) data + j + i * 60) = buffer[j];
          }
 
-#ifdef USE_DRS_MUTEX
-         s_drsMutex->Unlock();
-#endif
          return size;
       }
 #endif                          // HAVE_USB
@@ -1538,21 +1736,120 @@ int DRSBoard::Read(int type, void *data, unsigned int addr, int size)
          printf("musb_read error %d\n", i);
 
       i = musb_read(fUsbInterface, 8, data, size, USB_TIMEOUT);
-#ifdef USE_DRS_MUTEX
-      s_drsMutex->Unlock();
-#endif
       return i;
 #endif                          // HAVE_USB
    }
 
-#ifdef USE_DRS_MUTEX
-   s_drsMutex->Unlock();
-#endif
    return 0;
 }
 
 /*------------------------------------------------------------------*/
 
+void DRSBoard::SetTransportLayer(DRSTransport *transport)
+{
+   // board takes ownership of the transport layer, NULL restores direct access
+   StopRecording();
+
+#ifdef USE_DRS_QT_MUTEX
+   m_mutex.lock();
+#endif
+   delete fTransportLayer;
+   fTransportLayer = transport;
+#ifdef USE_DRS_QT_MUTEX
+   m_mutex.unlock();
+#endif
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSBoard::StartRecording(const char *fileName)
+{
+   FILE *f;
+   unsigned char buffer[2];
+   unsigned short d;
+   unsigned short eeprom[1024*16]; // 32 kB
+   double freq;
+   int page, nPages;
+
+   if (fRecorder)
+      return 0;
+
+   f = fopen(fileName, "wb");
+   if (f == NULL) {
+      printf("Cannot open file \"%s\"\n", fileName);
+      return 0;
+   }
+
+#ifdef USE_DRS_QT_MUTEX
+   m_mutex.lock();
+#endif
+   fRecorder = new DRSRecordTransport(fTransportLayer ? fTransportLayer : new DRSDeviceTransport(this), f, fBoardType);
+   fTransportLayer = fRecorder;
+#ifdef USE_DRS_QT_MUTEX
+   m_mutex.unlock();
+#endif
+
+   // repeat the register reads of ConstructBoard() a replay needs to identify the board (members are not modified)
+   Read(T_STATUS, buffer, REG_MAGIC, 2);
+   Read(T_STATUS, buffer, REG_BOARD_TYPE, 2);
+   Read(T_STATUS, buffer, REG_VERSION_FW, 2);
+   Read(T_STATUS, buffer, REG_SERIAL_BOARD, 2);
+   GetCtrlReg();
+   Read(T_CTRL, &d, REG_READ_POINTER, 2);
+   ReadFrequency(0, &freq);
+   if (fBoardType == 6)
+      Read(T_CTRL, &d, REG_CHANNEL_MODE, 2);
+
+   // raw images of the calibration pages read by ReadCalibration(), the calibration in use is kept
+   if (fBoardType == 5 || fBoardType == 7 || fBoardType == 8 || fBoardType == 9)
+      nPages = 3;
+   else if (fBoardType == 6)
+      nPages = 9;
+   else
+      nPages = 0;
+
+   for (page = 0; page < nPages; page++)
+      ReadEEPROM(page, eeprom, sizeof(eeprom));
+
+   return 1;
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSBoard::StopRecording()
+{
+   DRSTransport *transport;
+   DRSRecordTransport *recorder;
+
+#ifdef USE_DRS_QT_MUTEX
+   m_mutex.lock();
+#endif
+   recorder = fRecorder;
+   if (recorder == NULL) {
+#ifdef USE_DRS_QT_MUTEX
+      m_mutex.unlock();
+#endif
+      return;
+   }
+
+   // a DRSDeviceTransport created by StartRecording() is the same as direct access
+   transport = recorder->Detach();
+   if (dynamic_cast<DRSDeviceTransport *>(transport)) {
+      delete transport;
+      transport = NULL;
+   }
+   fTransportLayer = transport;
+   fRecorder = NULL;
+#ifdef USE_DRS_QT_MUTEX
+   m_mutex.unlock();
+#endif
+
+   // no access reaches the recorder any more
+   delete recorder;
+}
+
+/*------------------------------------------------------------------*/
+
 void DRSBoard::SetLED(int state)
 {
    // Set LED state
@@ -3292,6 +3589,90 @@ void DRSBoard::IncrementMultiBufferRP()
 
 /*------------------------------------------------------------------*/
 
+int DRSBoard::TransferMultiBufferWaves(unsigned char **p, int *triggerCells, int maxEvents)
+{
+   // Transfer all pending events of the multi-buffer at once. The buffers
+   // between read and write pointer sit next to each other in the RAM of the
+   // board, so each run up to the wrap-around is read in one bulk transfer
+   // and the read pointer is advanced by a single register write. The events
+   // are handed out to p[] in the layout of TransferWaves(p, numberOfChannels),
+   // the stop cells of chip 0 to triggerCells[]. Returns the number of events.
+   int i, j, n, n_events, n_run, n_requested, n_bins, lastChannel, rp, wp;
+   unsigned char *ptr;
+
+   if (!fMultiBuffer || fNMultiBuffer < 2 || maxEvents < 1)
+      return 0;
+
+   rp = fReadPointer;
+   wp = GetMultiBufferWP();
+   n_events = (wp - rp + fNMultiBuffer) % fNMultiBuffer;
+   if (n_events > maxEvents)
+      n_events = maxEvents;
+   if (n_events == 0)
+      return 0;
+
+   if (fBoardType != 6 || fFirmwareVersion < 17147) {
+      // stop cells are not part of the buffer: one transfer per event
+      for (i=0 ; i<n_events ; i++) {
+         if (TransferWaves(p[i], kNumberOfChipsMax * kNumberOfChannelsMax) <= 0)
+            return i;
+         triggerCells[i] = GetStopCell(0);
+      }
+      return n_events;
+   }
+
+   // same size as one buffer in TransferWaves() on VME, including the trailer
+   lastChannel = fNumberOfChips * fNumberOfChannels - 1;
+   if (fReadoutChannelConfig == 4)
+      lastChannel = fNumberOfChips * 5 - 1;
+   n_bins = fDecimation ? kNumberOfBins/2 : kNumberOfBins;
+   n_requested = (lastChannel + 1) * sizeof(short int) * n_bins + 16;
+
+   if (fMultiBufferWavesSize < fNMultiBuffer * n_requested) {
+      delete[]fMultiBufferWaves;
+      fMultiBufferWavesSize = fNMultiBuffer * n_requested;
+      fMultiBufferWaves = new unsigned char[fMultiBufferWavesSize];
+   }
+
+   for (i=0 ; i<n_events ; i+=n_run) {
+      n_run = fNMultiBuffer - (rp + i) % fNMultiBuffer;
+      if (n_run > n_events - i)
+         n_run = n_events - i;
+
+      n = Read(T_RAM, fMultiBufferWaves, ((rp + i) % fNMultiBuffer) * n_requested, n_run * n_requested);
+      if (n != n_run * n_requested) {
+         printf("Error: only %d bytes read instead of %d\n", n, n_run * n_requested);
+         n_events = i;
+         break;
+      }
+
+      for (j=0 ; j<n_run ; j++) {
+         ptr = fMultiBufferWaves + j * n_requested;
+         memcpy(p[i+j], ptr, n_requested);
+
+         // trailer
+         ptr += n_requested - 16;
+         triggerCells[i+j] = *((unsigned short *)ptr);
+      }
+   }
+
+   if (n_events > 0) {
+      // stop cells and trigger bus of the last transferred event
+      ptr = p[n_events-1] + n_requested - 16;
+      for (i=0 ; i<4 ; i++) {
+         fStopCell[i] = *((unsigned short *)(ptr + i*2));
+         fStopWSR[i]  = *(ptr + 8 + i);
+      }
+      fTriggerBus = *((unsigned short *)(ptr + 12));
+
+      SetMultiBufferRP((rp + n_events) % fNMultiBuffer);
+   }
+
+   return n_events;
+}
+
+/*------------------------------------------------------------------*/
+
 int DRSBoard::TransferWaves(int numberOfChannels)
 {
    return TransferWaves(fWaveforms, numberOfChannels);
@@ -3694,6 +4075,46 @@ int DRSBoard::GetWave(unsigned char *waveforms, unsigned int chipIndex, unsigned
 
 /*------------------------------------------------------------------*/
 
+int DRSBoard::GetWaves(unsigned char *waveforms, unsigned int chipIndex, unsigned char channel1, unsigned char channel2,
+                       float *waveform1, float *waveform2, bool responseCalib, int triggerCell,
+                       float threshold, bool offsetCalib)
+{
+   // Decode and calibrate two channels of one event directly into the caller's
+   // buffers (no intermediate short waveform). Cascaded channels are combined
+   // by GetWave().
+   unsigned short adcWaveform[kNumberOfBins];
+   int ret;
+
+   if (fChannelCascading == 1 || channel1 == 8) {
+      ret = DecodeWave(waveforms, chipIndex, channel1, adcWaveform);
+      if (ret != kSuccess)
+         return ret;
+
+      ret = CalibrateWaveform(chipIndex, channel1, adcWaveform, waveform1, responseCalib,
+                              triggerCell, false, threshold, offsetCalib);
+   } else
+      ret = GetWave(waveforms, chipIndex, channel1, waveform1, responseCalib, triggerCell, -1, false,
+                    threshold, offsetCalib);
+
+   if (ret != kSuccess)
+      return ret;
+
+   if (fChannelCascading == 1 || channel2 == 8) {
+      ret = DecodeWave(waveforms, chipIndex, channel2, adcWaveform);
+      if (ret != kSuccess)
+         return ret;
+
+      ret = CalibrateWaveform(chipIndex, channel2, adcWaveform, waveform2, responseCalib,
+                              triggerCell, false, threshold, offsetCalib);
+   } else
+      ret = GetWave(waveforms, chipIndex, channel2, waveform2, responseCalib, triggerCell, -1, false,
+                    threshold, offsetCalib);
+
+   return ret;
+}
+
+/*------------------------------------------------------------------*/
+
 int DRSBoard::GetRawWave(unsigned int chipIndex, unsigned char channel, unsigned short *waveform,
                          bool adjustToClock)
 {
@@ -3841,6 +4262,134 @@ int DRSBoard::CalibrateWaveform(unsigned int chipIndex, unsigned char channel, u
 
 /*------------------------------------------------------------------*/
 
+static void CalibrateSpan(const unsigned short *adcWaveform, const double *offset, const double *gain,
+                          const double *offset2, float *waveform, int n, double lower, double upper, double precision)
+{
+   // Calibration of n consecutive cells without any modulo or data dependent
+   // branch, i.e. the loop is free to be vectorized. Arithmetic, clipping and
+   // rounding as in CalibrateWaveform().
+   int j;
+   double value;
+
+   for (j = 0; j < n; j++) {
+      value = ((adcWaveform[j] - offset[j]) / gain[j] - offset2[j] + 32768) / 65536.0 * 1000 * 10;
+
+      value = ((adcWaveform[j] >= 0xFFF0) | (value > upper)) ? upper : value;
+      value = ((adcWaveform[j] <  0x0010) | (value < lower)) ? lower : value;
+
+      waveform[j] = static_cast < float >(static_cast < short >(value + 0.5) * precision);
+   }
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSBoard::CalibrateWaveform(unsigned int chipIndex, unsigned char channel, unsigned short *adcWaveform,
+                                float *waveform, bool responseCalib,
+                                int triggerCell, bool adjustToClock, float threshold, bool offsetCalib)
+{
+   int j, ret;
+   double value, precision;
+   short s, left, right;
+
+   precision = GetPrecision();
+
+   if (!(responseCalib && fVoltageCalibrationValid && GetDRSType() == 4 && !adjustToClock && !fDecimation)) {
+      // calibrate to short and convert as in GetWave()
+      short waveS[kNumberOfBins];
+      int n_bins = fDecimation ? kNumberOfBins/2 : kNumberOfBins;
+
+      ret = CalibrateWaveform(chipIndex, channel, adcWaveform, waveS, responseCalib, triggerCell,
+                              adjustToClock, threshold, offsetCalib);
+
+      for (j = 0; j < n_bins; j++) {
+         if (responseCalib || fBoardType == 4 || fBoardType == 5 || fBoardType == 6 || fBoardType == 7 ||
+             fBoardType == 8 || fBoardType == 9)
+            waveform[j] = static_cast < float >(waveS[j] * precision);
+         else
+            waveform[j] = static_cast < float >(waveS[j]);
+      }
+
+      return ret;
+   }
+
+   // if Mezz though USB2 -> select correct calibration channel
+   if (fBoardType == 6 && (fReadoutChannelConfig == 0 || fReadoutChannelConfig == 2) &&
+       channel != 8)
+      channel++;
+
+   // Channel readout mode #4 -> select correct calibration channel
+   if (fBoardType == 6 && fReadoutChannelConfig == 4 && channel % 2 == 0 && channel != 8)
+      channel++;
+
+   if (offsetCalib && channel != 8 && triggerCell >= 0 && triggerCell < kNumberOfBins) {
+      int index, first, k;
+      double lower, upper;
+
+      index = channel+chipIndex*9;
+      if (!fCalibTableValid[index])
+         UpdateCalibrationTable(index);
+
+      upper = (fRange * 1000 + 500) * 10;
+      lower = (fRange * 1000 - 500) * 10;
+
+      // the cells are rotated by the trigger cell: two linear spans
+      first = kNumberOfBins - triggerCell;
+      CalibrateSpan(adcWaveform, fCalibTableOffset[index] + triggerCell, fCalibTableGain[index] + triggerCell,
+                    fCalibTableOffset2[index], waveform, first, lower, upper, precision);
+      CalibrateSpan(adcWaveform + first, fCalibTableOffset[index], fCalibTableGain[index],
+                    fCalibTableOffset2[index] + first, waveform + first, triggerCell, lower, upper, precision);
+
+      // stuck pixels in ascending order of the waveform index: cells behind the
+      // trigger cell first
+      for (k = 0; k < fCalibNumberOfStuckCells[index] && fCalibStuckCell[index][k] < triggerCell; k++)
+         ;
+      for (first = k; k < fCalibNumberOfStuckCells[index] + first; k++) {
+         j = (fCalibStuckCell[index][k % fCalibNumberOfStuckCells[index]] - triggerCell + kNumberOfBins) % kNumberOfBins;
+         left = (short) floor(waveform[(j-1+kNumberOfBins) % kNumberOfBins] / precision + 0.5);
+         right = (short) floor(waveform[(j+1) % kNumberOfBins] / precision + 0.5);
+         waveform[j] = static_cast < float >(((short) ((left+right)/2)) * precision);
+      }
+
+      return kSuccess;
+   }
+
+   // same arithmetic as the short version: the calibrated value is rounded to
+   // units of 0.1 mV before it is scaled to mV
+   for (j = 0; j < kNumberOfBins; j++) {
+      value = adcWaveform[j] - fCellOffset[channel+chipIndex*9][(j + triggerCell) % kNumberOfBins];
+      value = value / fCellGain[channel+chipIndex*9][(j + triggerCell) % kNumberOfBins];
+      if (offsetCalib && channel != 8)
+         value = value - fCellOffset2[channel+chipIndex*9][j] + 32768;
+
+      /* convert to units of 0.1 mV */
+      value = value / 65536.0 * 1000 * 10;
+
+      /* apply clipping */
+      if (channel != 8) {
+         if (adcWaveform[j] >= 0xFFF0 || value > (fRange * 1000 + 500) * 10)
+            value = (fRange * 1000 + 500) * 10;
+         if (adcWaveform[j] <  0x0010 || value < (fRange * 1000 - 500) * 10)
+            value = (fRange * 1000 - 500) * 10;
+      }
+
+      s = (short) (value + 0.5);
+      waveform[j] = static_cast < float >(s * precision);
+   }
+
+   // check for stuck pixels and replace by average of neighbors
+   for (j = 0 ; j < kNumberOfBins; j++) {
+      if (fCellOffset[channel+chipIndex*9][(j + triggerCell) % kNumberOfBins] == 0) {
+         left = (short) floor(waveform[(j-1+kNumberOfBins) % kNumberOfBins] / precision + 0.5);
+         right = (short) floor(waveform[(j+1) % kNumberOfBins] / precision + 0.5);
+         waveform[j] = static_cast < float >(((short) ((left+right)/2)) * precision);
+      }
+   }
+
+   return kSuccess;
+}
+
+/*------------------------------------------------------------------*/
+
 int DRSBoard::GetStretchedTime(float *time, float *measurement, int numberOfMeasurements, float period)
 {
    int j;
@@ -4576,13 +5125,66 @@ double DRSBoard::GetTrueFrequency()
 
 int DRSBoard::GetTime(unsigned int chipIndex, int channelIndex, int tc, float *time, bool tcalibrated, bool rotated)
 {
-   int i, scale, iend;
-   double gt0, gt;
+   const float *axis;
 
    /* for DRS2, please use function below */
    if (fDRSType < 4)
       return GetTime(chipIndex, channelIndex, fNominalFrequency, tc, time, tcalibrated, rotated);
 
+   if (tcalibrated && rotated) {
+      axis = GetTimeAxis(chipIndex, channelIndex, tc);
+      if (axis) {
+         memcpy(time, axis, kNumberOfBins * sizeof(float));
+         return 1;
+      }
+   }
+
+   return ComputeTime(chipIndex, channelIndex, tc, time, tcalibrated, rotated);
+}
+
+/*------------------------------------------------------------------*/
+
+const float *DRSBoard::GetTimeAxis(unsigned int chipIndex, int channelIndex, int tc)
+{
+   // The rotated and calibrated time axis depends only on chip, channel and
+   // trigger cell, so the 1024 possible axes of a channel are computed on
+   // first use and kept until the timing calibration or the sampling speed
+   // changes. Returns NULL for configurations not covered by the cache.
+   int index;
+   float *axis;
+
+   if (fDRSType < 4 || fDecimation || fChannelDepth != kNumberOfBins)
+      return NULL;
+   if (chipIndex >= kNumberOfChipsMax || channelIndex < 0 || channelIndex >= kNumberOfChannelsMax ||
+       tc < 0 || tc >= kNumberOfBins)
+      return NULL;
+
+   if (fTimeAxisFrequency != fNominalFrequency || fTimeAxisCalibratedFrequency != fTimingCalibratedFrequency)
+      InvalidateTimeAxes();
+
+   index = chipIndex * kNumberOfChannelsMax + channelIndex;
+   if (fTimeAxis[index] == NULL) {
+      fTimeAxis[index] = new float[kNumberOfBins * kNumberOfBins];
+      fTimeAxisValid[index] = new bool[kNumberOfBins];
+      memset(fTimeAxisValid[index], 0, kNumberOfBins * sizeof(bool));
+   }
+
+   axis = fTimeAxis[index] + tc * kNumberOfBins;
+   if (!fTimeAxisValid[index][tc]) {
+      ComputeTime(chipIndex, channelIndex, tc, axis, true, true);
+      fTimeAxisValid[index][tc] = true;
+   }
+
+   return axis;
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSBoard::ComputeTime(unsigned int chipIndex, int channelIndex, int tc, float *time, bool tcalibrated, bool rotated)
+{
+   int i, scale, iend;
+   double gt0, gt;
+
    scale = fDecimation ? 2 : 1;
 
    if (!IsTimingCalibrationValid() || !tcalibrated) {
@@ -5127,6 +5729,7 @@ unsigned short buf[1024*16]; // 32 kB
          }
       }
    }
+   InvalidateCalibrationTables();
 
    /*
    FILE *fh = fopen("calib.txt", "wt");
@@ -5169,6 +5772,7 @@ unsigned short buf[1024*16]; // 32 kB
       for (j=0 ; j<kNumberOfBins; j++)
          if (i % 9 != timingChan)
             fCellOffset2[i][j] = wf1[i][j];
+   InvalidateCalibrationTables();
 
    /*
    FILE *fh = fopen("calib.txt", "wt");
@@ -5538,6 +6142,7 @@ int DRSBoard::CalibrateTiming(DRSCallback *pcb)
    Init();
    fNominalFrequency = f;
    fTimingCalibratedFrequency = 0;
+   InvalidateTimeAxes();
    if (fBoardType == 6) // don't set refclk for evaluation boards
       SetRefclk(refclk);
    SetFrequency(fNominalFrequency, true);
@@ -5786,6 +6391,7 @@ int DRSBoard::CalibrateTiming(DRSCallback *pcb)
       fTimingCalibratedFrequency = buf[6] / 1000.0;
       WriteEEPROM(0, buf, 16);
    }
+   InvalidateTimeAxes();
 
    if (ave)
       delete ave;
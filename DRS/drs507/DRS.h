@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "averager.h"
+#include "drstransport.h"
 
 #ifdef USE_DRS_QT_MUTEX
 #include <QMutex>
@@ -504,6 +505,8 @@ protected:
    MVME_INTERFACE      *fVmeInterface;
    mvme_addr_t          fBaseAddress;
 #endif
+   DRSTransport        *fTransportLayer;  // NULL: direct VME or USB access
+   DRSRecordTransport  *fRecorder;        // fTransportLayer while recording
    int                  fSlotNumber;
    double               fNominalFrequency;
    double               fTrueFrequency;
@@ -564,9 +567,23 @@ protected:
    unsigned short       fCellOffset2[kNumberOfChipsMax * kNumberOfChannelsMax][kNumberOfBins];
    double               fCellGain[kNumberOfChipsMax * kNumberOfChannelsMax][kNumberOfBins];
 
+   // Tables of the calibration fast path, derived from the fields above on first use (see CalibrateWaveform())
+   bool                 fCalibTableValid[kNumberOfChipsMax * kNumberOfChannelsMax];
+   double               fCalibTableOffset[kNumberOfChipsMax * kNumberOfChannelsMax][kNumberOfBins];  // fCellOffset
+   double               fCalibTableGain[kNumberOfChipsMax * kNumberOfChannelsMax][kNumberOfBins];    // fCellGain
+   double               fCalibTableOffset2[kNumberOfChipsMax * kNumberOfChannelsMax][kNumberOfBins]; // fCellOffset2
+   unsigned short       fCalibStuckCell[kNumberOfChipsMax * kNumberOfChannelsMax][kNumberOfBins];    // cells with fCellOffset == 0
+   int                  fCalibNumberOfStuckCells[kNumberOfChipsMax * kNumberOfChannelsMax];
+
    double               fTimingCalibratedFrequency;
    double               fCellDT[kNumberOfChipsMax][kNumberOfChannelsMax][kNumberOfBins];
 
+   // Rotated time axes per trigger cell, allocated per channel on first use (see GetTimeAxis())
+   float               *fTimeAxis[kNumberOfChipsMax * kNumberOfChannelsMax];      // [kNumberOfBins][kNumberOfBins]
+   bool                *fTimeAxisValid[kNumberOfChipsMax * kNumberOfChannelsMax]; // [kNumberOfBins]
+   double               fTimeAxisFrequency;           // fNominalFrequency the axes were computed for
+   double               fTimeAxisCalibratedFrequency; // fTimingCalibratedFrequency the axes were computed for
+
    // Fields for Time Calibration
    TimeData           **fTimeData;
    int                  fNumberOfTimeData;
@@ -576,6 +593,8 @@ protected:
 
    // Fields for wave transfer
    bool                 fWaveTransferred[kNumberOfChipsMax * kNumberOfChannelsMax];
+   unsigned char       *fMultiBufferWaves;     // staging area of TransferMultiBufferWaves()
+   int                  fMultiBufferWavesSize;
 
    // Waveform Rotation
    int                  fTriggerStartBin; // Start Bin of the trigger
@@ -596,6 +615,7 @@ public:
 
    MVME_INTERFACE *GetVMEInterface() const { return fVmeInterface; };
 #endif
+   DRSBoard(DRSTransport *transport, int slot = 0);
    ~DRSBoard();
 
    int          SetBoardSerialNumber(unsigned short serialNumber);
@@ -633,7 +653,16 @@ public:
    int          InitFPGA(void);
    int          Write(int type, unsigned int addr, void *data, int size);
    int          Read(int type, void *data, unsigned int addr, int size);
+   int          WriteDevice(int type, unsigned int addr, void *data, int size);
+   int          ReadDevice(int type, void *data, unsigned int addr, int size);
    int          GetTransport() const { return fTransport; }
+   void         SetTransportLayer(DRSTransport *transport);
+   DRSTransport *GetTransportLayer() const { return fTransportLayer; }
+   // records all accesses into a file for a DRSReplayTransport; call it only while the acquisition is stopped:
+   // the calibration pages are read through the waveform RAM of the board
+   int          StartRecording(const char *fileName);
+   void         StopRecording();
+   bool         IsRecording() const { return fRecorder != NULL; }
    void         RegisterTest(void);
    int          RAMTest(int flag);
    int          ChipTest();
@@ -700,6 +729,8 @@ public:
    int          SetMultiBufferRP(unsigned short rp);
    int          GetMultiBufferWP(void);
    void         IncrementMultiBufferRP(void);
+   int          GetNumberOfMultiBuffers() const { return fNMultiBuffer; }
+   int          TransferMultiBufferWaves(unsigned char **p, int *triggerCells, int maxEvents);
    void         SetVoltageOffset(double offset1, double offset2);
    int          SetInputRange(double center);
    double       GetInputRange(void) { return fRange; }
@@ -724,6 +755,9 @@ public:
    int          GetWave(unsigned int chipIndex, unsigned char channel, float *waveform, bool responseCalib,
                         int triggerCell = -1, int wsr = -1, bool adjustToClock = false, float threshold = 0, bool offsetCalib = true);
    int          GetWave(unsigned int chipIndex, unsigned char channel, float *waveform);
+   int          GetWaves(unsigned char *waveforms, unsigned int chipIndex, unsigned char channel1, unsigned char channel2,
+                         float *waveform1, float *waveform2, bool responseCalib = false, int triggerCell = -1,
+                         float threshold = 0, bool offsetCalib = true);
    int          GetRawWave(unsigned int chipIndex, unsigned char channel, unsigned short *waveform, bool adjustToClock = false);
    int          GetRawWave(unsigned char *waveforms,unsigned int chipIndex, unsigned char channel,
                            unsigned short *waveform, bool adjustToClock = false);
@@ -731,6 +765,7 @@ public:
    bool         IsVoltageCalibrationValid(void) { return fVoltageCalibrationValid; }
    int          GetTime(unsigned int chipIndex, int channelIndex, double freq, int tc, float *time, bool tcalibrated=true, bool rotated=true);
    int          GetTime(unsigned int chipIndex, int channelIndex, int tc, float *time, bool tcalibrated=true, bool rotated=true);
+   const float *GetTimeAxis(unsigned int chipIndex, int channelIndex, int tc);
    int          GetTimeCalibration(unsigned int chipIndex, int channelIndex, int mode, float *time, bool force=false);
    int          GetTriggerCell(unsigned int chipIndex);
    int          GetStopCell(unsigned int chipIndex);
@@ -773,6 +808,9 @@ public:
    int          CalibrateWaveform(unsigned int chipIndex, unsigned char channel, unsigned short *adcWaveform,
                                   short *waveform, bool responseCalib, int triggerCell, bool adjustToClock,
                                   float threshold, bool offsetCalib);
+   int          CalibrateWaveform(unsigned int chipIndex, unsigned char channel, unsigned short *adcWaveform,
+                                  float *waveform, bool responseCalib, int triggerCell, bool adjustToClock,
+                                  float threshold, bool offsetCalib);
 
    static void  LinearRegression(double *x, double *y, int n, double *a, double *b);
    
@@ -793,6 +831,10 @@ protected:
    void         ConstructBoard();
    void         ReadSerialNumber();
    void         ReadCalibration(void);
+   void         InvalidateCalibrationTables(void);
+   void         UpdateCalibrationTable(int index);
+   void         InvalidateTimeAxes(void);
+   int          ComputeTime(unsigned int chipIndex, int channelIndex, int tc, float *time, bool tcalibrated, bool rotated);
 
    TimeData    *GetTimeCalibration(unsigned int chipIndex, bool reinit = false);
 
@@ -948,10 +990,12 @@ private:
 public:
    // Public Methods
    DRS();
+   DRS(DRSBoard *b); // single board without hardware scan, e.g. on a DRSReplayTransport
    ~DRS();
 
    DRSBoard        *GetBoard(int i) { return fBoard[i]; }
    void             SetBoard(int i, DRSBoard *b);
+   int              AddBoard(DRSBoard *b);
    DRSBoard       **GetBoards() { return fBoard; }
    int              GetNumberOfBoards() const { return fNumberOfBoards; }
    bool             GetError(char *str, int size);
@@ -0,0 +1,340 @@
+/********************************************************************\
+
+  Name:         drstransport.cpp
+
+  Contents:     I/O layer below DRSBoard::Read()/Write(): direct access
+                of VME or USB, recording of all accesses into a file and
+                a file-backed mock device replaying such a recording
+
+\********************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "DRS.h"
+#include "drstransport.h"
+
+/*------------------------------------------------------------------*/
+
+int DRSDeviceTransport::Read(int type, void *data, unsigned int addr, int size)
+{
+   return fBoard->ReadDevice(type, data, addr, size);
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSDeviceTransport::Write(int type, unsigned int addr, void *data, int size)
+{
+   return fBoard->WriteDevice(type, addr, data, size);
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSDeviceTransport::GetTransportType()
+{
+   return fBoard->GetTransport();
+}
+
+/*------------------------------------------------------------------*/
+
+DRSRecordTransport::DRSRecordTransport(DRSTransport *transport, FILE *file, int boardType)
+:  fTransport(transport)
+    , fFile(file)
+{
+   int transportType;
+
+   // header
+   transportType = fTransport->GetTransportType();
+   fwrite(DRS_RECORD_MAGIC, 1, 8, fFile);
+   fwrite(&transportType, sizeof(int), 1, fFile);
+   fwrite(&boardType, sizeof(int), 1, fFile);
+}
+
+/*------------------------------------------------------------------*/
+
+DRSRecordTransport::~DRSRecordTransport()
+{
+   if (fFile)
+      fclose(fFile);
+
+   delete fTransport;
+}
+
+/*------------------------------------------------------------------*/
+
+DRSTransport *DRSRecordTransport::Detach()
+{
+   DRSTransport *transport;
+
+   transport = fTransport;
+   fTransport = NULL;
+
+   return transport;
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSRecordTransport::WriteRecord(char op, int type, unsigned int addr, int size, int result, void *data)
+{
+   unsigned char t;
+
+   t = (unsigned char) type;
+   fwrite(&op, 1, 1, fFile);
+   fwrite(&t, 1, 1, fFile);
+   fwrite(&addr, sizeof(unsigned int), 1, fFile);
+   fwrite(&size, sizeof(int), 1, fFile);
+   fwrite(&result, sizeof(int), 1, fFile);
+   fwrite(data, 1, size, fFile);
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSRecordTransport::Read(int type, void *data, unsigned int addr, int size)
+{
+   int n;
+
+   n = fTransport->Read(type, data, addr, size);
+   WriteRecord(DRS_RECORD_READ, type, addr, size, n, data);
+
+   return n;
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSRecordTransport::Write(int type, unsigned int addr, void *data, int size)
+{
+   int n;
+
+   n = fTransport->Write(type, addr, data, size);
+   WriteRecord(DRS_RECORD_WRITE, type, addr, size, n, data);
+
+   return n;
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSRecordTransport::GetTransportType()
+{
+   return fTransport->GetTransportType();
+}
+
+/*------------------------------------------------------------------*/
+
+DRSReplayTransport::DRSReplayTransport(const char *fileName, double eventRate)
+:  fTransportType(TR_USB2)
+    , fBoardType(0)
+    , fValid(false)
+    , fPage(0)
+    , fEEPROMPending(false)
+    , fEventRate(eventRate)
+    , fNextFrame(0)
+    , fFramesDelivered(0)
+    , fNextEventTime(0)
+{
+   FILE *f;
+   char magic[8], op;
+   unsigned char type;
+   unsigned int addr;
+   int size, result;
+   Buffer data;
+   Frame frame;
+   unsigned long long key;
+
+   f = fopen(fileName, "rb");
+   if (f == NULL) {
+      printf("Cannot open recording \"%s\"\n", fileName);
+      return;
+   }
+
+   if (fread(magic, 1, 8, f) != 8 || memcmp(magic, DRS_RECORD_MAGIC, 8) != 0 ||
+       fread(&fTransportType, sizeof(int), 1, f) != 1 ||
+       fread(&fBoardType, sizeof(int), 1, f) != 1) {
+      printf("Invalid recording \"%s\"\n", fileName);
+      fclose(f);
+      return;
+   }
+
+   // classify the recorded accesses with the same state as the replay
+   while (fread(&op, 1, 1, f) == 1) {
+      if (fread(&type, 1, 1, f) != 1 ||
+          fread(&addr, sizeof(unsigned int), 1, f) != 1 ||
+          fread(&size, sizeof(int), 1, f) != 1 ||
+          fread(&result, sizeof(int), 1, f) != 1 ||
+          size < 0)
+         break;
+
+      data.resize(size);
+      if (size > 0 && fread(&data[0], 1, size, f) != (size_t) size)
+         break;
+
+      if (op == DRS_RECORD_WRITE) {
+         Access(type, addr, size, size > 0 ? &data[0] : NULL);
+      } else if (type == T_RAM) {
+         if (fEEPROMPending) {
+            fEEPROMPage[fPage] = data;
+            fEEPROMPending = false;
+         } else if (result == size) {
+            frame.addr = addr;
+            frame.data = data;
+            fFrame.push_back(frame);
+         }
+      } else {
+         // registers keep their value at the start of the recording
+         key = RegisterKey(type, addr, size);
+         if (fRegister.find(key) == fRegister.end())
+            fRegister[key] = data;
+      }
+   }
+
+   fclose(f);
+
+   fPage = 0;
+   fEEPROMPending = false;
+   fValid = true;
+}
+
+/*------------------------------------------------------------------*/
+
+unsigned long long DRSReplayTransport::RegisterKey(int type, unsigned int addr, int size)
+{
+   return ((unsigned long long) type << 48) | ((unsigned long long) (size & 0xFFFF) << 32) | addr;
+}
+
+/*------------------------------------------------------------------*/
+
+double DRSReplayTransport::Now()
+{
+   return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*------------------------------------------------------------------*/
+
+bool DRSReplayTransport::IsPageRegister(unsigned int addr, int size)
+{
+   if (size != 2)
+      return false;
+
+   if (fBoardType == 6)
+      return addr == REG_EEPROM_PAGE_MEZZ;
+
+   return addr == REG_EEPROM_PAGE_EVAL;
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSReplayTransport::Access(int type, unsigned int addr, int size, const unsigned char *data)
+{
+   // track the EEPROM page and read trigger of DRSBoard::ReadEEPROM()
+   unsigned int bits;
+
+   if (type != T_CTRL || data == NULL)
+      return;
+
+   if (IsPageRegister(addr, size))
+      fPage = *((unsigned short *) data);
+
+   if (addr == REG_CTRL && size == 4) {
+      memcpy(&bits, data, 4);
+      if (bits & BIT_EEPROM_READ_TRIG)
+         fEEPROMPending = true;
+   }
+}
+
+/*------------------------------------------------------------------*/
+
+bool DRSReplayTransport::IsEventDue()
+{
+   if (fEventRate <= 0)
+      return true;
+
+   return Now() >= fNextEventTime;
+}
+
+/*------------------------------------------------------------------*/
+
+void DRSReplayTransport::SetEventRate(double rate)
+{
+   fEventRate = rate;
+   fNextEventTime = 0;
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSReplayTransport::Read(int type, void *data, unsigned int addr, int size)
+{
+   unsigned int i, status;
+   std::map<int, Buffer>::iterator page;
+   std::map<unsigned long long, Buffer>::iterator reg;
+
+   memset(data, 0, size);
+
+   if (!fValid)
+      return 0;
+
+   if (type == T_RAM) {
+      if (fEEPROMPending) {
+         fEEPROMPending = false;
+         page = fEEPROMPage.find(fPage);
+         if (page != fEEPROMPage.end())
+            memcpy(data, &page->second[0], page->second.size() < (size_t) size ? page->second.size() : size);
+         return size;
+      }
+
+      // next recorded frame of the same transfer, in a loop
+      for (i = 0; i < fFrame.size(); i++) {
+         Frame &frame = fFrame[(fNextFrame + i) % fFrame.size()];
+         if (frame.addr == addr && frame.data.size() == (size_t) size) {
+            memcpy(data, &frame.data[0], size);
+            fNextFrame = (fNextFrame + i + 1) % fFrame.size();
+            fFramesDelivered++;
+            if (fEventRate > 0)
+               fNextEventTime = Now() + 1 / fEventRate;
+            return size;
+         }
+      }
+
+      return 0;
+   }
+
+   reg = fRegister.find(RegisterKey(type, addr, size));
+   if (reg != fRegister.end())
+      memcpy(data, &reg->second[0], size);
+
+   if (type == T_STATUS && addr == REG_STATUS && size == 4) {
+      // EEPROM is never busy, the domino wave stops when the next event is due
+      memcpy(&status, data, 4);
+      status &= ~BIT_SERIAL_BUSY;
+      if (IsEventDue())
+         status &= ~BIT_RUNNING;
+      else
+         status |= BIT_RUNNING;
+      memcpy(data, &status, 4);
+   }
+
+   return size;
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSReplayTransport::Write(int type, unsigned int addr, void *data, int size)
+{
+   if (!fValid)
+      return 0;
+
+   // control registers read back the last value written
+   if (type == T_CTRL)
+      fRegister[RegisterKey(type, addr, size)] = Buffer((unsigned char *) data, (unsigned char *) data + size);
+
+   Access(type, addr, size, (unsigned char *) data);
+
+   return size;
+}
+
+/*------------------------------------------------------------------*/
+
+int DRSReplayTransport::GetTransportType()
+{
+   return fTransportType;
+}
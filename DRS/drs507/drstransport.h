@@ -0,0 +1,123 @@
+/********************************************************************\
+
+  Name:         drstransport.h
+
+  Contents:     I/O layer below DRSBoard::Read()/Write(): direct access
+                of VME or USB, recording of all accesses into a file and
+                a file-backed mock device replaying such a recording
+
+\********************************************************************/
+
+#ifndef DRSTRANSPORT_H
+#define DRSTRANSPORT_H
+
+#include <stdio.h>
+
+#include <map>
+#include <vector>
+
+class DRSBoard;
+
+/* file format of a recording: header followed by one record per access */
+#define DRS_RECORD_MAGIC   "DRSREC01"
+#define DRS_RECORD_READ    'R'
+#define DRS_RECORD_WRITE   'W'
+
+class DRSTransport {
+public:
+   virtual ~DRSTransport() {}
+
+   // same semantics as DRSBoard::Read()/Write(): addresses are relative to the type (T_CTRL, T_STATUS, T_RAM, T_FIFO)
+   virtual int Read(int type, void *data, unsigned int addr, int size) = 0;
+   virtual int Write(int type, unsigned int addr, void *data, int size) = 0;
+
+   // transport mode of the device (TR_VME, TR_USB or TR_USB2)
+   virtual int GetTransportType() = 0;
+};
+
+/*------------------------------------------------------------------*/
+
+// VME or USB (libusb) access of a board, see DRSBoard::ReadDevice()/WriteDevice()
+class DRSDeviceTransport : public DRSTransport {
+   DRSBoard *fBoard;
+
+public:
+   DRSDeviceTransport(DRSBoard *board) : fBoard(board) {}
+
+   virtual int Read(int type, void *data, unsigned int addr, int size);
+   virtual int Write(int type, unsigned int addr, void *data, int size);
+   virtual int GetTransportType();
+};
+
+/*------------------------------------------------------------------*/
+
+// forwards all accesses to another transport and writes them into a file
+class DRSRecordTransport : public DRSTransport {
+   DRSTransport *fTransport;
+   FILE         *fFile;
+
+   void          WriteRecord(char op, int type, unsigned int addr, int size, int result, void *data);
+
+public:
+   DRSRecordTransport(DRSTransport *transport, FILE *file, int boardType);
+   virtual ~DRSRecordTransport();
+
+   virtual int Read(int type, void *data, unsigned int addr, int size);
+   virtual int Write(int type, unsigned int addr, void *data, int size);
+   virtual int GetTransportType();
+
+   DRSTransport *Detach();
+};
+
+/*------------------------------------------------------------------*/
+
+// mock device replaying a recording: registers return their first recorded
+// value (or the last value written), the EEPROM pages their recorded image
+// and the waveform transfers the recorded frames in a loop at a given rate
+class DRSReplayTransport : public DRSTransport {
+   typedef std::vector<unsigned char> Buffer;
+
+   struct Frame {
+      unsigned int addr;
+      Buffer       data;
+   };
+
+   int                                      fTransportType;
+   int                                      fBoardType;
+   bool                                     fValid;
+
+   std::map<unsigned long long, Buffer>     fRegister;   // (type, size, addr)
+   std::map<int, Buffer>                    fEEPROMPage;
+   std::vector<Frame>                       fFrame;
+
+   int                                      fPage;
+   bool                                     fEEPROMPending;
+
+   double                                   fEventRate;  // [Hz], 0: no limit
+   unsigned int                             fNextFrame;
+   unsigned long long                       fFramesDelivered;
+   double                                   fNextEventTime;
+
+   static unsigned long long RegisterKey(int type, unsigned int addr, int size);
+   static double Now();
+
+   bool          IsPageRegister(unsigned int addr, int size);
+   void          Access(int type, unsigned int addr, int size, const unsigned char *data);
+   bool          IsEventDue();
+
+public:
+   DRSReplayTransport(const char *fileName, double eventRate = 0);
+   virtual ~DRSReplayTransport() {}
+
+   bool          IsValid() const { return fValid; }
+   int           GetNumberOfFrames() const { return (int) fFrame.size(); }
+   unsigned long long GetFramesDelivered() const { return fFramesDelivered; }
+
+   void          SetEventRate(double rate);
+
+   virtual int Read(int type, void *data, unsigned int addr, int size);
+   virtual int Write(int type, unsigned int addr, void *data, int size);
+   virtual int GetTransportType();
+};
+
+#endif // DRSTRANSPORT_H
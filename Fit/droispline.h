@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DROISPLINE_H
+#define DROISPLINE_H
+
+/* natural cubic spline built over a window [first ; last] of a fixed-capacity sample array (ROI of the DRS4 cells):
+ *
+ * - no heap allocations: the samples and the coefficients live in arrays of the given capacity.
+ * - the element-wise parts of the build (differences, slopes, right-hand side and coefficients) run in separate, branch-free loops over
+ *   contiguous arrays, which are vectorized by the compiler. Only the recurrences of the tridiagonal solve (Thomas) are sequential.
+ * - the samples outside the window are interpolated linearly.
+ *
+ * within segment i: y(x) = y[i] + b[i]*h + c[i]*h^2 + d[i]*h^3 with h = x - x[i] */
+template <typename T, int capacity>
+class DROICubicSpline final {
+    T m_x[capacity];
+    T m_y[capacity];
+
+    /* build: differences >> slopes >> coefficients */
+    T m_h[capacity];
+    T m_b[capacity];
+    T m_c[capacity];
+    T m_d[capacity];
+
+    int m_size;
+    int m_first, m_last;
+
+public:
+    DROICubicSpline() :
+        m_size(0),
+        m_first(0),
+        m_last(-1) {}
+
+    inline int size() const {
+        return m_size;
+    }
+
+    inline void resize(int size) {
+        m_size = (size < 0)?0:((size > capacity)?capacity:size);
+    }
+
+    inline void setSample(int index, T x, T y) {
+        m_x[index] = x;
+        m_y[index] = y;
+    }
+
+    /* natural cubic spline over the samples [first ; last] */
+    void build(int first, int last) {
+        first = (first < 0)?0:first;
+        last = (last > m_size - 1)?(m_size - 1):last;
+
+        m_first = first;
+        m_last = last;
+
+        const int n = last - first + 1;
+
+        if ( n < 2 )
+            return;
+
+        const T *x = m_x + first;
+        const T *y = m_y + first;
+
+        T *h = m_h + first;
+        T *b = m_b + first;
+        T *c = m_c + first;
+        T *d = m_d + first;
+
+        /* differences and slopes (b) */
+        for ( int i = 0 ; i < n - 1 ; ++ i )
+            h[i] = x[i + 1] - x[i];
+
+        for ( int i = 0 ; i < n - 1 ; ++ i )
+            b[i] = (y[i + 1] - y[i])/h[i];
+
+        /* tridiagonal system of the curvatures: diagonal (d) and right-hand side (c) */
+        for ( int i = 1 ; i < n - 1 ; ++ i ) {
+            d[i] = T(2)*(h[i - 1] + h[i]);
+            c[i] = T(3)*(b[i] - b[i - 1]);
+        }
+
+        /* Thomas: forward elimination and back substitution, natural boundary conditions */
+        for ( int i = 2 ; i < n - 1 ; ++ i ) {
+            const T w = h[i - 1]/d[i - 1];
+
+            d[i] -= w*h[i - 1];
+            c[i] -= w*c[i - 1];
+        }
+
+        c[0] = T(0);
+        c[n - 1] = T(0);
+
+        for ( int i = n - 2 ; i >= 1 ; -- i )
+            c[i] = (c[i] - h[i]*c[i + 1])/d[i];
+
+        /* coefficients of the segments */
+        for ( int i = 0 ; i < n - 1 ; ++ i ) {
+            b[i] = b[i] - h[i]*(T(2)*c[i] + c[i + 1])/T(3);
+            d[i] = (c[i + 1] - c[i])/(T(3)*h[i]);
+        }
+    }
+
+    /* coefficients of the segment [x0 ; x1] containing x (x0 <= x) in the form coeff[0] + coeff[1]*h + coeff[2]*h^2 + coeff[3]*h^3 with
+     * h = x - x0 - 'false' if x is outside the samples */
+    inline bool segment(double x, double *x0, double *x1, double coeff[4]) const {
+        if ( m_size < 2
+             || x < m_x[0]
+             || x > m_x[m_size - 1] )
+            return false;
+
+        /* binary search of the segment m_x[l] <= x < m_x[l + 1] */
+        int l = 0;
+        int r = m_size - 1;
+
+        while ( l != r - 1 ) {
+            const int m = (l + r)/2;
+
+            if ( m_x[m] > x )
+                r = m;
+            else
+                l = m;
+        }
+
+        *x0 = m_x[l];
+        *x1 = m_x[l + 1];
+
+        coeff[0] = m_y[l];
+
+        if ( l >= m_first && l < m_last ) {
+            coeff[1] = m_b[l];
+            coeff[2] = m_c[l];
+            coeff[3] = m_d[l];
+        }
+        else {
+            coeff[1] = (m_y[l + 1] - m_y[l])/(m_x[l + 1] - m_x[l]);
+            coeff[2] = 0.;
+            coeff[3] = 0.;
+        }
+
+        return true;
+    }
+
+    /* extrapolates linearly outside the samples */
+    inline double operator()(double x) const {
+        if ( m_size < 2 )
+            return m_size?m_y[0]:0.;
+
+        double x0 = 0., x1 = 0.;
+        double coeff[4];
+
+        if ( !segment(x, &x0, &x1, coeff) ) {
+            const int l = (x < m_x[0])?0:(m_size - 2);
+
+            return m_y[l] + (x - m_x[l])*(m_y[l + 1] - m_y[l])/(m_x[l + 1] - m_x[l]);
+        }
+
+        const double h = x - x0;
+
+        return coeff[0] + h*(coeff[1] + h*(coeff[2] + h*coeff[3]));
+    }
+};
+
+#endif // DROISPLINE_H
@@ -434,3 +434,26 @@ double spline::operator() (double x) const
     }
     return interpol;
 }
+
+bool spline::segment(double x, double *x0, double *x1, double coeff[4]) const
+{
+    const size_t n=m_x.size();
+
+    if(n<2 || x<m_x[0] || x>m_x[n-1])
+        return false;
+
+    // find the point m_x[idx] <= x, the last point belongs to the last segment
+    std::vector<double>::const_iterator it;
+    it=std::upper_bound(m_x.begin(),m_x.end(),x);
+    const int idx=std::min( int(it-m_x.begin())-1, int(n)-2);
+
+    *x0=m_x[idx];
+    *x1=m_x[idx+1];
+
+    coeff[0]=m_y[idx];
+    coeff[1]=m_c[idx];
+    coeff[2]=m_b[idx];
+    coeff[3]=m_a[idx];
+
+    return true;
+}
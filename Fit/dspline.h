@@ -86,6 +86,11 @@ public:
     void set_points(const std::vector<double>& x, const std::vector<double>& y, bool cubic_spline=true);
     void set_pointsArray(float x[], float y[], int size, bool cubic_spline=true);
     double operator() (double x) const;
+
+    // coefficients of the segment [x0 ; x1] containing x (x0 <= x), i.e.
+    // f(x) = coeff[0] + coeff[1]*(x-x0) + coeff[2]*(x-x0)^2 + coeff[3]*(x-x0)^3
+    // returns false if x is outside the range of the points
+    bool segment(double x, double *x0, double *x1, double coeff[4]) const;
 };
 
 class akimaSpline
@@ -186,6 +191,14 @@ public:
             break;
         }
     }
+
+    // piecewise polynomial representation (not available for the Akima spline)
+    bool segment(double x, double *x0, double *x1, double coeff[4]) const {
+        if ( m_type == SplineType::Akima )
+            return false;
+
+        return m_cubicAndLinearSpline.segment(x, x0, x1, coeff);
+    }
 };
 
 #endif // DSPLINE_H
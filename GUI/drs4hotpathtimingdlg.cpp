@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#include "drs4hotpathtimingdlg.h"
+#include "ui_drs4hotpathtimingdlg.h"
+
+DRS4HotPathTimingDlg::DRS4HotPathTimingDlg(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::DRS4HotPathTimingDlg)
+{
+    ui->setupUi(this);
+
+    if (DRS4BoardManager::sharedInstance()->isDemoModeEnabled()  )
+        setWindowTitle(PROGRAM_NAME + " - SIMULATION-MODE");
+    else
+        setWindowTitle(PROGRAM_NAME);
+
+    ui->tableWidget->setColumnCount(7);
+    ui->tableWidget->setRowCount(__HOT_PATH_STAGES);
+    ui->tableWidget->setHorizontalHeaderLabels(QStringList() << "count" << "total [ms]" << "mean [us]" << "median [us]" << "99% [us]" << "max [us]" << "share [%]");
+    ui->tableWidget->setVerticalHeaderLabels(DRS4HotPathStage::typeList());
+
+    for ( int row = 0 ; row < __HOT_PATH_STAGES ; ++ row ) {
+        for ( int column = 0 ; column < ui->tableWidget->columnCount() ; ++ column ) {
+            QTableWidgetItem *item = new QTableWidgetItem("0");
+
+            item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+            ui->tableWidget->setItem(row, column, item);
+        }
+    }
+
+    ui->tableWidget_filters->setColumnCount(4);
+    ui->tableWidget_filters->setRowCount(__HOT_PATH_FILTERS);
+    ui->tableWidget_filters->setHorizontalHeaderLabels(QStringList() << "tested" << "rejected" << "reject rate [%]" << "of all events [%]");
+    ui->tableWidget_filters->setVerticalHeaderLabels(DRS4RejectFilter::typeList());
+
+    for ( int row = 0 ; row < __HOT_PATH_FILTERS ; ++ row ) {
+        for ( int column = 0 ; column < ui->tableWidget_filters->columnCount() ; ++ column ) {
+            QTableWidgetItem *item = new QTableWidgetItem("0");
+
+            item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+            ui->tableWidget_filters->setItem(row, column, item);
+        }
+    }
+
+    ui->checkBox_enabled->setChecked(DRS4HotPathTiming::isEnabled());
+
+    m_updateTimer.setInterval(1000);
+    m_updateTimer.setSingleShot(false);
+
+    connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateTimings()));
+
+    connect(ui->checkBox_enabled, SIGNAL(clicked(bool)), this, SLOT(changeTimingEnabled(bool)));
+    connect(ui->pushButton_reset, SIGNAL(clicked()), this, SLOT(resetTimings()));
+    connect(ui->pushButton_export, SIGNAL(clicked()), this, SLOT(exportTimings()));
+}
+
+DRS4HotPathTimingDlg::~DRS4HotPathTimingDlg()
+{
+    DDELETE_SAFETY(ui);
+}
+
+void DRS4HotPathTimingDlg::showEvent(QShowEvent *event)
+{
+    updateTimings();
+
+    m_updateTimer.start();
+
+    QWidget::showEvent(event);
+}
+
+void DRS4HotPathTimingDlg::hideEvent(QHideEvent *event)
+{
+    m_updateTimer.stop();
+
+    QWidget::hideEvent(event);
+}
+
+void DRS4HotPathTimingDlg::updateTimings()
+{
+    const QVector<DRS4HotPathStageTiming> timings = DRS4HotPathTiming::sharedInstance()->timings();
+
+    quint64 totalInNs = 0;
+
+    for ( const DRS4HotPathStageTiming& timing : timings )
+        totalInNs += timing.m_sumInNs;
+
+    for ( int stage = 0 ; stage < __HOT_PATH_STAGES ; ++ stage ) {
+        const DRS4HotPathStageTiming& timing = timings.at(stage);
+
+        ui->tableWidget->item(stage, 0)->setText(QString::number(timing.m_count));
+        ui->tableWidget->item(stage, 1)->setText(QString::number(1E-6*double(timing.m_sumInNs), 'f', 3));
+        ui->tableWidget->item(stage, 2)->setText(QString::number(1E-3*timing.meanInNs(), 'f', 3));
+        ui->tableWidget->item(stage, 3)->setText(QString::number(1E-3*timing.quantileInNs(0.5), 'f', 3));
+        ui->tableWidget->item(stage, 4)->setText(QString::number(1E-3*timing.quantileInNs(0.99), 'f', 3));
+        ui->tableWidget->item(stage, 5)->setText(QString::number(1E-3*double(timing.m_maxInNs), 'f', 3));
+        ui->tableWidget->item(stage, 6)->setText(QString::number(totalInNs?(100.*double(timing.m_sumInNs)/double(totalInNs)):0., 'f', 1));
+    }
+
+    const QVector<DRS4RejectFilterStatistics> statistics = DRS4HotPathTiming::sharedInstance()->filterStatistics();
+
+    /* events entering the cascade */
+    const quint64 events = statistics.first().m_tested;
+
+    for ( int filter = 0 ; filter < __HOT_PATH_FILTERS ; ++ filter ) {
+        const DRS4RejectFilterStatistics& filterStatistics = statistics.at(filter);
+
+        ui->tableWidget_filters->item(filter, 0)->setText(QString::number(filterStatistics.m_tested));
+        ui->tableWidget_filters->item(filter, 1)->setText(QString::number(filterStatistics.m_rejected));
+        ui->tableWidget_filters->item(filter, 2)->setText(QString::number(100.*filterStatistics.rejectRate(), 'f', 2));
+        ui->tableWidget_filters->item(filter, 3)->setText(QString::number(events?(100.*double(filterStatistics.m_rejected)/double(events)):0., 'f', 2));
+    }
+
+    ui->label_threads->setText(QString("threads: %1").arg(DRS4HotPathTiming::sharedInstance()->threadCount()));
+}
+
+void DRS4HotPathTimingDlg::changeTimingEnabled(bool on)
+{
+    DRS4HotPathTiming::sharedInstance()->setEnabled(on);
+}
+
+void DRS4HotPathTimingDlg::resetTimings()
+{
+    DRS4HotPathTiming::sharedInstance()->reset();
+
+    updateTimings();
+}
+
+void DRS4HotPathTimingDlg::exportTimings()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, tr("Save File"),
+                                                          DRS4ProgramSettingsManager::sharedInstance()->saveDataFilePath(),
+                                                          tr("CSV (*.csv)"));
+
+    if ( fileName.isEmpty() )
+        return;
+
+    DRS4ProgramSettingsManager::sharedInstance()->setSaveDataFilePath(fileName);
+
+    QFile file(fileName);
+    QTextStream stream(&file);
+
+    if ( file.open(QIODevice::WriteOnly) ) {
+        stream << DRS4HotPathTiming::sharedInstance()->toCSV();
+
+        file.close();
+    }
+    else {
+        MSGBOX("Error while writing file!");
+    }
+}
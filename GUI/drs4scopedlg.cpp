@@ -103,6 +103,7 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     m_pulseShapeFilterTimerB(DNULLPTR),
     m_lifetimeRequestTimer(DNULLPTR),
     m_temperatureTimer(DNULLPTR),
+    m_chunkSizeTimer(DNULLPTR),
     m_autoSaveTimer(DNULLPTR),
     m_addInfoDlg(DNULLPTR),
     m_gplDialog(DNULLPTR),
@@ -214,6 +215,9 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     m_calculatorDlg = new DRS4CalculatorDlg;
     m_calculatorDlg->hide();
 
+    m_hotPathTimingDlg = new DRS4HotPathTimingDlg;
+    m_hotPathTimingDlg->hide();
+
     m_gplDialog = new DRS4LicenseTextBox;
     m_gplDialog->addLicense(":/license/GPL", "License - GPLv3");
     m_gplDialog->hide();
@@ -294,6 +298,10 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     m_autoSaveTimer->setInterval(30000);
     m_autoSaveTimer->setSingleShot(false);
 
+    m_chunkSizeTimer = new QTimer();
+    m_chunkSizeTimer->setInterval(1000);
+    m_chunkSizeTimer->setSingleShot(false);
+
     if ( !DRS4BoardManager::sharedInstance()->isDemoModeEnabled() ) {
         DRS4BoardManager::sharedInstance()->currentBoard()->Init();
         DRS4BoardManager::sharedInstance()->currentBoard()->SetFrequency(DRS4SettingsManager::sharedInstance()->sampleSpeedInGHz(), true);
@@ -376,12 +384,16 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
 
     m_worker->moveToThread(m_workerThread);
 
-    ui->label_cores->setNum((m_worker->maxThreads()==0)?1:m_worker->maxThreads());
+    /* the analysis threads leave one core to the readout of the board */
+    ui->label_cores->setNum(qMax(1, QThread::idealThreadCount()));
 
-    if ( m_worker->maxThreads() <= 1 ) {
+    if ( QThread::idealThreadCount() <= 1 ) {
         DRS4ProgramSettingsManager::sharedInstance()->setEnableMulticoreThreading(false);
         ui->checkBox_hyperthreading->setEnabled(false);
         ui->spinBox_parallelChunkSize->setEnabled(false);
+        ui->checkBox_parallelChunkSizeAuto->setEnabled(false);
+        ui->checkBox_pinThreads->setEnabled(false);
+        ui->checkBox_multiBuffer->setEnabled(false);
         ui->label_87->setEnabled(false);
         ui->label_88->setEnabled(false);
         ui->label_89->setEnabled(false);
@@ -419,6 +431,7 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     connect(ui->actionSave_next_N_Pulses, SIGNAL(triggered()), this, SLOT(showSavePulses()));
     connect(ui->actionSave_next_N_Pulses_in_Range, SIGNAL(triggered()), this, SLOT(showSavePulsesRange()));
     connect(ui->actionOpen_calculator, SIGNAL(triggered()), this, SLOT(showCalculator()));
+    connect(ui->actionOpen_hotPathTiming, SIGNAL(triggered()), this, SLOT(showHotPathTiming()));
     connect(ui->actionLicense_GPLv3, SIGNAL(triggered()), this, SLOT(showGPL()));
     connect(ui->actionLicense_LGPLv3, SIGNAL(triggered()), this, SLOT(showLGPL()));
     connect(ui->actionUsed_License_GPLv3, SIGNAL(triggered()), this, SLOT(showUsedGPL()));
@@ -509,6 +522,11 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     ui->spinBox_parallelChunkSize->setValue(DRS4ProgramSettingsManager::sharedInstance()->pulsePairChunkSize());
 
     ui->checkBox_hyperthreading->setChecked(DRS4ProgramSettingsManager::sharedInstance()->isMulticoreThreadingEnabled());
+    ui->checkBox_parallelChunkSizeAuto->setChecked(DRS4ProgramSettingsManager::sharedInstance()->isPulsePairChunkSizeAdaptive());
+    ui->spinBox_parallelChunkSize->setReadOnly(ui->checkBox_parallelChunkSizeAuto->isChecked());
+
+    ui->checkBox_pinThreads->setChecked(DRS4ProgramSettingsManager::sharedInstance()->isAnalysisThreadPinningEnabled());
+    ui->checkBox_multiBuffer->setChecked(DRS4ProgramSettingsManager::sharedInstance()->isMultiBufferReadoutEnabled());
 
     if (ui->checkBox_hyperthreading->isChecked()) {
         ui->actionStart_True_False_Pulse_Streaming->setEnabled(false);
@@ -627,6 +645,9 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     connect(ui->doubleSpinBox_persistanceRightB, SIGNAL(valueChanged(double)), this, SLOT(changeRightBPersistance(double)));
 
     connect(ui->spinBox_parallelChunkSize, SIGNAL(valueChanged(int)), this, SLOT(changePulsePairChunkSize(int)));
+    connect(ui->checkBox_parallelChunkSizeAuto, SIGNAL(clicked(bool)), this, SLOT(changePulsePairChunkSizeAdaptive(bool)));
+    connect(ui->checkBox_pinThreads, SIGNAL(clicked(bool)), this, SLOT(changeAnalysisThreadPinningEnabled(bool)));
+    connect(ui->checkBox_multiBuffer, SIGNAL(clicked(bool)), this, SLOT(changeMultiBufferReadoutEnabled(bool)));
 
     connect(ui->spinBox_chnCountAB, SIGNAL(valueChanged(int)), this, SLOT(changeChannelSettingsAB2(int)));
     connect(ui->spinBox_chnCountBA, SIGNAL(valueChanged(int)), this, SLOT(changeChannelSettingsBA2(int)));
@@ -685,6 +706,7 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
     connect(ui->pushButton_clearBAFitData, SIGNAL(clicked()), this, SLOT(clearBAFitData()));
 
     connect(m_autoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSave()));
+    connect(m_chunkSizeTimer, SIGNAL(timeout()), this, SLOT(updatePulsePairChunkSize()));
 
     ui->comboBox_triggerLogic->addItem("A");
     ui->comboBox_triggerLogic->addItem("B");
@@ -837,6 +859,7 @@ DRS4ScopeDlg::DRS4ScopeDlg(const ProgramStartType &startType, QWidget *parent) :
 
     m_autoSaveTimer->start();
     m_autoSaveSpectraTimer->start();
+    m_chunkSizeTimer->start();
 
     /* Connection Check Timer */
     if ( !DRS4BoardManager::sharedInstance()->isDemoModeEnabled() ) {
@@ -1150,6 +1173,7 @@ DRS4ScopeDlg::~DRS4ScopeDlg()
     DDELETE_SAFETY(m_boardInfoDlg);
     DDELETE_SAFETY(m_scriptDlg);
     DDELETE_SAFETY(m_calculatorDlg);
+    DDELETE_SAFETY(m_hotPathTimingDlg);
     DDELETE_SAFETY(m_gplDialog);
     DDELETE_SAFETY(m_lgplDialog);
     DDELETE_SAFETY(m_usedgplDialog);
@@ -1173,6 +1197,7 @@ DRS4ScopeDlg::~DRS4ScopeDlg()
     DDELETE_SAFETY(m_dataExchange);
 
     DDELETE_SAFETY(m_temperatureTimer);
+    DDELETE_SAFETY(m_chunkSizeTimer);
     DDELETE_SAFETY(m_autoSaveTimer);
     DDELETE_SAFETY(m_currentSettingsFileLabel);
 
@@ -2297,6 +2322,118 @@ int DRS4ScopeDlg::pulsePairChunkSize() const
     return DRS4ProgramSettingsManager::sharedInstance()->pulsePairChunkSize();
 }
 
+void DRS4ScopeDlg::changePulsePairChunkSizeAdaptive(bool on, const FunctionSource &source)
+{
+    if ( source == FunctionSource::AccessFromScript )
+    {
+        ui->checkBox_parallelChunkSizeAuto->setChecked(on);
+        emit ui->checkBox_parallelChunkSizeAuto->clicked(on);
+        return;
+    }
+
+    m_worker->setBusy(true);
+
+    while(!m_worker->isBlocking()) {}
+
+    DRS4ProgramSettingsManager::sharedInstance()->setPulsePairChunkSizeAdaptive(on);
+
+    m_worker->setBusy(false);
+
+    /* adaptive: the spin-box shows the chosen chunk size, otherwise the fixed one */
+    ui->spinBox_parallelChunkSize->setReadOnly(on);
+
+    if (!on) {
+        ui->spinBox_parallelChunkSize->blockSignals(true);
+        ui->spinBox_parallelChunkSize->setValue(DRS4ProgramSettingsManager::sharedInstance()->pulsePairChunkSize());
+        ui->spinBox_parallelChunkSize->blockSignals(false);
+
+        ui->spinBox_parallelChunkSize->setToolTip("");
+    }
+}
+
+bool DRS4ScopeDlg::isPulsePairChunkSizeAdaptive() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return DRS4ProgramSettingsManager::sharedInstance()->isPulsePairChunkSizeAdaptive();
+}
+
+void DRS4ScopeDlg::updatePulsePairChunkSize()
+{
+    if (!m_worker)
+        return;
+
+    if (!ui->checkBox_parallelChunkSizeAuto->isChecked()
+            || !m_worker->isPulsePairChunkSizeAdaptive())
+        return;
+
+    ui->spinBox_parallelChunkSize->blockSignals(true);
+    ui->spinBox_parallelChunkSize->setValue(m_worker->pulsePairChunkSize());
+    ui->spinBox_parallelChunkSize->blockSignals(false);
+
+    const QVector<DRS4ChunkSizeSample> history = m_worker->pulsePairChunkSizeHistory();
+
+    QString toolTip("adaptive chunk size (latest first):\n[time: chunk size | latency per chunk | queue depth]");
+
+    for ( int i = history.size() - 1, n = 0 ; i >= 0 && n < 10 ; -- i, ++ n ) {
+        const DRS4ChunkSizeSample& sample = history.at(i);
+
+        toolTip.append(QString("\n%1 s: %2 | %3 ms | %4").arg(sample.m_timeInMs/1000.0, 0, 'f', 1).arg(sample.m_chunkSize).arg(sample.m_chunkLatencyInMs, 0, 'f', 3).arg(sample.m_queueDepth));
+    }
+
+    ui->spinBox_parallelChunkSize->setToolTip(toolTip);
+}
+
+void DRS4ScopeDlg::changeAnalysisThreadPinningEnabled(bool on, const FunctionSource &source)
+{
+    if ( source == FunctionSource::AccessFromScript )
+    {
+        ui->checkBox_pinThreads->setChecked(on);
+        emit ui->checkBox_pinThreads->clicked(on);
+        return;
+    }
+
+    m_worker->setBusy(true);
+
+    while(!m_worker->isBlocking()) {}
+
+    DRS4ProgramSettingsManager::sharedInstance()->setAnalysisThreadPinningEnabled(on);
+
+    m_worker->setBusy(false);
+}
+
+bool DRS4ScopeDlg::isAnalysisThreadPinningEnabled() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return DRS4ProgramSettingsManager::sharedInstance()->isAnalysisThreadPinningEnabled();
+}
+
+void DRS4ScopeDlg::changeMultiBufferReadoutEnabled(bool on, const FunctionSource &source)
+{
+    if ( source == FunctionSource::AccessFromScript )
+    {
+        ui->checkBox_multiBuffer->setChecked(on);
+        emit ui->checkBox_multiBuffer->clicked(on);
+        return;
+    }
+
+    m_worker->setBusy(true);
+
+    while(!m_worker->isBlocking()) {}
+
+    DRS4ProgramSettingsManager::sharedInstance()->setMultiBufferReadoutEnabled(on);
+
+    m_worker->setBusy(false);
+}
+
+bool DRS4ScopeDlg::isMultiBufferReadoutEnabled() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return DRS4ProgramSettingsManager::sharedInstance()->isMultiBufferReadoutEnabled();
+}
+
 bool DRS4ScopeDlg::saveABSpectrumFromExtern(const QString &fileName)
 {
     QMutexLocker locker(&m_mutex);
@@ -4556,14 +4693,10 @@ void DRS4ScopeDlg::plotPulseAreaFilterData()
          || DRS4SettingsManager::sharedInstance()->isBurstMode() ) {
         m_areaRequestTimer->stop();
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
-
-        ui->label_areaCollectedCountsA->setNum(m_worker->countsCollectedInAreaFilterA());
-        ui->label_areaCollectedCountsB->setNum(m_worker->countsCollectedInAreaFilterB());
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        m_worker->setBusy(false);
+        ui->label_areaCollectedCountsA->setNum(snapshot->m_areaFilterCollectedACounter);
+        ui->label_areaCollectedCountsB->setNum(snapshot->m_areaFilterCollectedBCounter);
 
         m_areaRequestTimer->start();
 
@@ -4578,20 +4711,18 @@ void DRS4ScopeDlg::plotPulseAreaFilterData()
     ui->widget_plotAreaFilterA->curve().at(7)->clearCurveContent();
     ui->widget_plotAreaFilterB_2->curve().at(7)->clearCurveContent();
 
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    ui->widget_plotAreaFilterA->curve().at(0)->addData(*m_worker->areaFilterAData());
-    ui->widget_plotAreaFilterB_2->curve().at(0)->addData(*m_worker->areaFilterBData());
+    ui->widget_plotAreaFilterA->curve().at(0)->addData(snapshot->m_areaFilterDataA);
+    ui->widget_plotAreaFilterB_2->curve().at(0)->addData(snapshot->m_areaFilterDataB);
 
-    ui->label_areaCollectedCountsA->setNum(m_worker->countsCollectedInAreaFilterA());
-    ui->label_areaCollectedCountsB->setNum(m_worker->countsCollectedInAreaFilterB());
+    ui->label_areaCollectedCountsA->setNum(snapshot->m_areaFilterCollectedACounter);
+    ui->label_areaCollectedCountsB->setNum(snapshot->m_areaFilterCollectedBCounter);
 
     QVector<QPointF> cA, cB;
     for ( int i = 0 ; i < kNumberOfBins ; ++ i ) {
-        const double yA = (*m_worker->areaFilterACollectedData_raw())[i];
-        const double yB = (*m_worker->areaFilterBCollectedData_raw())[i];
+        const double yA = snapshot->m_areaFilterCollectedDataA_raw.at(i);
+        const double yB = snapshot->m_areaFilterCollectedDataB_raw.at(i);
 
         const QPointF valueA(i, yA);
         const QPointF valueB(i, yB);
@@ -4603,8 +4734,6 @@ void DRS4ScopeDlg::plotPulseAreaFilterData()
     ui->widget_plotAreaFilterA->curve().at(7)->addData(cA);
     ui->widget_plotAreaFilterB_2->curve().at(7)->addData(cB);
 
-    m_worker->setBusy(false);
-
     ui->widget_plotAreaFilterA->yLeft()->setAxisRange(0, DRS4SettingsManager::sharedInstance()->pulseAreaFilterBinningA());
     ui->widget_plotAreaFilterB_2->yLeft()->setAxisRange(0, DRS4SettingsManager::sharedInstance()->pulseAreaFilterBinningB());
 
@@ -4636,17 +4765,13 @@ void DRS4ScopeDlg::plotRiseTimeFilterData()
     ui->widget_plotrRiseTimeFilterA->curve().at(0)->clearCurveContent();
     ui->widget_plotrRiseTimeFilterB->curve().at(0)->clearCurveContent();
 
-    m_worker->setBusy(true);
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    while(!m_worker->isBlocking()) {}
-
-    ui->widget_plotrRiseTimeFilterA->curve().at(0)->addDataVec(*m_worker->riseTimeFilterAData());
-    ui->widget_plotrRiseTimeFilterB->curve().at(0)->addDataVec(*m_worker->riseTimeFilterBData());
-
-    m_worker->setBusy(false);
+    ui->widget_plotrRiseTimeFilterA->curve().at(0)->addDataVec(snapshot->m_riseTimeFilterDataA);
+    ui->widget_plotrRiseTimeFilterB->curve().at(0)->addDataVec(snapshot->m_riseTimeFilterDataB);
 
-    const int valA = m_worker->riseTimeFilterADataMax();
-    const int valB = m_worker->riseTimeFilterBDataMax();
+    const int valA = snapshot->m_maxY_RiseTimeSpectrumA;
+    const int valB = snapshot->m_maxY_RiseTimeSpectrumB;
 
     ui->widget_plotrRiseTimeFilterA->yLeft()->setAxisRange(1, valA<=/*1000?1000*/10?10:valA);
     ui->widget_plotrRiseTimeFilterB->yLeft()->setAxisRange(1, valB<=/*1000?1000*/10?10:valB);
@@ -4706,54 +4831,50 @@ void DRS4ScopeDlg::plotLifetimeSpectra()
         ui->widget_ltMerged->curve().at(1)->clearCurveContent();
     }
 
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    const double countABHz = m_worker->currentLifetimeABCountRateInHz();
-    const double avgCountABHz = m_worker->avgLifetimeABCountRateInHz();
+    const double countABHz = snapshot->m_currentABSpecCountRateInHz;
+    const double avgCountABHz = snapshot->m_avgABSpecCountRateInHz;
 
-    const double countBAHz = m_worker->currentLifetimeBACountRateInHz();
-    const double avgCountBAHz = m_worker->avgLifetimeBACountRateInHz();
+    const double countBAHz = snapshot->m_currentBASpecCountRateInHz;
+    const double avgCountBAHz = snapshot->m_avgBASpecCountRateInHz;
 
-    const double countMergedHz = m_worker->currentLifetimeMergedCountRateInHz();
-    const double avgCountMergedHz = m_worker->avgLifetimeMergedCountRateInHz();
+    const double countMergedHz = snapshot->m_currentMergedSpecCountRateInHz;
+    const double avgCountMergedHz = snapshot->m_avgMergedSpecCountRateInHz;
 
-    const double countCoincidenceHz = m_worker->currentLifetimeCoincidenceCountRateInHz();
-    const double avgCountCoincidenceHz = m_worker->avgLifetimeCoincidenceCountRateInHz();
+    const double countCoincidenceHz = snapshot->m_currentCoincidenceSpecCountRateInHz;
+    const double avgCountCoincidenceHz = snapshot->m_avgCoincidenceSpecCountRateInHz;
 
-    const int yABMax = m_worker->maxYValueABSpectrum();
-    const int yBAMax = m_worker->maxYValueBASpectrum();
-    const int yMergedMax = m_worker->maxYValueMergedSpectrum();
-    const int yCoincidenceMax = m_worker->maxYValueCoincidenceSpectrum();
+    const int yABMax = snapshot->m_maxY_ABSpectrum;
+    const int yBAMax = snapshot->m_maxY_BASpectrum;
+    const int yMergedMax = snapshot->m_maxY_MergedSpectrum;
+    const int yCoincidenceMax = snapshot->m_maxY_CoincidenceSpectrum;
 
-    const int abCounts = m_worker->countsSpectrumAB();
-    const int baCounts = m_worker->countsSpectrumBA();
-    const int mergedCounts = m_worker->countsSpectrumMerged();
-    const int coincidenceCounts = m_worker->countsSpectrumCoincidence();
+    const int abCounts = snapshot->m_abCounts;
+    const int baCounts = snapshot->m_baCounts;
+    const int mergedCounts = snapshot->m_mergedCounts;
+    const int coincidenceCounts = snapshot->m_coincidenceCounts;
 
     /* A-B */
     if (ui->tab_3->isVisible()) {
-        ui->widget_ltAB->curve().at(0)->addDataVec(*m_worker->spectrumAB());
+        ui->widget_ltAB->curve().at(0)->addDataVec(snapshot->m_lifeTimeDataAB);
     }
 
     /* B-A */
     if (ui->tab_4->isVisible()) {
-        ui->widget_ltBA->curve().at(0)->addDataVec(*m_worker->spectrumBA());
+        ui->widget_ltBA->curve().at(0)->addDataVec(snapshot->m_lifeTimeDataBA);
     }
 
     /* Merged */
     if (ui->tab_7->isVisible()) {
-        ui->widget_ltMerged->curve().at(0)->addDataVec(*m_worker->spectrumMerged());
+        ui->widget_ltMerged->curve().at(0)->addDataVec(snapshot->m_lifeTimeDataMerged);
     }
 
     /* Prompt */
     if (ui->tab_5->isVisible()) {
-        ui->widget_ltConicidence->curve().at(0)->addDataVec(*m_worker->spectrumCoincidence());
+        ui->widget_ltConicidence->curve().at(0)->addDataVec(snapshot->m_lifeTimeDataCoincidence);
     }
 
-    m_worker->setBusy(false);
-
     /* A-B */
     if (ui->tab_3->isVisible()) {
         ui->widget_ltAB->yLeft()->setAxisRange(1, qMax(yABMax, 2));
@@ -4838,12 +4959,10 @@ void DRS4ScopeDlg::plotPersistance()
 
     m_persistanceRequestTimer->stop();
 
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    if (!m_worker->persistanceDataA()->isEmpty()
-            && !m_worker->persistanceDataB()->isEmpty()) {
+    if (!snapshot->m_persistanceDataA.isEmpty()
+            && !snapshot->m_persistanceDataB.isEmpty()) {
         if (ui->widget_persistanceA->curve().at(0)->getDataSize() >= 360000) {
             ui->widget_persistanceA->curve().at(0)->clearCurveContent();
             ui->widget_persistanceA->curve().at(0)->clearCurveCache();
@@ -4854,14 +4973,12 @@ void DRS4ScopeDlg::plotPersistance()
             ui->widget_persistanceB->curve().at(0)->clearCurveCache();
         }
 
-        ui->widget_persistanceA->curve().at(0)->addData(*m_worker->persistanceDataA(), m_bSwapDirection);
-        ui->widget_persistanceB->curve().at(0)->addData(*m_worker->persistanceDataB(), m_bSwapDirection);
+        ui->widget_persistanceA->curve().at(0)->addData(snapshot->m_persistanceDataA, m_bSwapDirection);
+        ui->widget_persistanceB->curve().at(0)->addData(snapshot->m_persistanceDataB, m_bSwapDirection);
 
         m_bSwapDirection = m_bSwapDirection?false:true;
     }
 
-    m_worker->setBusy(false);
-
     ui->widget_persistanceA->replot();
     ui->widget_persistanceB->replot();
 
@@ -7808,6 +7925,9 @@ void DRS4ScopeDlg::checkForConnection() {
         if (m_calculatorDlg)
             m_calculatorDlg->close();
 
+        if (m_hotPathTimingDlg)
+            m_hotPathTimingDlg->close();
+
         if (m_boardInfoDlg)
             m_boardInfoDlg->close();
 
@@ -8641,13 +8761,8 @@ void DRS4ScopeDlg::runningFromDataStreamFinished()
 
 void DRS4ScopeDlg::autoSave()
 {
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
-
+    /* the worker reads the settings only: no need to pause the acquisition */
     DRS4SettingsManager::sharedInstance()->save(QCoreApplication::applicationDirPath() + "//__drs4AutoSave" + EXT_LT_SETTINGS_FILE, true);
-
-    m_worker->setBusy(false);
 }
 
 void DRS4ScopeDlg::loadAutoSave()
@@ -9473,6 +9588,11 @@ void DRS4ScopeDlg::showCalculator()
     m_calculatorDlg->show();
 }
 
+void DRS4ScopeDlg::showHotPathTiming()
+{
+    m_hotPathTimingDlg->show();
+}
+
 void DRS4ScopeDlg::showGPL()
 {
     m_gplDialog->show();
@@ -9547,47 +9667,45 @@ void DRS4ScopeDlg::updateInBurstMode()
 
     m_burstModeTimer->stop();
 
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    const double countABHz = m_worker->currentLifetimeABCountRateInHz();
-    const double avgCountABHz = m_worker->avgLifetimeABCountRateInHz();
+    const double countABHz = snapshot->m_currentABSpecCountRateInHz;
+    const double avgCountABHz = snapshot->m_avgABSpecCountRateInHz;
 
-    const double countBAHz = m_worker->currentLifetimeBACountRateInHz();
-    const double avgCountBAHz = m_worker->avgLifetimeBACountRateInHz();
+    const double countBAHz = snapshot->m_currentBASpecCountRateInHz;
+    const double avgCountBAHz = snapshot->m_avgBASpecCountRateInHz;
 
-    const double countMergedHz = m_worker->currentLifetimeMergedCountRateInHz();
-    const double avgCountMergedHz = m_worker->avgLifetimeMergedCountRateInHz();
+    const double countMergedHz = snapshot->m_currentMergedSpecCountRateInHz;
+    const double avgCountMergedHz = snapshot->m_avgMergedSpecCountRateInHz;
 
-    const double countCoincidenceHz = m_worker->currentLifetimeCoincidenceCountRateInHz();
-    const double avgCountCoincidenceHz = m_worker->avgLifetimeCoincidenceCountRateInHz();
+    const double countCoincidenceHz = snapshot->m_currentCoincidenceSpecCountRateInHz;
+    const double avgCountCoincidenceHz = snapshot->m_avgCoincidenceSpecCountRateInHz;
 
-    /*const int yABMax = m_worker->maxYValueABSpectrum();
-    const int yBAMax = m_worker->maxYValueBASpectrum();
-    const int yMergedMax = m_worker->maxYValueMergedSpectrum();
-    const int yCoincidenceMax = m_worker->maxYValueCoincidenceSpectrum();*/
+    /*const int yABMax = snapshot->m_maxY_ABSpectrum;
+    const int yBAMax = snapshot->m_maxY_BASpectrum;
+    const int yMergedMax = snapshot->m_maxY_MergedSpectrum;
+    const int yCoincidenceMax = snapshot->m_maxY_CoincidenceSpectrum;*/
 
-    const int abCounts = m_worker->countsSpectrumAB();
-    const int baCounts = m_worker->countsSpectrumBA();
-    const int mergedCounts = m_worker->countsSpectrumMerged();
-    const int coincidenceCounts = m_worker->countsSpectrumCoincidence();
+    const int abCounts = snapshot->m_abCounts;
+    const int baCounts = snapshot->m_baCounts;
+    const int mergedCounts = snapshot->m_mergedCounts;
+    const int coincidenceCounts = snapshot->m_coincidenceCounts;
 
-    const int cntA = m_worker->phsACounts();
-    const int cntB = m_worker->phsBCounts();
+    const int cntA = snapshot->m_phsACounts;
+    const int cntB = snapshot->m_phsBCounts;
 
     int cntAStart = 0, cntAStop = 0;
     int cntBStart = 0, cntBStop = 0;
 
-    const int cntA_post = m_worker->phsACounts_post();
-    const int cntB_post = m_worker->phsBCounts_post();
+    const int cntA_post = snapshot->m_phsACounts_post;
+    const int cntB_post = snapshot->m_phsBCounts_post;
 
     int cntAStart_post = 0, cntAStop_post = 0;
     int cntBStart_post = 0, cntBStop_post = 0;
 
     for ( int i = 0 ; i < kNumberOfBins ; ++ i ) {
-        const int yA = (*m_worker->phsA())[i];
-        const int yB = (*m_worker->phsB())[i];
+        const int yA = snapshot->m_phsA.at(i);
+        const int yB = snapshot->m_phsB.at(i);
 
         const QPointF valueA(i, yA);
         const QPointF valueB(i, yB);
@@ -9595,8 +9713,8 @@ void DRS4ScopeDlg::updateInBurstMode()
         phsA.append(valueA);
         phsB.append(valueB);
 
-        const int yA_post = (*m_worker->phsA_post())[i];
-        const int yB_post = (*m_worker->phsB_post())[i];
+        const int yA_post = snapshot->m_phsA_post.at(i);
+        const int yB_post = snapshot->m_phsB_post.at(i);
 
         const QPointF valueA_post(i, yA_post);
         const QPointF valueB_post(i, yB_post);
@@ -9663,8 +9781,6 @@ void DRS4ScopeDlg::updateInBurstMode()
         }
     }
 
-    m_worker->setBusy(false);
-
     ui->label_countsIntergralAB->setNum(abCounts);
     ui->label_countsIntergralBA->setNum(baCounts);
     ui->label_countsIntergralMerged->setNum(mergedCounts);
@@ -9681,7 +9797,7 @@ void DRS4ScopeDlg::updateInBurstMode()
     ui->label_valiLTPerSec->setText("/Lifetime Efficiency [Hz]: [A-B] " + QString::number(avgCountABHz, 'f', 2) + " (" + QString::number(countABHz, 'f', 2) + ") [B-A] " + QString::number(avgCountBAHz, 'f', 2) + " (" + QString::number(countBAHz, 'f', 2) + ") [Merged] " + QString::number(avgCountMergedHz, 'f', 2) + " (" + QString::number(countMergedHz, 'f', 2) + ")");
     ui->label_validCoincidencePerSec->setText("/Prompt Efficiency [Hz]: " + QString::number(avgCountCoincidenceHz, 'f', 2) + " (" + QString::number(countCoincidenceHz, 'f', 2) + ")" );
 
-    ui->label_phsCntPerSecA->setText("/Sample Rate [Hz]: " + QString::number(m_worker->avgPulseCountRateInHz(), 'f', 2) + " (" + QString::number(m_worker->currentPulseCountRateInHz(), 'f', 2) + ")" );
+    ui->label_phsCntPerSecA->setText("/Sample Rate [Hz]: " + QString::number(snapshot->m_avgPulseCountRateInHz, 'f', 2) + " (" + QString::number(snapshot->m_currentPulseCountRateInHz, 'f', 2) + ")" );
 
     m_burstModeTimer->start();
 }
@@ -9947,17 +10063,13 @@ void DRS4ScopeDlg::plotPulseScope()
     ui->widget_plotB->curve().at(0)->clearCurveContent();
     ui->widget_plotB->curve().at(1)->clearCurveContent();
 
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
-
-    ui->widget_plotA->curve().at(0)->addData(*m_worker->pulseDataA());
-    ui->widget_plotA->curve().at(1)->addData(*m_worker->pulseSplineDataA());
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    ui->widget_plotB->curve().at(0)->addData(*m_worker->pulseDataB());
-    ui->widget_plotB->curve().at(1)->addData(*m_worker->pulseSplineDataB());
+    ui->widget_plotA->curve().at(0)->addData(snapshot->m_pulseDataA);
+    ui->widget_plotA->curve().at(1)->addData(snapshot->m_pulseSplineDataA);
 
-    m_worker->setBusy(false);
+    ui->widget_plotB->curve().at(0)->addData(snapshot->m_pulseDataB);
+    ui->widget_plotB->curve().at(1)->addData(snapshot->m_pulseSplineDataB);
 
     ui->widget_plotA->replot();
     ui->widget_plotB->replot();
@@ -9978,13 +10090,9 @@ void DRS4ScopeDlg::plotPHS()
     if (!ui->tab_2->isVisible()) {
         m_phsRequestTimer->stop();
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
-
-        ui->label_phsCntPerSecA->setText("/Sample Rate [Hz]: " + QString::number(m_worker->avgPulseCountRateInHz(), 'f', 2) + " (" + QString::number(m_worker->currentPulseCountRateInHz(), 'f', 2) + ")" );
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        m_worker->setBusy(false);
+        ui->label_phsCntPerSecA->setText("/Sample Rate [Hz]: " + QString::number(snapshot->m_avgPulseCountRateInHz, 'f', 2) + " (" + QString::number(snapshot->m_currentPulseCountRateInHz, 'f', 2) + ")" );
 
         m_phsRequestTimer->start();
 
@@ -10025,15 +10133,13 @@ void DRS4ScopeDlg::plotPHS()
     int yMaxA_post = -INT_MAX;
     int yMaxB_post = -INT_MAX;
 
-    m_worker->setBusy(true);
-
-    while(!m_worker->isBlocking()) {}
+    const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-    const int cntA = m_worker->phsACounts();
-    const int cntB = m_worker->phsBCounts();
+    const int cntA = snapshot->m_phsACounts;
+    const int cntB = snapshot->m_phsBCounts;
 
-    const int cntA_post = m_worker->phsACounts_post();
-    const int cntB_post = m_worker->phsBCounts_post();
+    const int cntA_post = snapshot->m_phsACounts_post;
+    const int cntB_post = snapshot->m_phsBCounts_post;
 
     int cntAStart = 0, cntAStop = 0;
     int cntBStart = 0, cntBStop = 0;
@@ -10042,8 +10148,8 @@ void DRS4ScopeDlg::plotPHS()
     int cntBStart_post = 0, cntBStop_post = 0;
 
     for ( int i = 0 ; i < kNumberOfBins ; ++ i ) {
-        const int yA = (*m_worker->phsA())[i];
-        const int yB = (*m_worker->phsB())[i];
+        const int yA = snapshot->m_phsA.at(i);
+        const int yB = snapshot->m_phsB.at(i);
 
         const QPointF valueA(i, yA);
         const QPointF valueB(i, yB);
@@ -10051,8 +10157,8 @@ void DRS4ScopeDlg::plotPHS()
         phsA.append(valueA);
         phsB.append(valueB);
 
-        const int yA_post = (*m_worker->phsA_post())[i];
-        const int yB_post = (*m_worker->phsB_post())[i];
+        const int yA_post = snapshot->m_phsA_post.at(i);
+        const int yB_post = snapshot->m_phsB_post.at(i);
 
         const QPointF valueA_post(i, yA_post);
         const QPointF valueB_post(i, yB_post);
@@ -10119,9 +10225,7 @@ void DRS4ScopeDlg::plotPHS()
         }
     }
 
-    ui->label_phsCntPerSecA->setText("/Sample Rate [Hz]: " + QString::number(m_worker->avgPulseCountRateInHz(), 'f', 2) + " (" + QString::number(m_worker->currentPulseCountRateInHz(), 'f', 2) + ")" );
-
-    m_worker->setBusy(false);
+    ui->label_phsCntPerSecA->setText("/Sample Rate [Hz]: " + QString::number(snapshot->m_avgPulseCountRateInHz, 'f', 2) + " (" + QString::number(snapshot->m_currentPulseCountRateInHz, 'f', 2) + ")" );
 
     ui->widget_phs_A->yLeft()->setAxisRange(0, yMaxA);
     ui->widget_phs_B->yLeft()->setAxisRange(0, yMaxB);
@@ -10199,6 +10303,9 @@ void DRS4ScopeDlg::closeEvent(QCloseEvent *event)
     if (m_calculatorDlg)
         m_calculatorDlg->close();
 
+    if (m_hotPathTimingDlg)
+        m_hotPathTimingDlg->close();
+
     if (m_boardInfoDlg)
         m_boardInfoDlg->close();
 
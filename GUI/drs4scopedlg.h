@@ -69,6 +69,7 @@
 #include "GUI/drs4pulsesavedlg.h"
 #include "GUI/drs4pulsesaverangedlg.h"
 #include "GUI/drs4calculatordlg.h"
+#include "GUI/drs4hotpathtimingdlg.h"
 #include "GUI/drs4licensetextbox.h"
 #include "GUI/drs4httpserverconfigdlg.h"
 #include "GUI/drs4remotecontrolserverconfigdlg.h"
@@ -338,6 +339,7 @@ private slots:
     void showSavePulses();
     void showSavePulsesRange();
     void showCalculator();
+    void showHotPathTiming();
     void showGPL();
     void showLGPL();
     void showUsedGPL();
@@ -358,6 +360,7 @@ private slots:
     void plotPersistance();
 
     void updateTemperature();
+    void updatePulsePairChunkSize();
     void checkForConnection();
 
 public slots:
@@ -397,6 +400,15 @@ public slots:
     void ACCESSED_BY_SCRIPT_AND_GUI changePulsePairChunkSize(int value, const FunctionSource& source = FunctionSource::AccessFromGUI);
     int ACCESSED_BY_SCRIPT_AND_GUI pulsePairChunkSize() const;
 
+    void ACCESSED_BY_SCRIPT_AND_GUI changePulsePairChunkSizeAdaptive(bool on, const FunctionSource& source = FunctionSource::AccessFromGUI);
+    bool ACCESSED_BY_SCRIPT_AND_GUI isPulsePairChunkSizeAdaptive() const;
+
+    void ACCESSED_BY_SCRIPT_AND_GUI changeAnalysisThreadPinningEnabled(bool on, const FunctionSource& source = FunctionSource::AccessFromGUI);
+    bool ACCESSED_BY_SCRIPT_AND_GUI isAnalysisThreadPinningEnabled() const;
+
+    void ACCESSED_BY_SCRIPT_AND_GUI changeMultiBufferReadoutEnabled(bool on, const FunctionSource& source = FunctionSource::AccessFromGUI);
+    bool ACCESSED_BY_SCRIPT_AND_GUI isMultiBufferReadoutEnabled() const;
+
     /* Persistance */
     void ACCESSED_BY_SCRIPT_AND_GUI changePersistancePlotEnabled(bool on, const FunctionSource& source = FunctionSource::AccessFromGUI);
 
@@ -628,6 +640,9 @@ private:
     double m_lastTemperatureInDegree;
     //qint64 m_time;
 
+    /* Pulse-Pair Chunk Size (adaptive) */
+    QTimer *m_chunkSizeTimer;
+
     /* Autosave */
     QTimer *m_autoSaveTimer;
 
@@ -644,6 +659,7 @@ private:
     DRS4PulseSaveDlg *m_pulseSaveDlg;
     DRS4PulseSaveRangeDlg *m_pulseSaveRangeDlg;
     DRS4CalculatorDlg *m_calculatorDlg;
+    DRS4HotPathTimingDlg *m_hotPathTimingDlg;
     DRS4LicenseTextBox *m_gplDialog;
     DRS4LicenseTextBox *m_lgplDialog;
     DRS4LicenseTextBox *m_usedgplDialog;
@@ -166,14 +166,8 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
-
         const bool bRunning = m_worker->isRunning();
 
-        m_worker->setBusy(false);
-
         if (bRunning) {
             respond(DRS4RCReturnCode::code::ok, id, "1");
 
@@ -190,14 +184,8 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
-
         const bool bRunning = m_worker->isRunning();
 
-        m_worker->setBusy(false);
-
         if (!bRunning) {
             respond(DRS4RCReturnCode::code::ok, id, "1");
 
@@ -214,14 +202,8 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
-
         const bool bRunning = m_worker->isRunning();
 
-        m_worker->setBusy(false);
-
         respond(DRS4RCReturnCode::code::ok, id, QVariant(int(bRunning)).toString());
     }
     else if (id == 3) { // reset all (A-B, B-A, merged, prompt) spectra ...
@@ -313,18 +295,14 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        while(!m_worker->isBlocking()) {}
-
-        const QVector<int> data = *m_worker->spectrumAB();
-        const int counts = m_worker->countsSpectrumAB();
+        const QVector<int> data = snapshot->m_lifeTimeDataAB;
+        const int counts = snapshot->m_abCounts;
 
         const int no_chn = DRS4SettingsManager::sharedInstance()->channelCntAB();
         const double scale = DRS4SettingsManager::sharedInstance()->scalerInNSAB();
 
-        m_worker->setBusy(false);
-
         QString sData = QString("<channel-width-ps>%1</channel-width-ps>").arg(1000.*scale/no_chn);
         sData.append(QString("<number-of-channel>%1</number-of-channel>").arg(no_chn));
         sData.append(QString("<integral-counts>%1</integral-counts>").arg(counts));
@@ -343,18 +321,14 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        while(!m_worker->isBlocking()) {}
-
-        const QVector<int> data = *m_worker->spectrumBA();
-        const int counts = m_worker->countsSpectrumBA();
+        const QVector<int> data = snapshot->m_lifeTimeDataBA;
+        const int counts = snapshot->m_baCounts;
 
         const int no_chn = DRS4SettingsManager::sharedInstance()->channelCntBA();
         const double scale = DRS4SettingsManager::sharedInstance()->scalerInNSBA();
 
-        m_worker->setBusy(false);
-
         QString sData = QString("<channel-width-ps>%1</channel-width-ps>").arg(1000.*scale/no_chn);
         sData.append(QString("<number-of-channel>%1</number-of-channel>").arg(no_chn));
         sData.append(QString("<integral-counts>%1</integral-counts>").arg(counts));
@@ -373,18 +347,14 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        const QVector<int> data = *m_worker->spectrumMerged();
-        const int counts = m_worker->countsSpectrumMerged();
+        const QVector<int> data = snapshot->m_lifeTimeDataMerged;
+        const int counts = snapshot->m_mergedCounts;
 
         const int no_chn = DRS4SettingsManager::sharedInstance()->channelCntMerged();
         const double scale = DRS4SettingsManager::sharedInstance()->scalerInNSMerged();
 
-        m_worker->setBusy(false);
-
         QString sData = QString("<channel-width-ps>%1</channel-width-ps>").arg(1000.*scale/no_chn);
         sData.append(QString("<number-of-channel>%1</number-of-channel>").arg(no_chn));
         sData.append(QString("<integral-counts>%1</integral-counts>").arg(counts));
@@ -403,18 +373,14 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        const QVector<int> data = *m_worker->spectrumCoincidence();
-        const int counts = m_worker->countsSpectrumCoincidence();
+        const QVector<int> data = snapshot->m_lifeTimeDataCoincidence;
+        const int counts = snapshot->m_coincidenceCounts;
 
         const int no_chn = DRS4SettingsManager::sharedInstance()->channelCntCoincindence();
         const double scale = DRS4SettingsManager::sharedInstance()->scalerInNSCoincidence();
 
-        m_worker->setBusy(false);
-
         QString sData = QString("<channel-width-ps>%1</channel-width-ps>").arg(1000.*scale/no_chn);
         sData.append(QString("<number-of-channel>%1</number-of-channel>").arg(no_chn));
         sData.append(QString("<integral-counts>%1</integral-counts>").arg(counts));
@@ -433,13 +399,9 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
-
-        const int counts = m_worker->countsSpectrumAB();
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        m_worker->setBusy(false);
+        const int counts = snapshot->m_abCounts;
 
         respond(DRS4RCReturnCode::code::ok, id, QVariant(counts).toString());
     }
@@ -449,13 +411,9 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        while(!m_worker->isBlocking()) {}
-
-        const int counts = m_worker->countsSpectrumBA();
-
-        m_worker->setBusy(false);
+        const int counts = snapshot->m_baCounts;
 
         respond(DRS4RCReturnCode::code::ok, id, QVariant(counts).toString());
     }
@@ -465,13 +423,9 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        while(!m_worker->isBlocking()) {}
-
-        const int counts = m_worker->countsSpectrumMerged();
-
-        m_worker->setBusy(false);
+        const int counts = snapshot->m_mergedCounts;
 
         respond(DRS4RCReturnCode::code::ok, id, QVariant(counts).toString());
     }
@@ -481,13 +435,9 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        const int counts = m_worker->countsSpectrumCoincidence();
-
-        m_worker->setBusy(false);
+        const int counts = snapshot->m_coincidenceCounts;
 
         respond(DRS4RCReturnCode::code::ok, id, QVariant(counts).toString());
     }
@@ -510,6 +460,55 @@ void DRS4RCClientConnection::handleMessage(const QString &data) {
     else if (id == 17) {
         respond(DRS4RCReturnCode::code::ok, id, QString("<major>%1</major><minor>%2</minor>").arg(MAJOR_VERSION).arg(MINOR_VERSION));
     }
+    else if (id == 18) { // event ring and acquisition pipeline (multi-core) statistics ?
+        if (!m_worker)
+            return;
+
+        QString sData = QString("<capacity>%1</capacity>").arg(m_worker->eventRingCapacity());
+        sData.append(QString("<occupancy>%1</occupancy>").arg(m_worker->eventRingOccupancy()));
+        sData.append(QString("<high-water-mark>%1</high-water-mark>").arg(m_worker->eventRingHighWaterMark()));
+        sData.append(QString("<published-events>%1</published-events>").arg(m_worker->eventRingPublishedEvents()));
+        sData.append(QString("<dropped-events>%1</dropped-events>").arg(m_worker->eventRingDroppedEvents()));
+
+        /* acquisition pipeline: input queue and counters per stage */
+        for ( int stage = 0 ; stage < __WORKER_PIPELINE_STAGES ; ++ stage ) {
+            const DRS4PipelineStageInfo info = m_worker->pipelineStageInfo((DRS4PipelineStageType::type)stage);
+
+            sData.append("<stage>");
+            sData.append(QString("<name>%1</name>").arg(DRS4PipelineStageType::typeList().at(stage)));
+            sData.append(QString("<queue-capacity>%1</queue-capacity>").arg(info.m_queueCapacity));
+            sData.append(QString("<queue-occupancy>%1</queue-occupancy>").arg(info.m_queueOccupancy));
+            sData.append(QString("<queue-high-water-mark>%1</queue-high-water-mark>").arg(info.m_queueHighWaterMark));
+            sData.append(QString("<processed-events>%1</processed-events>").arg(info.m_processedEvents));
+            sData.append(QString("<stalls>%1</stalls>").arg(info.m_stalls));
+            sData.append(QString("<idle-cycles>%1</idle-cycles>").arg(info.m_idleCycles));
+            sData.append(QString("<dropped-events>%1</dropped-events>").arg(info.m_droppedEvents));
+            sData.append("</stage>");
+        }
+
+        respond(DRS4RCReturnCode::code::ok, id, sData);
+    }
+    else if (id == 19) { // pulse-pair chunk size (multi-core) and its history (adaptive mode) ?
+        if (!m_worker)
+            return;
+
+        QString sData = QString("<chunk-size>%1</chunk-size>").arg(m_worker->pulsePairChunkSize());
+        sData.append(QString("<adaptive?>%1</adaptive?>").arg(m_worker->isPulsePairChunkSizeAdaptive() ? 1 : 0));
+        sData.append(QString("<target-latency-ms>%1</target-latency-ms>").arg(__WORKER_CHUNK_TARGET_LATENCY));
+
+        const QVector<DRS4ChunkSizeSample> history = m_worker->pulsePairChunkSizeHistory();
+
+        for ( const DRS4ChunkSizeSample& sample : history ) {
+            sData.append("<sample>");
+            sData.append(QString("<time-ms>%1</time-ms>").arg(sample.m_timeInMs));
+            sData.append(QString("<chunk-size>%1</chunk-size>").arg(sample.m_chunkSize));
+            sData.append(QString("<latency-ms>%1</latency-ms>").arg(sample.m_chunkLatencyInMs));
+            sData.append(QString("<queue-depth>%1</queue-depth>").arg(sample.m_queueDepth));
+            sData.append("</sample>");
+        }
+
+        respond(DRS4RCReturnCode::code::ok, id, sData);
+    }
     else
         respond(DRS4RCReturnCode::code::failed, -1);
 }
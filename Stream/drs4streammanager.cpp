@@ -576,6 +576,9 @@ void DRS4TextFileStreamManager::writeInterpolations(QVector<QPointF> *interpolat
              case DRS4SplineInterpolationType::type::tk_cubic:
                  splineType = "cubic - Tino Kluge";
                  break;
+             case DRS4SplineInterpolationType::type::roi_cubic:
+                 splineType = "cubic (ROI) - DDRS4PALS";
+                 break;
              default:
                  splineType = "cubic - ALGLIB";
                  break;
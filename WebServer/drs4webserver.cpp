@@ -155,20 +155,33 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
         if (!m_worker)
             return;
 
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
-        double t = -1;
-        if (!DRS4BoardManager::sharedInstance()->isDemoModeEnabled())
-            t = DRS4BoardManager::sharedInstance()->currentBoard()->GetTemperature();
+        /* the temperature is sampled by the worker: no USB access from here */
+        const double t = snapshot->m_boardTemperature;
 
-        const double freq = m_worker->currentPulseCountRateInHz();
+        const double freq = snapshot->m_currentPulseCountRateInHz;
         const bool isRunning = m_worker->isRunning();
 
         const bool bParallel = DRS4ProgramSettingsManager::sharedInstance()->isMulticoreThreadingEnabled();
         const int cores = m_worker->maxThreads();
 
+        const int ringCapacity = m_worker->eventRingCapacity();
+        const int ringHighWater = m_worker->eventRingHighWaterMark();
+        const quint64 ringDropped = m_worker->eventRingDroppedEvents();
+
+        const int chunkSize = m_worker->pulsePairChunkSize();
+        const bool bAdaptiveChunkSize = m_worker->isPulsePairChunkSizeAdaptive();
+
+        /* stalls per stage of the acquisition pipeline (output queue full) */
+        QString pipelineStalls;
+
+        for ( int stage = 0 ; stage < __WORKER_PIPELINE_STAGES ; ++ stage ) {
+            const DRS4PipelineStageInfo info = m_worker->pipelineStageInfo((DRS4PipelineStageType::type)stage);
+
+            pipelineStalls.append(QString("%1%2 %3").arg(stage ? " / " : "").arg(DRS4PipelineStageType::typeList().at(stage)).arg(info.m_stalls));
+        }
+
         const int trigger_id = !DRS4BoardManager::sharedInstance()->isDemoModeEnabled() ? DRS4SettingsManager::sharedInstance()->triggerSource_index() : -1;
         const double boardFreq = !DRS4BoardManager::sharedInstance()->isDemoModeEnabled() ? DRS4SettingsManager::sharedInstance()->sampleSpeedInGHz() : -1;
 
@@ -182,29 +195,29 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
         const double offset_AB = DRS4SettingsManager::sharedInstance()->offsetInNSAB();
         const double scale_AB = DRS4SettingsManager::sharedInstance()->scalerInNSAB();
         const double bin_width_AB = 1000.*scale_AB/no_chn_AB;
-        const int counts_AB = m_worker->countsSpectrumAB();
-        const double efficiency_AB = m_worker->currentLifetimeABCountRateInHz();
+        const int counts_AB = snapshot->m_abCounts;
+        const double efficiency_AB = snapshot->m_currentABSpecCountRateInHz;
 
         const int no_chn_BA = DRS4SettingsManager::sharedInstance()->channelCntBA();
         const double offset_BA = DRS4SettingsManager::sharedInstance()->offsetInNSBA();
         const double scale_BA = DRS4SettingsManager::sharedInstance()->scalerInNSBA();
         const double bin_width_BA = 1000.*scale_BA/no_chn_BA;
-        const int counts_BA = m_worker->countsSpectrumBA();
-        const double efficiency_BA = m_worker->currentLifetimeABCountRateInHz();
+        const int counts_BA = snapshot->m_baCounts;
+        const double efficiency_BA = snapshot->m_currentABSpecCountRateInHz;
 
         const int no_chn_merged = DRS4SettingsManager::sharedInstance()->channelCntMerged();
         const double offset_merged = DRS4SettingsManager::sharedInstance()->offsetInNSMerged();
         const double scale_merged = DRS4SettingsManager::sharedInstance()->scalerInNSMerged();
         const double bin_width_merged = 1000.*scale_merged/no_chn_merged;
-        const int counts_merged = m_worker->countsSpectrumMerged();
-        const double efficiency_merged = m_worker->currentLifetimeMergedCountRateInHz();
+        const int counts_merged = snapshot->m_mergedCounts;
+        const double efficiency_merged = snapshot->m_currentMergedSpecCountRateInHz;
 
         const int no_chn_prompt = DRS4SettingsManager::sharedInstance()->channelCntCoincindence();
         const double offset_prompt = DRS4SettingsManager::sharedInstance()->offsetInNSCoincidence();
         const double scale_prompt = DRS4SettingsManager::sharedInstance()->scalerInNSCoincidence();
         const double bin_width_prompt = 1000.*scale_prompt/no_chn_prompt;
-        const int counts_prompt = m_worker->countsSpectrumCoincidence();
-        const double efficiency_prompt = m_worker->currentLifetimeCoincidenceCountRateInHz();
+        const int counts_prompt = snapshot->m_coincidenceCounts;
+        const double efficiency_prompt = snapshot->m_currentCoincidenceSpecCountRateInHz;
 
         // hard-drive >> ...
         const bool loaderArmed = DRS4StreamDataLoader::sharedInstance()->isArmed() && DRS4BoardManager::sharedInstance()->isDemoModeEnabled();
@@ -218,8 +231,6 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
         const double fileSizeS = streamerArmed ? (DRS4StreamManager::sharedInstance()->streamedContentInBytes()/1024.0f)/1000.0f : 0;
         const QString fileNameS = streamerArmed ? DRS4StreamManager::sharedInstance()->fileName() : "";
 
-        m_worker->setBusy(false);
-
         QString html_template_form = ":/webcontent/main_template_online";
 
         if (DRS4BoardManager::sharedInstance()->isDemoModeEnabled())
@@ -241,7 +252,7 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
                 response.replace("PARALLEL_INFO_COLOR", QString("#0938e3"));
             }
 
-            response.replace("PARALLEL_INFO", bParallel ? QString("on (running on %1 CPU cores)").arg(cores) : QString("off"));
+            response.replace("PARALLEL_INFO", bParallel ? QString("on (running on %1 CPU cores, event ring: %2/%3 peak, %4 dropped, pipeline stalls: %5, chunk size: %6%7)").arg(cores).arg(ringHighWater).arg(ringCapacity).arg(ringDropped).arg(pipelineStalls).arg(chunkSize).arg(bAdaptiveChunkSize ? " (auto)" : "") : QString("off"));
 
             if (!int(freq)) {
                 response.replace("SAMPLING_VALUE_COLOR", QString("#fc0303")); // red
@@ -424,10 +435,24 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
 
         return;
     }
-    else if (request.contains("data-")) {
-        m_worker->setBusy(true);
+    else if (request == "/timing") {
+        const QStringList lines = DRS4HotPathTiming::sharedInstance()->toCSV().split("\n", QString::SkipEmptyParts);
 
-        while(!m_worker->isBlocking()) {}
+        QString response = "<!doctype html><html><head></head><body>";
+
+        response.append("===>> hot-path timing (" + QString(DRS4HotPathTiming::isEnabled() ? "enabled" : "disabled") + ") ... <<===<br><br>");
+
+        for (int i = 0 ; i < lines.size() ; ++ i)
+            response.append(lines.at(i) + "<br>");
+
+        response.append("</body></html>");
+
+        respond(DRS4HttpReturnCode::code::ok, response);
+
+        return;
+    }
+    else if (request.contains("data-")) {
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
         int no_chn = 0;
         double offset = 0.;
@@ -443,51 +468,48 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSAB();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSAB();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumAB();
-            efficiency = m_worker->currentLifetimeABCountRateInHz();
+            counts = snapshot->m_abCounts;
+            efficiency = snapshot->m_currentABSpecCountRateInHz;
 
-            data = *m_worker->spectrumAB();
+            data = snapshot->m_lifeTimeDataAB;
         }
         else if (request == "/data-B-A") {
             no_chn = DRS4SettingsManager::sharedInstance()->channelCntBA();
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSBA();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSBA();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumBA();
-            efficiency = m_worker->currentLifetimeBACountRateInHz();
+            counts = snapshot->m_baCounts;
+            efficiency = snapshot->m_currentBASpecCountRateInHz;
 
-            data = *m_worker->spectrumBA();
+            data = snapshot->m_lifeTimeDataBA;
         }
         else if (request == "/data-merged") {
             no_chn = DRS4SettingsManager::sharedInstance()->channelCntMerged();
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSMerged();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSMerged();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumMerged();
-            efficiency = m_worker->currentLifetimeMergedCountRateInHz();
+            counts = snapshot->m_mergedCounts;
+            efficiency = snapshot->m_currentMergedSpecCountRateInHz;
 
-            data = *m_worker->spectrumMerged();
+            data = snapshot->m_lifeTimeDataMerged;
         }
         else if (request == "/data-prompt") {
             no_chn = DRS4SettingsManager::sharedInstance()->channelCntCoincindence();
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSCoincidence();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSCoincidence();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumCoincidence();
-            efficiency = m_worker->currentLifetimeCoincidenceCountRateInHz();
+            counts = snapshot->m_coincidenceCounts;
+            efficiency = snapshot->m_currentCoincidenceSpecCountRateInHz;
 
-            data = *m_worker->spectrumCoincidence();
+            data = snapshot->m_lifeTimeDataCoincidence;
         }
         else {
-            m_worker->setBusy(false);
 
             respond(DRS4HttpReturnCode::code::failed);
 
             return;
         }
 
-        m_worker->setBusy(false);
-
         QString response = "<!doctype html><html><head></head><body>";
 
         response.append("===>> please copy and paste your data ... <<===<br><br>");
@@ -504,9 +526,7 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
         return;
     }
     else if (request.contains("/spectrum-")) {
-        m_worker->setBusy(true);
-
-        while(!m_worker->isBlocking()) {}
+        const DRS4WorkerSnapshotPtr snapshot = m_worker->snapshot();
 
         const bool isRunning = m_worker->isRunning();
 
@@ -527,10 +547,10 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSAB();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSAB();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumAB();
-            efficiency = m_worker->currentLifetimeABCountRateInHz();
+            counts = snapshot->m_abCounts;
+            efficiency = snapshot->m_currentABSpecCountRateInHz;
 
-            data = *m_worker->spectrumAB();
+            data = snapshot->m_lifeTimeDataAB;
 
             headline = "lifetime spectrum A-B";
             data_url = "/data-A-B";
@@ -540,10 +560,10 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSBA();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSBA();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumBA();
-            efficiency = m_worker->currentLifetimeBACountRateInHz();
+            counts = snapshot->m_baCounts;
+            efficiency = snapshot->m_currentBASpecCountRateInHz;
 
-            data = *m_worker->spectrumBA();
+            data = snapshot->m_lifeTimeDataBA;
 
             headline = "lifetime spectrum B-A";
             data_url = "/data-B-A";
@@ -553,10 +573,10 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSMerged();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSMerged();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumMerged();
-            efficiency = m_worker->currentLifetimeMergedCountRateInHz();
+            counts = snapshot->m_mergedCounts;
+            efficiency = snapshot->m_currentMergedSpecCountRateInHz;
 
-            data = *m_worker->spectrumMerged();
+            data = snapshot->m_lifeTimeDataMerged;
 
             headline = "merged lifetime spectrum";
             data_url = "/data-merged";
@@ -566,24 +586,21 @@ void DRS4ClientConnection::handleMessage(const QString &data) {
             offset = DRS4SettingsManager::sharedInstance()->offsetInNSCoincidence();
             scale = DRS4SettingsManager::sharedInstance()->scalerInNSCoincidence();
             bin_width = 1000.*scale/no_chn;
-            counts = m_worker->countsSpectrumCoincidence();
-            efficiency = m_worker->currentLifetimeCoincidenceCountRateInHz();
+            counts = snapshot->m_coincidenceCounts;
+            efficiency = snapshot->m_currentCoincidenceSpecCountRateInHz;
 
-            data = *m_worker->spectrumCoincidence();
+            data = snapshot->m_lifeTimeDataCoincidence;
 
             headline = "prompt spectrum";
             data_url = "/data-prompt";
         }
         else {
-            m_worker->setBusy(false);
 
             respond(DRS4HttpReturnCode::code::failed);
 
             return;
         }
 
-        m_worker->setBusy(false);
-
         QString html_template_form = ":/webcontent/plot_template";
 
         QFile file(html_template_form);
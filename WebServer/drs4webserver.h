@@ -70,6 +70,7 @@
 
 #include "dversion.h"
 #include "drs4worker.h"
+#include "drs4hotpathtiming.h"
 #include "Stream/drs4streamdataloader.h"
 #include "Stream/drs4streammanager.h"
 #include "CPUUsage/drs4cpuusage.h"
@@ -0,0 +1,380 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#include "drs4analysisthreadpool.h"
+
+#if defined(Q_OS_WIN)
+#include <Windows.h>
+#elif defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static DRS4AnalysisThreadPool *__sharedInstanceAnalysisThreadPool = DNULLPTR;
+
+static thread_local int __analysisThreadIndex = -1;
+
+/* restricts the calling thread to the cores [firstCore, lastCore] */
+static bool setCurrentThreadAffinity(int firstCore, int lastCore)
+{
+#if defined(Q_OS_WIN)
+    DWORD_PTR mask = 0;
+
+    for ( int core = firstCore ; core <= lastCore && core < int(8*sizeof(DWORD_PTR)) ; ++ core )
+        mask |= (DWORD_PTR(1) << core);
+
+    return (mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0);
+#elif defined(Q_OS_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for ( int core = firstCore ; core <= lastCore && core < CPU_SETSIZE ; ++ core )
+        CPU_SET(core, &set);
+
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0);
+#else
+    Q_UNUSED(firstCore);
+    Q_UNUSED(lastCore);
+
+    return false;
+#endif
+}
+
+void DRS4AnalysisTaskDeque::push(QRunnable *task)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_tasks.push_back(task);
+}
+
+QRunnable *DRS4AnalysisTaskDeque::pop()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ( m_tasks.empty() )
+        return DNULLPTR;
+
+    QRunnable *task = m_tasks.back();
+    m_tasks.pop_back();
+
+    return task;
+}
+
+QRunnable *DRS4AnalysisTaskDeque::steal()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ( m_tasks.empty() )
+        return DNULLPTR;
+
+    QRunnable *task = m_tasks.front();
+    m_tasks.pop_front();
+
+    return task;
+}
+
+void DRS4AnalysisTaskDeque::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for ( QRunnable *task : m_tasks ) {
+        if ( task->autoDelete() )
+            delete task;
+    }
+
+    m_tasks.clear();
+}
+
+DRS4AnalysisThreadPool::DRS4AnalysisThreadPool() :
+    m_isRunning(true),
+    m_queuedTasks(0),
+    m_pendingTasks(0),
+    m_activeThreads(0),
+    m_idleThreads(0),
+    m_nextThread(0),
+    m_stolenTasks(0),
+    m_bThreadAffinity(false),
+    m_affinityVersion(0)
+{
+    const int threadCount = qMax(1, QThread::idealThreadCount() - __ANALYSIS_THREAD_POOL_RESERVED_CORES);
+
+    for ( int i = 0 ; i < threadCount ; ++ i ) {
+        m_deques.append(new DRS4AnalysisTaskDeque);
+        m_threads.append(new DRS4AnalysisThread(this, i));
+    }
+
+    for ( DRS4AnalysisThread *thread : m_threads )
+        thread->start(QThread::HighPriority);
+}
+
+DRS4AnalysisThreadPool::~DRS4AnalysisThreadPool()
+{
+    m_isRunning.store(false, std::memory_order_release);
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_taskAvailable.wakeAll();
+    }
+
+    for ( DRS4AnalysisThread *thread : m_threads )
+        thread->wait();
+
+    qDeleteAll(m_threads);
+    m_threads.clear();
+
+    for ( DRS4AnalysisTaskDeque *deque : m_deques )
+        deque->clear();
+
+    qDeleteAll(m_deques);
+    m_deques.clear();
+}
+
+DRS4AnalysisThreadPool *DRS4AnalysisThreadPool::sharedInstance()
+{
+    if ( !__sharedInstanceAnalysisThreadPool )
+        __sharedInstanceAnalysisThreadPool = new DRS4AnalysisThreadPool();
+
+    return __sharedInstanceAnalysisThreadPool;
+}
+
+void DRS4AnalysisThreadPool::start(QRunnable *task, int preferredThread)
+{
+    if ( !task )
+        return;
+
+    const int threadCount = m_threads.size();
+    const int threadIndex = (preferredThread < 0)?(m_nextThread.fetch_add(1, std::memory_order_relaxed) % threadCount):(preferredThread % threadCount);
+
+    m_pendingTasks.fetch_add(1, std::memory_order_acq_rel);
+
+    m_deques.at(threadIndex)->push(task);
+
+    m_queuedTasks.fetch_add(1);
+
+    /* hot path (one task per published event): the busy threads take the task anyway.
+     * A thread increments 'm_idleThreads' before it checks 'm_queuedTasks' under the lock (both sequentially consistent): either it sees the task or we see the thread. */
+    if ( m_idleThreads.load() <= 0 )
+        return;
+
+    QMutexLocker locker(&m_mutex);
+
+    m_taskAvailable.wakeOne();
+}
+
+bool DRS4AnalysisThreadPool::waitForDone(int msecs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while ( m_pendingTasks.load(std::memory_order_acquire) > 0 ) {
+        if ( msecs < 0 ) {
+            m_tasksDone.wait(&m_mutex);
+        }
+        else {
+            const qint64 remaining = msecs - timer.elapsed();
+
+            if ( remaining <= 0
+                 || !m_tasksDone.wait(&m_mutex, (unsigned long)remaining) )
+                return (m_pendingTasks.load(std::memory_order_acquire) == 0);
+        }
+    }
+
+    return true;
+}
+
+QRunnable *DRS4AnalysisThreadPool::take(int threadIndex)
+{
+    if ( m_queuedTasks.load(std::memory_order_acquire) <= 0 )
+        return DNULLPTR;
+
+    QRunnable *task = m_deques.at(threadIndex)->pop();
+
+    if ( !task ) {
+        const int threadCount = m_deques.size();
+
+        /* steal from the others, starting with the next neighbour */
+        for ( int i = 1 ; i < threadCount && !task ; ++ i )
+            task = m_deques.at((threadIndex + i) % threadCount)->steal();
+
+        if ( task )
+            m_stolenTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if ( task )
+        m_queuedTasks.fetch_sub(1, std::memory_order_acq_rel);
+
+    return task;
+}
+
+void DRS4AnalysisThreadPool::finished(QRunnable *task)
+{
+    if ( task->autoDelete() )
+        delete task;
+
+    if ( m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1 ) {
+        QMutexLocker locker(&m_mutex);
+
+        m_tasksDone.wakeAll();
+    }
+}
+
+int DRS4AnalysisThreadPool::maxThreadCount() const
+{
+    return m_threads.size();
+}
+
+int DRS4AnalysisThreadPool::activeThreadCount() const
+{
+    return m_activeThreads.load(std::memory_order_relaxed);
+}
+
+quint64 DRS4AnalysisThreadPool::stolenTasks() const
+{
+    return m_stolenTasks.load(std::memory_order_relaxed);
+}
+
+int DRS4AnalysisThreadPool::currentThreadIndex()
+{
+    return __analysisThreadIndex;
+}
+
+void DRS4AnalysisThreadPool::setThreadAffinityEnabled(bool on)
+{
+    if ( m_bThreadAffinity.exchange(on) == on )
+        return;
+
+    /* applied by every thread itself before it takes its next task */
+    m_affinityVersion.fetch_add(1, std::memory_order_release);
+
+    QMutexLocker locker(&m_mutex);
+
+    m_taskAvailable.wakeAll();
+}
+
+bool DRS4AnalysisThreadPool::isThreadAffinityEnabled() const
+{
+    return m_bThreadAffinity.load(std::memory_order_relaxed);
+}
+
+bool DRS4AnalysisThreadPool::pinCurrentThreadToReservedCores(bool on)
+{
+    const int cores = QThread::idealThreadCount();
+
+    if ( !on
+         || cores <= __ANALYSIS_THREAD_POOL_RESERVED_CORES )
+        return setCurrentThreadAffinity(0, cores - 1);
+
+    return setCurrentThreadAffinity(0, __ANALYSIS_THREAD_POOL_RESERVED_CORES - 1);
+}
+
+void DRS4AnalysisThread::applyAffinity()
+{
+    const int version = m_pool->m_affinityVersion.load(std::memory_order_acquire);
+
+    if ( version == m_appliedAffinityVersion )
+        return;
+
+    m_appliedAffinityVersion = version;
+
+    const int cores = QThread::idealThreadCount();
+    const int analysisCores = cores - __ANALYSIS_THREAD_POOL_RESERVED_CORES;
+
+    /* one core per thread behind the reserved core(s) */
+    if ( m_pool->m_bThreadAffinity.load(std::memory_order_relaxed)
+         && analysisCores > 0 ) {
+        const int core = __ANALYSIS_THREAD_POOL_RESERVED_CORES + (m_threadIndex % analysisCores);
+
+        setCurrentThreadAffinity(core, core);
+    }
+    else {
+        setCurrentThreadAffinity(0, cores - 1);
+    }
+}
+
+void DRS4AnalysisThread::run()
+{
+    __analysisThreadIndex = m_threadIndex;
+
+    while ( m_pool->m_isRunning.load(std::memory_order_acquire) ) {
+        applyAffinity();
+
+        QRunnable *task = m_pool->take(m_threadIndex);
+
+        if ( !task ) {
+            QMutexLocker locker(&m_pool->m_mutex);
+
+            m_pool->m_idleThreads.fetch_add(1);
+
+            if ( m_pool->m_queuedTasks.load() <= 0
+                 && m_pool->m_isRunning.load(std::memory_order_acquire)
+                 && m_pool->m_affinityVersion.load(std::memory_order_acquire) == m_appliedAffinityVersion )
+                m_pool->m_taskAvailable.wait(&m_pool->m_mutex, __ANALYSIS_THREAD_POOL_IDLE_WAIT);
+
+            m_pool->m_idleThreads.fetch_sub(1);
+
+            continue;
+        }
+
+        m_pool->m_activeThreads.fetch_add(1, std::memory_order_relaxed);
+
+        task->run();
+
+        m_pool->m_activeThreads.fetch_sub(1, std::memory_order_relaxed);
+
+        m_pool->finished(task);
+    }
+}
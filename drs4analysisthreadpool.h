@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DRS4ANALYSISTHREADPOOL_H
+#define DRS4ANALYSISTHREADPOOL_H
+
+#include <QThread>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QVector>
+
+#include <deque>
+#include <atomic>
+
+#include "DLib.h"
+
+#define __ANALYSIS_THREAD_POOL_RESERVED_CORES   1   // [#] cores kept free for the acquisition (readout) thread
+#define __ANALYSIS_THREAD_POOL_IDLE_WAIT        50  // [ms]
+
+class DRS4AnalysisThread;
+
+/* task queue of one analysis thread: the owner pops from the back (last in, first out), idle threads steal from the front */
+class DRS4AnalysisTaskDeque final {
+    std::deque<QRunnable*> m_tasks;
+    mutable QMutex m_mutex;
+
+public:
+    DRS4AnalysisTaskDeque() {}
+    ~DRS4AnalysisTaskDeque() {}
+
+    void push(QRunnable *task);
+
+    QRunnable *pop();
+    QRunnable *steal();
+
+    void clear();
+};
+
+/* dedicated pool of long-lived analysis threads (instead of QThreadPool::globalInstance(), which is shared with the rest of the application):
+ *
+ * - every thread owns a task deque. start() posts a task onto the deque of the preferred thread, idle threads steal from the deques of the others.
+ * - the pool leaves __ANALYSIS_THREAD_POOL_RESERVED_CORES cores to the acquisition: the analysis never competes with the readout.
+ * - optionally, the threads are pinned to the cores [__ANALYSIS_THREAD_POOL_RESERVED_CORES, idealThreadCount) and the acquisition thread to the reserved core(s). */
+class DRS4AnalysisThreadPool final {
+    friend class DRS4AnalysisThread;
+
+    QVector<DRS4AnalysisThread*> m_threads;
+    QVector<DRS4AnalysisTaskDeque*> m_deques;
+
+    QMutex m_mutex;
+    QWaitCondition m_taskAvailable;
+    QWaitCondition m_tasksDone;
+
+    std::atomic<bool> m_isRunning;
+    std::atomic<int> m_queuedTasks;
+    std::atomic<int> m_pendingTasks;
+    std::atomic<int> m_activeThreads;
+    std::atomic<int> m_idleThreads; /* waiting for 'm_taskAvailable' */
+    std::atomic<int> m_nextThread;
+    std::atomic<quint64> m_stolenTasks;
+
+    std::atomic<bool> m_bThreadAffinity;
+    std::atomic<int> m_affinityVersion;
+
+    DRS4AnalysisThreadPool();
+    ~DRS4AnalysisThreadPool();
+
+    /* analysis thread: own deque first, then steal */
+    QRunnable *take(int threadIndex);
+    void finished(QRunnable *task);
+
+public:
+    static DRS4AnalysisThreadPool *sharedInstance();
+
+    /* 'preferredThread' < 0: round robin */
+    void start(QRunnable *task, int preferredThread = -1);
+    bool waitForDone(int msecs = -1);
+
+    int maxThreadCount() const;
+    int activeThreadCount() const;
+
+    quint64 stolenTasks() const;
+
+    /* index of the calling analysis thread, -1 if called by any other thread */
+    static int currentThreadIndex();
+
+    void setThreadAffinityEnabled(bool on);
+    bool isThreadAffinityEnabled() const;
+
+    /* pins the calling (acquisition) thread to the reserved core(s) or releases it: returns false if not supported */
+    static bool pinCurrentThreadToReservedCores(bool on);
+};
+
+class DRS4AnalysisThread final : public QThread {
+    DRS4AnalysisThreadPool *m_pool;
+    int m_threadIndex;
+
+    int m_appliedAffinityVersion;
+
+    void applyAffinity();
+
+public:
+    DRS4AnalysisThread(DRS4AnalysisThreadPool *pool, int threadIndex) :
+        QThread(DNULLPTR),
+        m_pool(pool),
+        m_threadIndex(threadIndex),
+        m_appliedAffinityVersion(0) {}
+
+    virtual ~DRS4AnalysisThread() {}
+
+protected:
+    virtual void run();
+};
+
+#endif // DRS4ANALYSISTHREADPOOL_H
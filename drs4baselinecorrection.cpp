@@ -0,0 +1,248 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#include <cmath>
+
+#include "drs4baselinecorrection.h"
+
+DRS4BaselineCorrection::DRS4BaselineCorrection() :
+    m_bEnabled(false),
+    m_type(DRS4BaselineCorrectionType::type::fixed),
+    m_startCell(0),
+    m_cellRegion(1),
+    m_startPeakCell(0),
+    m_window(2),
+    m_shiftValueInMV(0.),
+    m_bRejectLimit(false),
+    m_limitInPercentage(100.) {}
+
+DRS4BaselineCorrection DRS4BaselineCorrection::channelA(const DRS4AnalysisConfig *config)
+{
+    DRS4BaselineCorrection correction;
+
+    correction.m_bEnabled = config->m_baselineCorrectionEnabledA;
+    correction.m_type = config->m_baselineCorrectionMethodA;
+    correction.m_startCell = config->m_baselineCorrectionStartCellA;
+    correction.m_cellRegion = config->m_baselineCorrectionRegionA;
+    correction.m_startPeakCell = config->m_baselineCorrectionStartPeakCellA;
+    correction.m_window = config->m_baselineCorrectionWindowA;
+    correction.m_shiftValueInMV = config->m_baselineCorrectionShiftValueInMVA;
+    correction.m_bRejectLimit = config->m_baselineCorrectionLimitRejectLimitA;
+    correction.m_limitInPercentage = config->m_baselineCorrectionLimitInPercentageA;
+
+    return correction;
+}
+
+DRS4BaselineCorrection DRS4BaselineCorrection::channelB(const DRS4AnalysisConfig *config)
+{
+    DRS4BaselineCorrection correction;
+
+    correction.m_bEnabled = config->m_baselineCorrectionEnabledB;
+    correction.m_type = config->m_baselineCorrectionMethodB;
+    correction.m_startCell = config->m_baselineCorrectionStartCellB;
+    correction.m_cellRegion = config->m_baselineCorrectionRegionB;
+    correction.m_startPeakCell = config->m_baselineCorrectionStartPeakCellB;
+    correction.m_window = config->m_baselineCorrectionWindowB;
+    correction.m_shiftValueInMV = config->m_baselineCorrectionShiftValueInMVB;
+    correction.m_bRejectLimit = config->m_baselineCorrectionLimitRejectLimitB;
+    correction.m_limitInPercentage = config->m_baselineCorrectionLimitInPercentageB;
+
+    return correction;
+}
+
+void DRS4BaselineCorrection::extendCellRange(int size, int *first, int *last) const
+{
+    if (!m_bEnabled)
+        return;
+
+    if (m_type == DRS4BaselineCorrectionType::type::fixed) {
+        *first = qMax(0, qMin(*first, m_startCell));
+        *last = qMin(size, qMax(*last, m_startCell + m_cellRegion - 1));
+    }
+    else if (m_type == DRS4BaselineCorrectionType::type::dynamic) {
+        /* extrema of the range and the region in front of them */
+        *first = qMax(0, *first - m_startPeakCell);
+        *last = qMin(size, *last);
+    }
+}
+
+bool DRS4BaselineCorrection::apply(float *wave, int first, int last, bool bPositiveSignal) const
+{
+    if (!m_bEnabled)
+        return true;
+
+    double baseline = 0.;
+
+    if (m_type == DRS4BaselineCorrectionType::type::fixed) {
+        if (!fixedBaseline(wave, &baseline))
+            return false;
+    }
+    else if (m_type == DRS4BaselineCorrectionType::type::dynamic) {
+        if (!dynamicBaseline(wave, first, last, bPositiveSignal, &baseline))
+            return false;
+    }
+    else {
+        return true;
+    }
+
+    /* rejection-limit filter */
+    const bool limitExceeded = (std::abs(baseline - m_shiftValueInMV)/500.0) > m_limitInPercentage*0.01;
+
+    if (m_bRejectLimit && limitExceeded)
+        return false;
+
+    const float fBaseline = float(baseline);
+
+    for (int i = first ; i < last ; ++ i)
+        wave[i] -= fBaseline;
+
+    return true;
+}
+
+bool DRS4BaselineCorrection::fixedBaseline(const float *wave, double *baseline) const
+{
+    const int endRegion = (m_startCell + m_cellRegion - 1);
+
+    double sum = 0.;
+
+    for (int i = m_startCell ; i < endRegion ; ++ i)
+        sum += wave[i];
+
+    *baseline = sum/m_cellRegion;
+
+    return true;
+}
+
+bool DRS4BaselineCorrection::dynamicBaseline(const float *wave, int first, int last, bool bPositiveSignal, double *baseline) const
+{
+    float minV = 500.0;
+    float maxV = -500.0;
+
+    int iMinV = -1;
+    int iMaxV = -1;
+
+    for (int i = first ; i < last ; ++ i) {
+        if (wave[i] < minV) {
+            iMinV = i;
+            minV = wave[i];
+        }
+
+        if (wave[i] > maxV) {
+            iMaxV = i;
+            maxV = wave[i];
+        }
+    }
+
+    const int iStop = bPositiveSignal?iMaxV:iMinV;
+    const int iStart = qMax(first, iStop - m_startPeakCell);
+
+    const int window = m_window;
+    const double normWindow = 1./double(window);
+    const double normVariance = 1./double(window - 1);
+
+    /* sum and sum of squares of the first window */
+    double sum = 0.;
+    double sumOfSquares = 0.;
+
+    if (iStart < iStop - window) {
+        for (int s = 0 ; s < window ; ++ s) {
+            sum += wave[iStart + s];
+            sumOfSquares += double(wave[iStart + s])*double(wave[iStart + s]);
+        }
+    }
+
+    /* end of the baseline: first sample outside the band [mean - var ; mean + var] of the preceding window */
+    int lastIndex = -1;
+
+    for (int i = iStart ; i < iStop - window ; ++ i) {
+        const double mean = sum*normWindow;
+        const double variance = qMax(0., sumOfSquares - sum*mean)*normVariance;
+
+        const float next = wave[i + window];
+
+        if (next > mean + variance
+                || next < mean - variance) {
+            lastIndex = i;
+            break;
+        }
+
+        /* slide the window */
+        const double first = wave[i];
+
+        sum += next - first;
+        sumOfSquares += double(next)*double(next) - first*first;
+    }
+
+    const int length = lastIndex - iStart;
+
+    /* the window breaks out immediately: no baseline in front of the pulse */
+    if (!length)
+        return false;
+
+    /* no end of the baseline found: the waveform remains uncorrected */
+    if (length < 0) {
+        *baseline = 0.;
+
+        return true;
+    }
+
+    double baselineSum = 0.;
+
+    for (int i = 0 ; i < length ; ++ i)
+        baselineSum += wave[iStart + i];
+
+    *baseline = baselineSum/length;
+
+    return true;
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DRS4BASELINECORRECTION_H
+#define DRS4BASELINECORRECTION_H
+
+#include "drs4settingsmanager.h"
+
+/* baseline (jitter) correction of one channel shared by the single- and the multi-threaded acquisition:
+ *
+ * - fixed: mean within a fixed cell region.
+ * - dynamic: mean of the region in front of the pulse, which ends at the first sample outside the [mean - var ; mean + var] band of
+ *   the preceding window. The window statistics are updated by a sliding accumulator, i.e. the cost is independent of the window size.
+ *
+ * the correction is restricted to the processing window of the channel (ROI and baseline region): cells outside remain uncorrected. */
+class DRS4BaselineCorrection final {
+public:
+    bool m_bEnabled;
+
+    DRS4BaselineCorrectionType::type m_type;
+
+    /* fixed */
+    int m_startCell;
+    int m_cellRegion;
+
+    /* dynamic */
+    int m_startPeakCell;
+    int m_window;
+
+    /* rejection-limit filter */
+    double m_shiftValueInMV;
+    bool m_bRejectLimit;
+    double m_limitInPercentage;
+
+    DRS4BaselineCorrection();
+
+    static DRS4BaselineCorrection channelA(const DRS4AnalysisConfig *config);
+    static DRS4BaselineCorrection channelB(const DRS4AnalysisConfig *config);
+
+    /* extends the cell range [first ; last[ by the cells read by the correction */
+    void extendCellRange(int size, int *first, int *last) const;
+
+    /* subtracts the baseline from the cells [first ; last[ of the waveform (extended by extendCellRange()) - 'false' if the event has to be rejected */
+    bool apply(float *wave, int first, int last, bool bPositiveSignal) const;
+
+private:
+    bool fixedBaseline(const float *wave, double *baseline) const;
+    bool dynamicBaseline(const float *wave, int first, int last, bool bPositiveSignal, double *baseline) const;
+};
+
+#endif // DRS4BASELINECORRECTION_H
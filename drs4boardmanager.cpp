@@ -60,12 +60,13 @@ DRS4BoardManager::DRS4BoardManager() :
     m_drs(DNULLPTR),
     m_drsBoard(DNULLPTR),
     m_demoMode(false),
-    m_demoFromStreamData(false) {}
+    m_demoFromStreamData(false),
+    m_acquisitionRunning(false) {}
 
 DRS4BoardManager::~DRS4BoardManager()
 {
-    DDELETE_SAFETY(m_drs);
-    DDELETE_SAFETY(m_drsBoard);
+    disconnectBoard();
+
     DDELETE_SAFETY(__sharedInstanceBoardManager);
 }
 
@@ -77,10 +78,23 @@ DRS4BoardManager *DRS4BoardManager::sharedInstance()
     return __sharedInstanceBoardManager;
 }
 
+void DRS4BoardManager::disconnectBoard()
+{
+    /* the boards are owned by the DRS container */
+    DDELETE_SAFETY(m_drs);
+
+    m_drsBoard = DNULLPTR;
+}
+
 bool DRS4BoardManager::connect()
 {
     QMutexLocker locker(&m_mutex);
 
+    if ( m_acquisitionRunning )
+        return false;
+
+    disconnectBoard();
+
     m_drs = new DRS;
 
     if ( !m_drs )
@@ -97,6 +111,86 @@ bool DRS4BoardManager::connect()
         return false;
 }
 
+bool DRS4BoardManager::connectToReplay(const QString &fileName, double eventRate)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ( m_acquisitionRunning )
+        return false;
+
+    /* mock device replaying a recording of DRSBoard::StartRecording() */
+    DRSReplayTransport *replay = new DRSReplayTransport(fileName.toLocal8Bit().constData(), eventRate);
+
+    if ( !replay->IsValid() ) {
+        DDELETE_SAFETY(replay);
+
+        return false;
+    }
+
+    disconnectBoard();
+
+    /* no hardware scan: an attached board is not opened */
+    m_drs = new DRS(new DRSBoard(replay));
+
+    if ( !m_drs )
+        return false;
+
+    if ( m_drs->GetNumberOfBoards() == 1 )
+        m_drsBoard = m_drs->GetBoard(0);
+    else
+        m_drsBoard = DNULLPTR;
+
+    if ( m_drsBoard )
+        return true;
+    else
+        return false;
+}
+
+bool DRS4BoardManager::startRecording(const QString &fileName)
+{
+    QMutexLocker locker(&m_mutex);
+
+    /* DRSBoard::StartRecording() reads the calibration pages through the waveform RAM of the board */
+    if ( !m_drsBoard || m_acquisitionRunning )
+        return false;
+
+    return m_drsBoard->StartRecording(fileName.toLocal8Bit().constData());
+}
+
+void DRS4BoardManager::stopRecording()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ( !m_drsBoard )
+        return;
+
+    m_drsBoard->StopRecording();
+}
+
+bool DRS4BoardManager::isRecording() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ( !m_drsBoard )
+        return false;
+
+    return m_drsBoard->IsRecording();
+}
+
+void DRS4BoardManager::setAcquisitionRunning(bool running)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_acquisitionRunning = running;
+}
+
+bool DRS4BoardManager::isAcquisitionRunning() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_acquisitionRunning;
+}
+
 bool DRS4BoardManager::isConnected() const
 {
     return m_drsBoard != DNULLPTR;
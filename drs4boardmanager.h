@@ -76,13 +76,24 @@ class DRS4BoardManager
 
     bool m_demoMode;
     bool m_demoFromStreamData;
+    bool m_acquisitionRunning;
 
     mutable QMutex m_mutex;
 
+    void disconnectBoard();
+
 public:
     static DRS4BoardManager *sharedInstance();
 
     bool connect();
+    bool connectToReplay(const QString& fileName, double eventRate = 0.);
+
+    bool startRecording(const QString& fileName);
+    void stopRecording();
+    bool isRecording() const;
+
+    void setAcquisitionRunning(bool running);
+    bool isAcquisitionRunning() const;
 
     bool isConnected() const;
 
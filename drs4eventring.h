@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DRS4EVENTRING_H
+#define DRS4EVENTRING_H
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <new>
+
+#include "DLib.h"
+
+/* preallocated, lock-free event ring between a single producer (e.g. the decode stage of the acquisition pipeline) and the analysis threads (multiple consumers):
+ *
+ * - the producer requests the next free slot, fills it in place and publishes it. Until it is published the same slot is handed out again, i.e. 'continue' within the producer loop simply recycles the slot.
+ * - consumers claim a contiguous run of published slots by CAS on the tail, work on the slots in place and release them afterwards.
+ * - if the analysis side cannot keep up, the slot is not available and the producer drops the event (drop counter). The high-water mark tracks the max. occupancy since the last reset. */
+
+#define __EVENT_RING_DEFAULT_CAPACITY 256
+#define __EVENT_RING_CACHE_LINE 64
+
+template <typename T>
+class DRS4EventRing final
+{
+    /* each slot starts on its own cache line: the producer filling a slot does not invalidate the neighbouring slot of a consumer */
+    struct alignas(__EVENT_RING_CACHE_LINE) Slot {
+        std::atomic<quint64> m_sequence;
+        T m_data;
+    };
+
+    Slot *m_slots;
+
+    quint64 m_capacity;
+    quint64 m_mask;
+
+    alignas(__EVENT_RING_CACHE_LINE) std::atomic<quint64> m_head; /* next position to be published by the producer */
+    alignas(__EVENT_RING_CACHE_LINE) std::atomic<quint64> m_tail; /* next position to be claimed by a consumer */
+
+    alignas(__EVENT_RING_CACHE_LINE) std::atomic<quint64> m_publishedEvents;
+    std::atomic<quint64> m_droppedEvents;
+    std::atomic<int> m_highWaterMark;
+
+    DRS4EventRing(const DRS4EventRing&) = delete;
+    DRS4EventRing& operator=(const DRS4EventRing&) = delete;
+
+public:
+    explicit DRS4EventRing(int capacity = __EVENT_RING_DEFAULT_CAPACITY) :
+        m_slots(DNULLPTR),
+        m_capacity(2),
+        m_mask(1),
+        m_head(0),
+        m_tail(0),
+        m_publishedEvents(0),
+        m_droppedEvents(0),
+        m_highWaterMark(0) {
+        /* power of 2 >> index by mask */
+        while (m_capacity < (quint64)qMax(2, capacity))
+            m_capacity <<= 1;
+
+        m_mask = m_capacity - 1;
+
+        /* new[] ignores the over-alignment of Slot (and of T) prior to C++17 */
+        m_slots = static_cast<Slot*>(qMallocAligned(m_capacity*sizeof(Slot), alignof(Slot)));
+
+        for (quint64 i = 0 ; i < m_capacity ; ++ i) {
+            new (&m_slots[i]) Slot;
+
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~DRS4EventRing() {
+        for (quint64 i = 0 ; i < m_capacity ; ++ i)
+            m_slots[i].~Slot();
+
+        qFreeAligned(m_slots);
+        m_slots = DNULLPTR;
+    }
+
+    /* producer: returns DNULLPTR if the ring is full */
+    inline T *acquireWriteSlot() {
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+        Slot *slot = &m_slots[head & m_mask];
+
+        /* slot still in use by a consumer (position head - capacity not yet released)? */
+        if (slot->m_sequence.load(std::memory_order_acquire) != head)
+            return DNULLPTR;
+
+        return &slot->m_data;
+    }
+
+    /* producer: returns the number of consecutive free slots (max. 'maxCount') from the next free slot on. They are accessed by writeSlotAt() and published at once by publishWriteSlots(). */
+    inline int acquireWriteSlots(int maxCount) {
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+
+        int count = 0;
+
+        while (count < maxCount
+               && m_slots[(head + count) & m_mask].m_sequence.load(std::memory_order_acquire) == head + count)
+            count ++;
+
+        return count;
+    }
+
+    /* producer: access to the slots of the last call of acquireWriteSlots() */
+    inline T *writeSlotAt(int index) const {
+        return &m_slots[(m_head.load(std::memory_order_relaxed) + index) & m_mask].m_data;
+    }
+
+    /* producer: publishes the slot returned by the last call of acquireWriteSlot() */
+    inline void publishWriteSlot() {
+        publishWriteSlots(1);
+    }
+
+    /* producer: publishes the first 'count' slots of the last call of acquireWriteSlots() */
+    inline void publishWriteSlots(int count) {
+        const quint64 head = m_head.load(std::memory_order_relaxed) + count;
+
+        m_head.store(head, std::memory_order_release);
+        m_publishedEvents.fetch_add(count, std::memory_order_relaxed);
+
+        const int occupancy = (int)(head - m_tail.load(std::memory_order_relaxed));
+
+        if (occupancy > m_highWaterMark.load(std::memory_order_relaxed))
+            m_highWaterMark.store(occupancy, std::memory_order_relaxed);
+    }
+
+    /* producer: the event(s) could not be placed into the ring */
+    inline void markDropped(int count = 1) {
+        m_droppedEvents.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /* consumer: claims up to 'maxCount' published slots starting at 'firstPosition'. Returns the number of claimed slots. */
+    inline int claimReadSlots(int maxCount, quint64 *firstPosition) {
+        quint64 tail = m_tail.load(std::memory_order_relaxed);
+
+        forever {
+            const quint64 head = m_head.load(std::memory_order_acquire);
+
+            if (head == tail)
+                return 0;
+
+            const int count = (int)qMin((quint64)qMax(1, maxCount), head - tail);
+
+            if (m_tail.compare_exchange_weak(tail, tail + count, std::memory_order_acquire, std::memory_order_relaxed)) {
+                *firstPosition = tail;
+
+                return count;
+            }
+        }
+    }
+
+    /* consumer: access to a claimed slot */
+    inline T *slotAt(quint64 position) const {
+        return &m_slots[position & m_mask].m_data;
+    }
+
+    /* consumer: hands the claimed slots back to the producer */
+    inline void releaseReadSlots(quint64 firstPosition, int count) {
+        for (int i = 0 ; i < count ; ++ i) {
+            const quint64 position = firstPosition + i;
+
+            m_slots[position & m_mask].m_sequence.store(position + m_capacity, std::memory_order_release);
+        }
+    }
+
+    /* drops all pending events (only valid if no consumer is running) */
+    inline void clear() {
+        const quint64 head = m_head.load(std::memory_order_acquire);
+
+        for (quint64 position = m_tail.load(std::memory_order_relaxed) ; position < head ; ++ position)
+            m_slots[position & m_mask].m_sequence.store(position + m_capacity, std::memory_order_relaxed);
+
+        m_tail.store(head, std::memory_order_release);
+    }
+
+    inline void resetStatistics() {
+        m_publishedEvents.store(0, std::memory_order_relaxed);
+        m_droppedEvents.store(0, std::memory_order_relaxed);
+        m_highWaterMark.store(0, std::memory_order_relaxed);
+    }
+
+    inline int capacity() const {
+        return (int)m_capacity;
+    }
+
+    inline int size() const {
+        const quint64 tail = m_tail.load(std::memory_order_relaxed);
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+
+        return (head > tail)?(int)(head - tail):0;
+    }
+
+    inline int highWaterMark() const {
+        return m_highWaterMark.load(std::memory_order_relaxed);
+    }
+
+    inline quint64 publishedEvents() const {
+        return m_publishedEvents.load(std::memory_order_relaxed);
+    }
+
+    inline quint64 droppedEvents() const {
+        return m_droppedEvents.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // DRS4EVENTRING_H
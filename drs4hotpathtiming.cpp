@@ -0,0 +1,266 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#include "drs4hotpathtiming.h"
+
+static DRS4HotPathTiming *__sharedInstanceHotPathTiming = DNULLPTR;
+
+std::atomic<bool> DRS4HotPathTiming::m_bEnabled(false);
+
+void DRS4HotPathTimingSlot::reset()
+{
+    for ( int stage = 0 ; stage < __HOT_PATH_STAGES ; ++ stage ) {
+        m_count[stage].store(0, std::memory_order_relaxed);
+        m_sumInNs[stage].store(0, std::memory_order_relaxed);
+        m_maxInNs[stage].store(0, std::memory_order_relaxed);
+
+        for ( int bin = 0 ; bin < __HOT_PATH_HISTOGRAM_BINS ; ++ bin )
+            m_histogram[stage][bin].store(0, std::memory_order_relaxed);
+    }
+
+    for ( int filter = 0 ; filter < __HOT_PATH_FILTERS ; ++ filter ) {
+        m_filterTested[filter].store(0, std::memory_order_relaxed);
+        m_filterRejected[filter].store(0, std::memory_order_relaxed);
+    }
+}
+
+void DRS4HotPathTimingSlot::addFilterCounts(const quint64 *tested, const quint64 *rejected)
+{
+    for ( int filter = 0 ; filter < __HOT_PATH_FILTERS ; ++ filter ) {
+        m_filterTested[filter].store(m_filterTested[filter].load(std::memory_order_relaxed) + tested[filter], std::memory_order_relaxed);
+        m_filterRejected[filter].store(m_filterRejected[filter].load(std::memory_order_relaxed) + rejected[filter], std::memory_order_relaxed);
+    }
+}
+
+double DRS4HotPathStageTiming::quantileInNs(double q) const
+{
+    if ( !m_count )
+        return 0.;
+
+    const quint64 rank = quint64(qBound(0., q, 1.)*double(m_count));
+
+    quint64 counts = 0;
+
+    for ( int bin = 0 ; bin < __HOT_PATH_HISTOGRAM_BINS ; ++ bin ) {
+        counts += m_histogram[bin];
+
+        if ( counts > rank
+             || counts == m_count )
+            return qMin(double(quint64(1) << (bin + 1)), double(m_maxInNs));
+    }
+
+    return double(m_maxInNs);
+}
+
+DRS4HotPathTiming::DRS4HotPathTiming() {}
+
+DRS4HotPathTiming::~DRS4HotPathTiming()
+{
+    qDeleteAll(m_slots);
+    m_slots.clear();
+}
+
+DRS4HotPathTiming *DRS4HotPathTiming::sharedInstance()
+{
+    if ( !__sharedInstanceHotPathTiming )
+        __sharedInstanceHotPathTiming = new DRS4HotPathTiming();
+
+    return __sharedInstanceHotPathTiming;
+}
+
+void DRS4HotPathTiming::setEnabled(bool on)
+{
+    m_bEnabled.store(on, std::memory_order_relaxed);
+}
+
+void DRS4HotPathTiming::reset()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for ( DRS4HotPathTimingSlot *slot : m_slots )
+        slot->reset();
+}
+
+DRS4HotPathTimingSlot *DRS4HotPathTiming::threadSlot()
+{
+    if ( m_threadSlot.hasLocalData() )
+        return m_threadSlot.localData()->m_slot;
+
+    QMutexLocker locker(&m_mutex);
+
+    DRS4HotPathTimingSlot *slot = DNULLPTR;
+
+    /* the slots of finished threads are reused: the pipeline threads are recreated on each start */
+    for ( DRS4HotPathTimingSlot *unusedSlot : m_slots ) {
+        if ( !unusedSlot->m_inUse.load(std::memory_order_acquire) ) {
+            slot = unusedSlot;
+            slot->m_inUse.store(true, std::memory_order_relaxed);
+
+            break;
+        }
+    }
+
+    if ( !slot ) {
+        slot = new DRS4HotPathTimingSlot;
+        m_slots.append(slot);
+    }
+
+    m_threadSlot.setLocalData(new DRS4HotPathTimingSlotHandle(slot));
+
+    return slot;
+}
+
+QVector<DRS4HotPathStageTiming> DRS4HotPathTiming::timings() const
+{
+    QVector<DRS4HotPathStageTiming> timings(__HOT_PATH_STAGES);
+
+    QMutexLocker locker(&m_mutex);
+
+    for ( const DRS4HotPathTimingSlot *slot : m_slots ) {
+        for ( int stage = 0 ; stage < __HOT_PATH_STAGES ; ++ stage ) {
+            DRS4HotPathStageTiming& timing = timings[stage];
+
+            timing.m_count += slot->m_count[stage].load(std::memory_order_relaxed);
+            timing.m_sumInNs += slot->m_sumInNs[stage].load(std::memory_order_relaxed);
+            timing.m_maxInNs = qMax(timing.m_maxInNs, slot->m_maxInNs[stage].load(std::memory_order_relaxed));
+
+            for ( int bin = 0 ; bin < __HOT_PATH_HISTOGRAM_BINS ; ++ bin )
+                timing.m_histogram[bin] += slot->m_histogram[stage][bin].load(std::memory_order_relaxed);
+        }
+    }
+
+    return timings;
+}
+
+QVector<DRS4RejectFilterStatistics> DRS4HotPathTiming::filterStatistics() const
+{
+    QVector<DRS4RejectFilterStatistics> statistics(__HOT_PATH_FILTERS);
+
+    QMutexLocker locker(&m_mutex);
+
+    for ( const DRS4HotPathTimingSlot *slot : m_slots ) {
+        for ( int filter = 0 ; filter < __HOT_PATH_FILTERS ; ++ filter ) {
+            statistics[filter].m_tested += slot->m_filterTested[filter].load(std::memory_order_relaxed);
+            statistics[filter].m_rejected += slot->m_filterRejected[filter].load(std::memory_order_relaxed);
+        }
+    }
+
+    return statistics;
+}
+
+int DRS4HotPathTiming::threadCount() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_slots.size();
+}
+
+QString DRS4HotPathTiming::toCSV() const
+{
+    const QVector<DRS4HotPathStageTiming> stageTimings = timings();
+
+    QString csv("stage;count;total [ms];mean [us];median [us];99% [us];max [us]\n");
+
+    for ( int stage = 0 ; stage < __HOT_PATH_STAGES ; ++ stage ) {
+        const DRS4HotPathStageTiming& timing = stageTimings.at(stage);
+
+        csv.append(QString("%1;%2;%3;%4;%5;%6;%7\n").arg(DRS4HotPathStage::typeList().at(stage))
+                   .arg(timing.m_count)
+                   .arg(1E-6*double(timing.m_sumInNs), 0, 'f', 3)
+                   .arg(1E-3*timing.meanInNs(), 0, 'f', 3)
+                   .arg(1E-3*timing.quantileInNs(0.5), 0, 'f', 3)
+                   .arg(1E-3*timing.quantileInNs(0.99), 0, 'f', 3)
+                   .arg(1E-3*double(timing.m_maxInNs), 0, 'f', 3));
+    }
+
+    const QVector<DRS4RejectFilterStatistics> statistics = filterStatistics();
+
+    csv.append("\nfilter;tested;rejected;reject rate [%]\n");
+
+    for ( int filter = 0 ; filter < __HOT_PATH_FILTERS ; ++ filter ) {
+        const DRS4RejectFilterStatistics& filterStatistics = statistics.at(filter);
+
+        csv.append(QString("%1;%2;%3;%4\n").arg(DRS4RejectFilter::typeList().at(filter))
+                   .arg(filterStatistics.m_tested)
+                   .arg(filterStatistics.m_rejected)
+                   .arg(100.*filterStatistics.rejectRate(), 0, 'f', 2));
+    }
+
+    return csv;
+}
+
+DRS4RejectFilterCounter::DRS4RejectFilterCounter() :
+    m_events(0)
+{
+    std::fill(m_tested, m_tested + __HOT_PATH_FILTERS, 0);
+    std::fill(m_rejected, m_rejected + __HOT_PATH_FILTERS, 0);
+}
+
+void DRS4RejectFilterCounter::flush()
+{
+    m_events = 0;
+
+    bool bPending = false;
+
+    for ( int filter = 0 ; filter < __HOT_PATH_FILTERS ; ++ filter )
+        bPending |= (m_tested[filter] != 0);
+
+    if (!bPending)
+        return;
+
+    DRS4HotPathTiming::sharedInstance()->threadSlot()->addFilterCounts(m_tested, m_rejected);
+
+    std::fill(m_tested, m_tested + __HOT_PATH_FILTERS, 0);
+    std::fill(m_rejected, m_rejected + __HOT_PATH_FILTERS, 0);
+}
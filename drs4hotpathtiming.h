@@ -0,0 +1,319 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DRS4HOTPATHTIMING_H
+#define DRS4HOTPATHTIMING_H
+
+#include <QStringList>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadStorage>
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+
+#include "DLib.h"
+
+#define __HOT_PATH_STAGES 9
+#define __HOT_PATH_HISTOGRAM_BINS 32 // [#] bin i: duration within [2^i, 2^(i+1)) ns
+
+#define __HOT_PATH_FILTERS 10
+#define __HOT_PATH_FILTER_FLUSH_EVENTS 256 // [#] events counted locally before they are added to the slot of the thread
+
+typedef struct {
+    static QStringList typeList() {
+        return QStringList() << "decode" << "median-filter" << "baseline-correction" << "scan" << "interpolation" << "refine" << "cfd" << "rise-time" << "merge";
+    }
+
+    enum type : int {
+        decode = 0,
+        medianFilter = 1,
+        baselineCorrection = 2,
+        scan = 3,
+        interpolation = 4,
+        refine = 5,
+        cfd = 6,
+        riseTime = 7,
+        merge = 8
+    };
+} DRS4HotPathStage;
+
+/* per-event filters in the order of the cascade: cheap and selective filters on the raw samples first, the pulse-shape filter last */
+typedef struct {
+    static QStringList typeList() {
+        return QStringList() << "baseline-limit" << "extrema" << "artifact" << "refine" << "cf-level" << "area-window" << "phs-window" << "rise-time-window" << "pulse-shape" << "lifetime-range";
+    }
+
+    enum type : int {
+        baselineLimit = 0,
+        extrema = 1,
+        artifact = 2,
+        refine = 3,
+        cfLevel = 4,
+        areaWindow = 5,
+        phsWindow = 6,
+        riseTimeWindow = 7,
+        pulseShape = 8,
+        lifetimeRange = 9
+    };
+} DRS4RejectFilter;
+
+/* timings of one thread: written by this thread only (no locks, no read-modify-write), read by the aggregation */
+class DRS4HotPathTimingSlot final {
+public:
+    std::atomic<quint64> m_count[__HOT_PATH_STAGES];
+    std::atomic<quint64> m_sumInNs[__HOT_PATH_STAGES];
+    std::atomic<quint64> m_maxInNs[__HOT_PATH_STAGES];
+    std::atomic<quint64> m_histogram[__HOT_PATH_STAGES][__HOT_PATH_HISTOGRAM_BINS];
+
+    std::atomic<quint64> m_filterTested[__HOT_PATH_FILTERS];
+    std::atomic<quint64> m_filterRejected[__HOT_PATH_FILTERS];
+
+    /* false: the thread has finished, the slot is reused by the next one */
+    std::atomic<bool> m_inUse;
+
+    DRS4HotPathTimingSlot() :
+        m_inUse(true) {
+        reset();
+    }
+
+    void reset();
+
+    inline void add(int stage, quint64 durationInNs) {
+        int bin = 0;
+
+        for ( quint64 d = durationInNs ; d > 1 && bin < __HOT_PATH_HISTOGRAM_BINS - 1 ; d >>= 1 )
+            bin ++;
+
+        m_count[stage].store(m_count[stage].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_sumInNs[stage].store(m_sumInNs[stage].load(std::memory_order_relaxed) + durationInNs, std::memory_order_relaxed);
+        m_histogram[stage][bin].store(m_histogram[stage][bin].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if ( durationInNs > m_maxInNs[stage].load(std::memory_order_relaxed) )
+            m_maxInNs[stage].store(durationInNs, std::memory_order_relaxed);
+    }
+
+    void addFilterCounts(const quint64 *tested, const quint64 *rejected);
+};
+
+/* thread-local reference on a slot: releases the slot if the thread has finished */
+class DRS4HotPathTimingSlotHandle final {
+public:
+    DRS4HotPathTimingSlot *m_slot;
+
+    DRS4HotPathTimingSlotHandle(DRS4HotPathTimingSlot *slot) :
+        m_slot(slot) {}
+
+    ~DRS4HotPathTimingSlotHandle() {
+        m_slot->m_inUse.store(false, std::memory_order_release);
+    }
+};
+
+/* sum of the timings of all threads for one stage */
+class DRS4HotPathStageTiming final {
+public:
+    quint64 m_count;
+    quint64 m_sumInNs;
+    quint64 m_maxInNs;
+
+    quint64 m_histogram[__HOT_PATH_HISTOGRAM_BINS];
+
+    DRS4HotPathStageTiming() :
+        m_count(0),
+        m_sumInNs(0),
+        m_maxInNs(0) {
+        std::fill(m_histogram, m_histogram + __HOT_PATH_HISTOGRAM_BINS, 0);
+    }
+
+    inline double meanInNs() const {
+        return m_count?(double(m_sumInNs)/double(m_count)):0.;
+    }
+
+    /* upper edge of the histogram bin containing the quantile 'q' [0, 1] */
+    double quantileInNs(double q) const;
+};
+
+/* sum of the decisions of all threads for one filter */
+class DRS4RejectFilterStatistics final {
+public:
+    quint64 m_tested;
+    quint64 m_rejected;
+
+    DRS4RejectFilterStatistics() :
+        m_tested(0),
+        m_rejected(0) {}
+
+    inline double rejectRate() const {
+        return m_tested?(double(m_rejected)/double(m_tested)):0.;
+    }
+};
+
+/* low-overhead timing of the hot path (decode, filters, pulse-pair kernel and merge) in both acquisition modes:
+ *
+ * - switchable at runtime. If disabled, a DRS4HotPathStageTimer costs a single relaxed load.
+ * - every thread writes into its own slot, i.e. the timed stages never share a cache line or a lock. */
+class DRS4HotPathTiming final {
+    static std::atomic<bool> m_bEnabled;
+
+    QVector<DRS4HotPathTimingSlot*> m_slots;
+    mutable QMutex m_mutex;
+
+    QThreadStorage<DRS4HotPathTimingSlotHandle*> m_threadSlot;
+
+    DRS4HotPathTiming();
+    ~DRS4HotPathTiming();
+
+public:
+    static DRS4HotPathTiming *sharedInstance();
+
+    static inline bool isEnabled() {
+        return m_bEnabled.load(std::memory_order_relaxed);
+    }
+
+    static inline quint64 now() {
+        return quint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void setEnabled(bool on);
+
+    /* not synchronized with the threads: a timing in progress may survive the reset */
+    void reset();
+
+    /* slot of the calling thread */
+    DRS4HotPathTimingSlot *threadSlot();
+
+    QVector<DRS4HotPathStageTiming> timings() const;
+    QVector<DRS4RejectFilterStatistics> filterStatistics() const;
+    int threadCount() const;
+
+    QString toCSV() const;
+};
+
+/* measures the time between start() and stop() (or the destructor), start() stops a running stage before */
+class DRS4HotPathStageTimer final {
+    DRS4HotPathTimingSlot *m_slot;
+    int m_stage;
+    quint64 m_startInNs;
+
+public:
+    inline DRS4HotPathStageTimer() :
+        m_slot(DNULLPTR),
+        m_stage(0),
+        m_startInNs(0) {}
+
+    inline explicit DRS4HotPathStageTimer(DRS4HotPathStage::type stage) :
+        m_slot(DNULLPTR),
+        m_stage(0),
+        m_startInNs(0) {
+        start(stage);
+    }
+
+    inline ~DRS4HotPathStageTimer() {
+        stop();
+    }
+
+    inline void start(DRS4HotPathStage::type stage) {
+        stop();
+
+        if ( !DRS4HotPathTiming::isEnabled() )
+            return;
+
+        m_slot = DRS4HotPathTiming::sharedInstance()->threadSlot();
+        m_stage = stage;
+        m_startInNs = DRS4HotPathTiming::now();
+    }
+
+    inline void stop() {
+        if ( !m_slot )
+            return;
+
+        m_slot->add(m_stage, DRS4HotPathTiming::now() - m_startInNs);
+        m_slot = DNULLPTR;
+    }
+};
+
+/* decisions of the filter cascade of one thread: counted without any atomic operation and flushed into the slot of the thread
+ * every __HOT_PATH_FILTER_FLUSH_EVENTS events and on destruction. Always enabled (independent of the timing). */
+class DRS4RejectFilterCounter final {
+    quint64 m_tested[__HOT_PATH_FILTERS];
+    quint64 m_rejected[__HOT_PATH_FILTERS];
+
+    int m_events;
+
+public:
+    DRS4RejectFilterCounter();
+
+    inline ~DRS4RejectFilterCounter() {
+        flush();
+    }
+
+    /* returns 'bPassed' */
+    inline bool pass(DRS4RejectFilter::type filter, bool bPassed) {
+        m_tested[filter] ++;
+        m_rejected[filter] += bPassed?0:1;
+
+        return bPassed;
+    }
+
+    inline void nextEvent() {
+        if ( ++ m_events >= __HOT_PATH_FILTER_FLUSH_EVENTS )
+            flush();
+    }
+
+    void flush();
+};
+
+#endif // DRS4HOTPATHTIMING_H
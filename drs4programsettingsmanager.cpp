@@ -103,6 +103,15 @@ DRS4ProgramSettingsManager::DRS4ProgramSettingsManager() {
     m_pulsePairChunkSizeNode = new DSimpleXMLNode("pulsePairChunkSize");
     m_pulsePairChunkSizeNode->setValue(1);
 
+    m_pulsePairChunkSizeAdaptiveNode = new DSimpleXMLNode("pulsePairChunkSizeAdaptive?");
+    m_pulsePairChunkSizeAdaptiveNode->setValue(false);
+
+    m_pinAnalysisThreadsNode = new DSimpleXMLNode("pinAnalysisThreads?");
+    m_pinAnalysisThreadsNode->setValue(false);
+
+    m_multiBufferReadoutNode = new DSimpleXMLNode("multiBufferReadout?");
+    m_multiBufferReadoutNode->setValue(false);
+
     m_httpServerPort = new DSimpleXMLNode("httpServerPort");
     m_httpServerPort->setValue(8080);
 
@@ -141,7 +150,10 @@ DRS4ProgramSettingsManager::DRS4ProgramSettingsManager() {
                     << m_rcServerAutoStart;
 
     (*m_multicoreThreadingParentNode) << m_enableMulticoreThreadingNode
-                    << m_pulsePairChunkSizeNode;
+                    << m_pulsePairChunkSizeNode
+                    << m_pulsePairChunkSizeAdaptiveNode
+                    << m_pinAnalysisThreadsNode
+                    << m_multiBufferReadoutNode;
 
      (*m_parentNode) << m_multicoreThreadingParentNode;
 }
@@ -179,6 +191,9 @@ bool DRS4ProgramSettingsManager::load()
         m_lastAreaDistrPathNode->setValue("/home");
         m_enableMulticoreThreadingNode->setValue(false);
         m_pulsePairChunkSizeNode->setValue(1);
+        m_pulsePairChunkSizeAdaptiveNode->setValue(false);
+        m_pinAnalysisThreadsNode->setValue(false);
+        m_multiBufferReadoutNode->setValue(false);
         m_httpServerPort->setValue(8080);
         m_rcServerPort->setValue(5000);
         m_rcServerIP->setValue("127.0.0.1");
@@ -207,6 +222,9 @@ bool DRS4ProgramSettingsManager::load()
         m_lastAreaDistrPathNode->setValue("/home");
         m_enableMulticoreThreadingNode->setValue(false);
         m_pulsePairChunkSizeNode->setValue(1);
+        m_pulsePairChunkSizeAdaptiveNode->setValue(false);
+        m_pinAnalysisThreadsNode->setValue(false);
+        m_multiBufferReadoutNode->setValue(false);
         m_httpServerPort->setValue(8080);
         m_rcServerPort->setValue(5000);
         m_rcServerIP->setValue("127.0.0.1");
@@ -331,6 +349,9 @@ bool DRS4ProgramSettingsManager::load()
    {
        m_enableMulticoreThreadingNode->setValue(false);
        m_pulsePairChunkSizeNode->setValue(1);
+       m_pulsePairChunkSizeAdaptiveNode->setValue(false);
+       m_pinAnalysisThreadsNode->setValue(false);
+       m_multiBufferReadoutNode->setValue(false);
 
        return true;
    }
@@ -347,6 +368,24 @@ bool DRS4ProgramSettingsManager::load()
    else
        m_pulsePairChunkSizeNode->setValue(1);
 
+   const bool bAdaptiveChunkSize = pTagMulticoreThreading.getValueAt(m_pulsePairChunkSizeAdaptiveNode, &ok).toBool();
+   if ( ok )
+       m_pulsePairChunkSizeAdaptiveNode->setValue(bAdaptiveChunkSize);
+   else
+       m_pulsePairChunkSizeAdaptiveNode->setValue(false);
+
+   const bool bPinThreads = pTagMulticoreThreading.getValueAt(m_pinAnalysisThreadsNode, &ok).toBool();
+   if ( ok )
+       m_pinAnalysisThreadsNode->setValue(bPinThreads);
+   else
+       m_pinAnalysisThreadsNode->setValue(false);
+
+   const bool bMultiBuffer = pTagMulticoreThreading.getValueAt(m_multiBufferReadoutNode, &ok).toBool();
+   if ( ok )
+       m_multiBufferReadoutNode->setValue(bMultiBuffer);
+   else
+       m_multiBufferReadoutNode->setValue(false);
+
    return true;
 }
 
@@ -510,6 +549,30 @@ void DRS4ProgramSettingsManager::setPulsePairChunkSize(int size)
     save();
 }
 
+void DRS4ProgramSettingsManager::setPulsePairChunkSizeAdaptive(bool on)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_pulsePairChunkSizeAdaptiveNode->setValue(on);
+    save();
+}
+
+void DRS4ProgramSettingsManager::setAnalysisThreadPinningEnabled(bool on)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_pinAnalysisThreadsNode->setValue(on);
+    save();
+}
+
+void DRS4ProgramSettingsManager::setMultiBufferReadoutEnabled(bool on)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_multiBufferReadoutNode->setValue(on);
+    save();
+}
+
 int DRS4ProgramSettingsManager::splineIntraPoints()
 {
     QMutexLocker locker(&m_mutex);
@@ -688,6 +751,30 @@ int DRS4ProgramSettingsManager::pulsePairChunkSize()
     return (ok?val:1);
 }
 
+bool DRS4ProgramSettingsManager::isPulsePairChunkSizeAdaptive()
+{
+    QMutexLocker locker(&m_mutex);
+
+    load();
+    return m_pulsePairChunkSizeAdaptiveNode->getValue().toBool();
+}
+
+bool DRS4ProgramSettingsManager::isAnalysisThreadPinningEnabled()
+{
+    QMutexLocker locker(&m_mutex);
+
+    load();
+    return m_pinAnalysisThreadsNode->getValue().toBool();
+}
+
+bool DRS4ProgramSettingsManager::isMultiBufferReadoutEnabled()
+{
+    QMutexLocker locker(&m_mutex);
+
+    load();
+    return m_multiBufferReadoutNode->getValue().toBool();
+}
+
 void DRS4ProgramSettingsManager::showXMLContent()
 {
     m_parentNode->XMLMessageBox();
@@ -96,6 +96,9 @@ class DRS4ProgramSettingsManager
     DSimpleXMLNode *m_multicoreThreadingParentNode;
         DSimpleXMLNode *m_enableMulticoreThreadingNode;
         DSimpleXMLNode *m_pulsePairChunkSizeNode;
+        DSimpleXMLNode *m_pulsePairChunkSizeAdaptiveNode;
+        DSimpleXMLNode *m_pinAnalysisThreadsNode;
+        DSimpleXMLNode *m_multiBufferReadoutNode;
 
     mutable QMutex m_mutex;
 
@@ -132,6 +135,9 @@ public:
 
     void setEnableMulticoreThreading(bool on);
     void setPulsePairChunkSize(int size);
+    void setPulsePairChunkSizeAdaptive(bool on);
+    void setAnalysisThreadPinningEnabled(bool on);
+    void setMultiBufferReadoutEnabled(bool on);
 
     int splineIntraPoints();
 
@@ -156,6 +162,9 @@ public:
 
     bool isMulticoreThreadingEnabled();
     int pulsePairChunkSize();
+    bool isPulsePairChunkSizeAdaptive();
+    bool isAnalysisThreadPinningEnabled();
+    bool isMultiBufferReadoutEnabled();
 
     void showXMLContent();
 
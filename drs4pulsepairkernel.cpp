@@ -0,0 +1,1011 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#include <limits>
+
+#include "drs4pulsepairkernel.h"
+
+void DRS4InterpolationBackendALGLIBSpline::build()
+{
+    switch (m_type) {
+    case DRS4SplineInterpolationType::type::cubic: {
+        alglib::spline1dbuildcubic(m_x, m_y, m_interpolant);
+    }
+        break;
+    case DRS4SplineInterpolationType::type::akima: {
+        alglib::spline1dbuildakima(m_x, m_y, m_interpolant);
+    }
+        break;
+    case DRS4SplineInterpolationType::type::catmullRom: {
+        alglib::spline1dbuildcatmullrom(m_x, m_y, m_interpolant);
+    }
+        break;
+    case DRS4SplineInterpolationType::type::monotone: {
+        alglib::spline1dbuildmonotone(m_x, m_y, m_interpolant);
+    }
+        break;
+    default: {
+        alglib::spline1dbuildcubic(m_x, m_y, m_interpolant);
+    }
+        break;
+    }
+}
+
+void DRS4PulseChannelScan::reset(float sweep)
+{
+    m_xMin = sweep;
+    m_xMax = 0.0f;
+
+    m_yMin = 500.0f;
+    m_yMax = -500.0f;
+
+    m_cellYMin = -1;
+    m_cellYMax = -1;
+
+    m_cfdValue = 0.0f;
+    m_cfdValue_10perc = 0.0f;
+    m_cfdValue_90perc = 0.0f;
+
+    m_estimCFDCellStart = -1;
+    m_estimCFDCellStop = -1;
+
+    m_estimCFDCellStart_10perc = -1;
+    m_estimCFDCellStop_10perc = -1;
+
+    m_estimCFDCellStart_90perc = -1;
+    m_estimCFDCellStop_90perc = -1;
+
+    m_cfdCounter = 0;
+
+    m_area = 0.0f;
+
+    m_timeForYMax = -1;
+
+    m_cellPHS = -1;
+
+    m_timeStamp = -1.0f;
+    m_timeStamp_10perc = -1.0f;
+    m_timeStamp_90perc = -1.0f;
+
+    m_bRiseTime = false;
+}
+
+/* fused scan of the ROI [first ; last]: time and voltage extrema (incl. their cells), pulse area and finiteness of the slopes
+ *
+ * the samples are distributed over __PULSE_SCAN_LANES independent lanes without any data dependent branch, i.e. the loop is
+ * free to be vectorized. Equal extrema resolve to the first cell. Returns 'false' if a slope is not finite. */
+static inline bool scanFeatures(DRS4PulseChannelScan& channel, int first, int last, bool bPulseArea)
+{
+    const float *t = channel.m_t;
+    const float *y = channel.m_y;
+
+    float laneYMax[__PULSE_SCAN_LANES], laneYMin[__PULSE_SCAN_LANES];
+    int laneCellYMax[__PULSE_SCAN_LANES], laneCellYMin[__PULSE_SCAN_LANES];
+    float laneXMin[__PULSE_SCAN_LANES], laneXMax[__PULSE_SCAN_LANES];
+    double laneArea[__PULSE_SCAN_LANES];
+    int laneFinite[__PULSE_SCAN_LANES];
+
+    for ( int k = 0 ; k < __PULSE_SCAN_LANES ; ++ k ) {
+        laneYMax[k] = -std::numeric_limits<float>::infinity();
+        laneYMin[k] = std::numeric_limits<float>::infinity();
+
+        laneCellYMax[k] = -1;
+        laneCellYMin[k] = -1;
+
+        laneXMin[k] = channel.m_xMin;
+        laneXMax[k] = channel.m_xMax;
+
+        laneArea[k] = 0.;
+        laneFinite[k] = 1;
+    }
+
+    /* first sample (without a slope) */
+    if ( y[first] > laneYMax[0] ) {
+        laneYMax[0] = y[first];
+        laneCellYMax[0] = first;
+    }
+
+    if ( y[first] < laneYMin[0] ) {
+        laneYMin[0] = y[first];
+        laneCellYMin[0] = first;
+    }
+
+    laneXMin[0] = qMin(laneXMin[0], t[first]);
+    laneXMax[0] = qMax(laneXMax[0], t[first]);
+
+    for ( int a = first + 1 ; a <= last ; a += __PULSE_SCAN_LANES ) {
+        const int n = qMin(__PULSE_SCAN_LANES, last - a + 1);
+
+        for ( int k = 0 ; k < n ; ++ k ) {
+            const int cell = a + k;
+
+            const float tCell = t[cell];
+            const float yCell = y[cell];
+
+            const bool bMax = (yCell > laneYMax[k]);
+            const bool bMin = (yCell < laneYMin[k]);
+
+            laneYMax[k] = bMax?yCell:laneYMax[k];
+            laneCellYMax[k] = bMax?cell:laneCellYMax[k];
+
+            laneYMin[k] = bMin?yCell:laneYMin[k];
+            laneCellYMin[k] = bMin?cell:laneCellYMin[k];
+
+            laneXMin[k] = qMin(laneXMin[k], tCell);
+            laneXMax[k] = qMax(laneXMax[k], tCell);
+
+            const double dy = (yCell - y[cell - 1]);
+            const double dt = (tCell - t[cell - 1]);
+
+            laneArea[k] += std::abs((y[cell - 1] + 0.5*dy)*dt);
+
+            /* inf - inf and nan - nan are nan */
+            const double slope = dy/dt;
+
+            laneFinite[k] &= int((slope - slope) == 0.);
+        }
+    }
+
+    /* merge the lanes: the limits of +/-500mV apply as in the sequential search */
+    float yMax = -std::numeric_limits<float>::infinity();
+    float yMin = std::numeric_limits<float>::infinity();
+
+    int cellYMax = -1;
+    int cellYMin = -1;
+
+    double area = 0.;
+    int finite = 1;
+
+    for ( int k = 0 ; k < __PULSE_SCAN_LANES ; ++ k ) {
+        if ( laneCellYMax[k] != -1
+             && (laneYMax[k] > yMax || (laneYMax[k] == yMax && laneCellYMax[k] < cellYMax)) ) {
+            yMax = laneYMax[k];
+            cellYMax = laneCellYMax[k];
+        }
+
+        if ( laneCellYMin[k] != -1
+             && (laneYMin[k] < yMin || (laneYMin[k] == yMin && laneCellYMin[k] < cellYMin)) ) {
+            yMin = laneYMin[k];
+            cellYMin = laneCellYMin[k];
+        }
+
+        channel.m_xMin = qMin(channel.m_xMin, laneXMin[k]);
+        channel.m_xMax = qMax(channel.m_xMax, laneXMax[k]);
+
+        area += laneArea[k];
+        finite &= laneFinite[k];
+    }
+
+    if ( cellYMax != -1
+         && yMax >= channel.m_yMax ) {
+        channel.m_yMax = yMax;
+        channel.m_cellYMax = cellYMax;
+    }
+
+    if ( cellYMin != -1
+         && yMin <= channel.m_yMin ) {
+        channel.m_yMin = yMin;
+        channel.m_cellYMin = cellYMin;
+    }
+
+    if (bPulseArea)
+        channel.m_area = area;
+
+    return (finite != 0);
+}
+
+/* brackets the CF level within [aDecr ; a] - 'true' if the level was found */
+template <bool bPositiveSignal>
+static inline bool bracketCFLevel(float y, float yDecr, float cfdValue, int a, int aDecr, int *cellStart, int *cellStop)
+{
+    const bool cfdLevelInRange = bPositiveSignal?(y > cfdValue && yDecr < cfdValue):(y < cfdValue && yDecr > cfdValue);
+
+    if ( cfdLevelInRange ) {
+        *cellStart = aDecr;
+        *cellStop = a;
+
+        return true;
+    }
+    else if ( qFuzzyCompare(y, cfdValue) ) {
+        *cellStart = a;
+        *cellStop = a;
+
+        return true;
+    }
+    else if ( qFuzzyCompare(yDecr, cfdValue) ) {
+        *cellStart = aDecr;
+        *cellStop = aDecr;
+
+        return true;
+    }
+
+    return false;
+}
+
+/* CFD cell estimation/determination: CFD on rising edge = positive slope? or falling edge = negative slope? */
+template <bool bPositiveSignal>
+static inline void estimateCFCells(DRS4PulseChannelScan& channel, double slope, int a, int aDecr)
+{
+    const bool bInRange = bPositiveSignal?(slope > 1E-6):(slope < 1E-6);
+
+    if ( !bInRange )
+        return;
+
+    const float y = channel.m_y[a];
+    const float yDecr = channel.m_y[aDecr];
+
+    if ( bracketCFLevel<bPositiveSignal>(y, yDecr, channel.m_cfdValue, a, aDecr, &channel.m_estimCFDCellStart, &channel.m_estimCFDCellStop) )
+        channel.m_cfdCounter ++;
+
+    /* 10% and 90% CF Level */
+    bracketCFLevel<bPositiveSignal>(y, yDecr, channel.m_cfdValue_10perc, a, aDecr, &channel.m_estimCFDCellStart_10perc, &channel.m_estimCFDCellStop_10perc);
+    bracketCFLevel<bPositiveSignal>(y, yDecr, channel.m_cfdValue_90perc, a, aDecr, &channel.m_estimCFDCellStart_90perc, &channel.m_estimCFDCellStop_90perc);
+}
+
+/* CF levels of the extremum of the signal polarity and their brackets on the leading edge [startCell ; cell of the extremum] */
+template <bool bPositiveSignal>
+static inline void estimateCFLevels(DRS4PulseChannelScan& channel, int startCell)
+{
+    const float yExtremum = bPositiveSignal?channel.m_yMax:channel.m_yMin;
+    const int cellYExtremum = bPositiveSignal?channel.m_cellYMax:channel.m_cellYMin;
+
+    channel.m_cfdValue = channel.m_cfdLevel*yExtremum;
+
+    /* t - rise according to the spec definition of a delta illumination signal */
+    channel.m_cfdValue_10perc = 0.1*yExtremum;
+    channel.m_cfdValue_90perc = 0.9*yExtremum;
+
+    channel.m_cfdCounter = 0;
+
+    const float *t = channel.m_t;
+    const float *y = channel.m_y;
+
+    for ( int a = cellYExtremum ; a > startCell ; -- a ) {
+        const int aDecr = (a - 1);
+
+        const double slope = (y[a] - y[aDecr])/(t[a] - t[aDecr]);
+
+        estimateCFCells<bPositiveSignal>(channel, slope, a, aDecr);
+    }
+}
+
+/* light-weight filtering of wrong events */
+template <bool bPositiveSignal>
+static inline bool isWrongEvent(const DRS4PulseChannelScan& channel, int startCell, int reducedEndRange)
+{
+    if (bPositiveSignal) {
+        if ( std::abs(channel.m_yMin) > std::abs(channel.m_yMax) )
+            return true;
+
+        if ( std::abs(channel.m_cellYMax - startCell) <= 15 )
+            return true;
+
+        if ( qFuzzyCompare(channel.m_y[reducedEndRange], channel.m_yMax)
+             || qFuzzyCompare(channel.m_y[startCell], channel.m_yMax) )
+            return true;
+    }
+    else {
+        if ( std::abs(channel.m_yMin) < std::abs(channel.m_yMax) )
+            return true;
+
+        if ( std::abs(channel.m_cellYMin - startCell) <= 15 )
+            return true;
+
+        if ( qFuzzyCompare(channel.m_y[reducedEndRange], channel.m_yMin)
+             || qFuzzyCompare(channel.m_y[startCell], channel.m_yMin) )
+            return true;
+    }
+
+    return false;
+}
+
+/* sample range of the leading edge (CF levels) and the peak (PHS) with a margin */
+template <bool bPositiveSignal>
+static inline void interpolationWindow(const DRS4PulseChannelScan& channel, int firstCell, int cellWidth, int *first, int *last)
+{
+    const int cellYExtremum = bPositiveSignal?channel.m_cellYMax:channel.m_cellYMin;
+
+    int firstWindowCell = cellYExtremum - 1;
+    int lastWindowCell = cellYExtremum + 1;
+
+    const int cells[] = { channel.m_estimCFDCellStart, channel.m_estimCFDCellStop,
+                          channel.m_estimCFDCellStart_10perc, channel.m_estimCFDCellStop_10perc,
+                          channel.m_estimCFDCellStart_90perc, channel.m_estimCFDCellStop_90perc };
+
+    for ( int cell : cells ) {
+        if ( cell == -1 )
+            continue;
+
+        firstWindowCell = qMin(firstWindowCell, cell);
+        lastWindowCell = qMax(lastWindowCell, cell);
+    }
+
+    *first = qMax(0, firstWindowCell - firstCell - __ROI_SPLINE_WINDOW_MARGIN);
+    *last = qMin(cellWidth - 1, lastWindowCell - firstCell + __ROI_SPLINE_WINDOW_MARGIN);
+}
+
+/* local extrema of the segment within ]tStart ; tStop[ in ascending order (closed form) - returns the number of extrema */
+static inline int cubicSegmentExtrema(const DRS4CubicSegment& segment, double tStart, double tStop, double *extremaTimes)
+{
+    /* c1 + 2*c2*h + 3*c3*h^2 = 0 */
+    const double a = 3.*segment.m_c[3];
+    const double b = 2.*segment.m_c[2];
+    const double c = segment.m_c[1];
+
+    double extrema[2];
+    int extremaCount = 0;
+
+    if ( qFuzzyIsNull(a) ) {
+        if ( !qFuzzyIsNull(b) )
+            extrema[extremaCount ++] = -c/b;
+    }
+    else {
+        const double discriminant = b*b - 4.*a*c;
+
+        if ( discriminant >= 0. ) {
+            /* numerically stable roots of the quadratic */
+            const double q = -0.5*(b + std::copysign(std::sqrt(discriminant), b));
+
+            extrema[extremaCount ++] = q/a;
+
+            if ( !qFuzzyIsNull(q) )
+                extrema[extremaCount ++] = c/q;
+
+            if ( extremaCount == 2 && extrema[0] > extrema[1] )
+                std::swap(extrema[0], extrema[1]);
+        }
+    }
+
+    int extremaTimesCount = 0;
+
+    for ( int i = 0 ; i < extremaCount ; ++ i ) {
+        const double t = segment.m_t0 + extrema[i];
+
+        if ( t > tStart && t < tStop )
+            extremaTimes[extremaTimesCount ++] = t;
+    }
+
+    return extremaTimesCount;
+}
+
+/* modify min/max to calculate the CF level in high accuracy, subsequently */
+template <bool bPositiveSignal>
+static inline void updateRefinedExtrema(DRS4PulseChannelScan& channel, double t, float valY)
+{
+    if (valY > channel.m_yMax) {
+        channel.m_yMax = valY;
+
+        if (bPositiveSignal)
+            channel.m_timeForYMax = t;
+    }
+
+    if (valY < channel.m_yMin) {
+        channel.m_yMin = valY;
+
+        if (!bPositiveSignal)
+            channel.m_timeForYMax = t;
+    }
+}
+
+/* extrema on the segments of the interpolant within [tStart ; tStop]: the candidates are the bounds of the segments and the roots of
+ * their derivatives - 'false' if the interpolant does not provide its segments */
+template <class Backend, bool bPositiveSignal>
+static inline bool refineExtremaOnSegments(DRS4PulseChannelScan& channel, const Backend& interpolant, double tStart, double tStop)
+{
+    DRS4CubicSegment segments[2];
+    int segmentsCount = 0;
+
+    /* validate all segments before the extrema are modified */
+    for ( double t = tStart ; t < tStop && segmentsCount < 2 ; t = segments[segmentsCount - 1].m_t1 ) {
+        if ( !interpolant.segment(t, &segments[segmentsCount]) )
+            return false;
+
+        /* last segment? */
+        if ( segments[segmentsCount ++].m_t1 <= t )
+            break;
+    }
+
+    if ( !segmentsCount
+         || segments[segmentsCount - 1].m_t1 < tStop )
+        return false;
+
+    for ( int i = 0 ; i < segmentsCount ; ++ i ) {
+        const DRS4CubicSegment& segment = segments[i];
+
+        const double tSegmentStart = qMax(segment.m_t0, tStart);
+        const double tSegmentStop = qMin(segment.m_t1, tStop);
+
+        double extremaTimes[2];
+        const int extremaCount = cubicSegmentExtrema(segment, tSegmentStart, tSegmentStop, extremaTimes);
+
+        updateRefinedExtrema<bPositiveSignal>(channel, tSegmentStart, segment(tSegmentStart));
+
+        for ( int e = 0 ; e < extremaCount ; ++ e )
+            updateRefinedExtrema<bPositiveSignal>(channel, extremaTimes[e], segment(extremaTimes[e]));
+
+        updateRefinedExtrema<bPositiveSignal>(channel, tSegmentStop, segment(tSegmentStop));
+    }
+
+    return true;
+}
+
+/* determine max/min more precisely on the interpolant */
+template <class Backend, bool bPositiveSignal>
+static inline void refineExtrema(DRS4PulseChannelScan& channel, const Backend& interpolant, int intraRenderPoints)
+{
+    const int cellYExtremum = bPositiveSignal?channel.m_cellYMax:channel.m_cellYMin;
+
+    const int cell_interpolRange_start = (cellYExtremum - 1);
+    const int cell_interpolRange_stop = (cellYExtremum + 1);
+
+    /* extremum from the roots of the derivative: independent of the number of intra-render points */
+    if ( Backend::hasSegments
+         && refineExtremaOnSegments<Backend, bPositiveSignal>(channel, interpolant, channel.m_t[cell_interpolRange_start], channel.m_t[cell_interpolRange_stop]) )
+        return;
+
+    const double renderIncrement = (channel.m_t[cell_interpolRange_stop] - channel.m_t[cell_interpolRange_start])/((float)intraRenderPoints);
+
+    for ( int i = 0 ; i <= intraRenderPoints ; ++ i ) {
+        const double t = channel.m_t[cell_interpolRange_start] + (float)i*renderIncrement;
+
+        updateRefinedExtrema<bPositiveSignal>(channel, t, interpolant(t));
+    }
+}
+
+/* first crossing of 'level' within [tStart ; tStop] of the segment: the interval is split at the extrema of the cubic, i.e. each part is
+ * monotone and contains one crossing at most, which is solved by a safeguarded Newton iteration - 'false' if the level is not crossed */
+static inline bool solveCubicCrossing(const DRS4CubicSegment& segment, double level, double tStart, double tStop, double *timeStamp)
+{
+    double bounds[4];
+    int boundsCount = 0;
+
+    bounds[boundsCount ++] = tStart;
+    boundsCount += cubicSegmentExtrema(segment, tStart, tStop, bounds + 1);
+    bounds[boundsCount ++] = tStop;
+
+    for ( int i = 0 ; i < boundsCount - 1 ; ++ i ) {
+        double tLower = bounds[i];
+        double tUpper = bounds[i + 1];
+
+        double fLower = segment(tLower) - level;
+        const double fUpper = segment(tUpper) - level;
+
+        if ( qFuzzyIsNull(fLower) ) {
+            *timeStamp = tLower;
+
+            return true;
+        }
+
+        if ( (fLower < 0.) == (fUpper < 0.) ) {
+            if ( i == boundsCount - 2 && qFuzzyIsNull(fUpper) ) {
+                *timeStamp = tUpper;
+
+                return true;
+            }
+
+            continue;
+        }
+
+        /* start at the linear interpolation between the bounds */
+        double t = tLower - fLower*(tUpper - tLower)/(fUpper - fLower);
+
+        for ( int iteration = 0 ; iteration < __CF_CROSSING_MAX_ITERATIONS ; ++ iteration ) {
+            const double f = segment(t) - level;
+
+            if ( qFuzzyIsNull(f) )
+                break;
+
+            if ( (f < 0.) == (fLower < 0.) ) {
+                tLower = t;
+                fLower = f;
+            }
+            else {
+                tUpper = t;
+            }
+
+            /* Newton step - bisection if the step leaves the bracket */
+            double tNext = t - f/segment.derivative(t);
+
+            if ( !(tNext > tLower && tNext < tUpper) )
+                tNext = 0.5*(tLower + tUpper);
+
+            const bool bConverged = (std::abs(tNext - t) <= __CF_CROSSING_TOLERANCE);
+
+            t = tNext;
+
+            if ( bConverged )
+                break;
+        }
+
+        *timeStamp = t;
+
+        return true;
+    }
+
+    return false;
+}
+
+/* CF crossing on the segments of the interpolant within [tStart ; tStop] - 'false' if the interpolant does not provide its segments */
+template <class Backend>
+static inline bool cfCrossing(const Backend& interpolant, double tStart, double tStop, double level, double *timeStamp)
+{
+    *timeStamp = -1.0f;
+
+    DRS4CubicSegment segment;
+
+    double t = tStart;
+
+    while ( t < tStop ) {
+        if ( !interpolant.segment(t, &segment) )
+            return false;
+
+        if ( solveCubicCrossing(segment, level, t, qMin(segment.m_t1, tStop), timeStamp) )
+            return true;
+
+        /* last segment? */
+        if ( segment.m_t1 <= t )
+            break;
+
+        t = segment.m_t1;
+    }
+
+    return true;
+}
+
+/* find correct CF level timestamp within the estimated CF bracketed index region */
+template <class Backend>
+static inline double cfTimeStamp(const DRS4PulseChannelScan& channel, const Backend& interpolant, int cellStart, int cellStop, float cfdValue, int intraRenderPoints)
+{
+    if ( cellStart == -1 )
+        return -1.0f;
+
+    if ( cellStart == cellStop )
+        return channel.m_t[cellStart];
+
+    if (Backend::isLinear) {
+        const float timeStamp1 = channel.m_t[cellStart];
+        const float timeStamp2 = channel.m_t[cellStop];
+
+        const float valY1 = channel.m_y[cellStart];
+        const float valY2 = channel.m_y[cellStop];
+
+        if ( (cfdValue < valY1 && cfdValue > valY2)
+             || (cfdValue > valY1 && cfdValue < valY2) ) {
+            const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
+            const double intersect = valY1 - slope*timeStamp1;
+
+            return (cfdValue - intersect)/slope;
+        }
+        else if ( qFuzzyCompare(cfdValue, valY1) ) {
+            return timeStamp1;
+        }
+        else if ( qFuzzyCompare(cfdValue, valY2) ) {
+            return timeStamp2;
+        }
+
+        return -1.0f;
+    }
+
+    /* solve on the bracketing segment: independent of the number of intra-render points */
+    if (Backend::hasSegments) {
+        double timeStamp = -1.0f;
+
+        if ( cfCrossing<Backend>(interpolant, channel.m_t[cellStart], channel.m_t[cellStop], cfdValue, &timeStamp) )
+            return timeStamp;
+    }
+
+    const double timeIncr = (channel.m_t[cellStop] - channel.m_t[cellStart])/((double)intraRenderPoints);
+
+    for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
+        const double timeStamp1 = channel.m_t[cellStart] + (double)i*timeIncr;
+        const double timeStamp2 = channel.m_t[cellStart] + (double)(i+1)*timeIncr;
+
+        const float valY1 = interpolant(timeStamp1);
+        const float valY2 = interpolant(timeStamp2);
+
+        if ( (cfdValue < valY1 && cfdValue > valY2)
+             || (cfdValue > valY1 && cfdValue < valY2) ) {
+            const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
+            const double intersect = valY1 - slope*timeStamp1;
+
+            return (cfdValue - intersect)/slope;
+        }
+        else if ( qFuzzyCompare(cfdValue, valY1) ) {
+            return timeStamp1;
+        }
+        else if ( qFuzzyCompare(cfdValue, valY2) ) {
+            return timeStamp2;
+        }
+    }
+
+    return -1.0f;
+}
+
+/* 10% and 90% timestamps of the leading edge in one pass: the brackets are adjacent cells, i.e. both levels are solved analytically on
+ * the segment spanning their bracket. The segment of the 10% level is reused for the 90% level if it spans both brackets. Brackets on
+ * a single cell, segment-less backends and segments not spanning the bracket are left to cfTimeStamp(). */
+template <class Backend>
+static inline void riseTimeStamps(DRS4PulseChannelScan& channel, const Backend& interpolant, int intraRenderPoints)
+{
+    const int cellStart10 = channel.m_estimCFDCellStart_10perc;
+    const int cellStop10 = channel.m_estimCFDCellStop_10perc;
+    const int cellStart90 = channel.m_estimCFDCellStart_90perc;
+    const int cellStop90 = channel.m_estimCFDCellStop_90perc;
+
+    channel.m_bRiseTime = true;
+
+    if (Backend::hasSegments
+            && cellStart10 != -1 && cellStart10 != cellStop10
+            && cellStart90 != -1 && cellStart90 != cellStop90) {
+        const double tStart10 = channel.m_t[cellStart10];
+        const double tStop10 = channel.m_t[cellStop10];
+
+        const double tStart90 = channel.m_t[cellStart90];
+        const double tStop90 = channel.m_t[cellStop90];
+
+        DRS4CubicSegment segment;
+
+        if ( interpolant.segment(tStart10, &segment)
+             && segment.m_t1 >= tStop10 ) {
+            double timeStamp10 = -1.0f;
+
+            solveCubicCrossing(segment, channel.m_cfdValue_10perc, tStart10, tStop10, &timeStamp10);
+
+            const bool bSameSegment = (tStart90 >= segment.m_t0 && tStop90 <= segment.m_t1);
+
+            if ( bSameSegment
+                 || (interpolant.segment(tStart90, &segment) && segment.m_t1 >= tStop90) ) {
+                double timeStamp90 = -1.0f;
+
+                solveCubicCrossing(segment, channel.m_cfdValue_90perc, tStart90, tStop90, &timeStamp90);
+
+                channel.m_timeStamp_10perc = timeStamp10;
+                channel.m_timeStamp_90perc = timeStamp90;
+
+                return;
+            }
+        }
+    }
+
+    channel.m_timeStamp_10perc = cfTimeStamp<Backend>(channel, interpolant, cellStart10, cellStop10, channel.m_cfdValue_10perc, intraRenderPoints);
+    channel.m_timeStamp_90perc = cfTimeStamp<Backend>(channel, interpolant, cellStart90, cellStop90, channel.m_cfdValue_90perc, intraRenderPoints);
+}
+
+/* CF levels valid? */
+template <bool bPositiveSignal>
+static inline bool isValidCFLevel(const DRS4PulseChannelScan& channel)
+{
+    if (bPositiveSignal) {
+        return !( channel.m_cfdValue > 500.0f
+                  || qFuzzyCompare(channel.m_cfdValue, 0.0f)
+                  || channel.m_cfdValue < 0.0f
+                  || ((int)channel.m_cfdValue == (int)channel.m_yMax) );
+    }
+
+    return !( channel.m_cfdValue < -500.0f
+              || qFuzzyCompare(channel.m_cfdValue, 0.0f)
+              || channel.m_cfdValue > 0.0f
+              || ((int)channel.m_cfdValue == (int)channel.m_yMin) );
+}
+
+DRS4PulsePairKernel::DRS4PulsePairKernel() :
+    m_interpolationType(DRS4InterpolationType::type::spline),
+    m_splineInterpolationType(DRS4SplineInterpolationType::type::cubic),
+    m_positiveSignal(false),
+    m_startCell(0),
+    m_endRange(kNumberOfBins),
+    m_cellWidth(kNumberOfBins),
+    m_sweep(0.0f),
+    m_bPulseArea(false),
+    m_pulseAreaFilterNormA(1.),
+    m_pulseAreaFilterNormB(1.),
+    m_intraRenderPoints(1)
+{
+    selectOps<DRS4InterpolationBackendALGLIBSpline>(m_positiveSignal);
+}
+
+void DRS4PulsePairKernel::select(DRS4InterpolationType::type interpolationType, DRS4SplineInterpolationType::type splineInterpolationType, bool bPositiveSignal)
+{
+    if ( m_interpolationType == interpolationType
+         && m_splineInterpolationType == splineInterpolationType
+         && m_positiveSignal == bPositiveSignal )
+        return;
+
+    m_interpolationType = interpolationType;
+    m_splineInterpolationType = splineInterpolationType;
+    m_positiveSignal = bPositiveSignal;
+
+    if (interpolationType != DRS4InterpolationType::type::spline) {
+        selectOps<DRS4InterpolationBackendBarycentric>(bPositiveSignal);
+
+        return;
+    }
+
+    switch (splineInterpolationType) {
+    case DRS4SplineInterpolationType::type::linear: {
+        selectOps<DRS4InterpolationBackendLinear>(bPositiveSignal);
+    }
+        break;
+    case DRS4SplineInterpolationType::type::tk_cubic: {
+        selectOps<DRS4InterpolationBackendTinoKluge>(bPositiveSignal);
+    }
+        break;
+    case DRS4SplineInterpolationType::type::roi_cubic: {
+        selectOps<DRS4InterpolationBackendROISpline>(bPositiveSignal);
+    }
+        break;
+    default: {
+        backends<DRS4InterpolationBackendALGLIBSpline>()->m_backendA.m_type = splineInterpolationType;
+        backends<DRS4InterpolationBackendALGLIBSpline>()->m_backendB.m_type = splineInterpolationType;
+
+        selectOps<DRS4InterpolationBackendALGLIBSpline>(bPositiveSignal);
+    }
+        break;
+    }
+}
+
+template <class Backend>
+void DRS4PulsePairKernel::selectOps(bool bPositiveSignal)
+{
+    if (bPositiveSignal) {
+        m_ops.scan = &DRS4PulsePairKernel::scanStage<Backend, true>;
+        m_ops.interpolate = &DRS4PulsePairKernel::interpolateStage<Backend, true>;
+        m_ops.refine = &DRS4PulsePairKernel::refineStage<Backend, true>;
+        m_ops.timeStamps = &DRS4PulsePairKernel::timeStampsStage<Backend, true>;
+    }
+    else {
+        m_ops.scan = &DRS4PulsePairKernel::scanStage<Backend, false>;
+        m_ops.interpolate = &DRS4PulsePairKernel::interpolateStage<Backend, false>;
+        m_ops.refine = &DRS4PulsePairKernel::refineStage<Backend, false>;
+        m_ops.timeStamps = &DRS4PulsePairKernel::timeStampsStage<Backend, false>;
+    }
+
+    m_ops.riseTimes = &DRS4PulsePairKernel::riseTimesStage<Backend>;
+
+    m_ops.evaluateA = &DRS4PulsePairKernel::evaluateInterpolantA<Backend>;
+    m_ops.evaluateB = &DRS4PulsePairKernel::evaluateInterpolantB<Backend>;
+}
+
+template <class Backend, bool bPositiveSignal>
+bool DRS4PulsePairKernel::scanStage(DRS4PulsePairKernel *kernel)
+{
+    DRS4InterpolationBackendPair<Backend> *backends = kernel->backends<Backend>();
+
+    DRS4PulseChannelScan& channelA = kernel->m_channelA;
+    DRS4PulseChannelScan& channelB = kernel->m_channelB;
+
+    backends->m_backendA.resize(kernel->m_cellWidth);
+    backends->m_backendB.resize(kernel->m_cellWidth);
+
+    channelA.reset(kernel->m_sweep);
+    channelB.reset(kernel->m_sweep);
+
+    const int reducedEndRange = (kernel->m_endRange - 1);
+    const int reducedCellWidth = (kernel->m_cellWidth - 1);
+
+    /* determine min/max, the pulse area and the finiteness of the slopes in ROI */
+    const bool bFiniteA = scanFeatures(channelA, kernel->m_startCell, reducedEndRange, kernel->m_bPulseArea);
+    const bool bFiniteB = scanFeatures(channelB, kernel->m_startCell, reducedEndRange, kernel->m_bPulseArea);
+
+    if ( !bFiniteA || !bFiniteB )
+        return false;
+
+    /* min/max was not able to be determined */
+    if (channelA.m_cellYMax == -1
+            || channelA.m_cellYMin == -1
+            || channelB.m_cellYMax == -1
+            || channelB.m_cellYMin == -1
+            || qFuzzyCompare(channelA.m_yMin, channelA.m_yMax)
+            || qFuzzyCompare(channelB.m_yMin, channelB.m_yMax)
+            || (((int)channelA.m_yMin == (int)channelA.m_yMax) || ((int)channelB.m_yMin == (int)channelB.m_yMax)))
+        return false;
+
+    /* CF estimation on the leading edge */
+    estimateCFLevels<bPositiveSignal>(channelA, kernel->m_startCell);
+    estimateCFLevels<bPositiveSignal>(channelB, kernel->m_startCell);
+
+    const float *tA = channelA.m_t;
+    const float *yA = channelA.m_y;
+    const float *tB = channelB.m_t;
+    const float *yB = channelB.m_y;
+
+    for ( int a = reducedEndRange, it = reducedCellWidth ; a >= kernel->m_startCell ; -- a, -- it ) {
+        backends->m_backendA.setSample(it, tA[a], yA[a]);
+        backends->m_backendB.setSample(it, tB[a], yB[a]);
+    }
+
+    return true;
+}
+
+template <class Backend, bool bPositiveSignal>
+bool DRS4PulsePairKernel::interpolateStage(DRS4PulsePairKernel *kernel)
+{
+    DRS4PulseChannelScan& channelA = kernel->m_channelA;
+    DRS4PulseChannelScan& channelB = kernel->m_channelB;
+
+    const int reducedEndRange = (kernel->m_endRange - 1);
+
+    /* light-weight filtering of wrong events: */
+    if ( isWrongEvent<bPositiveSignal>(channelA, kernel->m_startCell, reducedEndRange)
+         || isWrongEvent<bPositiveSignal>(channelB, kernel->m_startCell, reducedEndRange) )
+        return false;
+
+    /* reject artifacts */
+    if ( channelB.m_cfdCounter > 1 || channelB.m_cfdCounter == 0
+         || channelA.m_cfdCounter > 1 || channelA.m_cfdCounter == 0 )
+        return false;
+
+    /* obtain interpolant */
+    DRS4InterpolationBackendPair<Backend> *backends = kernel->backends<Backend>();
+
+    /* cell of the first sample */
+    const int firstCell = kernel->m_endRange - kernel->m_cellWidth;
+
+    int first = 0, last = 0;
+
+    interpolationWindow<bPositiveSignal>(channelA, firstCell, kernel->m_cellWidth, &first, &last);
+    backends->m_backendA.setWindow(first, last);
+
+    interpolationWindow<bPositiveSignal>(channelB, firstCell, kernel->m_cellWidth, &first, &last);
+    backends->m_backendB.setWindow(first, last);
+
+    backends->m_backendA.build();
+    backends->m_backendB.build();
+
+    /* calculate and normalize pulse area for subsequent area filtering */
+    if (kernel->m_bPulseArea) {
+        const float rat = 5120*((float)kernel->m_cellWidth/((float)kNumberOfBins));
+
+        channelA.m_area = channelA.m_area/(kernel->m_pulseAreaFilterNormA*rat);
+        channelB.m_area = channelB.m_area/(kernel->m_pulseAreaFilterNormB*rat);
+    }
+
+    if (bPositiveSignal) {
+        channelA.m_timeForYMax = channelA.m_t[channelA.m_cellYMax];
+        channelB.m_timeForYMax = channelB.m_t[channelB.m_cellYMax];
+    }
+    else {
+        channelA.m_timeForYMax = channelA.m_t[channelA.m_cellYMin];
+        channelB.m_timeForYMax = channelB.m_t[channelB.m_cellYMin];
+    }
+
+    if (qFuzzyCompare(channelA.m_timeForYMax, -1)
+            || qFuzzyCompare(channelB.m_timeForYMax, -1))
+        return false;
+
+    return true;
+}
+
+template <class Backend, bool bPositiveSignal>
+bool DRS4PulsePairKernel::refineStage(DRS4PulsePairKernel *kernel)
+{
+    DRS4PulseChannelScan& channelA = kernel->m_channelA;
+    DRS4PulseChannelScan& channelB = kernel->m_channelB;
+
+    if (!Backend::isLinear) {
+        const DRS4InterpolationBackendPair<Backend> *backends = kernel->backends<Backend>();
+
+        const int cellYExtremumA = bPositiveSignal?channelA.m_cellYMax:channelA.m_cellYMin;
+        const int cellYExtremumB = bPositiveSignal?channelB.m_cellYMax:channelB.m_cellYMin;
+
+        if ( !(cellYExtremumA - 1 >= 0 && cellYExtremumA + 1 < kNumberOfBins)
+             || !(cellYExtremumB - 1 >= 0 && cellYExtremumB + 1 < kNumberOfBins) )
+            return false;
+
+        refineExtrema<Backend, bPositiveSignal>(channelA, backends->m_backendA, kernel->m_intraRenderPoints);
+        refineExtrema<Backend, bPositiveSignal>(channelB, backends->m_backendB, kernel->m_intraRenderPoints);
+    }
+
+    /* cells of the (interpolated/fitted) pulse heights in the PHS */
+    const double fkNumberOfBins = (double)kNumberOfBins;
+
+    const float fractPHSA = bPositiveSignal?(channelA.m_yMax*0.002):(std::abs(channelA.m_yMin)*0.002);
+    const float fractPHSB = bPositiveSignal?(channelB.m_yMax*0.002):(std::abs(channelB.m_yMin)*0.002);
+
+    channelA.m_cellPHS = ((int)(fractPHSA*fkNumberOfBins))-1;
+    channelB.m_cellPHS = ((int)(fractPHSB*fkNumberOfBins))-1;
+
+    return true;
+}
+
+template <class Backend, bool bPositiveSignal>
+bool DRS4PulsePairKernel::timeStampsStage(DRS4PulsePairKernel *kernel)
+{
+    DRS4PulseChannelScan& channelA = kernel->m_channelA;
+    DRS4PulseChannelScan& channelB = kernel->m_channelB;
+
+    /* CF levels valid? */
+    if (channelA.m_estimCFDCellStart == -1
+        || channelA.m_estimCFDCellStop == -1
+        || channelB.m_estimCFDCellStart == -1
+        || channelB.m_estimCFDCellStop == -1)
+        return false;
+
+    if ( !isValidCFLevel<bPositiveSignal>(channelA)
+         || !isValidCFLevel<bPositiveSignal>(channelB) )
+        return false;
+
+    const DRS4InterpolationBackendPair<Backend> *backends = kernel->backends<Backend>();
+    const int intraRenderPoints = kernel->m_intraRenderPoints;
+
+    channelA.m_timeStamp = cfTimeStamp<Backend>(channelA, backends->m_backendA, channelA.m_estimCFDCellStart, channelA.m_estimCFDCellStop, channelA.m_cfdValue, intraRenderPoints);
+    channelB.m_timeStamp = cfTimeStamp<Backend>(channelB, backends->m_backendB, channelB.m_estimCFDCellStart, channelB.m_estimCFDCellStop, channelB.m_cfdValue, intraRenderPoints);
+
+    return true;
+}
+
+template <class Backend>
+void DRS4PulsePairKernel::riseTimesStage(DRS4PulsePairKernel *kernel, bool bChannelA, bool bChannelB)
+{
+    const DRS4InterpolationBackendPair<Backend> *backends = kernel->backends<Backend>();
+    const int intraRenderPoints = kernel->m_intraRenderPoints;
+
+    if ( bChannelA && !kernel->m_channelA.m_bRiseTime )
+        riseTimeStamps<Backend>(kernel->m_channelA, backends->m_backendA, intraRenderPoints);
+
+    if ( bChannelB && !kernel->m_channelB.m_bRiseTime )
+        riseTimeStamps<Backend>(kernel->m_channelB, backends->m_backendB, intraRenderPoints);
+}
+
+template <class Backend>
+double DRS4PulsePairKernel::evaluateInterpolantA(const DRS4PulsePairKernel *kernel, double t)
+{
+    return kernel->backends<Backend>()->m_backendA(t);
+}
+
+template <class Backend>
+double DRS4PulsePairKernel::evaluateInterpolantB(const DRS4PulsePairKernel *kernel, double t)
+{
+    return kernel->backends<Backend>()->m_backendB(t);
+}
@@ -0,0 +1,524 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DRS4PULSEPAIRKERNEL_H
+#define DRS4PULSEPAIRKERNEL_H
+
+#include <QtGlobal>
+
+#include <vector>
+#include <cmath>
+
+#include "alglib.h"
+#include "DLib.h"
+
+#include "drs4boardmanager.h"
+#include "drs4settingsmanager.h"
+
+#include "Fit/dspline.h"
+#include "Fit/droispline.h"
+
+#include "drs4hotpathtiming.h"
+
+#define __CF_CROSSING_MAX_ITERATIONS 16 // [#] safeguarded Newton iterations
+#define __CF_CROSSING_TOLERANCE 1E-7 // [ns]
+
+#define __ROI_SPLINE_WINDOW_MARGIN 8 // [#] cells around the leading edge and the peak
+
+#define __PULSE_SCAN_LANES 8 // [#] independent lanes of the fused ROI scan
+
+/* polynomial of one segment [t0 ; t1] of a piecewise interpolant: y(t) = c0 + c1*(t - t0) + c2*(t - t0)^2 + c3*(t - t0)^3 */
+class DRS4CubicSegment final {
+public:
+    double m_t0, m_t1;
+    double m_c[4];
+
+    inline double operator()(double t) const {
+        const double h = t - m_t0;
+
+        return m_c[0] + h*(m_c[1] + h*(m_c[2] + h*m_c[3]));
+    }
+
+    inline double derivative(double t) const {
+        const double h = t - m_t0;
+
+        return m_c[1] + h*(2.*m_c[2] + h*3.*m_c[3]);
+    }
+};
+
+/* interpolation backends of the pulse-pair kernel: resize(), setSample(), build() and operator()
+ *
+ * piecewise polynomial backends (hasSegments) provide the coefficients of the segment containing 't' by segment(), which
+ * allows to solve for the CF crossings directly instead of sampling the interpolant.
+ *
+ * setWindow() passes the sample range used for the CF levels and the PHS before build(): only the ROI backend makes use of it. */
+class DRS4InterpolationBackendALGLIBSpline final {
+    alglib::real_1d_array m_x, m_y;
+    alglib::spline1dinterpolant m_interpolant;
+
+public:
+    static const bool isLinear = false;
+
+    inline void setWindow(int, int) {}
+
+    DRS4SplineInterpolationType::type m_type;
+
+    DRS4InterpolationBackendALGLIBSpline() :
+        m_type(DRS4SplineInterpolationType::type::cubic) {}
+
+    inline void resize(int size) {
+        if ( m_x.length() == size )
+            return;
+
+        m_x.setlength(size);
+        m_y.setlength(size);
+    }
+
+    inline void setSample(int index, double x, double y) {
+        m_x.ptr->ptr.p_double[index] = x;
+        m_y.ptr->ptr.p_double[index] = y;
+    }
+
+    void build();
+
+    inline double operator()(double x) const {
+        return alglib::spline1dcalc(m_interpolant, x);
+    }
+
+    static const bool hasSegments = true;
+
+    /* all spline types of ALGLIB are stored as cubic Hermite segments with the coefficients c[4*i ... 4*i + 3] */
+    inline bool segment(double t, DRS4CubicSegment *segment) const {
+        const alglib_impl::spline1dinterpolant *interpolant = m_interpolant.c_ptr();
+
+        const int n = int(interpolant->n);
+        const double *x = interpolant->x.ptr.p_double;
+
+        if ( n < 2
+             || interpolant->k != 3
+             || interpolant->periodic
+             || t < x[0]
+             || t > x[n - 1] )
+            return false;
+
+        /* binary search of the segment x[l] <= t < x[l + 1] */
+        int l = 0;
+        int r = n - 1;
+
+        while ( l != r - 1 ) {
+            const int m = (l + r)/2;
+
+            if ( x[m] > t )
+                r = m;
+            else
+                l = m;
+        }
+
+        const double *c = interpolant->c.ptr.p_double + 4*l;
+
+        segment->m_t0 = x[l];
+        segment->m_t1 = x[l + 1];
+
+        segment->m_c[0] = c[0];
+        segment->m_c[1] = c[1];
+        segment->m_c[2] = c[2];
+        segment->m_c[3] = c[3];
+
+        return true;
+    }
+};
+
+class DRS4InterpolationBackendTinoKluge final {
+    std::vector<double> m_x, m_y;
+    DSpline m_spline;
+
+public:
+    static const bool isLinear = false;
+
+    inline void setWindow(int, int) {}
+
+    inline void resize(int size) {
+        m_x.resize(size);
+        m_y.resize(size);
+    }
+
+    inline void setSample(int index, double x, double y) {
+        m_x[index] = x;
+        m_y[index] = y;
+    }
+
+    inline void build() {
+        m_spline.setType(SplineType::Cubic);
+        m_spline.setPoints(m_x, m_y);
+    }
+
+    inline double operator()(double x) const {
+        return m_spline(x);
+    }
+
+    static const bool hasSegments = true;
+
+    inline bool segment(double t, DRS4CubicSegment *segment) const {
+        return m_spline.segment(t, &segment->m_t0, &segment->m_t1, segment->m_c);
+    }
+};
+
+class DRS4InterpolationBackendBarycentric final {
+    alglib::real_1d_array m_x, m_y;
+    alglib::barycentricinterpolant m_interpolant;
+
+public:
+    static const bool isLinear = false;
+
+    inline void setWindow(int, int) {}
+
+    inline void resize(int size) {
+        if ( m_x.length() == size )
+            return;
+
+        m_x.setlength(size);
+        m_y.setlength(size);
+    }
+
+    inline void setSample(int index, double x, double y) {
+        m_x.ptr->ptr.p_double[index] = x;
+        m_y.ptr->ptr.p_double[index] = y;
+    }
+
+    inline void build() {
+        alglib::polynomialbuild(m_x, m_y, m_interpolant);
+    }
+
+    inline double operator()(double x) const {
+        return alglib::barycentriccalc(m_interpolant, x);
+    }
+
+    /* global polynomial: the CF crossings are searched by sampling */
+    static const bool hasSegments = false;
+
+    inline bool segment(double, DRS4CubicSegment*) const {
+        return false;
+    }
+};
+
+/* no interpolant: the CF levels are obtained by linear interpolation between the samples */
+class DRS4InterpolationBackendLinear final {
+public:
+    static const bool isLinear = true;
+
+    inline void setWindow(int, int) {}
+
+    inline void resize(int) {}
+    inline void setSample(int, double, double) {}
+    inline void build() {}
+
+    inline double operator()(double) const {
+        return 0.0;
+    }
+
+    static const bool hasSegments = false;
+
+    inline bool segment(double, DRS4CubicSegment*) const {
+        return false;
+    }
+};
+
+/* in-tree natural cubic spline over the leading edge and the peak only: float precision and fixed-capacity buffers */
+class DRS4InterpolationBackendROISpline final {
+    DROICubicSpline<float, kNumberOfBins> m_spline;
+
+    int m_first, m_last;
+
+public:
+    static const bool isLinear = false;
+
+    DRS4InterpolationBackendROISpline() :
+        m_first(0),
+        m_last(kNumberOfBins - 1) {}
+
+    inline void setWindow(int first, int last) {
+        m_first = first;
+        m_last = last;
+    }
+
+    inline void resize(int size) {
+        m_spline.resize(size);
+    }
+
+    inline void setSample(int index, double x, double y) {
+        m_spline.setSample(index, float(x), float(y));
+    }
+
+    inline void build() {
+        m_spline.build(m_first, m_last);
+    }
+
+    inline double operator()(double x) const {
+        return m_spline(x);
+    }
+
+    static const bool hasSegments = true;
+
+    inline bool segment(double t, DRS4CubicSegment *segment) const {
+        return m_spline.segment(t, &segment->m_t0, &segment->m_t1, segment->m_c);
+    }
+};
+
+template <class Backend>
+class DRS4InterpolationBackendPair {
+public:
+    Backend m_backendA;
+    Backend m_backendB;
+};
+
+/* feature record of one channel within the ROI: filled by a single fused scan of the waveform, the subsequent stages (artifact filter,
+ * interpolation window, PHS, CF levels and rise-time) consume the record instead of re-reading the waveform */
+class DRS4PulseChannelScan final {
+public:
+    /* waveform of the event (not owned) */
+    const float *m_t;
+    const float *m_y;
+
+    double m_cfdLevel;
+
+    /* time and voltage extrema */
+    float m_xMin, m_xMax;
+    float m_yMin, m_yMax;
+
+    int m_cellYMin, m_cellYMax;
+
+    /* CF levels (CFD, 10% and 90% >> rise-time) */
+    float m_cfdValue;
+    float m_cfdValue_10perc;
+    float m_cfdValue_90perc;
+
+    int m_estimCFDCellStart, m_estimCFDCellStop;
+    int m_estimCFDCellStart_10perc, m_estimCFDCellStop_10perc;
+    int m_estimCFDCellStart_90perc, m_estimCFDCellStop_90perc;
+
+    int m_cfdCounter;
+
+    float m_area;
+
+    /* results */
+    double m_timeForYMax;
+
+    int m_cellPHS;
+
+    double m_timeStamp;
+    double m_timeStamp_10perc;
+    double m_timeStamp_90perc;
+
+    bool m_bRiseTime; /* 10% and 90% timestamps computed? */
+
+    DRS4PulseChannelScan() :
+        m_t(DNULLPTR),
+        m_y(DNULLPTR),
+        m_cfdLevel(0.) {
+        reset(0.0f);
+    }
+
+    void reset(float sweep);
+};
+
+class DRS4PulsePairKernel;
+
+typedef struct {
+    bool (*scan)(DRS4PulsePairKernel *kernel);
+    bool (*interpolate)(DRS4PulsePairKernel *kernel);
+    bool (*refine)(DRS4PulsePairKernel *kernel);
+    bool (*timeStamps)(DRS4PulsePairKernel *kernel);
+    void (*riseTimes)(DRS4PulsePairKernel *kernel, bool bChannelA, bool bChannelB);
+
+    double (*evaluateA)(const DRS4PulsePairKernel *kernel, double t);
+    double (*evaluateB)(const DRS4PulsePairKernel *kernel, double t);
+} DRS4PulsePairKernelOps;
+
+/* CFD/PHS/area/rise-time analysis of a pulse pair shared by the single- and the multi-threaded acquisition:
+ *
+ * the stages are instantiated at compile time for each interpolation backend and signal polarity. select() picks the instantiation once per config,
+ * i.e. the sample loops are free of any dispatch on the interpolation type or the polarity. The stages run in the order
+ *
+ * scan() >> interpolate() >> refine() >> timeStamps() [>> riseTimes()]
+ *
+ * and return 'false' if the event has to be rejected. riseTimes() is evaluated on demand, i.e. only for the channels whose rise-time is
+ * required by the spectra or the rise-time filter. */
+class DRS4PulsePairKernel final : private DRS4InterpolationBackendPair<DRS4InterpolationBackendALGLIBSpline>,
+                                  private DRS4InterpolationBackendPair<DRS4InterpolationBackendTinoKluge>,
+                                  private DRS4InterpolationBackendPair<DRS4InterpolationBackendBarycentric>,
+                                  private DRS4InterpolationBackendPair<DRS4InterpolationBackendROISpline>,
+                                  private DRS4InterpolationBackendPair<DRS4InterpolationBackendLinear>
+{
+    DRS4PulsePairKernelOps m_ops;
+
+    DRS4InterpolationType::type m_interpolationType;
+    DRS4SplineInterpolationType::type m_splineInterpolationType;
+    bool m_positiveSignal;
+
+    template <class Backend>
+    inline DRS4InterpolationBackendPair<Backend> *backends() {
+        return static_cast<DRS4InterpolationBackendPair<Backend>*>(this);
+    }
+
+    template <class Backend>
+    inline const DRS4InterpolationBackendPair<Backend> *backends() const {
+        return static_cast<const DRS4InterpolationBackendPair<Backend>*>(this);
+    }
+
+    template <class Backend, bool bPositiveSignal>
+    static bool scanStage(DRS4PulsePairKernel *kernel);
+
+    template <class Backend, bool bPositiveSignal>
+    static bool interpolateStage(DRS4PulsePairKernel *kernel);
+
+    template <class Backend, bool bPositiveSignal>
+    static bool refineStage(DRS4PulsePairKernel *kernel);
+
+    template <class Backend, bool bPositiveSignal>
+    static bool timeStampsStage(DRS4PulsePairKernel *kernel);
+
+    template <class Backend>
+    static void riseTimesStage(DRS4PulsePairKernel *kernel, bool bChannelA, bool bChannelB);
+
+    template <class Backend>
+    static double evaluateInterpolantA(const DRS4PulsePairKernel *kernel, double t);
+
+    template <class Backend>
+    static double evaluateInterpolantB(const DRS4PulsePairKernel *kernel, double t);
+
+    template <class Backend>
+    void selectOps(bool bPositiveSignal);
+
+public:
+    /* ROI */
+    int m_startCell;
+    int m_endRange;
+    int m_cellWidth;
+
+    float m_sweep;
+
+    /* pulse area */
+    bool m_bPulseArea;
+    double m_pulseAreaFilterNormA;
+    double m_pulseAreaFilterNormB;
+
+    int m_intraRenderPoints;
+
+    DRS4PulseChannelScan m_channelA;
+    DRS4PulseChannelScan m_channelB;
+
+    DRS4PulsePairKernel();
+
+    /* selects the instantiation of the stages: only if the interpolation type or the polarity has changed */
+    void select(DRS4InterpolationType::type interpolationType, DRS4SplineInterpolationType::type splineInterpolationType, bool bPositiveSignal);
+
+    inline bool isLinear() const {
+        return (m_interpolationType == DRS4InterpolationType::type::spline
+                && m_splineInterpolationType == DRS4SplineInterpolationType::type::linear);
+    }
+
+    inline void setWaveforms(const float *tChannelA, const float *waveChannelA, const float *tChannelB, const float *waveChannelB) {
+        m_channelA.m_t = tChannelA;
+        m_channelA.m_y = waveChannelA;
+
+        m_channelB.m_t = tChannelB;
+        m_channelB.m_y = waveChannelB;
+    }
+
+    /* ROI scan: extrema, CF cells and pulse area - 'false' if the extrema cannot be determined or a slope is not finite */
+    inline bool scan() {
+        DRS4HotPathStageTimer timer(DRS4HotPathStage::scan);
+
+        return m_ops.scan(this);
+    }
+
+    /* light-weight filtering of wrong events and artifacts, interpolation and pulse area normalization */
+    inline bool interpolate() {
+        DRS4HotPathStageTimer timer(DRS4HotPathStage::interpolation);
+
+        return m_ops.interpolate(this);
+    }
+
+    /* extrema on the interpolant and the cells of the PHS */
+    inline bool refine() {
+        DRS4HotPathStageTimer timer(DRS4HotPathStage::refine);
+
+        return m_ops.refine(this);
+    }
+
+    /* validity of the CF levels and the CFD timestamps */
+    inline bool timeStamps() {
+        DRS4HotPathStageTimer timer(DRS4HotPathStage::cfd);
+
+        return m_ops.timeStamps(this);
+    }
+
+    /* 10% and 90% timestamps (rise-time) of the requested channels (valid after timeStamps()): computed once per event */
+    inline void riseTimes(bool bChannelA, bool bChannelB) {
+        DRS4HotPathStageTimer timer(DRS4HotPathStage::riseTime);
+
+        m_ops.riseTimes(this, bChannelA, bChannelB);
+    }
+
+    /* interpolants (valid after interpolate()) */
+    inline double evaluateA(double t) const {
+        return m_ops.evaluateA(this, t);
+    }
+
+    inline double evaluateB(double t) const {
+        return m_ops.evaluateB(this, t);
+    }
+};
+
+#endif // DRS4PULSEPAIRKERNEL_H
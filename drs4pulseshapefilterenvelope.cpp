@@ -0,0 +1,186 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#include <cmath>
+#include <algorithm>
+
+#include "drs4pulseshapefilterenvelope.h"
+
+DRS4PulseShapeFilterEnvelope::DRS4PulseShapeFilterEnvelope() :
+    m_bValid(false),
+    m_leftOfRef(0.),
+    m_rightOfRef(0.),
+    m_step(1.),
+    m_invStep(1.)
+{
+    std::fill(m_lower, m_lower + __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE, 0.0f);
+    std::fill(m_upper, m_upper + __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE, 0.0f);
+}
+
+void DRS4PulseShapeFilterEnvelope::build(const DSpline &meanSpline, const DSpline &stddevSpline, bool bValid, double leftOfRefInNs, double rightOfRefInNs, double lowerFraction, double upperFraction)
+{
+    m_bValid = bValid;
+
+    m_leftOfRef = -leftOfRefInNs;
+    m_rightOfRef = rightOfRefInNs;
+
+    const double range = (m_rightOfRef - m_leftOfRef);
+
+    m_step = (range > 0.)?(range/(double)(__PULSESHAPEFILTER_ENVELOPE_LUT_SIZE - 1)):1.;
+    m_invStep = 1./m_step;
+
+    if (!m_bValid) {
+        std::fill(m_lower, m_lower + __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE, 0.0f);
+        std::fill(m_upper, m_upper + __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE, 0.0f);
+
+        return;
+    }
+
+    for (int i = 0 ; i < __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE ; ++ i) {
+        const double t = m_leftOfRef + (double)i*m_step;
+
+        const double mean = meanSpline(t);
+        const double stddev = stddevSpline(t);
+
+        m_lower[i] = (float)(mean - lowerFraction*stddev);
+        m_upper[i] = (float)(mean + upperFraction*stddev);
+    }
+}
+
+bool DRS4PulseShapeFilterEnvelope::isInside(double t, float y) const
+{
+    if (t < m_leftOfRef || t > m_rightOfRef)
+        return true;
+
+    if (!m_bValid)
+        return false;
+
+    const double pos = (t - m_leftOfRef)*m_invStep;
+    const int index = std::min((int)pos, __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE - 2);
+    const float frac = (float)(pos - (double)index);
+
+    const float lower = m_lower[index] + frac*(m_lower[index + 1] - m_lower[index]);
+    const float upper = m_upper[index] + frac*(m_upper[index + 1] - m_upper[index]);
+
+    return (y <= upper) && (y >= lower);
+}
+
+int DRS4PulseShapeFilterEnvelope::firstReject(const float *time, const float *wave, int limit, double timeRef, float yScale) const
+{
+    if (!time || !wave)
+        return limit;
+
+    const int lastIndex = (__PULSESHAPEFILTER_ENVELOPE_LUT_SIZE - 2);
+    const float invalid = m_bValid?0.0f:1.0f;
+
+    /* the time axis is ascending: only the cells covering the ROI are visited */
+    const int firstCell = (int)(std::lower_bound(time, time + limit, (float)(timeRef + m_leftOfRef)) - time);
+    const int lastCell = std::min(limit, (int)(std::upper_bound(time, time + limit, (float)(timeRef + m_rightOfRef)) - time) + 1);
+
+    for (int first = std::max(0, firstCell - 1) ; first < lastCell ; first += __PULSESHAPEFILTER_ENVELOPE_BLOCK) {
+        const int n = std::min(__PULSESHAPEFILTER_ENVELOPE_BLOCK, lastCell - first);
+
+        int reject[__PULSESHAPEFILTER_ENVELOPE_BLOCK];
+        int anyReject = 0;
+
+        /* branch-free within the block: samples outside the ROI are clamped to the table and masked afterwards */
+        for (int k = 0 ; k < n ; ++ k) {
+            const double t = (double)time[first + k] - timeRef;
+            const float y = wave[first + k]*yScale;
+
+            const int inROI = (t >= m_leftOfRef) & (t <= m_rightOfRef);
+
+            const double pos = std::max(0., std::min((t - m_leftOfRef)*m_invStep, (double)(lastIndex + 1)));
+            const int index = std::min((int)pos, lastIndex);
+            const float frac = (float)(pos - (double)index);
+
+            const float lower = m_lower[index] + frac*(m_lower[index + 1] - m_lower[index]);
+            const float upper = m_upper[index] + frac*(m_upper[index + 1] - m_upper[index]);
+
+            reject[k] = inROI & (!((y <= upper) & (y >= lower)) | (invalid > 0.0f));
+            anyReject |= reject[k];
+        }
+
+        if (!anyReject)
+            continue;
+
+        for (int k = 0 ; k < n ; ++ k) {
+            if (reject[k])
+                return (first + k);
+        }
+    }
+
+    return limit;
+}
+
+void DRS4PulseShapeFilterEnvelope::extendCellRange(const float *time, int size, int *first, int *last) const
+{
+    extendCellRange(time, size, m_leftOfRef, m_rightOfRef, first, last);
+}
+
+void DRS4PulseShapeFilterEnvelope::extendCellRange(const float *time, int size, double leftOfRef, double rightOfRef, int *first, int *last)
+{
+    if (!time || size <= 0 || *first >= *last)
+        return;
+
+    /* the reference time (extremum on the interpolant) may exceed the range by one cell */
+    const float timeRefMin = time[std::max(0, *first - 1)];
+    const float timeRefMax = time[std::min(size - 1, *last)];
+
+    const int firstCell = (int)(std::lower_bound(time, time + size, (float)(timeRefMin + leftOfRef)) - time) - 1;
+    const int lastCell = (int)(std::upper_bound(time, time + size, (float)(timeRefMax + rightOfRef)) - time) + 1;
+
+    *first = std::max(0, std::min(*first, firstCell));
+    *last = std::min(size, std::max(*last, lastCell));
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+#ifndef DRS4PULSESHAPEFILTERENVELOPE_H
+#define DRS4PULSESHAPEFILTERENVELOPE_H
+
+#include "Fit/dspline.h"
+
+#define __PULSESHAPEFILTER_ENVELOPE_LUT_SIZE 2048 // number of grid points spanning the ROI
+#define __PULSESHAPEFILTER_ENVELOPE_BLOCK    8    // samples tested per block before the early exit
+
+/* acceptance band [mean - lower-fraction*stddev ; mean + upper-fraction*stddev] of the pulse-shape filter sampled on a uniform grid across the ROI:
+ *
+ * - the band is compiled from the mean and stddev splines once per settings version (see DRS4SettingsManager::analysisConfig()).
+ * - the per-event test is a linear interpolation in the table and a compare, instead of two spline evaluations per sample. */
+class DRS4PulseShapeFilterEnvelope final {
+public:
+    DRS4PulseShapeFilterEnvelope();
+
+    /* bValid: 'false' if no trace was recorded - each sample within the ROI is rejected in that case (as in DRS4PulseShapeFilterData::isInsideBounding) */
+    void build(const DSpline& meanSpline, const DSpline& stddevSpline, bool bValid, double leftOfRefInNs, double rightOfRefInNs, double lowerFraction, double upperFraction);
+
+    bool isValid() const {
+        return m_bValid;
+    }
+
+    bool isInside(double t, float y) const;
+
+    /* index of the first sample within [0 ; limit[ being in the ROI and outside the band or 'limit' if the pulse is accepted:
+     * t = time[j] - timeRef and y = wave[j]*yScale */
+    int firstReject(const float *time, const float *wave, int limit, double timeRef, float yScale) const;
+
+    /* extends the cell range [first ; last[ by the cells visited by firstReject() for a reference time within the range */
+    void extendCellRange(const float *time, int size, int *first, int *last) const;
+
+    /* extends the cell range [first ; last[ by the cells within [leftOfRef ; rightOfRef] of a reference time within the range */
+    static void extendCellRange(const float *time, int size, double leftOfRef, double rightOfRef, int *first, int *last);
+
+private:
+    bool m_bValid;
+
+    double m_leftOfRef;
+    double m_rightOfRef;
+
+    double m_step;
+    double m_invStep;
+
+    float m_lower[__PULSESHAPEFILTER_ENVELOPE_LUT_SIZE];
+    float m_upper[__PULSESHAPEFILTER_ENVELOPE_LUT_SIZE];
+};
+
+#endif // DRS4PULSESHAPEFILTERENVELOPE_H
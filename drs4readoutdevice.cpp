@@ -0,0 +1,284 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+
+#include "drs4readoutdevice.h"
+
+#include "drs4boardmanager.h"
+#include "drs4pulsegenerator.h"
+
+#include "Stream/drs4streamdataloader.h"
+
+DRS4BoardReadoutDevice::DRS4BoardReadoutDevice(DRSBoard *board, bool bIgnoreBusyState) :
+    DRS4ReadoutDevice(),
+    m_board(board),
+    m_bIgnoreBusyState(bIgnoreBusyState),
+    m_bMultiBuffer(false) {}
+
+void DRS4BoardReadoutDevice::arm(bool bMultiBuffer)
+{
+    /* only the VME board provides a multi-buffer: the evaluation board falls back to one event per transfer */
+    m_bMultiBuffer = bMultiBuffer && m_board->HasMultiBuffer();
+
+    if (m_bMultiBuffer) {
+        m_board->SetMultiBuffer(1);
+        m_board->ResetMultiBuffer();
+    }
+
+    m_board->StartDomino();
+}
+
+void DRS4BoardReadoutDevice::disarm()
+{
+    if (m_bMultiBuffer)
+        m_board->SetMultiBuffer(0);
+
+    m_bMultiBuffer = false;
+}
+
+bool DRS4BoardReadoutDevice::isMultiBuffer() const
+{
+    return m_bMultiBuffer;
+}
+
+int DRS4BoardReadoutDevice::pendingEvents()
+{
+    if (m_bMultiBuffer) {
+        const int buffers = m_board->GetNumberOfMultiBuffers();
+
+        return (m_board->GetMultiBufferWP() - m_board->GetMultiBufferRP() + buffers) % buffers;
+    }
+
+    if (m_bIgnoreBusyState)
+        return 1;
+
+    return m_board->IsEventAvailable()?1:0;
+}
+
+int DRS4BoardReadoutDevice::transferEvents(DRS4PipelineRawEvent **events, int count, int chnA, int chnB)
+{
+    if (count <= 0)
+        return 0;
+
+    if (m_bMultiBuffer) {
+        unsigned char *raw[__READOUT_DEVICE_MAX_BATCH];
+        int triggerCell[__READOUT_DEVICE_MAX_BATCH];
+
+        count = qMin(count, __READOUT_DEVICE_MAX_BATCH);
+
+        for ( int i = 0 ; i < count ; ++ i )
+            raw[i] = events[i]->m_raw;
+
+        /* the board keeps on sampling into the free buffers: no rearm */
+        const int transferred = m_board->TransferMultiBufferWaves(raw, triggerCell, count);
+
+        for ( int i = 0 ; i < transferred ; ++ i ) {
+            events[i]->m_triggerCell = triggerCell[i];
+            events[i]->m_bDecoded = false;
+        }
+
+        return transferred;
+    }
+
+    const int minChn = qMin(chnA, chnB);
+    const int maxChn = qMax(chnA, chnB);
+
+    /* same layout as DRSBoard::TransferWaves(firstChannel, lastChannel) into its internal buffer */
+    const int offset = (m_board->GetTransport() == TR_USB)?(minChn*sizeof(short int)*kNumberOfBins):0;
+
+    m_board->TransferWaves(events[0]->m_raw + offset, minChn, maxChn);
+
+    events[0]->m_triggerCell = m_board->GetTriggerCell(0);
+    events[0]->m_bDecoded = false;
+
+    /* the event is a copy: rearm the board before it is decoded */
+    try {
+        m_board->StartDomino(); // returns always 1.
+    }
+    catch ( ... ) {
+    }
+
+    return 1;
+}
+
+void DRS4BoardReadoutDevice::dropEvents()
+{
+    if (m_bMultiBuffer)
+        m_board->SetMultiBufferRP(m_board->GetMultiBufferWP());
+    else
+        m_board->StartDomino();
+}
+
+DRS4SoftwareBoard::DRS4SoftwareBoard(int buffers, double triggerRate, int roundTripLatency) :
+    DRS4ReadoutDevice(),
+    m_buffers(qMax(1, buffers)),
+    m_triggerRate(triggerRate),
+    m_roundTripLatency(roundTripLatency),
+    m_bMultiBuffer(false),
+    m_depth(1),
+    m_pendingEvents(0.),
+    m_lostEvents(0) {}
+
+void DRS4SoftwareBoard::roundTrip()
+{
+    if (m_roundTripLatency > 0)
+        QThread::usleep(m_roundTripLatency);
+}
+
+void DRS4SoftwareBoard::arm(bool bMultiBuffer)
+{
+    m_bMultiBuffer = bMultiBuffer && m_buffers > 1;
+    m_depth = m_bMultiBuffer?m_buffers:1;
+
+    m_pendingEvents = 0.;
+    m_lostEvents = 0;
+
+    m_triggerTimer.start();
+
+    roundTrip();
+}
+
+void DRS4SoftwareBoard::disarm()
+{
+    m_bMultiBuffer = false;
+    m_depth = 1;
+
+    m_triggerTimer.invalidate();
+}
+
+bool DRS4SoftwareBoard::isMultiBuffer() const
+{
+    return m_bMultiBuffer;
+}
+
+int DRS4SoftwareBoard::pendingEvents()
+{
+    /* status register */
+    roundTrip();
+
+    if (m_triggerRate <= 0.)
+        return m_depth;
+
+    /* triggers since the last request: the ones exceeding the free buffers are lost (dead time) */
+    const double triggers = m_pendingEvents + m_triggerRate*m_triggerTimer.nsecsElapsed()*1E-9;
+
+    m_triggerTimer.restart();
+
+    if (triggers > m_depth) {
+        m_lostEvents += (quint64)(triggers - m_depth);
+        m_pendingEvents = m_depth;
+    }
+    else {
+        m_pendingEvents = triggers;
+    }
+
+    return (int)m_pendingEvents;
+}
+
+int DRS4SoftwareBoard::transferEvents(DRS4PipelineRawEvent **events, int count, int chnA, int chnB)
+{
+    Q_UNUSED(chnA);
+    Q_UNUSED(chnB);
+
+    count = qMin(count, m_depth);
+
+    if (count <= 0)
+        return 0;
+
+    /* one bulk transfer */
+    roundTrip();
+
+    int transferred = 0;
+
+    for ( ; transferred < count ; ++ transferred ) {
+        DRS4PipelineRawEvent *rawEvent = events[transferred];
+
+        if ( !DRS4BoardManager::sharedInstance()->usingStreamDataOnDemoMode() ) {
+            if ( !DRS4PulseGenerator::sharedInstance()->receiveGeneratedPulsePair(rawEvent->m_tChannel0, rawEvent->m_waveChannel0, rawEvent->m_tChannel1, rawEvent->m_waveChannel1) )
+                break;
+        }
+        else {
+            if ( !DRS4StreamDataLoader::sharedInstance()->isArmed() )
+                break;
+
+            if ( !DRS4StreamDataLoader::sharedInstance()->receiveGeneratedPulsePair(rawEvent->m_tChannel0, rawEvent->m_waveChannel0, rawEvent->m_tChannel1, rawEvent->m_waveChannel1) )
+                break;
+        }
+
+        rawEvent->m_triggerCell = 0;
+        rawEvent->m_bDecoded = true;
+    }
+
+    if (m_triggerRate > 0.)
+        m_pendingEvents = qMax(0., m_pendingEvents - transferred);
+
+    /* without multi-buffer the board is rearmed by an extra register access */
+    if (!m_bMultiBuffer)
+        roundTrip();
+
+    return transferred;
+}
+
+void DRS4SoftwareBoard::dropEvents()
+{
+    m_lostEvents += (quint64)m_pendingEvents;
+    m_pendingEvents = 0.;
+
+    roundTrip();
+}
+
+quint64 DRS4SoftwareBoard::lostEvents() const
+{
+    return m_lostEvents;
+}
@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+**  DDRS4PALS, a software for the acquisition of lifetime spectra using the
+**  DRS4 evaluation board of PSI: https://www.psi.ch/drs/evaluation-board
+**
+**  Copyright (C) 2016-2022 Dr. Danny Petschke
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see http://www.gnu.org/licenses/.
+**
+*****************************************************************************
+**
+**  @author: Dr. Danny Petschke
+**  @contact: danny.petschke@uni-wuerzburg.de
+**
+*****************************************************************************
+**
+** related publications:
+**
+** when using DDRS4PALS for your research purposes please cite:
+**
+** DDRS4PALS: A software for the acquisition and simulation of lifetime spectra using the DRS4 evaluation board:
+** https://www.sciencedirect.com/science/article/pii/S2352711019300676
+**
+** and
+**
+** Data on pure tin by Positron Annihilation Lifetime Spectroscopy (PALS) acquired with a semi-analog/digital setup using DDRS4PALS
+** https://www.sciencedirect.com/science/article/pii/S2352340918315142?via%3Dihub
+**
+** when using the integrated simulation tool /DLTPulseGenerator/ of DDRS4PALS for your research purposes please cite:
+**
+** DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300530
+**
+** Update (v1.1) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018300694
+**
+** Update (v1.2) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S2352711018301092
+**
+** Update (v1.3) to DLTPulseGenerator: A library for the simulation of lifetime spectra based on detector-output pulses
+** https://www.sciencedirect.com/science/article/pii/S235271101930038X
+**/
+
+
+#ifndef DRS4READOUTDEVICE_H
+#define DRS4READOUTDEVICE_H
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include "DLib.h"
+#include "DRS/drs507/DRS.h"
+
+#include "drs4eventring.h"
+#include "drs4settingsmanager.h"
+
+#define __WORKER_PIPELINE_RAW_EVENT_SIZE (kNumberOfChipsMax*kNumberOfChannelsMax*2*kNumberOfBins) // [byte]
+
+#define __READOUT_DEVICE_MAX_BATCH 16 // [#] events of one bulk transfer
+
+#define __SOFTWARE_BOARD_BUFFERS 3 // [#] as the multi-buffer of the VME board
+#define __SOFTWARE_BOARD_TRIGGER_RATE 0. // [Hz] 0: a trigger is always pending
+#define __SOFTWARE_BOARD_ROUND_TRIP_LATENCY 0 // [us] per register access or transfer
+
+/* slot of the readout queue: the raw board data (or the generated pulse pair in demo mode) */
+class DRS4PipelineRawEvent final {
+public:
+    alignas(__EVENT_RING_CACHE_LINE) unsigned char m_raw[__WORKER_PIPELINE_RAW_EVENT_SIZE];
+
+    /* demo mode: the pulse pair is generated in calibrated form */
+    alignas(__EVENT_RING_CACHE_LINE) float m_tChannel0[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_tChannel1[kNumberOfBins];
+
+    alignas(__EVENT_RING_CACHE_LINE) float m_waveChannel0[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_waveChannel1[kNumberOfBins];
+
+    bool m_bDecoded;
+    int m_triggerCell;
+
+    int m_chnA;
+    int m_chnB;
+
+    DRS4AnalysisConfigPtr m_config;
+};
+
+/* board side of the readout stage of the acquisition pipeline:
+ *
+ * - arm() starts the acquisition. In multi-buffer mode the device keeps on sampling into its next free buffer while the pending events are transferred.
+ * - pendingEvents() returns the number of events waiting in the buffers of the device.
+ * - transferEvents() moves up to 'count' pending events into the slots of the readout queue at once (one bulk transfer) and rearms the device if required.
+ * - dropEvents() discards the pending events if the readout queue is full.
+ *
+ * DRS4BoardReadoutDevice drives the DRSBoard, DRS4SoftwareBoard is a stand-in delivering the pulse pairs of the demo mode. */
+class DRS4ReadoutDevice {
+public:
+    DRS4ReadoutDevice() {}
+    virtual ~DRS4ReadoutDevice() {}
+
+    virtual void arm(bool bMultiBuffer) = 0;
+    virtual void disarm() = 0;
+
+    virtual bool isMultiBuffer() const = 0;
+
+    virtual int pendingEvents() = 0;
+    virtual int transferEvents(DRS4PipelineRawEvent **events, int count, int chnA, int chnB) = 0;
+    virtual void dropEvents() = 0;
+};
+
+class DRS4BoardReadoutDevice final : public DRS4ReadoutDevice {
+    DRSBoard *m_board;
+
+    bool m_bIgnoreBusyState;
+    bool m_bMultiBuffer;
+
+public:
+    DRS4BoardReadoutDevice(DRSBoard *board, bool bIgnoreBusyState = false);
+    virtual ~DRS4BoardReadoutDevice() {}
+
+    virtual void arm(bool bMultiBuffer);
+    virtual void disarm();
+
+    virtual bool isMultiBuffer() const;
+
+    virtual int pendingEvents();
+    virtual int transferEvents(DRS4PipelineRawEvent **events, int count, int chnA, int chnB);
+    virtual void dropEvents();
+};
+
+/* software stand-in of the board: triggers arrive at 'triggerRate' into 'buffers' buffers (1 without multi-buffer), further triggers are lost until the buffers are read.
+ * Every register access or transfer costs 'roundTripLatency', so the readout can be profiled without hardware. */
+class DRS4SoftwareBoard final : public DRS4ReadoutDevice {
+    int m_buffers;
+    double m_triggerRate;
+    int m_roundTripLatency;
+
+    bool m_bMultiBuffer;
+    int m_depth;
+
+    double m_pendingEvents;
+    quint64 m_lostEvents;
+
+    QElapsedTimer m_triggerTimer;
+
+    void roundTrip();
+
+public:
+    DRS4SoftwareBoard(int buffers = __SOFTWARE_BOARD_BUFFERS, double triggerRate = __SOFTWARE_BOARD_TRIGGER_RATE, int roundTripLatency = __SOFTWARE_BOARD_ROUND_TRIP_LATENCY);
+    virtual ~DRS4SoftwareBoard() {}
+
+    virtual void arm(bool bMultiBuffer);
+    virtual void disarm();
+
+    virtual bool isMultiBuffer() const;
+
+    virtual int pendingEvents();
+    virtual int transferEvents(DRS4PipelineRawEvent **events, int count, int chnA, int chnB);
+    virtual void dropEvents();
+
+    quint64 lostEvents() const;
+};
+
+#endif // DRS4READOUTDEVICE_H
@@ -198,6 +198,16 @@ bool DRS4PulseShapeFilterData::isInsideBounding(const double &x, const double &y
     return (y <= upperLimit) && (y >= lowerLimit);
 }
 
+void DRS4PulseShapeFilterData::envelope(DRS4PulseShapeFilterEnvelope *envelope, double leftOfRefInNs, double rightOfRefInNs, double lowerFraction, double upperFraction) const
+{
+    if (!envelope)
+        return;
+
+    const bool bValid = !(m_meanTrace.isEmpty() || m_stdDevTrace.isEmpty());
+
+    envelope->build(m_meanTraceSpline, m_stddevTraceSpline, bValid, leftOfRefInNs, rightOfRefInNs, lowerFraction, upperFraction);
+}
+
 static DRS4SettingsManager *__sharedInstanceSettingsManager = DNULLPTR;
 
 DRS4SettingsManager::DRS4SettingsManager() :
@@ -310,7 +320,8 @@ DRS4SettingsManager::DRS4SettingsManager() :
     m_baseLineCorrectionShiftValueB(0.0),
     m_baseLineCorrectionEnabledB(false),
     m_baseLineCorrectionLimitB(3.0),
-    m_baseLineCorrectionLimitExceededRejectB(false) {
+    m_baseLineCorrectionLimitExceededRejectB(false),
+    m_settingsVersion(1) {
     m_parentNode = new DSimpleXMLNode("DDRS4PALS");
 
     m_versionNode = new DSimpleXMLNode("file-version");
@@ -355,6 +366,10 @@ DRS4SettingsManager::DRS4SettingsManager() :
     m_splineTypeTKCubicEnabledNode = new DSimpleXMLNode("enabled?");
     m_splineTypeTKCubicEnabledNode->setValue(false);
 
+    m_splineTypeROICubicNode = new DSimpleXMLNode("roi-cubic");
+    m_splineTypeROICubicEnabledNode = new DSimpleXMLNode("enabled?");
+    m_splineTypeROICubicEnabledNode->setValue(false);
+
     m_splineIntraSamplingPointsNode = new DSimpleXMLNode("intra-sampling-points");
     m_splineIntraSamplingPointsNode->setValue(10);
 
@@ -777,13 +792,15 @@ DRS4SettingsManager::DRS4SettingsManager() :
     (*m_splineTypeCatmullRomNode) << m_splineTypeCatmullRomEnabledNode;
     (*m_splineTypeMonotoneNode) << m_splineTypeMonotoneEnabledNode;
     (*m_splineTypeTKCubicNode) << m_splineTypeTKCubicEnabledNode;
+    (*m_splineTypeROICubicNode) << m_splineTypeROICubicEnabledNode;
 
     (*m_splineTypeNode) << m_splineTypeLinearNode
                         << m_splineTypeCubicNode
                         << m_splineTypeAkimaNode
                         << m_splineTypeCatmullRomNode
                         << m_splineTypeMonotoneNode
-                        << m_splineTypeTKCubicNode;
+                        << m_splineTypeTKCubicNode
+                        << m_splineTypeROICubicNode;
     (*m_cfdAlgorithmType_splineAndFittingInterpolationNode) << m_splineTypeNode
                                                             << m_splineIntraSamplingPointsNode;
 
@@ -977,8 +994,11 @@ bool DRS4SettingsManager::load(const QString &path)
                 /* rise time filter (since version 1.05 / settings version 2.0) */
                 const DSimpleXMLTag pRiseTimeFilterSettingsTag = pTag.getTag(m_riseTimeFilterSettingsNode, &ok);
 
-                if ( !ok )
+                if ( !ok ) {
+                    m_settingsVersion ++;
+
                     return false;
+                }
 
                 m_riseTimeFilterIsActivated_Node->setValue(pRiseTimeFilterSettingsTag.getValueAt(m_riseTimeFilterIsActivated_Node, &ok));
                 if (!ok) m_riseTimeFilterIsActivated_Node->setValue(m_riseTimeFilterIsActivated);
@@ -1435,6 +1455,17 @@ bool DRS4SettingsManager::load(const QString &path)
     m_splineTypeTKCubicEnabledNode->setValue(pCFDAlgorithmSplineTKCubicTag.getValueAt(m_splineTypeTKCubicEnabledNode, &ok));
     if  ( !ok ) m_splineTypeTKCubicEnabledNode->setValue(false);
 
+    /* optional: not available in settings of previous versions */
+    const DSimpleXMLTag pCFDAlgorithmSplineROICubicTag = pCFDAlgorithmSplineTag.getTag(m_splineTypeROICubicNode, &ok);
+
+    if ( ok ) {
+        m_splineTypeROICubicEnabledNode->setValue(pCFDAlgorithmSplineROICubicTag.getValueAt(m_splineTypeROICubicEnabledNode, &ok));
+        if  ( !ok ) m_splineTypeROICubicEnabledNode->setValue(false);
+    }
+    else {
+        m_splineTypeROICubicEnabledNode->setValue(false);
+    }
+
     /* Area filter */
 
     m_pulseAreaFilerEnabledNode->setValue(pAreaFilterSettingsTag.getValueAt(m_pulseAreaFilerEnabledNode, &ok));
@@ -1519,6 +1550,8 @@ bool DRS4SettingsManager::load(const QString &path)
 
     m_fileName = path;
 
+    m_settingsVersion ++;
+
     return true;
 }
 
@@ -1624,6 +1657,157 @@ QMutex *DRS4SettingsManager::mutex()
     return &m_mutex;
 }
 
+quint64 DRS4SettingsManager::settingsVersion() const
+{
+    return m_settingsVersion.load(std::memory_order_acquire);
+}
+
+DRS4AnalysisConfigPtr DRS4SettingsManager::analysisConfig() const
+{
+    QMutexLocker locker(&m_analysisConfigMutex);
+
+    const quint64 version = settingsVersion();
+
+    if ( m_analysisConfig
+         && m_analysisConfig->m_version == version )
+        return m_analysisConfig;
+
+    DRS4AnalysisConfig *config = new DRS4AnalysisConfig;
+
+    config->m_version = version;
+
+    config->m_startCell = startCell();
+    config->m_stopCell = stopCell();
+
+    config->m_channelNumberA = channelNumberA();
+    config->m_channelNumberB = channelNumberB();
+
+    config->m_positiveSignal = isPositiveSignal();
+    config->m_burstMode = isBurstMode();
+    config->m_sweepInNanoseconds = sweepInNanoseconds();
+
+    config->m_cfdLevelA = cfdLevelA();
+    config->m_cfdLevelB = cfdLevelB();
+
+    config->m_interpolationType = interpolationType();
+    config->m_splineInterpolationType = splineInterpolationType();
+    config->m_splineIntraSamplingCounts = splineIntraSamplingCounts();
+    config->m_polynomialSamplingCounts = polynomialSamplingCounts();
+
+    config->m_startChannelAMin = startChanneAMin();
+    config->m_startChannelAMax = startChanneAMax();
+    config->m_stopChannelAMin = stopChanneAMin();
+    config->m_stopChannelAMax = stopChanneAMax();
+
+    config->m_startChannelBMin = startChanneBMin();
+    config->m_startChannelBMax = startChanneBMax();
+    config->m_stopChannelBMin = stopChanneBMin();
+    config->m_stopChannelBMax = stopChanneBMax();
+
+    config->m_channelCntAB = channelCntAB();
+    config->m_channelCntBA = channelCntBA();
+    config->m_channelCntCoincidence = channelCntCoincindence();
+    config->m_channelCntMerged = channelCntMerged();
+
+    config->m_offsetInNSAB = offsetInNSAB();
+    config->m_offsetInNSBA = offsetInNSBA();
+    config->m_offsetInNSCoincidence = offsetInNSCoincidence();
+    config->m_offsetInNSMerged = offsetInNSMerged();
+
+    config->m_scalerInNSAB = scalerInNSAB();
+    config->m_scalerInNSBA = scalerInNSBA();
+    config->m_scalerInNSCoincidence = scalerInNSCoincidence();
+    config->m_scalerInNSMerged = scalerInNSMerged();
+
+    config->m_meanCableDelay = meanCableDelay();
+
+    config->m_negativeLTAccepted = isNegativeLTAccepted();
+    config->m_forceCoincidence = isforceCoincidence();
+
+    config->m_pulseAreaFilterEnabled = isPulseAreaFilterEnabled();
+    config->m_pulseAreaFilterPlotEnabled = isPulseAreaFilterPlotEnabled();
+
+    config->m_pulseAreaFilterBinningA = pulseAreaFilterBinningA();
+    config->m_pulseAreaFilterBinningB = pulseAreaFilterBinningB();
+
+    config->m_pulseAreaFilterNormalizationA = pulseAreaFilterNormalizationA();
+    config->m_pulseAreaFilterNormalizationB = pulseAreaFilterNormalizationB();
+
+    config->m_riseTimeFilterEnabled = isRiseTimeFilterEnabled();
+
+    config->m_riseTimeFilterScaleInNanosecondsOfA = riseTimeFilterScaleInNanosecondsOfA();
+    config->m_riseTimeFilterScaleInNanosecondsOfB = riseTimeFilterScaleInNanosecondsOfB();
+
+    config->m_riseTimeFilterBinningOfA = riseTimeFilterBinningOfA();
+    config->m_riseTimeFilterBinningOfB = riseTimeFilterBinningOfB();
+
+    config->m_riseTimeFilterLeftWindowOfA = riseTimeFilterLeftWindowOfA();
+    config->m_riseTimeFilterLeftWindowOfB = riseTimeFilterLeftWindowOfB();
+
+    config->m_riseTimeFilterRightWindowOfA = riseTimeFilterRightWindowOfA();
+    config->m_riseTimeFilterRightWindowOfB = riseTimeFilterRightWindowOfB();
+
+    config->m_persistanceEnabled = isPersistanceEnabled();
+
+    config->m_persistanceUsingCFDBAsRefForA = persistanceUsingCFDBAsRefForA();
+    config->m_persistanceUsingCFDAAsRefForB = persistanceUsingCFDAAsRefForB();
+
+    config->m_medianFilterAEnabled = medianFilterAEnabled();
+    config->m_medianFilterBEnabled = medianFilterBEnabled();
+
+    config->m_medianFilterWindowSizeA = medianFilterWindowSizeA();
+    config->m_medianFilterWindowSizeB = medianFilterWindowSizeB();
+
+    config->m_baselineCorrectionMethodA = baselineCorrectionMethodA();
+    config->m_baselineCorrectionStartPeakCellA = baselineCorrectionCalculationStartPeakCellA();
+    config->m_baselineCorrectionWindowA = baselineCorrectionCalculationWindowA();
+    config->m_baselineCorrectionEnabledA = baselineCorrectionCalculationEnabledA();
+    config->m_baselineCorrectionStartCellA = baselineCorrectionCalculationStartCellA();
+    config->m_baselineCorrectionRegionA = baselineCorrectionCalculationRegionA();
+    config->m_baselineCorrectionShiftValueInMVA = baselineCorrectionCalculationShiftValueInMVA();
+    config->m_baselineCorrectionLimitRejectLimitA = baselineCorrectionCalculationLimitRejectLimitA();
+    config->m_baselineCorrectionLimitInPercentageA = baselineCorrectionCalculationLimitInPercentageA();
+
+    config->m_baselineCorrectionMethodB = baselineCorrectionMethodB();
+    config->m_baselineCorrectionStartPeakCellB = baselineCorrectionCalculationStartPeakCellB();
+    config->m_baselineCorrectionWindowB = baselineCorrectionCalculationWindowB();
+    config->m_baselineCorrectionEnabledB = baselineCorrectionCalculationEnabledB();
+    config->m_baselineCorrectionStartCellB = baselineCorrectionCalculationStartCellB();
+    config->m_baselineCorrectionRegionB = baselineCorrectionCalculationRegionB();
+    config->m_baselineCorrectionShiftValueInMVB = baselineCorrectionCalculationShiftValueInMVB();
+    config->m_baselineCorrectionLimitRejectLimitB = baselineCorrectionCalculationLimitRejectLimitB();
+    config->m_baselineCorrectionLimitInPercentageB = baselineCorrectionCalculationLimitInPercentageB();
+
+    config->m_pulseShapeFilterEnabledA = pulseShapeFilterEnabledA();
+    config->m_pulseShapeFilterEnabledB = pulseShapeFilterEnabledB();
+
+    config->m_pulseShapeFilterRecordScheme = pulseShapeFilterRecordScheme();
+
+    config->m_pulseShapeFilterROILeftInNsOfA = pulseShapeFilterROILeftInNsOfA();
+    config->m_pulseShapeFilterROIRightInNsOfA = pulseShapeFilterROIRightInNsOfA();
+    config->m_pulseShapeFilterROILeftInNsOfB = pulseShapeFilterROILeftInNsOfB();
+    config->m_pulseShapeFilterROIRightInNsOfB = pulseShapeFilterROIRightInNsOfB();
+
+    config->m_pulseShapeFilterStdDevUpperFractionA = pulseShapeFilterStdDevUpperFractionA();
+    config->m_pulseShapeFilterStdDevLowerFractionA = pulseShapeFilterStdDevLowerFractionA();
+    config->m_pulseShapeFilterStdDevUpperFractionB = pulseShapeFilterStdDevUpperFractionB();
+    config->m_pulseShapeFilterStdDevLowerFractionB = pulseShapeFilterStdDevLowerFractionB();
+
+    /* deep copies: setPulseShapeFilterDataA/B() replace the data under m_analysisConfigMutex */
+    config->m_pulseShapeFilterDataA = m_pulseShapeFilterDataA;
+    config->m_pulseShapeFilterDataB = m_pulseShapeFilterDataB;
+
+    if (config->m_pulseShapeFilterEnabledA)
+        config->m_pulseShapeFilterDataA.envelope(&config->m_pulseShapeFilterEnvelopeA, config->m_pulseShapeFilterROILeftInNsOfA, config->m_pulseShapeFilterROIRightInNsOfA, config->m_pulseShapeFilterStdDevLowerFractionA, config->m_pulseShapeFilterStdDevUpperFractionA);
+
+    if (config->m_pulseShapeFilterEnabledB)
+        config->m_pulseShapeFilterDataB.envelope(&config->m_pulseShapeFilterEnvelopeB, config->m_pulseShapeFilterROILeftInNsOfB, config->m_pulseShapeFilterROIRightInNsOfB, config->m_pulseShapeFilterStdDevLowerFractionB, config->m_pulseShapeFilterStdDevUpperFractionB);
+
+    m_analysisConfig = DRS4AnalysisConfigPtr(config);
+
+    return m_analysisConfig;
+}
+
 void DRS4SettingsManager::setForceCoincidence(bool force)
 {
 #ifndef __DISABLE_MUTEX_LOCKER
@@ -1632,6 +1816,8 @@ void DRS4SettingsManager::setForceCoincidence(bool force)
 
     m_bForceCoincidence = force;
     m_bForceCoincidenceNode->setValue(force);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBurstMode(bool on)
@@ -1642,6 +1828,8 @@ void DRS4SettingsManager::setBurstMode(bool on)
 
     m_burstModeNode->setValue(on);
     m_burstMode = on;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartCell(int startCell)
@@ -1652,6 +1840,8 @@ void DRS4SettingsManager::setStartCell(int startCell)
 
     m_startCellNode->setValue(startCell);
     m_startCell = startCell;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopCell(int stopCell)
@@ -1662,6 +1852,8 @@ void DRS4SettingsManager::setStopCell(int stopCell)
 
     m_stopCellNode->setValue(stopCell);
     m_stopCell = stopCell;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPositivSignal(bool positiv)
@@ -1672,6 +1864,8 @@ void DRS4SettingsManager::setPositivSignal(bool positiv)
 
     m_isPositivSignalNode->setValue(positiv);
     m_isPositivSignal = positiv;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setNegativeLifetimeAccepted(bool accepted)
@@ -1682,6 +1876,8 @@ void DRS4SettingsManager::setNegativeLifetimeAccepted(bool accepted)
 
     m_negativeLifetimesNode->setValue(accepted);
     m_negativeLifetimes = accepted;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setIgnoreBusyState(bool ignore)
@@ -1692,6 +1888,8 @@ void DRS4SettingsManager::setIgnoreBusyState(bool ignore)
 
     m_ignoreBusyNode->setValue(ignore);
     m_ignoreBusy = ignore;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setCFDLevelA(double level)
@@ -1702,6 +1900,8 @@ void DRS4SettingsManager::setCFDLevelA(double level)
 
     m_cfdLevelANode->setValue(level);
     m_cfdLevelA = level;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setCFDLevelB(double level)
@@ -1712,6 +1912,8 @@ void DRS4SettingsManager::setCFDLevelB(double level)
 
     m_cfdLevelBNode->setValue(level);
     m_cfdLevelB = level;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setOffsetInNSAB(double offset)
@@ -1722,6 +1924,8 @@ void DRS4SettingsManager::setOffsetInNSAB(double offset)
 
     m_offsetNsABNode->setValue(offset);
     m_offsetNsAB = offset;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setOffsetInNSBA(double offset)
@@ -1732,6 +1936,8 @@ void DRS4SettingsManager::setOffsetInNSBA(double offset)
 
     m_offsetNsBANode->setValue(offset);
     m_offsetNsBA = offset;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setOffsetInNSCoincidence(double offset)
@@ -1742,6 +1948,8 @@ void DRS4SettingsManager::setOffsetInNSCoincidence(double offset)
 
     m_offsetNsCoincidenceNode->setValue(offset);
     m_offsetNsCoincidence = offset;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setOffsetInNSMerged(double offset)
@@ -1752,6 +1960,8 @@ void DRS4SettingsManager::setOffsetInNSMerged(double offset)
 
     m_offsetNsMergedNode->setValue(offset);
     m_offsetNsMerged = offset;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setScalerInNSAB(double scaler)
@@ -1762,6 +1972,8 @@ void DRS4SettingsManager::setScalerInNSAB(double scaler)
 
     m_scalerNsABNode->setValue(scaler);
     m_scalerNsAB = scaler;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setScalerInNSBA(double scaler)
@@ -1772,6 +1984,8 @@ void DRS4SettingsManager::setScalerInNSBA(double scaler)
 
     m_scalerNsBANode->setValue(scaler);
     m_scalerNsBA = scaler;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setScalerInNSCoincidence(double scaler)
@@ -1782,6 +1996,8 @@ void DRS4SettingsManager::setScalerInNSCoincidence(double scaler)
 
     m_scalerNsCoincidenceNode->setValue(scaler);
     m_scalerNsCoincidence = scaler;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setScalerInNSMerged(double scaler)
@@ -1792,6 +2008,8 @@ void DRS4SettingsManager::setScalerInNSMerged(double scaler)
 
     m_scalerNsMergedNode->setValue(scaler);
     m_scalerNsMerged = scaler;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setChannelCntAB(int count)
@@ -1802,6 +2020,8 @@ void DRS4SettingsManager::setChannelCntAB(int count)
 
     m_channelCountABNode->setValue(count);
     m_channelCountAB = count;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setChannelCntBA(int count)
@@ -1812,6 +2032,8 @@ void DRS4SettingsManager::setChannelCntBA(int count)
 
     m_channelCountBANode->setValue(count);
     m_channelCountBA = count;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setChannelCntCoincindence(int count)
@@ -1822,6 +2044,8 @@ void DRS4SettingsManager::setChannelCntCoincindence(int count)
 
     m_channelCountCoincidenceNode->setValue(count);
     m_channelCountCoincidence = count;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setChannelCntMerged(int count)
@@ -1832,6 +2056,8 @@ void DRS4SettingsManager::setChannelCntMerged(int count)
 
     m_channelCountMergedNode->setValue(count);
     m_channelCountMerged = count;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setTriggerSource(int triggerSource)
@@ -1842,6 +2068,8 @@ void DRS4SettingsManager::setTriggerSource(int triggerSource)
 
     m_triggerSourceNode->setValue(triggerSource);
     m_triggerSource = triggerSource;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setTriggerPolarityPositive(bool positive)
@@ -1852,6 +2080,8 @@ void DRS4SettingsManager::setTriggerPolarityPositive(bool positive)
 
     m_isTriggerPolarityPositiveNode->setValue(positive);
     m_isTriggerPolarityPositive = positive;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setTriggerLevelAmV(double triggerLevelInmV)
@@ -1862,6 +2092,8 @@ void DRS4SettingsManager::setTriggerLevelAmV(double triggerLevelInmV)
 
     m_triggerLevelANode->setValue(triggerLevelInmV);
     m_triggerLevelA = triggerLevelInmV;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setTriggerLevelBmV(double triggerLevelInmV)
@@ -1872,6 +2104,8 @@ void DRS4SettingsManager::setTriggerLevelBmV(double triggerLevelInmV)
 
     m_triggerLevelBNode->setValue(triggerLevelInmV);
     m_triggerLevelB = triggerLevelInmV;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setTriggerDelayInNs(double delayInNs)
@@ -1882,6 +2116,8 @@ void DRS4SettingsManager::setTriggerDelayInNs(double delayInNs)
 
     m_triggerDelayInNSNode ->setValue(delayInNs);
     m_triggerDelayInNS = delayInNs;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setComment(const QString &comment)
@@ -1892,6 +2128,8 @@ void DRS4SettingsManager::setComment(const QString &comment)
 
     m_commentNode->setValue(comment);
     m_comment = comment;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setLastSaveDate(const QString &lastSaveDate)
@@ -1902,6 +2140,8 @@ void DRS4SettingsManager::setLastSaveDate(const QString &lastSaveDate)
 
     m_lastSaveDateNode->setValue(lastSaveDate);
     m_lastSaveDate = lastSaveDate;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setChannelNumberA(int channelNumber)
@@ -1912,6 +2152,8 @@ void DRS4SettingsManager::setChannelNumberA(int channelNumber)
 
     m_channelNumberANode->setValue(channelNumber);
     m_channelNumberA = channelNumber;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setChannelNumberB(int channelNumber)
@@ -1922,6 +2164,8 @@ void DRS4SettingsManager::setChannelNumberB(int channelNumber)
 
     m_channelNumberBNode->setValue(channelNumber);
     m_channelNumberB = channelNumber;
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartChannelA(int min, int max)
@@ -1935,6 +2179,8 @@ void DRS4SettingsManager::setStartChannelA(int min, int max)
 
     m_startAChannelMinNode->setValue(min);
     m_startAChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartChannelB(int min, int max)
@@ -1948,6 +2194,8 @@ void DRS4SettingsManager::setStartChannelB(int min, int max)
 
     m_startBChannelMinNode->setValue(min);
     m_startBChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopChannelA(int min, int max)
@@ -1961,6 +2209,8 @@ void DRS4SettingsManager::setStopChannelA(int min, int max)
 
     m_stopAChannelMinNode->setValue(min);
     m_stopAChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopChannelB(int min, int max)
@@ -1974,6 +2224,8 @@ void DRS4SettingsManager::setStopChannelB(int min, int max)
 
     m_stopBChannelMinNode->setValue(min);
     m_stopBChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartChannelBMin(int min)
@@ -1984,6 +2236,8 @@ void DRS4SettingsManager::setStartChannelBMin(int min)
 
     m_startBChannelMin = min;
     m_startBChannelMinNode->setValue(min);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartChannelAMax(int max)
@@ -1994,6 +2248,8 @@ void DRS4SettingsManager::setStartChannelAMax(int max)
 
     m_startAChannelMax = max;
     m_startAChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartChannelBMax(int max)
@@ -2004,6 +2260,8 @@ void DRS4SettingsManager::setStartChannelBMax(int max)
 
     m_startBChannelMax = max;
     m_startBChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopChannelAMin(int min)
@@ -2014,6 +2272,8 @@ void DRS4SettingsManager::setStopChannelAMin(int min)
 
     m_stopAChannelMin = min;
     m_stopAChannelMinNode->setValue(min);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopChannelBMin(int min)
@@ -2024,6 +2284,8 @@ void DRS4SettingsManager::setStopChannelBMin(int min)
 
     m_stopBChannelMin = min;
     m_stopBChannelMinNode->setValue(min);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopChannelAMax(int max)
@@ -2034,6 +2296,8 @@ void DRS4SettingsManager::setStopChannelAMax(int max)
 
     m_stopAChannelMax = max;
     m_stopAChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStopChannelBMax(int max)
@@ -2044,6 +2308,8 @@ void DRS4SettingsManager::setStopChannelBMax(int max)
 
     m_stopBChannelMax = max;
     m_stopBChannelMaxNode->setValue(max);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setMeanCableDelayInNs(double ns)
@@ -2054,6 +2320,8 @@ void DRS4SettingsManager::setMeanCableDelayInNs(double ns)
 
     m_meanNs = ns;
     m_meanNSNode->setValue(ns);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setFitIterations(int count)
@@ -2064,6 +2332,8 @@ void DRS4SettingsManager::setFitIterations(int count)
 
     m_fitIter = count;
     m_fitIterNode->setValue(count);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setFitIterationsMerged(int count)
@@ -2074,6 +2344,8 @@ void DRS4SettingsManager::setFitIterationsMerged(int count)
 
     m_fitIterMerged = count;
     m_fitIterMergedNode->setValue(count);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setFitIterationsAB(int count)
@@ -2084,6 +2356,8 @@ void DRS4SettingsManager::setFitIterationsAB(int count)
 
     m_fitIterAB = count;
     m_fitIterABNode->setValue(count);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setFitIterationsBA(int count)
@@ -2094,6 +2368,8 @@ void DRS4SettingsManager::setFitIterationsBA(int count)
 
     m_fitIterBA = count;
     m_fitIterBANode->setValue(count);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setSweepInNanoseconds(double ns)
@@ -2104,6 +2380,8 @@ void DRS4SettingsManager::setSweepInNanoseconds(double ns)
 
     m_sweepInNanoSec = ns;
     m_sweepInNanoSecNode->setValue(ns);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setSampleSpeedInGHz(double ghz)
@@ -2114,6 +2392,8 @@ void DRS4SettingsManager::setSampleSpeedInGHz(double ghz)
 
     m_freqInGHz = ghz;
     m_freqInGHzNode->setValue(ghz);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterNormalizationA(double percentage)
@@ -2124,6 +2404,8 @@ void DRS4SettingsManager::setPulseAreaFilterNormalizationA(double percentage)
 
     m_pulseAreaNormA = percentage;
     m_pulseAreaNormANode->setValue(percentage);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterNormalizationB(double percentage)
@@ -2134,6 +2416,8 @@ void DRS4SettingsManager::setPulseAreaFilterNormalizationB(double percentage)
 
     m_pulseAreaNormB = percentage;
     m_pulseAreaNormBNode->setValue(percentage);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterBinningA(int binning)
@@ -2144,6 +2428,8 @@ void DRS4SettingsManager::setPulseAreaFilterBinningA(int binning)
 
     m_pulseAreaBinningA = binning;
     m_pulseAreaBinningANode->setValue(binning);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterBinningB(int binning)
@@ -2154,6 +2440,8 @@ void DRS4SettingsManager::setPulseAreaFilterBinningB(int binning)
 
     m_pulseAreaBinningB = binning;
     m_pulseAreaBinningBNode->setValue(binning);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitUpperLeftA(double value)
@@ -2164,6 +2452,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitUpperLeftA(double value)
 
     m_pulseAreaLeftUpper_A = value;
     m_pulseAreaLeftUpper_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitUpperRightA(double value)
@@ -2174,6 +2464,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitUpperRightA(double value)
 
     m_pulseAreaRightUpper_A = value;
     m_pulseAreaRightUpper_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitLowerLeftA(double value)
@@ -2184,6 +2476,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitLowerLeftA(double value)
 
     m_pulseAreaLeftLower_A = value;
     m_pulseAreaLeftLower_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitLowerRightA(double value)
@@ -2194,6 +2488,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitLowerRightA(double value)
 
     m_pulseAreaRightLower_A = value;
     m_pulseAreaRightLower_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitUpperLeftB(double value)
@@ -2204,6 +2500,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitUpperLeftB(double value)
 
     m_pulseAreaLeftUpper_B = value;
     m_pulseAreaLeftUpper_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitUpperRightB(double value)
@@ -2214,6 +2512,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitUpperRightB(double value)
 
     m_pulseAreaRightUpper_B = value;
     m_pulseAreaRightUpper_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitLowerLeftB(double value)
@@ -2224,6 +2524,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitLowerLeftB(double value)
 
     m_pulseAreaLeftLower_B = value;
     m_pulseAreaLeftLower_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterLimitLowerRightB(double value)
@@ -2234,6 +2536,8 @@ void DRS4SettingsManager::setPulseAreaFilterLimitLowerRightB(double value)
 
     m_pulseAreaRightLower_B = value;
     m_pulseAreaRightLower_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterEnabled(bool enabled)
@@ -2244,6 +2548,8 @@ void DRS4SettingsManager::setRiseTimeFilterEnabled(bool enabled)
 
     m_riseTimeFilterIsActivated = enabled;
     m_riseTimeFilterIsActivated_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterPlotEnabled(bool enabled)
@@ -2254,6 +2560,8 @@ void DRS4SettingsManager::setRiseTimeFilterPlotEnabled(bool enabled)
 
     m_riseTimeFilterIsPlotEnabled = enabled;
     m_riseTimeFilterIsPlotEnabled_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterScaleInNanosecondsOfA(double value)
@@ -2264,6 +2572,8 @@ void DRS4SettingsManager::setRiseTimeFilterScaleInNanosecondsOfA(double value)
 
     m_riseTimeFilter_scaleInNs_A = value;
     m_riseTimeFilter_scaleInNs_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterScaleInNanosecondsOfB(double value)
@@ -2274,6 +2584,8 @@ void DRS4SettingsManager::setRiseTimeFilterScaleInNanosecondsOfB(double value)
 
     m_riseTimeFilter_scaleInNs_B = value;
     m_riseTimeFilter_scaleInNs_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterBinningOfA(int value)
@@ -2284,6 +2596,8 @@ void DRS4SettingsManager::setRiseTimeFilterBinningOfA(int value)
 
     m_riseTimeFilter_scaleBinningCnt_A = value;
     m_riseTimeFilter_scaleBinningCnt_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterBinningOfB(int value)
@@ -2294,6 +2608,8 @@ void DRS4SettingsManager::setRiseTimeFilterBinningOfB(int value)
 
     m_riseTimeFilter_scaleBinningCnt_B = value;
     m_riseTimeFilter_scaleBinningCnt_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterLeftWindowOfA(int value)
@@ -2304,6 +2620,8 @@ void DRS4SettingsManager::setRiseTimeFilterLeftWindowOfA(int value)
 
     m_riseTimeFilter_leftWindow_A = value;
     m_riseTimeFilter_leftWindow_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterLeftWindowOfB(int value)
@@ -2314,6 +2632,8 @@ void DRS4SettingsManager::setRiseTimeFilterLeftWindowOfB(int value)
 
     m_riseTimeFilter_leftWindow_B = value;
     m_riseTimeFilter_leftWindow_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterRightWindowOfA(int value)
@@ -2324,6 +2644,8 @@ void DRS4SettingsManager::setRiseTimeFilterRightWindowOfA(int value)
 
     m_riseTimeFilter_rightWindow_A = value;
     m_riseTimeFilter_rightWindow_A_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setRiseTimeFilterRightWindowOfB(int value)
@@ -2334,6 +2656,8 @@ void DRS4SettingsManager::setRiseTimeFilterRightWindowOfB(int value)
 
     m_riseTimeFilter_rightWindow_B = value;
     m_riseTimeFilter_rightWindow_B_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceEnabled(bool activated)
@@ -2344,6 +2668,8 @@ void DRS4SettingsManager::setPersistanceEnabled(bool activated)
 
     m_persistanceEnabled = activated;
     m_persistanceEnabled_Node->setValue(activated);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceLeftInNsOfA(double value)
@@ -2354,6 +2680,8 @@ void DRS4SettingsManager::setPersistanceLeftInNsOfA(double value)
 
     m_persistance_leftAInNs = value;
     m_persistance_leftAInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceLeftInNsOfB(double value)
@@ -2364,6 +2692,8 @@ void DRS4SettingsManager::setPersistanceLeftInNsOfB(double value)
 
     m_persistance_leftBInNs = value;
     m_persistance_leftBInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceRightInNsOfA(double value)
@@ -2374,6 +2704,8 @@ void DRS4SettingsManager::setPersistanceRightInNsOfA(double value)
 
     m_persistance_rightAInNs = value;
     m_persistance_rightAInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceRightInNsOfB(double value)
@@ -2384,6 +2716,8 @@ void DRS4SettingsManager::setPersistanceRightInNsOfB(double value)
 
     m_persistance_rightBInNs = value;
     m_persistance_rightBInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceUsingCFDBAsRefForA(bool on)
@@ -2393,6 +2727,8 @@ void DRS4SettingsManager::setPersistanceUsingCFDBAsRefForA(bool on)
 #endif
 
     m_persistanceUsingRefB_A_Node->setValue(on);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPersistanceUsingCFDAAsRefForB(bool on)
@@ -2402,6 +2738,8 @@ void DRS4SettingsManager::setPersistanceUsingCFDAAsRefForB(bool on)
 #endif
 
     m_persistanceUsingRefA_B_Node->setValue(on);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setInterpolationType(const DRS4InterpolationType::type &type)
@@ -2411,6 +2749,8 @@ void DRS4SettingsManager::setInterpolationType(const DRS4InterpolationType::type
 #endif
 
     m_cfdAlgorithmTypeNode->setValue(type);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setSplineInterpolationType(const DRS4SplineInterpolationType::type &type)
@@ -2425,6 +2765,7 @@ void DRS4SettingsManager::setSplineInterpolationType(const DRS4SplineInterpolati
     m_splineTypeCatmullRomEnabledNode->setValue(false);
     m_splineTypeMonotoneEnabledNode->setValue(false);
     m_splineTypeTKCubicEnabledNode->setValue(false);
+    m_splineTypeROICubicEnabledNode->setValue(false);
 
     switch (type) {
     case DRS4SplineInterpolationType::type::linear: {
@@ -2451,10 +2792,16 @@ void DRS4SettingsManager::setSplineInterpolationType(const DRS4SplineInterpolati
         m_splineTypeTKCubicEnabledNode->setValue(true);
     }
         break;
+    case DRS4SplineInterpolationType::type::roi_cubic: {
+        m_splineTypeROICubicEnabledNode->setValue(true);
+    }
+        break;
     default: {
         m_splineTypeLinearEnabledNode->setValue(true);
     }
     }
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setSplineIntraSamplingCounts(int counts)
@@ -2464,6 +2811,8 @@ void DRS4SettingsManager::setSplineIntraSamplingCounts(int counts)
 #endif
 
     m_splineIntraSamplingPointsNode->setValue(counts);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPolynomialSamplingCounts(int counts)
@@ -2473,6 +2822,8 @@ void DRS4SettingsManager::setPolynomialSamplingCounts(int counts)
 #endif
 
     m_polynomialIntraSamplingPointsNode->setValue(counts);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setMedianFilterAEnabled(bool enabled)
@@ -2482,6 +2833,8 @@ void DRS4SettingsManager::setMedianFilterAEnabled(bool enabled)
 #endif
 
     m_medianFilterActivated_A_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setMedianFilterBEnabled(bool enabled)
@@ -2491,6 +2844,8 @@ void DRS4SettingsManager::setMedianFilterBEnabled(bool enabled)
 #endif
 
     m_medianFilterActivated_B_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setMedianFilterWindowSizeA(int size)
@@ -2500,6 +2855,8 @@ void DRS4SettingsManager::setMedianFilterWindowSizeA(int size)
 #endif
 
     m_medianFilterWindowSize_A_Node->setValue(size);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setMedianFilterWindowSizeB(int size)
@@ -2509,6 +2866,8 @@ void DRS4SettingsManager::setMedianFilterWindowSizeB(int size)
 #endif
 
     m_medianFilterWindowSize_B_Node->setValue(size);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterNumberOfPulsesToBeRecordedA(int number)
@@ -2518,6 +2877,8 @@ void DRS4SettingsManager::setPulseShapeFilterNumberOfPulsesToBeRecordedA(int num
 #endif
 
     m_pulseShapeFilter_numberOfPulsesAcq_A_Node->setValue(number);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterNumberOfPulsesToBeRecordedB(int number)
@@ -2527,6 +2888,8 @@ void DRS4SettingsManager::setPulseShapeFilterNumberOfPulsesToBeRecordedB(int num
 #endif
 
     m_pulseShapeFilter_numberOfPulsesAcq_B_Node->setValue(number);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterLeftInNsOfA(double value)
@@ -2536,6 +2899,8 @@ void DRS4SettingsManager::setPulseShapeFilterLeftInNsOfA(double value)
 #endif
 
     m_pulseShapeFilter_leftAInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterLeftInNsOfB(double value)
@@ -2545,6 +2910,8 @@ void DRS4SettingsManager::setPulseShapeFilterLeftInNsOfB(double value)
 #endif
 
     m_pulseShapeFilter_leftBInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterRightInNsOfA(double value)
@@ -2554,6 +2921,8 @@ void DRS4SettingsManager::setPulseShapeFilterRightInNsOfA(double value)
 #endif
 
     m_pulseShapeFilter_rightAInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterRightInNsOfB(double value)
@@ -2563,6 +2932,8 @@ void DRS4SettingsManager::setPulseShapeFilterRightInNsOfB(double value)
 #endif
 
     m_pulseShapeFilter_rightBInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterROILeftInNsOfA(double value)
@@ -2572,6 +2943,8 @@ void DRS4SettingsManager::setPulseShapeFilterROILeftInNsOfA(double value)
 #endif
 
     m_pulseShapeFilter_ROIleftAInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterROILeftInNsOfB(double value)
@@ -2581,6 +2954,8 @@ void DRS4SettingsManager::setPulseShapeFilterROILeftInNsOfB(double value)
 #endif
 
     m_pulseShapeFilter_ROIleftBInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterROIRightInNsOfA(double value)
@@ -2590,6 +2965,8 @@ void DRS4SettingsManager::setPulseShapeFilterROIRightInNsOfA(double value)
 #endif
 
     m_pulseShapeFilter_ROIrightAInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterROIRightInNsOfB(double value)
@@ -2599,6 +2976,8 @@ void DRS4SettingsManager::setPulseShapeFilterROIRightInNsOfB(double value)
 #endif
 
     m_pulseShapeFilter_ROIrightBInNs_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterStdDevUpperFractionA(double value)
@@ -2608,6 +2987,8 @@ void DRS4SettingsManager::setPulseShapeFilterStdDevUpperFractionA(double value)
 #endif
 
     m_pulseShapeFilter_StdDevUpperFractA_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterStdDevLowerFractionA(double value)
@@ -2617,6 +2998,8 @@ void DRS4SettingsManager::setPulseShapeFilterStdDevLowerFractionA(double value)
 #endif
 
     m_pulseShapeFilter_StdDevLowerFractA_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterStdDevUpperFractionB(double value)
@@ -2626,6 +3009,8 @@ void DRS4SettingsManager::setPulseShapeFilterStdDevUpperFractionB(double value)
 #endif
 
     m_pulseShapeFilter_StdDevUpperFractB_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterStdDevLowerFractionB(double value)
@@ -2635,6 +3020,8 @@ void DRS4SettingsManager::setPulseShapeFilterStdDevLowerFractionB(double value)
 #endif
 
     m_pulseShapeFilter_StdDevLowerFractB_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterDataA(const DRS4PulseShapeFilterData &data, bool lockMutex)
@@ -2645,7 +3032,11 @@ void DRS4SettingsManager::setPulseShapeFilterDataA(const DRS4PulseShapeFilterDat
 #endif
     }
 
-    m_pulseShapeFilterDataA = data;
+    {
+        QMutexLocker configLocker(&m_analysisConfigMutex);
+
+        m_pulseShapeFilterDataA = data;
+    }
 
     QString valueMean = "";
     QString valueStdDev = "";
@@ -2657,6 +3048,8 @@ void DRS4SettingsManager::setPulseShapeFilterDataA(const DRS4PulseShapeFilterDat
 
     m_pulseShapeFilter_meanDataA_Node->setValue(valueMean);
     m_pulseShapeFilter_stddevDataA_Node->setValue(valueStdDev);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterDataB(const DRS4PulseShapeFilterData &data, bool lockMutex)
@@ -2667,7 +3060,11 @@ void DRS4SettingsManager::setPulseShapeFilterDataB(const DRS4PulseShapeFilterDat
 #endif
     }
 
-    m_pulseShapeFilterDataB = data;
+    {
+        QMutexLocker configLocker(&m_analysisConfigMutex);
+
+        m_pulseShapeFilterDataB = data;
+    }
 
     QString valueMean = "";
     QString valueStdDev = "";
@@ -2679,6 +3076,8 @@ void DRS4SettingsManager::setPulseShapeFilterDataB(const DRS4PulseShapeFilterDat
 
     m_pulseShapeFilter_meanDataB_Node->setValue(valueMean);
     m_pulseShapeFilter_stddevDataB_Node->setValue(valueStdDev);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterEnabledA(bool enabled)
@@ -2688,6 +3087,8 @@ void DRS4SettingsManager::setPulseShapeFilterEnabledA(bool enabled)
 #endif
 
     m_pulseShapeFilterEnabledA_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterEnabledB(bool enabled)
@@ -2697,6 +3098,8 @@ void DRS4SettingsManager::setPulseShapeFilterEnabledB(bool enabled)
 #endif
 
     m_pulseShapeFilterEnabledB_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseShapeFilterRecordScheme(const DRS4PulseShapeFilterRecordScheme::Scheme &rc)
@@ -2706,6 +3109,8 @@ void DRS4SettingsManager::setPulseShapeFilterRecordScheme(const DRS4PulseShapeFi
 #endif
 
     m_pulseShapeFilterRecordScheme_Node->setValue(rc);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationStartPeakCellA(int cell)
@@ -2715,6 +3120,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationStartPeakCellA(int cel
 #endif
 
     m_baseLineCorrectionStartCellPeakA_Node->setValue(cell);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationWindowA(int region)
@@ -2724,6 +3131,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationWindowA(int region)
 #endif
 
     m_baseLineCorrectionWindowA_Node->setValue(region);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionMethodA(DRS4BaselineCorrectionType::type type)
@@ -2733,6 +3142,8 @@ void DRS4SettingsManager::setBaselineCorrectionMethodA(DRS4BaselineCorrectionTyp
 #endif
 
     m_baseLineCorrectionMethodA_Node->setValue(type);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationStartCellA(int cell)
@@ -2742,6 +3153,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationStartCellA(int cell)
 #endif
 
     m_baseLineCorrectionStartCellA_Node->setValue(cell);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationRegionA(int region)
@@ -2751,6 +3164,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationRegionA(int region)
 #endif
 
     m_baseLineCorrectionRegionA_Node->setValue(region);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationEnabledA(bool enabled)
@@ -2760,6 +3175,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationEnabledA(bool enabled)
 #endif
 
     m_baseLineCorrectionEnabledA_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationShiftValueInMVA(double value)
@@ -2769,6 +3186,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationShiftValueInMVA(double
 #endif
 
     m_baseLineCorrectionShiftValueA_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationLimitInPercentageA(double limit)
@@ -2778,6 +3197,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationLimitInPercentageA(dou
 #endif
 
     m_baseLineCorrectionLimitA_Node->setValue(limit);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationLimitRejectLimitA(bool reject)
@@ -2787,6 +3208,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationLimitRejectLimitA(bool
 #endif
 
     m_baseLineCorrectionLimitExceededRejectA_Node->setValue(reject);
+
+    m_settingsVersion ++;
 }
 
 DRS4BaselineCorrectionType::type DRS4SettingsManager::baselineCorrectionMethodA() const
@@ -2877,6 +3300,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationStartPeakCellB(int cel
 #endif
 
     m_baseLineCorrectionStartCellPeakB_Node->setValue(cell);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationWindowB(int region)
@@ -2886,6 +3311,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationWindowB(int region)
 #endif
 
     m_baseLineCorrectionWindowB_Node->setValue(region);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionMethodB(DRS4BaselineCorrectionType::type type)
@@ -2895,6 +3322,8 @@ void DRS4SettingsManager::setBaselineCorrectionMethodB(DRS4BaselineCorrectionTyp
 #endif
 
     m_baseLineCorrectionMethodB_Node->setValue(type);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationStartCellB(int cell)
@@ -2904,6 +3333,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationStartCellB(int cell)
 #endif
 
     m_baseLineCorrectionStartCellB_Node->setValue(cell);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationRegionB(int region)
@@ -2913,6 +3344,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationRegionB(int region)
 #endif
 
     m_baseLineCorrectionRegionB_Node->setValue(region);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationEnabledB(bool enabled)
@@ -2922,6 +3355,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationEnabledB(bool enabled)
 #endif
 
     m_baseLineCorrectionEnabledB_Node->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationShiftValueInMVB(double value)
@@ -2931,6 +3366,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationShiftValueInMVB(double
 #endif
 
     m_baseLineCorrectionShiftValueB_Node->setValue(value);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationLimitInPercentageB(double limit)
@@ -2940,6 +3377,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationLimitInPercentageB(dou
 #endif
 
     m_baseLineCorrectionLimitB_Node->setValue(limit);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setBaselineCorrectionCalculationLimitRejectLimitB(bool reject)
@@ -2949,6 +3388,8 @@ void DRS4SettingsManager::setBaselineCorrectionCalculationLimitRejectLimitB(bool
 #endif
 
     m_baseLineCorrectionLimitExceededRejectB_Node->setValue(reject);
+
+    m_settingsVersion ++;
 }
 
 DRS4BaselineCorrectionType::type DRS4SettingsManager::baselineCorrectionMethodB() const
@@ -3292,6 +3733,8 @@ DRS4SplineInterpolationType::type DRS4SettingsManager::splineInterpolationType()
         return DRS4SplineInterpolationType::type::monotone;
     else if ( m_splineTypeTKCubicEnabledNode->getValue().toBool() )
         return DRS4SplineInterpolationType::type::tk_cubic;
+    else if ( m_splineTypeROICubicEnabledNode->getValue().toBool() )
+        return DRS4SplineInterpolationType::type::roi_cubic;
 
     return DRS4SplineInterpolationType::type::cubic;
 }
@@ -3613,6 +4056,8 @@ void DRS4SettingsManager::setPulseAreaFilterEnabled(bool enabled)
 
     m_bPulseAreaFilterEnabled = enabled;
     m_pulseAreaFilerEnabledNode->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setPulseAreaFilterPlotEnabled(bool enabled)
@@ -3623,6 +4068,8 @@ void DRS4SettingsManager::setPulseAreaFilterPlotEnabled(bool enabled)
 
     m_bPulseAreaFilterEnabledPlot = enabled;
     m_pulseAreaFilerEnabledPlotNode->setValue(enabled);
+
+    m_settingsVersion ++;
 }
 
 void DRS4SettingsManager::setStartChannelAMin(int min)
@@ -3633,6 +4080,8 @@ void DRS4SettingsManager::setStartChannelAMin(int min)
 
     m_startAChannelMin = min;
     m_startAChannelMinNode->setValue(min);
+
+    m_settingsVersion ++;
 }
 
 bool DRS4SettingsManager::isPositiveSignal() const
@@ -59,11 +59,16 @@
 
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSharedPointer>
+
+#include <atomic>
 
 #include "DLib.h"
 #include "Fit/dspline.h"
 #include "dversion.h"
 
+#include "drs4pulseshapefilterenvelope.h"
+
 #include "alglib.h"
 
 #define __PULSESHAPEFILTER_LEFT_MAX -200.0 /* [ns] */
@@ -149,6 +154,9 @@ public:
     void setData(const QVector<QPointF>& mean, const QVector<QPointF>& stddev);
     bool isInsideBounding(const double& x, const double& y, const double& lowerFraction, const double &upperFraction) const;
 
+    /* compiles the band used by isInsideBounding() into a lookup table across the ROI [-leftOfRefInNs ; rightOfRefInNs] */
+    void envelope(DRS4PulseShapeFilterEnvelope *envelope, double leftOfRefInNs, double rightOfRefInNs, double lowerFraction, double upperFraction) const;
+
     double getMeanAt(unsigned int index) const {
         if (index >= m_meanTrace.size())
             return 0.0;
@@ -268,6 +276,7 @@ public:
         type.append("Catmull-Rom - ALGLIB");
         type.append("Monotone - ALGLIB");
         type.append("Cubic - Tino Kluge");
+        type.append("Cubic (ROI) - DDRS4PALS");
 
         return type;
     }
@@ -281,7 +290,9 @@ public:
         catmullRom = 4,
         monotone = 5,
         /* Tino Kluge */
-        tk_cubic = 6
+        tk_cubic = 6,
+        /* in-tree: leading edge and peak only */
+        roi_cubic = 7
     };
 } DRS4SplineInterpolationType;
 
@@ -301,6 +312,132 @@ public:
     };
 } DRS4BaselineCorrectionType;
 
+/* immutable copy of all settings read by the acquisition loop (see DRS4SettingsManager::analysisConfig()):
+ * the worker compares the version once per event and reads plain fields instead of querying the xml-nodes. */
+class DRS4AnalysisConfig final
+{
+public:
+    quint64 m_version;
+
+    /* ROI */
+    int m_startCell;
+    int m_stopCell;
+
+    int m_channelNumberA;
+    int m_channelNumberB;
+
+    bool m_positiveSignal;
+    bool m_burstMode;
+    double m_sweepInNanoseconds;
+
+    /* CFD */
+    double m_cfdLevelA;
+    double m_cfdLevelB;
+
+    DRS4InterpolationType::type m_interpolationType;
+    DRS4SplineInterpolationType::type m_splineInterpolationType;
+    int m_splineIntraSamplingCounts;
+    int m_polynomialSamplingCounts;
+
+    /* PHS */
+    int m_startChannelAMin, m_startChannelAMax;
+    int m_stopChannelAMin, m_stopChannelAMax;
+
+    int m_startChannelBMin, m_startChannelBMax;
+    int m_stopChannelBMin, m_stopChannelBMax;
+
+    /* Lifetime-Spectra */
+    int m_channelCntAB, m_channelCntBA, m_channelCntCoincidence, m_channelCntMerged;
+    double m_offsetInNSAB, m_offsetInNSBA, m_offsetInNSCoincidence, m_offsetInNSMerged;
+    double m_scalerInNSAB, m_scalerInNSBA, m_scalerInNSCoincidence, m_scalerInNSMerged;
+
+    double m_meanCableDelay;
+
+    bool m_negativeLTAccepted;
+    bool m_forceCoincidence;
+
+    /* Area-Filter */
+    bool m_pulseAreaFilterEnabled;
+    bool m_pulseAreaFilterPlotEnabled;
+
+    int m_pulseAreaFilterBinningA;
+    int m_pulseAreaFilterBinningB;
+
+    double m_pulseAreaFilterNormalizationA;
+    double m_pulseAreaFilterNormalizationB;
+
+    /* Rise-Time Filter */
+    bool m_riseTimeFilterEnabled;
+
+    double m_riseTimeFilterScaleInNanosecondsOfA;
+    double m_riseTimeFilterScaleInNanosecondsOfB;
+
+    int m_riseTimeFilterBinningOfA;
+    int m_riseTimeFilterBinningOfB;
+
+    int m_riseTimeFilterLeftWindowOfA;
+    int m_riseTimeFilterLeftWindowOfB;
+
+    int m_riseTimeFilterRightWindowOfA;
+    int m_riseTimeFilterRightWindowOfB;
+
+    /* Persistance */
+    bool m_persistanceEnabled;
+
+    bool m_persistanceUsingCFDBAsRefForA;
+    bool m_persistanceUsingCFDAAsRefForB;
+
+    /* Median-Filter */
+    bool m_medianFilterAEnabled;
+    bool m_medianFilterBEnabled;
+
+    int m_medianFilterWindowSizeA;
+    int m_medianFilterWindowSizeB;
+
+    /* Baseline - Jitter Corrections */
+    DRS4BaselineCorrectionType::type m_baselineCorrectionMethodA;
+    int m_baselineCorrectionStartPeakCellA;
+    int m_baselineCorrectionWindowA;
+    bool m_baselineCorrectionEnabledA;
+    int m_baselineCorrectionStartCellA;
+    int m_baselineCorrectionRegionA;
+    double m_baselineCorrectionShiftValueInMVA;
+    bool m_baselineCorrectionLimitRejectLimitA;
+    double m_baselineCorrectionLimitInPercentageA;
+
+    DRS4BaselineCorrectionType::type m_baselineCorrectionMethodB;
+    int m_baselineCorrectionStartPeakCellB;
+    int m_baselineCorrectionWindowB;
+    bool m_baselineCorrectionEnabledB;
+    int m_baselineCorrectionStartCellB;
+    int m_baselineCorrectionRegionB;
+    double m_baselineCorrectionShiftValueInMVB;
+    bool m_baselineCorrectionLimitRejectLimitB;
+    double m_baselineCorrectionLimitInPercentageB;
+
+    /* Shape-Filter */
+    bool m_pulseShapeFilterEnabledA;
+    bool m_pulseShapeFilterEnabledB;
+
+    DRS4PulseShapeFilterRecordScheme::Scheme m_pulseShapeFilterRecordScheme;
+
+    double m_pulseShapeFilterROILeftInNsOfA, m_pulseShapeFilterROIRightInNsOfA;
+    double m_pulseShapeFilterROILeftInNsOfB, m_pulseShapeFilterROIRightInNsOfB;
+
+    double m_pulseShapeFilterStdDevUpperFractionA, m_pulseShapeFilterStdDevLowerFractionA;
+    double m_pulseShapeFilterStdDevUpperFractionB, m_pulseShapeFilterStdDevLowerFractionB;
+
+    /* copies taken for this version: the settings may be changed by the GUI meanwhile */
+    DRS4PulseShapeFilterData m_pulseShapeFilterDataA;
+    DRS4PulseShapeFilterData m_pulseShapeFilterDataB;
+
+    /* band of the shape-filter compiled for this version */
+    DRS4PulseShapeFilterEnvelope m_pulseShapeFilterEnvelopeA;
+    DRS4PulseShapeFilterEnvelope m_pulseShapeFilterEnvelopeB;
+};
+
+typedef QSharedPointer<const DRS4AnalysisConfig> DRS4AnalysisConfigPtr;
+
 class DRS4SettingsManager
 {
     DRS4SettingsManager();
@@ -461,6 +598,8 @@ class DRS4SettingsManager
     DSimpleXMLNode *m_splineTypeMonotoneEnabledNode;
     DSimpleXMLNode *m_splineTypeTKCubicNode;
     DSimpleXMLNode *m_splineTypeTKCubicEnabledNode;
+    DSimpleXMLNode *m_splineTypeROICubicNode;
+    DSimpleXMLNode *m_splineTypeROICubicEnabledNode;
     DSimpleXMLNode *m_splineIntraSamplingPointsNode;
     DSimpleXMLNode *m_phsSettingsNode;
     DSimpleXMLNode *m_spectrumSettingsNode;
@@ -604,6 +743,12 @@ class DRS4SettingsManager
 
     mutable QMutex m_mutex;
 
+    /* incremented by each setter and load(): marks the cached analysis config as outdated */
+    std::atomic<quint64> m_settingsVersion;
+
+    mutable DRS4AnalysisConfigPtr m_analysisConfig;
+    mutable QMutex m_analysisConfigMutex;
+
 public:
     static DRS4SettingsManager *sharedInstance();
 
@@ -614,6 +759,9 @@ public:
 
     QMutex *mutex();
 
+    quint64 settingsVersion() const;
+    DRS4AnalysisConfigPtr analysisConfig() const;
+
 public:
     void parsePulseShapeData(DSimpleXMLNode *node, QVector<QPointF> *filterData);
 
@@ -61,13 +61,17 @@ DRS4Worker::DRS4Worker(DRS4WorkerDataExchange *dataExchange, QObject *parent) :
     m_dataExchange(dataExchange),
     QObject(parent),
     m_nextSignal(true),
-    m_isBlocking(false),
+    m_parkedStages(0),
+    m_stagesToPark(1),
     m_isRunning(false),
+    m_snapshotVersion(0),
+    m_boardTemperature(-1.),
     m_isRecordingForShapeFilterA(false),
     m_isRecordingForShapeFilterB(false),
     m_pulseShapeDataAmountA(0),
     m_pulseShapeDataAmountB(0) {
     m_workerConcurrentManager = new DRS4WorkerConcurrentManager(this);
+    m_pipeline = new DRS4WorkerPipeline(this);
 
     resetPHSA();
     resetPHSB();
@@ -87,17 +91,18 @@ DRS4Worker::DRS4Worker(DRS4WorkerDataExchange *dataExchange, QObject *parent) :
     resetMergedSpectrum();
 
     resetLifetimeEfficiencyCounter();
+
+    publishSnapshot();
 }
 
 DRS4Worker::~DRS4Worker() {
+    DDELETE_SAFETY(m_pipeline);
     DDELETE_SAFETY(m_workerConcurrentManager);
 }
 
 void DRS4Worker::initDRS4Worker() {}
 
 void DRS4Worker::start() {
-    m_copyData.clear();
-
     if ( !DRS4BoardManager::sharedInstance()->currentBoard() ) {
         DRS4BoardManager::sharedInstance()->setDemoMode(true);
     }
@@ -111,8 +116,14 @@ void DRS4Worker::start() {
 
 void DRS4Worker::stop()
 {
-    m_copyData.clear();
-    m_isRunning = false;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_isRunning = false;
+
+        /* release a paused acquisition loop */
+        m_nextSignalCondition.wakeAll();
+    }
 
     emit stopped();
 }
@@ -459,12 +470,17 @@ void DRS4Worker::setBusy(bool busy)
         return;
 
     m_nextSignal = !busy;
+
+    if (m_nextSignal)
+        m_nextSignalCondition.wakeAll();
 }
 
 void DRS4Worker::resetPHSA()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::phsA);
+
     m_phsACounts = 0;
     m_phsACounts_post = 0;
 
@@ -477,12 +493,16 @@ void DRS4Worker::resetPHSA()
 
     m_pulseCounterCnt = 0;
     m_pulseCounterCntAvg = 0;
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetPHSB()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::phsB);
+
     m_phsBCounts = 0;
     m_phsBCounts_post = 0;
 
@@ -495,6 +515,8 @@ void DRS4Worker::resetPHSB()
 
     m_pulseCounterCnt = 0;
     m_pulseCounterCntAvg = 0;
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetPulseA()
@@ -622,6 +644,8 @@ void DRS4Worker::resetAreaFilterA()
     m_areaFilterCollectedDataA.fill(QPointF(0.0, 0.0), kNumberOfBins);
     m_areaFilterCollectedDataA_raw.fill(0., kNumberOfBins);
     m_areaFilterCollectedDataCounterA.fill(0, kNumberOfBins);
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetAreaFilterB()
@@ -635,6 +659,8 @@ void DRS4Worker::resetAreaFilterB()
     m_areaFilterCollectedDataB.fill(QPointF(0.0, 0.0), kNumberOfBins);
     m_areaFilterCollectedDataB_raw.fill(0., kNumberOfBins);
     m_areaFilterCollectedDataCounterB.fill(0, kNumberOfBins);
+
+    publishSnapshot();
 }
 
 QVector<QPointF> *DRS4Worker::areaFilterAData()
@@ -711,18 +737,26 @@ void DRS4Worker::resetRiseTimeFilterA()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::riseTimeFilterA);
+
     m_riseTimeFilterACounter = 0;
     m_maxY_RiseTimeSpectrumA = 0;
     m_riseTimeFilterDataA.fill(-1, DRS4SettingsManager::sharedInstance()->riseTimeFilterBinningOfA());
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetRiseTimeFilterB()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::riseTimeFilterB);
+
     m_riseTimeFilterBCounter = 0;
     m_maxY_RiseTimeSpectrumB = 0;
     m_riseTimeFilterDataB.fill(-1, DRS4SettingsManager::sharedInstance()->riseTimeFilterBinningOfB());
+
+    publishSnapshot();
 }
 
 QVector<int> *DRS4Worker::riseTimeFilterAData()
@@ -757,46 +791,62 @@ void DRS4Worker::resetABSpectrum()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::abSpectrum);
+
     m_abCounts = 0;
     m_lifeTimeDataAB.fill(0, DRS4SettingsManager::sharedInstance()->channelCntAB());
 
     m_maxY_ABSpectrum = 0;
 
     m_startAqAB = QDateTime::currentDateTime();
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetBASpectrum()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::baSpectrum);
+
     m_baCounts = 0;
     m_lifeTimeDataBA.fill(0, DRS4SettingsManager::sharedInstance()->channelCntBA());
 
     m_maxY_BASpectrum = 0;
 
     m_startAqBA = QDateTime::currentDateTime();
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetMergedSpectrum()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::mergedSpectrum);
+
     m_mergedCounts = 0;
     m_lifeTimeDataMerged.fill(0, DRS4SettingsManager::sharedInstance()->channelCntMerged());
     m_maxY_MergedSpectrum = 0;
     m_startAqMerged = QDateTime::currentDateTime();
+
+    publishSnapshot();
 }
 
 void DRS4Worker::resetCoincidenceSpectrum()
 {
     QMutexLocker locker(&m_mutex);
 
+    m_workerConcurrentManager->resetHistograms(DRS4ConcurrentHistogramsType::coincidenceSpectrum);
+
     m_coincidenceCounts = 0;
     m_lifeTimeDataCoincidence.fill(0, DRS4SettingsManager::sharedInstance()->channelCntCoincindence());
 
     m_maxY_CoincidenceSpectrum = 0;
 
     m_startAqPrompt = QDateTime::currentDateTime();
+
+    publishSnapshot();
 }
 
 QVector<int> *DRS4Worker::spectrumAB()
@@ -1049,6 +1099,94 @@ int DRS4Worker::maxThreads() const
     return m_workerConcurrentManager->maxThreads();
 }
 
+int DRS4Worker::eventRingCapacity() const
+{
+    return m_workerConcurrentManager->m_eventRing->capacity();
+}
+
+int DRS4Worker::eventRingOccupancy() const
+{
+    return m_workerConcurrentManager->m_eventRing->size();
+}
+
+int DRS4Worker::eventRingHighWaterMark() const
+{
+    return m_workerConcurrentManager->m_eventRing->highWaterMark();
+}
+
+quint64 DRS4Worker::eventRingPublishedEvents() const
+{
+    return m_workerConcurrentManager->m_eventRing->publishedEvents();
+}
+
+quint64 DRS4Worker::eventRingDroppedEvents() const
+{
+    return m_workerConcurrentManager->m_eventRing->droppedEvents();
+}
+
+DRS4PipelineStageInfo DRS4Worker::pipelineStageInfo(DRS4PipelineStageType::type stage) const
+{
+    DRS4PipelineStageInfo info;
+
+    const DRS4PipelineStageStatistics& statistics = (stage == DRS4PipelineStageType::analyze)?(m_workerConcurrentManager->m_statistics):(m_pipeline->m_statistics[stage]);
+
+    info.m_processedEvents = statistics.m_processedEvents.load(std::memory_order_relaxed);
+    info.m_stalls = statistics.m_stalls.load(std::memory_order_relaxed);
+    info.m_idleCycles = statistics.m_idleCycles.load(std::memory_order_relaxed);
+
+    switch (stage) {
+    case DRS4PipelineStageType::readout: {
+        info.m_droppedEvents = m_pipeline->m_readoutQueue->droppedEvents();
+    }
+        break;
+    case DRS4PipelineStageType::decode: {
+        info.m_queueCapacity = m_pipeline->m_readoutQueue->capacity();
+        info.m_queueOccupancy = m_pipeline->m_readoutQueue->size();
+        info.m_queueHighWaterMark = m_pipeline->m_readoutQueue->highWaterMark();
+        info.m_droppedEvents = m_workerConcurrentManager->m_eventRing->droppedEvents();
+    }
+        break;
+    case DRS4PipelineStageType::analyze: {
+        info.m_queueCapacity = m_workerConcurrentManager->m_eventRing->capacity();
+        info.m_queueOccupancy = m_workerConcurrentManager->m_eventRing->size();
+        info.m_queueHighWaterMark = m_workerConcurrentManager->m_eventRing->highWaterMark();
+    }
+        break;
+    case DRS4PipelineStageType::histogram: {
+        /* the hand-over histograms of the analysis threads */
+        info.m_queueCapacity = m_workerConcurrentManager->maxThreads();
+        info.m_queueOccupancy = m_workerConcurrentManager->pendingHistograms();
+        info.m_queueHighWaterMark = statistics.m_highWaterMark.load(std::memory_order_relaxed);
+    }
+        break;
+    case DRS4PipelineStageType::persist: {
+        info.m_queueCapacity = m_pipeline->m_persistQueue->capacity();
+        info.m_queueOccupancy = m_pipeline->m_persistQueue->size();
+        info.m_queueHighWaterMark = m_pipeline->m_persistQueue->highWaterMark();
+    }
+        break;
+    default:
+        break;
+    }
+
+    return info;
+}
+
+int DRS4Worker::pulsePairChunkSize() const
+{
+    return m_workerConcurrentManager->chunkSize();
+}
+
+bool DRS4Worker::isPulsePairChunkSizeAdaptive() const
+{
+    return m_workerConcurrentManager->isChunkSizeAdaptive();
+}
+
+QVector<DRS4ChunkSizeSample> DRS4Worker::pulsePairChunkSizeHistory() const
+{
+    return m_workerConcurrentManager->chunkSizeHistory();
+}
+
 QVector<int> *DRS4Worker::spectrumMerged()
 {
     QMutexLocker locker(&m_mutex);
@@ -1070,7 +1208,285 @@ bool DRS4Worker::isBlocking() const
     if (!m_isRunning)
         return true;
 
-    return m_isBlocking;
+    return (m_parkedStages >= m_stagesToPark);
+}
+
+DRS4WorkerSnapshotPtr DRS4Worker::snapshot() const
+{
+    QMutexLocker locker(&m_snapshotMutex);
+
+    return m_snapshot;
+}
+
+void DRS4Worker::waitForNextSignal()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if ( m_nextSignal || !m_isRunning )
+        return;
+
+    /* sleep instead of spinning as long as the worker is held via setBusy(true) */
+    m_parkedStages ++;
+
+    while ( !m_nextSignal && m_isRunning )
+        m_nextSignalCondition.wait(&m_mutex);
+
+    m_parkedStages --;
+}
+
+void DRS4Worker::publishSnapshot()
+{
+    DRS4WorkerSnapshot *snapshot = new DRS4WorkerSnapshot;
+
+    snapshot->m_version = ++ m_snapshotVersion;
+
+    snapshot->m_boardTemperature = m_boardTemperature;
+
+    /* implicitly shared: the vectors are detached not before the worker writes the next time */
+    snapshot->m_pulseDataA = m_pListChannelA;
+    snapshot->m_pulseDataB = m_pListChannelB;
+    snapshot->m_pulseSplineDataA = m_pListChannelASpline;
+    snapshot->m_pulseSplineDataB = m_pListChannelBSpline;
+
+    snapshot->m_phsA = m_phsA;
+    snapshot->m_phsB = m_phsB;
+    snapshot->m_phsA_post = m_phsA_post;
+    snapshot->m_phsB_post = m_phsB_post;
+
+    snapshot->m_phsACounts = m_phsACounts;
+    snapshot->m_phsBCounts = m_phsBCounts;
+    snapshot->m_phsACounts_post = m_phsACounts_post;
+    snapshot->m_phsBCounts_post = m_phsBCounts_post;
+
+    snapshot->m_avgPulseCountRateInHz = m_avgPulseCountRateInSeconds;
+    snapshot->m_currentPulseCountRateInHz = m_currentPulseCountRateInSeconds;
+
+    snapshot->m_areaFilterDataA = m_areaFilterDataA;
+    snapshot->m_areaFilterDataB = m_areaFilterDataB;
+    snapshot->m_areaFilterCollectedDataA_raw = m_areaFilterCollectedDataA_raw;
+    snapshot->m_areaFilterCollectedDataB_raw = m_areaFilterCollectedDataB_raw;
+
+    snapshot->m_areaFilterCollectedACounter = m_areaFilterCollectedACounter;
+    snapshot->m_areaFilterCollectedBCounter = m_areaFilterCollectedBCounter;
+
+    snapshot->m_riseTimeFilterDataA = m_riseTimeFilterDataA;
+    snapshot->m_riseTimeFilterDataB = m_riseTimeFilterDataB;
+
+    snapshot->m_maxY_RiseTimeSpectrumA = m_maxY_RiseTimeSpectrumA;
+    snapshot->m_maxY_RiseTimeSpectrumB = m_maxY_RiseTimeSpectrumB;
+
+    snapshot->m_lifeTimeDataAB = m_lifeTimeDataAB;
+    snapshot->m_lifeTimeDataBA = m_lifeTimeDataBA;
+    snapshot->m_lifeTimeDataCoincidence = m_lifeTimeDataCoincidence;
+    snapshot->m_lifeTimeDataMerged = m_lifeTimeDataMerged;
+
+    snapshot->m_abCounts = m_abCounts;
+    snapshot->m_baCounts = m_baCounts;
+    snapshot->m_mergedCounts = m_mergedCounts;
+    snapshot->m_coincidenceCounts = m_coincidenceCounts;
+
+    snapshot->m_maxY_ABSpectrum = m_maxY_ABSpectrum;
+    snapshot->m_maxY_BASpectrum = m_maxY_BASpectrum;
+    snapshot->m_maxY_CoincidenceSpectrum = m_maxY_CoincidenceSpectrum;
+    snapshot->m_maxY_MergedSpectrum = m_maxY_MergedSpectrum;
+
+    snapshot->m_avgABSpecCountRateInHz = m_avgABSpecCountRateInSeconds;
+    snapshot->m_avgBASpecCountRateInHz = m_avgBASpecCountRateInSeconds;
+    snapshot->m_avgMergedSpecCountRateInHz = m_avgMergedSpecCountRateInSeconds;
+    snapshot->m_avgCoincidenceSpecCountRateInHz = m_avgCoincidenceSpecCountRateInSeconds;
+
+    snapshot->m_currentABSpecCountRateInHz = m_currentABSpecCountRateInSeconds;
+    snapshot->m_currentBASpecCountRateInHz = m_currentBASpecCountRateInSeconds;
+    snapshot->m_currentMergedSpecCountRateInHz = m_currentMergedSpecCountRateInSeconds;
+    snapshot->m_currentCoincidenceSpecCountRateInHz = m_currentCoincidenceSpecCountRateInSeconds;
+
+    snapshot->m_persistanceDataA = m_persistanceDataA;
+    snapshot->m_persistanceDataB = m_persistanceDataB;
+
+    const DRS4WorkerSnapshotPtr ptr(snapshot);
+
+    {
+        QMutexLocker locker(&m_snapshotMutex);
+
+        m_snapshot = ptr;
+    }
+
+    m_snapshotTimer.restart();
+}
+
+void DRS4Worker::publishSnapshotOnInterval()
+{
+    if ( m_snapshotTimer.isValid()
+         && m_snapshotTimer.elapsed() < __WORKER_SNAPSHOT_INTERVAL )
+        return;
+
+    publishSnapshot();
+}
+
+const DRS4AnalysisConfig *DRS4Worker::updateAnalysisConfig()
+{
+    const quint64 version = DRS4SettingsManager::sharedInstance()->settingsVersion();
+
+    if ( !m_analysisConfig
+         || m_analysisConfig->m_version != version )
+        m_analysisConfig = DRS4SettingsManager::sharedInstance()->analysisConfig();
+
+    return m_analysisConfig.data();
+}
+
+const DRS4ConcurrentSharedInputDataPtr& DRS4Worker::updateConcurrentSharedInputData(const DRS4AnalysisConfig *config)
+{
+    const DRS4ConcurrentSharedInputData *current = m_concurrentSharedInputData.data();
+
+    /* the recording ends within merge() on the histogram stage: read once per event */
+    const bool bRecordingA = m_isRecordingForShapeFilterA.load();
+    const bool bRecordingB = m_isRecordingForShapeFilterB.load();
+
+    if ( current
+         && current->m_configVersion == config->m_version
+         && current->m_pulseShapeFilterAIsRecording == bRecordingA
+         && current->m_pulseShapeFilterBIsRecording == bRecordingB
+         && current->m_areaFilterASlopeUpper == *m_dataExchange->m_areaFilterASlopeUpper
+         && current->m_areaFilterAInterceptUpper == *m_dataExchange->m_areaFilterAInterceptUpper
+         && current->m_areaFilterASlopeLower == *m_dataExchange->m_areaFilterASlopeLower
+         && current->m_areaFilterAInterceptLower == *m_dataExchange->m_areaFilterAInterceptLower
+         && current->m_areaFilterBSlopeUpper == *m_dataExchange->m_areaFilterBSlopeUpper
+         && current->m_areaFilterBInterceptUpper == *m_dataExchange->m_areaFilterBInterceptUpper
+         && current->m_areaFilterBSlopeLower == *m_dataExchange->m_areaFilterBSlopeLower
+         && current->m_areaFilterBInterceptLower == *m_dataExchange->m_areaFilterBInterceptLower )
+        return m_concurrentSharedInputData;
+
+    DRS4ConcurrentSharedInputData *sharedData = new DRS4ConcurrentSharedInputData;
+
+    sharedData->m_configVersion = config->m_version;
+
+    /* ROI variables */
+    sharedData->m_startCell = config->m_startCell;
+    sharedData->m_endRange = config->m_stopCell;
+    sharedData->m_stopCellWidth = (kNumberOfBins - config->m_stopCell);
+    sharedData->m_cellWidth = (kNumberOfBins - sharedData->m_startCell - sharedData->m_stopCellWidth);
+
+    sharedData->m_positiveSignal = config->m_positiveSignal;
+    sharedData->m_cfdA = config->m_cfdLevelA;
+    sharedData->m_cfdB = config->m_cfdLevelB;
+    sharedData->m_bBurstMode = config->m_burstMode;
+    sharedData->m_sweep = config->m_sweepInNanoseconds;
+    sharedData->m_bPulseAreaPlot = config->m_pulseAreaFilterPlotEnabled;
+    sharedData->m_bPulseAreaFilter = config->m_pulseAreaFilterEnabled;
+    sharedData->m_bPulseRiseTimeFilter = config->m_riseTimeFilterEnabled;
+
+    sharedData->m_interpolationType = config->m_interpolationType;
+    sharedData->m_splineInterpolationType = config->m_splineInterpolationType;
+    sharedData->m_intraRenderPoints = (sharedData->m_interpolationType == DRS4InterpolationType::type::spline)?(config->m_splineIntraSamplingCounts):(config->m_polynomialSamplingCounts);
+
+    sharedData->m_bPersistance = config->m_persistanceEnabled;
+
+    sharedData->m_pulseAreaFilterBinningA = config->m_pulseAreaFilterBinningA;
+    sharedData->m_pulseAreaFilterBinningB = config->m_pulseAreaFilterBinningB;
+    sharedData->m_pulseAreaFilterNormA = config->m_pulseAreaFilterNormalizationA;
+    sharedData->m_pulseAreaFilterNormB = config->m_pulseAreaFilterNormalizationB;
+
+    sharedData->m_areaFilterASlopeUpper = *m_dataExchange->m_areaFilterASlopeUpper;
+    sharedData->m_areaFilterAInterceptUpper = *m_dataExchange->m_areaFilterAInterceptUpper;
+
+    sharedData->m_areaFilterASlopeLower = *m_dataExchange->m_areaFilterASlopeLower;
+    sharedData->m_areaFilterAInterceptLower = *m_dataExchange->m_areaFilterAInterceptLower;
+
+    sharedData->m_areaFilterBSlopeUpper = *m_dataExchange->m_areaFilterBSlopeUpper;
+    sharedData->m_areaFilterBInterceptUpper = *m_dataExchange->m_areaFilterBInterceptUpper;
+
+    sharedData->m_areaFilterBSlopeLower = *m_dataExchange->m_areaFilterBSlopeLower;
+    sharedData->m_areaFilterBInterceptLower = *m_dataExchange->m_areaFilterBInterceptLower;
+
+    sharedData->m_riseTimeFilterARangeInNanoseconds = config->m_riseTimeFilterScaleInNanosecondsOfA;
+    sharedData->m_riseTimeFilterBRangeInNanoseconds = config->m_riseTimeFilterScaleInNanosecondsOfB;
+
+    sharedData->m_riseTimeFilterBinningA = config->m_riseTimeFilterBinningOfA;
+    sharedData->m_riseTimeFilterBinningB = config->m_riseTimeFilterBinningOfB;
+
+    sharedData->m_riseTimeFilterLeftWindowA = config->m_riseTimeFilterLeftWindowOfA;
+    sharedData->m_riseTimeFilterLeftWindowB = config->m_riseTimeFilterLeftWindowOfB;
+
+    sharedData->m_riseTimeFilterRightWindowA = config->m_riseTimeFilterRightWindowOfA;
+    sharedData->m_riseTimeFilterRightWindowB = config->m_riseTimeFilterRightWindowOfB;
+
+    sharedData->m_pulseShapeFilterAIsRecording = bRecordingA;
+    sharedData->m_pulseShapeFilterBIsRecording = bRecordingB;
+
+    sharedData->m_pulseShapeFilterEnabledA = config->m_pulseShapeFilterEnabledA;
+    sharedData->m_pulseShapeFilterEnabledB = config->m_pulseShapeFilterEnabledB;
+
+    sharedData->m_pulseShapeFilterLeftInNsROIA = config->m_pulseShapeFilterROILeftInNsOfA;
+    sharedData->m_pulseShapeFilterRightInNsROIA = config->m_pulseShapeFilterROIRightInNsOfA;
+
+    sharedData->m_pulseShapeFilterLeftInNsROIB = config->m_pulseShapeFilterROILeftInNsOfB;
+    sharedData->m_pulseShapeFilterRightInNsROIB = config->m_pulseShapeFilterROIRightInNsOfB;
+
+    sharedData->m_pulseShapeFilterFractOfStdDevLowerA = config->m_pulseShapeFilterStdDevLowerFractionA;
+    sharedData->m_pulseShapeFilterFractOfStdDevUpperA = config->m_pulseShapeFilterStdDevUpperFractionA;
+
+    sharedData->m_pulseShapeFilterFractOfStdDevLowerB = config->m_pulseShapeFilterStdDevLowerFractionB;
+    sharedData->m_pulseShapeFilterFractOfStdDevUpperB = config->m_pulseShapeFilterStdDevUpperFractionB;
+
+    sharedData->m_rcScheme = config->m_pulseShapeFilterRecordScheme;
+
+    /* the band of the filter is compiled once per config version (not per event) */
+    sharedData->m_pulseShapeFilterEnvelopeA = config->m_pulseShapeFilterEnvelopeA;
+    sharedData->m_pulseShapeFilterEnvelopeB = config->m_pulseShapeFilterEnvelopeB;
+
+    sharedData->m_channelCntAB = config->m_channelCntAB;
+    sharedData->m_channelCntBA = config->m_channelCntBA;
+    sharedData->m_channelCntPrompt = config->m_channelCntCoincidence;
+    sharedData->m_channelCntMerged = config->m_channelCntMerged;
+
+    sharedData->m_offsetAB = config->m_offsetInNSAB;
+    sharedData->m_offsetBA = config->m_offsetInNSBA;
+    sharedData->m_offsetPrompt = config->m_offsetInNSCoincidence;
+    sharedData->m_offsetMerged = config->m_offsetInNSMerged;
+
+    sharedData->m_scalerAB = config->m_scalerInNSAB;
+    sharedData->m_scalerBA = config->m_scalerInNSBA;
+    sharedData->m_scalerPrompt = config->m_scalerInNSCoincidence;
+    sharedData->m_scalerMerged = config->m_scalerInNSMerged;
+
+    sharedData->m_ATS = config->m_meanCableDelay;
+
+    sharedData->m_bNegativeLT = config->m_negativeLTAccepted;
+    sharedData->m_bForcePrompt = config->m_forceCoincidence;
+
+    sharedData->m_startAMinPHS = config->m_startChannelAMin;
+    sharedData->m_startAMaxPHS = config->m_startChannelAMax;
+    sharedData->m_startBMinPHS = config->m_startChannelBMin;
+    sharedData->m_startBMaxPHS = config->m_startChannelBMax;
+
+    sharedData->m_stopAMinPHS = config->m_stopChannelAMin;
+    sharedData->m_stopAMaxPHS = config->m_stopChannelAMax;
+    sharedData->m_stopBMinPHS = config->m_stopChannelBMin;
+    sharedData->m_stopBMaxPHS = config->m_stopChannelBMax;
+
+    sharedData->m_bMedianFilterA = config->m_medianFilterAEnabled;
+    sharedData->m_bMedianFilterB = config->m_medianFilterBEnabled;
+    sharedData->m_medianFilterWindowSizeA = config->m_medianFilterWindowSizeA;
+    sharedData->m_medianFilterWindowSizeB = config->m_medianFilterWindowSizeB;
+
+    m_concurrentSharedInputData = DRS4ConcurrentSharedInputDataPtr(sharedData);
+
+    return m_concurrentSharedInputData;
+}
+
+void DRS4Worker::updateBoardTemperature(bool bDemoMode)
+{
+    if ( bDemoMode ) {
+        m_boardTemperature = -1.;
+
+        return;
+    }
+
+    try {
+        m_boardTemperature = DRS4BoardManager::sharedInstance()->currentBoard()->GetTemperature();
+    }
+    catch ( ... ) {
+    }
 }
 
 bool DRS4Worker::isRunning() const
@@ -1082,21 +1498,56 @@ bool DRS4Worker::isRunning() const
 
 void DRS4Worker::run()
 {
+    DRS4BoardManager::sharedInstance()->setAcquisitionRunning(true);
+
     if (DRS4ProgramSettingsManager::sharedInstance()->isMulticoreThreadingEnabled())
         runMultiThreaded();
     else
         runSingleThreaded();
+
+    DRS4BoardManager::sharedInstance()->setAcquisitionRunning(false);
+}
+
+/* processing window [first ; last[ of a channel: the ROI extended by the cells read by the baseline correction and the pulse-shape filter
+ * (incl. its recording) - the whole waveform if 'bWholeWaveform'. Median filter and baseline correction are restricted to this window. */
+static inline void processingWindow(const float *time, int startCell, int endRange, bool bWholeWaveform,
+                                    const DRS4BaselineCorrection& baselineCorrection,
+                                    const DRS4PulseShapeFilterEnvelope *pulseShapeFilterEnvelope, bool bPulseShapeFilterRecording,
+                                    int *first, int *last)
+{
+    if (bWholeWaveform) {
+        *first = 0;
+        *last = kNumberOfBins;
+
+        return;
+    }
+
+    *first = startCell;
+    *last = endRange;
+
+    if (pulseShapeFilterEnvelope)
+        pulseShapeFilterEnvelope->extendCellRange(time, kNumberOfBins, first, last);
+
+    if (bPulseShapeFilterRecording)
+        DRS4PulseShapeFilterEnvelope::extendCellRange(time, kNumberOfBins, __PULSESHAPEFILTER_LEFT_MAX, __PULSESHAPEFILTER_RIGHT_MAX, first, last);
+
+    baselineCorrection.extendCellRange(kNumberOfBins, first, last);
 }
 
 void DRS4Worker::runSingleThreaded()
 {
-    DSpline tkSplineA, tkSplineB;
+    bool bPulsePairKernelSelected = false;
+    quint64 pulsePairKernelVersion = 0;
 
     const int sizeOfWave = sizeof(float)*kNumberOfBins;
     const int sizeOfFloat = 1/sizeof(float);
 
-    m_isBlocking = false;
-    m_isRunning = true;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_stagesToPark = 1;
+        m_isRunning = true;
+    }
 
     const bool bDemoMode = DRS4BoardManager::sharedInstance()->isDemoModeEnabled();
     const bool bIgnoreBusyState = DRS4SettingsManager::sharedInstance()->ignoreBusyState(); /* this value is deprecated and for test purposes only */
@@ -1110,9 +1561,13 @@ void DRS4Worker::runSingleThreaded()
     time(&start);
     time(&stop);
 
+    updateBoardTemperature(bDemoMode);
+
+    DRS4RejectFilterCounter rejectCounter;
+
     forever {
         if ( !m_isRunning ) {
-            m_isBlocking = false;
+            publishSnapshot();
 
             return;
         }
@@ -1120,12 +1575,10 @@ void DRS4Worker::runSingleThreaded()
         if (!bIgnoreBusyState) {
             if (!bDemoMode) {
                 while ( !DRS4BoardManager::sharedInstance()->currentBoard()->IsEventAvailable()) {
-                    while ( !nextSignal() ) {
-                        m_isBlocking = true;
-                    }
+                    waitForNextSignal();
 
                     if ( !m_isRunning ) {
-                        m_isBlocking = false;
+                        publishSnapshot();
 
                         return;
                     }
@@ -1133,14 +1586,17 @@ void DRS4Worker::runSingleThreaded()
             }
         }
 
-        while ( !nextSignal() ) {
-            m_isBlocking = true;
-        }
+        waitForNextSignal();
+
+        publishSnapshotOnInterval();
 
-        m_isBlocking = false;
+        rejectCounter.nextEvent();
 
-        const int chnA = DRS4SettingsManager::sharedInstance()->channelNumberA();
-        const int chnB = DRS4SettingsManager::sharedInstance()->channelNumberB();
+        /* settings are taken from an immutable copy: no xml-node access within the loop */
+        const DRS4AnalysisConfig *config = updateAnalysisConfig();
+
+        const int chnA = config->m_channelNumberA;
+        const int chnB = config->m_channelNumberB;
 
         if (!bDemoMode) {
             try {
@@ -1173,11 +1629,15 @@ void DRS4Worker::runSingleThreaded()
         std::fill(waveChannel0S, waveChannel0S + sizeof(waveChannel0S)*sizeOfFloat, 0);
         std::fill(waveChannel1S, waveChannel1S + sizeof(waveChannel1S)*sizeOfFloat, 0);
 
+        DRS4HotPathStageTimer hotPathTimer;
+
         if (!bDemoMode) {
             int retState = 1;
             int retStateT = 1;
             int retStateV = kSuccess;
 
+            hotPathTimer.start(DRS4HotPathStage::decode);
+
             try {
                 retStateT = DRS4BoardManager::sharedInstance()->currentBoard()->GetTime(0, 2*chnA, DRS4BoardManager::sharedInstance()->currentBoard()->GetTriggerCell(0), tChannel0);
             }
@@ -1222,6 +1682,8 @@ void DRS4Worker::runSingleThreaded()
                 continue;
             }
 
+            hotPathTimer.stop();
+
             try {
                 retState = DRS4BoardManager::sharedInstance()->currentBoard()->StartDomino(); // returns always 1.
             }
@@ -1271,6 +1733,8 @@ void DRS4Worker::runSingleThreaded()
 
             time(&start);
 
+            updateBoardTemperature(bDemoMode);
+
             m_pulseCounterCnt = 0;
             m_pulseCounterCntAvg ++;
 
@@ -1289,3678 +1753,1173 @@ void DRS4Worker::runSingleThreaded()
 
 
         /* ROI variables */
-        const int startCell = DRS4SettingsManager::sharedInstance()->startCell();
-        const int endRange = DRS4SettingsManager::sharedInstance()->stopCell();
-        const int stopCellWidth = (kNumberOfBins - DRS4SettingsManager::sharedInstance()->stopCell());
+        const int startCell = config->m_startCell;
+        const int endRange = config->m_stopCell;
+        const int stopCellWidth = (kNumberOfBins - config->m_stopCell);
         const int cellWidth = (kNumberOfBins - startCell - stopCellWidth);
 
         /* prevent mutex locking: call these functions only once within the loop */
-        const bool positiveSignal = DRS4SettingsManager::sharedInstance()->isPositiveSignal();
-        const double cfdA = DRS4SettingsManager::sharedInstance()->cfdLevelA();
-        const double cfdB = DRS4SettingsManager::sharedInstance()->cfdLevelB();
-        const bool bBurstMode = DRS4SettingsManager::sharedInstance()->isBurstMode();
-        const double sweep = DRS4SettingsManager::sharedInstance()->sweepInNanoseconds();
-
-        const bool bPulseAreaPlot = DRS4SettingsManager::sharedInstance()->isPulseAreaFilterPlotEnabled();
-        const bool bPulseAreaFilter = DRS4SettingsManager::sharedInstance()->isPulseAreaFilterEnabled();
-        const bool bPulseRiseTimeFilter = DRS4SettingsManager::sharedInstance()->isRiseTimeFilterEnabled();
-
-        const DRS4PulseShapeFilterRecordScheme::Scheme rcScheme = DRS4SettingsManager::sharedInstance()->pulseShapeFilterRecordScheme();
-
-        const DRS4InterpolationType::type interpolationType = DRS4SettingsManager::sharedInstance()->interpolationType();
-        const DRS4SplineInterpolationType::type splineInterpolationType = DRS4SettingsManager::sharedInstance()->splineInterpolationType();
-        const bool bUsingALGLIB = (splineInterpolationType < 6 && splineInterpolationType > 1);
-        const bool bUsingTinoKluge = ((interpolationType == DRS4InterpolationType::type::spline) && (splineInterpolationType == 6));
-        const bool bUsingLinearInterpol = ((interpolationType == DRS4InterpolationType::type::spline) && (splineInterpolationType == 1));
-        const int intraRenderPoints = (DRS4InterpolationType::type::spline == interpolationType)?(DRS4SettingsManager::sharedInstance()->splineIntraSamplingCounts()):(DRS4SettingsManager::sharedInstance()->polynomialSamplingCounts());
+        const bool positiveSignal = config->m_positiveSignal;
+        const double cfdA = config->m_cfdLevelA;
+        const double cfdB = config->m_cfdLevelB;
+        const bool bBurstMode = config->m_burstMode;
+        const double sweep = config->m_sweepInNanoseconds;
+
+        const bool bPulseAreaPlot = config->m_pulseAreaFilterPlotEnabled;
+        const bool bPulseAreaFilter = config->m_pulseAreaFilterEnabled;
+        const bool bPulseRiseTimeFilter = config->m_riseTimeFilterEnabled;
+
+        const DRS4PulseShapeFilterRecordScheme::Scheme rcScheme = config->m_pulseShapeFilterRecordScheme;
+
+        const DRS4InterpolationType::type interpolationType = config->m_interpolationType;
+        const DRS4SplineInterpolationType::type splineInterpolationType = config->m_splineInterpolationType;
+        const int intraRenderPoints = (DRS4InterpolationType::type::spline == interpolationType)?(config->m_splineIntraSamplingCounts):(config->m_polynomialSamplingCounts);
         const int streamIntraRenderPoints =  DRS4ProgramSettingsManager::sharedInstance()->splineIntraPoints();
 
-        const bool bMedianFilterA = DRS4SettingsManager::sharedInstance()->medianFilterAEnabled();
-        const bool bMedianFilterB = DRS4SettingsManager::sharedInstance()->medianFilterBEnabled();
-        const int medianFilterWindowSizeA = DRS4SettingsManager::sharedInstance()->medianFilterWindowSizeA();
-        const int medianFilterWindowSizeB = DRS4SettingsManager::sharedInstance()->medianFilterWindowSizeB();
+        const bool bMedianFilterA = config->m_medianFilterAEnabled;
+        const bool bMedianFilterB = config->m_medianFilterBEnabled;
+        const int medianFilterWindowSizeA = config->m_medianFilterWindowSizeA;
+        const int medianFilterWindowSizeB = config->m_medianFilterWindowSizeB;
 
         /* Baseline - Jitter Corrections */
-        DRS4BaselineCorrectionType::type blTypeA = DRS4SettingsManager::sharedInstance()->baselineCorrectionMethodA();
-        int bl_peakCellA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartPeakCellA();
-        int bl_windowA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationWindowA();
-        bool bUseBaseLineCorrectionA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationEnabledA();
-        int bl_startCellA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartCellA();
-        int bl_cellRegionA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationRegionA();
-        double bl_valueA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationShiftValueInMVA();
-        bool bUseBaseLineCorrectionRejectionA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitRejectLimitA();
-        double bl_rejectionLimitA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitInPercentageA();
-
-        DRS4BaselineCorrectionType::type blTypeB = DRS4SettingsManager::sharedInstance()->baselineCorrectionMethodB();
-        int bl_peakCellB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartPeakCellB();
-        int bl_windowB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationWindowB();
-        bool bUseBaseLineCorrectionB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationEnabledB();
-        int bl_startCellB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartCellB();
-        int bl_cellRegionB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationRegionB();
-        double bl_valueB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationShiftValueInMVB();
-        bool bUseBaseLineCorrectionRejectionB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitRejectLimitB();
-        double bl_rejectionLimitB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitInPercentageB();
+        const DRS4BaselineCorrection baselineCorrectionA = DRS4BaselineCorrection::channelA(config);
+        const DRS4BaselineCorrection baselineCorrectionB = DRS4BaselineCorrection::channelB(config);
 
         /* Shape Filter */
-        const bool bPulseShapeFilterIsEnabledA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterEnabledA();
-        const bool bPulseShapeFilterIsEnabledB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterEnabledB();
+        const bool bPulseShapeFilterIsEnabledA = config->m_pulseShapeFilterEnabledA;
+        const bool bPulseShapeFilterIsEnabledB = config->m_pulseShapeFilterEnabledB;
 
-        const bool bIntrinsicFilterA = (bMedianFilterA || bUseBaseLineCorrectionA);
-        const bool bIntrinsicFilterB = (bMedianFilterB || bUseBaseLineCorrectionB);
+        const bool bIntrinsicFilterA = (bMedianFilterA || baselineCorrectionA.m_bEnabled);
+        const bool bIntrinsicFilterB = (bMedianFilterB || baselineCorrectionB.m_bEnabled);
 
-        if (bIntrinsicFilterA) {
+        /* the source data set is only required by the streams */
+        const bool bStreamSourceWaveforms = (DRS4StreamManager::sharedInstance()->isArmed()
+                                             || DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed());
+
+        if (bIntrinsicFilterA && bStreamSourceWaveforms) {
             copy(waveChannel0, waveChannel0 + kNumberOfBins, waveChannel0S);
         }
 
-        if (bIntrinsicFilterB) {
+        if (bIntrinsicFilterB && bStreamSourceWaveforms) {
             copy(waveChannel1, waveChannel1 + kNumberOfBins, waveChannel1S);
         }
 
+        /* processing windows: the whole waveform if the filtered waveforms are streamed */
+        const bool bWholeWaveform = (DRS4TextFileStreamManager::sharedInstance()->isArmed()
+                                     || DRS4StreamManager::sharedInstance()->isArmed());
+
+        int firstCellA = 0, lastCellA = kNumberOfBins;
+        int firstCellB = 0, lastCellB = kNumberOfBins;
+
+        processingWindow(tChannel0, startCell, endRange, bWholeWaveform, baselineCorrectionA, bPulseShapeFilterIsEnabledA?&config->m_pulseShapeFilterEnvelopeA:DNULLPTR, false, &firstCellA, &lastCellA);
+        processingWindow(tChannel1, startCell, endRange, bWholeWaveform, baselineCorrectionB, bPulseShapeFilterIsEnabledB?&config->m_pulseShapeFilterEnvelopeB:DNULLPTR, false, &firstCellB, &lastCellB);
+
         //apply median filter to remove spikes:
+        hotPathTimer.start(DRS4HotPathStage::medianFilter);
+
         if (bMedianFilterA) {
-            if (!DMedianFilter::apply(waveChannel0, kNumberOfBins, medianFilterWindowSizeA))
+            if (!DMedianFilter::apply(waveChannel0, kNumberOfBins, medianFilterWindowSizeA, firstCellA, lastCellA))
                 continue;
         }
 
         if (bMedianFilterB) {
-            if (!DMedianFilter::apply(waveChannel1, kNumberOfBins, medianFilterWindowSizeB))
+            if (!DMedianFilter::apply(waveChannel1, kNumberOfBins, medianFilterWindowSizeB, firstCellB, lastCellB))
                 continue;
         }
 
         /* baseline - jitter corrections */
-        if (bUseBaseLineCorrectionA) {
-            if (blTypeA == DRS4BaselineCorrectionType::type::fixed) {
-                const int endRegionA = (bl_startCellA + bl_cellRegionA - 1);
-
-                double blA = 0.0f;
-
-                for (int i = bl_startCellA ; i  < endRegionA ; ++ i )
-                    blA += waveChannel0[i];
-
-                blA /= bl_cellRegionA;
-
-                const bool limitExceededA = (abs(blA - bl_valueA)/500.0) > bl_rejectionLimitA*0.01;
-
-                if (bUseBaseLineCorrectionRejectionA && limitExceededA)
-                    continue;
-
-                for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                    waveChannel0[i] -= blA;
-            }
-            else if (blTypeA == DRS4BaselineCorrectionType::type::dynamic) {
-                float minV = 500.0;
-                float maxV = -500.0;
-
-                int iMinV = -1;
-                int iMaxV = -1;
+        hotPathTimer.start(DRS4HotPathStage::baselineCorrection);
 
-                int iStart = -1;
-                int iStop = -1;
+        if (!rejectCounter.pass(DRS4RejectFilter::baselineLimit, baselineCorrectionA.apply(waveChannel0, firstCellA, lastCellA, positiveSignal)
+                                && baselineCorrectionB.apply(waveChannel1, firstCellB, lastCellB, positiveSignal)))
+            continue;
 
-                for (int i = 0 ; i < kNumberOfBins ; ++ i) {
-                    if (waveChannel0[i] < minV) {
-                        iMinV = i;
-                        minV = waveChannel0[i];
-                    }
+        hotPathTimer.stop();
 
-                    if (waveChannel0[i] > maxV) {
-                        iMaxV = i;
-                        maxV = waveChannel0[i];
-                    }
-                }
+        /* clear pulse-data for new visualization */
+        if (!bBurstMode) {
+            resetPulseA();
+            resetPulseB();
 
-                if (positiveSignal) {
-                    iStop = iMaxV;
+            m_pListChannelA.resize(cellWidth);
+            m_pListChannelB.resize(cellWidth);
+        }
 
-                    if (iMaxV - bl_peakCellA < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMaxV - bl_peakCellA;
-                }
-                else {
-                    iStop = iMinV;
+        /* the pulse-pair kernel is instantiated for the interpolation type and the signal polarity: select it once per config */
+        if ( !bPulsePairKernelSelected
+             || pulsePairKernelVersion != config->m_version ) {
+            m_pulsePairKernel.select(interpolationType, splineInterpolationType, positiveSignal);
 
-                    if (iMinV - bl_peakCellA < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMinV - bl_peakCellA;
-                }
+            m_pulsePairKernel.m_startCell = startCell;
+            m_pulsePairKernel.m_endRange = endRange;
+            m_pulsePairKernel.m_cellWidth = cellWidth;
+            m_pulsePairKernel.m_sweep = sweep;
 
-                int lastIndex = -1;
-                for (int i = iStart ; i <  iStop - bl_windowA ; ++ i) {
-                    // mean + stddev
-                    float mean = 0.;
-                    float stddev = 0.;
+            m_pulsePairKernel.m_bPulseArea = (bPulseAreaPlot || bPulseAreaFilter);
+            m_pulsePairKernel.m_pulseAreaFilterNormA = config->m_pulseAreaFilterNormalizationA;
+            m_pulsePairKernel.m_pulseAreaFilterNormB = config->m_pulseAreaFilterNormalizationB;
 
-                    for (int s = 0 ; s < bl_windowA ; ++ s)
-                         mean +=  waveChannel0[i+s];
+            m_pulsePairKernel.m_intraRenderPoints = intraRenderPoints;
 
-                    mean /= bl_windowA;
+            m_pulsePairKernel.m_channelA.m_cfdLevel = cfdA;
+            m_pulsePairKernel.m_channelB.m_cfdLevel = cfdB;
 
-                    for (int s = 0 ; s < bl_windowA ; ++ s)
-                        stddev += (waveChannel0[i+s] - mean)*(waveChannel0[i+s] - mean);
+            pulsePairKernelVersion = config->m_version;
+            bPulsePairKernelSelected = true;
+        }
 
-                    stddev /= (bl_windowA-1);
+        /* insert pulse-points for visualization */
+        if (!bBurstMode) {
+            for ( int a = startCell, it = 0 ; a < endRange ; ++ a, ++ it ) {
+                m_pListChannelA[it] = QPointF(tChannel0[a], waveChannel0[a]);
+                m_pListChannelB[it] = QPointF(tChannel1[a], waveChannel1[a]);
+            }
+        }
 
-                    if (positiveSignal) {
-                        if (waveChannel0[i+bl_windowA] > mean + stddev
-                                || waveChannel0[i+bl_windowA] < mean - stddev) {
-                            lastIndex = i;
-                            break;
-                        }
-                    }
-                    else {
-                        if (waveChannel0[i+bl_windowA] < mean - stddev
-                                || waveChannel0[i+bl_windowA] > mean + stddev) {
-                            lastIndex = i;
-                            break;
-                        }
-                    }
-                }
+        m_pulsePairKernel.setWaveforms(tChannel0, waveChannel0, tChannel1, waveChannel1);
 
-                const int length = lastIndex - iStart;
+        /* determine min/max and proceed a CF estimation in ROI */
+        if (!rejectCounter.pass(DRS4RejectFilter::extrema, m_pulsePairKernel.scan()))
+            continue;
 
-                if (length) {
-                    float mean = 0.;
-                    for (int i = 0 ; i < length ; ++ i)
-                        mean += waveChannel0[iStart + i];
+        /* prevent mutex locking: call these functions only once within the loop */
+        const bool bPersistance = config->m_persistanceEnabled;
+        const int pulseAreaFilterBinningA = config->m_pulseAreaFilterBinningA;
+        const int pulseAreaFilterBinningB = config->m_pulseAreaFilterBinningB;
+        const double pulseAreaFilterNormA = config->m_pulseAreaFilterNormalizationA;
+        const double pulseAreaFilterNormB = config->m_pulseAreaFilterNormalizationB;
+        const double riseTimeFilterAScale = config->m_riseTimeFilterScaleInNanosecondsOfA;
+        const double riseTimeFilterBScale = config->m_riseTimeFilterScaleInNanosecondsOfB;
+        const int riseTimeFilterABinning = config->m_riseTimeFilterBinningOfA;
+        const int riseTimeFilterBBinning = config->m_riseTimeFilterBinningOfB;
+        const int riseTimeFilterWindowLeftA = config->m_riseTimeFilterLeftWindowOfA;
+        const int riseTimeFilterWindowLeftB = config->m_riseTimeFilterLeftWindowOfB;
+        const int riseTimeFilterWindowRightA = config->m_riseTimeFilterRightWindowOfA;
+        const int riseTimeFilterWindowRightB = config->m_riseTimeFilterRightWindowOfB;
+        const int channelCntAB = config->m_channelCntAB;
+        const int channelCntBA = config->m_channelCntBA;
+        const int channelCntPrompt = config->m_channelCntCoincidence;
+        const int channelCntMerged = config->m_channelCntMerged;
+        const bool bNegativeLT = config->m_negativeLTAccepted;
+        const bool bForcePrompt = config->m_forceCoincidence;
+        const double offsetAB = config->m_offsetInNSAB;
+        const double offsetBA = config->m_offsetInNSBA;
+        const double offsetPrompt = config->m_offsetInNSCoincidence;
+        const double offsetMerged = config->m_offsetInNSMerged;
+        const double scalerAB = config->m_scalerInNSAB;
+        const double scalerBA = config->m_scalerInNSBA;
+        const double scalerPrompt = config->m_scalerInNSCoincidence;
+        const double scalerMerged = config->m_scalerInNSMerged;
+        const double ATS = config->m_meanCableDelay;
+        const bool bStreamInRangeArmed = DRS4TextFileStreamRangeManager::sharedInstance()->isArmed();
+        const bool bStreamWithoutRangeArmed = DRS4TextFileStreamManager::sharedInstance()->isArmed();
+        const bool bOppositePersistanceA = config->m_persistanceUsingCFDBAsRefForA;
+        const bool bOppositePersistanceB = config->m_persistanceUsingCFDAAsRefForB;
 
-                    mean /= length;
+        if ( DRS4StreamManager::sharedInstance()->isArmed() ) {
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)tChannel0, sizeOfWave)) {
+                /* nothing yet */
+            }
 
-                    const bool limitExceededA = (abs(mean - bl_valueA)/500.0) > bl_rejectionLimitA*0.01;
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)(bMedianFilterA?waveChannel0S:waveChannel0), sizeOfWave)) {
+                /* nothing yet */
+            }
 
-                    if (bUseBaseLineCorrectionRejectionA && limitExceededA)
-                        continue;
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)tChannel1, sizeOfWave)) {
+                /* nothing yet */
+            }
 
-                    for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                        waveChannel0[i] -= mean;
-                }
-                else
-                    continue;
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)(bMedianFilterA?waveChannel1S:waveChannel1), sizeOfWave)) {
+                /* nothing yet */
             }
         }
 
-        if (bUseBaseLineCorrectionB) {
-            if (blTypeB == DRS4BaselineCorrectionType::type::fixed) {
-                const int endRegionB = (bl_startCellB + bl_cellRegionB - 1);
+        /* light-weight filtering (raw samples), obtain interpolant and normalize the pulse area */
+        if (!rejectCounter.pass(DRS4RejectFilter::artifact, m_pulsePairKernel.interpolate()))
+            continue;
 
-                double blB = 0.0f;
+        const float areaA = m_pulsePairKernel.m_channelA.m_area;
+        const float areaB = m_pulsePairKernel.m_channelB.m_area;
 
-                for (int i = bl_startCellB ; i  < endRegionB ; ++ i )
-                    blB += waveChannel1[i];
+        /* store/write pulses and interpolations to ASCII file */
+        if (!bBurstMode) {
+            if (bStreamWithoutRangeArmed) {
+                DRS4TextFileStreamManager::sharedInstance()->writePulses(tChannel0, tChannel1, waveChannel0, waveChannel1, kNumberOfBins);
 
-                blB /= bl_cellRegionB;
+                if ( (DRS4TextFileStreamManager::sharedInstance()->writeInterpolationA() || DRS4TextFileStreamManager::sharedInstance()->writeInterpolationB())
+                     && (m_pListChannelA.size() > 0 && m_pListChannelB.size() > 0) ) {
+                    if (!m_pulsePairKernel.isLinear()) {
+                        const int points = m_pListChannelA.size()*streamIntraRenderPoints;
 
-                const bool limitExceededB = (abs(blB - bl_valueB)/500.0) > bl_rejectionLimitB*0.01;
+                        QVector<QPointF> splineA(points);
+                        QVector<QPointF> splineB(points);
 
-                if (bUseBaseLineCorrectionRejectionB && limitExceededB)
-                    continue;
+                        const float incrA = (m_pListChannelA.at(m_pListChannelA.size()-1).x() - m_pListChannelA.at(0).x())/(float)points;
+                        const float incrB = (m_pListChannelB.at(m_pListChannelB.size()-1).x() - m_pListChannelB.at(0).x())/(float)points;
+                        const float startXA = m_pListChannelA.at(0).x();
+                        const float startXB = m_pListChannelB.at(0).x();
 
-                for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                    waveChannel1[i] -= blB;
-            }
-            else if (blTypeB == DRS4BaselineCorrectionType::type::dynamic) {
-                float minV = 500.0;
-                float maxV = -500.0;
+                        for ( int i = 0 ; i < points ; ++ i ) {
+                            const float valXA = startXA + (float)i*incrA;
+                            const float valXB = startXB + (float)i*incrB;
 
-                int iMinV = -1;
-                int iMaxV = -1;
+                            const float valYA = m_pulsePairKernel.evaluateA(valXA);
+                            const float valYB = m_pulsePairKernel.evaluateB(valXB);
 
-                int iStart = -1;
-                int iStop = -1;
+                            splineA[i] = QPointF(valXA, valYA);
+                            splineB[i] = QPointF(valXB, valYB);
+                        }
 
-                for (int i = 0 ; i < kNumberOfBins ; ++ i) {
-                    if (waveChannel1[i] < minV) {
-                        iMinV = i;
-                        minV = waveChannel1[i];
+                        DRS4TextFileStreamManager::sharedInstance()->writeInterpolations(&splineA, &splineB, interpolationType, splineInterpolationType);
                     }
-
-                    if (waveChannel1[i] > maxV) {
-                        iMaxV = i;
-                        maxV = waveChannel1[i];
+                    else {
+                        DRS4TextFileStreamManager::sharedInstance()->writeInterpolations(&m_pListChannelA, &m_pListChannelB, interpolationType, splineInterpolationType);
                     }
                 }
+            }
+        }
 
-                if (positiveSignal) {
-                    iStop = iMaxV;
+        /* determine max/min more precisely */
+        if (!rejectCounter.pass(DRS4RejectFilter::refine, m_pulsePairKernel.refine()))
+            continue;
 
-                    if (iMaxV - bl_peakCellB < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMaxV - bl_peakCellB;
-                }
-                else {
-                    iStop = iMinV;
+        const float yMinA = m_pulsePairKernel.m_channelA.m_yMin;
+        const float yMaxA = m_pulsePairKernel.m_channelA.m_yMax;
+        const float yMinB = m_pulsePairKernel.m_channelB.m_yMin;
+        const float yMaxB = m_pulsePairKernel.m_channelB.m_yMax;
 
-                    if (iMinV - bl_peakCellB < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMinV - bl_peakCellB;
-                }
+        const double timeAForYMax = m_pulsePairKernel.m_channelA.m_timeForYMax;
+        const double timeBForYMax = m_pulsePairKernel.m_channelB.m_timeForYMax;
+
+        /* add modified (interpolated/fitted) pulse heights to PHS */
+        const int cellPHSA = m_pulsePairKernel.m_channelA.m_cellPHS;
+        const int cellPHSB = m_pulsePairKernel.m_channelB.m_cellPHS;
 
-                int lastIndex = -1;
-                for (int i = iStart ; i <  iStop - bl_windowB ; ++ i) {
-                    // mean + stddev
-                    float mean = 0.;
-                    float stddev = 0.;
+        if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
+            m_phsA[cellPHSA] ++;
+            m_phsACounts ++;
+        }
 
-                    for (int s = 0 ; s < bl_windowB ; ++ s)
-                         mean +=  waveChannel1[i+s];
+        if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
+            m_phsB[cellPHSB] ++;
+            m_phsBCounts ++;
+        }
 
-                    mean /= bl_windowB;
+        /* CF levels valid? find the CFD timestamps */
+        if (!m_pulsePairKernel.timeStamps()) {
+            rejectCounter.pass(DRS4RejectFilter::cfLevel, false);
 
-                    for (int s = 0 ; s < bl_windowB ; ++ s)
-                        stddev += (waveChannel1[i+s] - mean)*(waveChannel1[i+s] - mean);
+            continue;
+        }
 
-                    stddev /= (bl_windowB-1);
+        const double timeStampA = m_pulsePairKernel.m_channelA.m_timeStamp;
+        const double timeStampB = m_pulsePairKernel.m_channelB.m_timeStamp;
 
-                    if (positiveSignal) {
-                        if (waveChannel1[i+bl_windowB] > mean + stddev
-                                || waveChannel1[i+bl_windowB] < mean - stddev) {
-                            lastIndex = i;
-                            break;
-                        }
+        if (!rejectCounter.pass(DRS4RejectFilter::cfLevel, !((int)timeStampA == -1 || (int)timeStampB == -1))) {
+            if ((int)timeStampA == -1) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
                     }
-                    else {
-                        if (waveChannel1[i+bl_windowB] < mean - stddev
-                                || waveChannel1[i+bl_windowB] > mean + stddev) {
-                            lastIndex = i;
-                            break;
-                        }
+
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
                     }
                 }
+            }
 
-                const int length = lastIndex - iStart;
-
-                if (length) {
-                    float mean = 0.;
-                    for (int i = 0 ; i < length ; ++ i)
-                        mean += waveChannel1[iStart + i];
-
-                    mean /= length;
-
-                    const bool limitExceededB = (abs(mean - bl_valueB)/500.0) > bl_rejectionLimitB*0.01;
-
-                    if (bUseBaseLineCorrectionRejectionB && limitExceededB)
-                        continue;
+            if ((int)timeStampB == -1) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
 
-                    for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                        waveChannel1[i] -= mean;
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
                 }
-                else
-                    continue;
             }
+
+            continue;
         }
 
-        /* clear pulse-data for new visualization */
-        if (!bBurstMode) {
-            resetPulseA();
-            resetPulseB();
+        /* area-Filter */
+        double areaA_raw = areaA*(double)pulseAreaFilterBinningA;
+        double areaB_raw = areaB*(double)pulseAreaFilterBinningB;
 
-            m_pListChannelA.resize(cellWidth);
-            m_pListChannelB.resize(cellWidth);
-        }
+        if (!bBurstMode
+                && bPulseAreaPlot) {
+            const int binA = areaA*(double)pulseAreaFilterBinningA;
+            const int binB = areaB*(double)pulseAreaFilterBinningB;
 
-        if (bUsingALGLIB) {
-            /* ALGLIB array allocation */
-            m_arrayDataX_A.setlength(cellWidth);
-            m_arrayDataY_A.setlength(cellWidth);
-            m_arrayDataX_B.setlength(cellWidth);
-            m_arrayDataY_B.setlength(cellWidth);
-        }
-        else if (bUsingTinoKluge) {
-            m_arrayDataTKX_A.resize(cellWidth);
-            m_arrayDataTKX_B.resize(cellWidth);
-            m_arrayDataTKY_A.resize(cellWidth);
-            m_arrayDataTKY_B.resize(cellWidth);
-        }
-        else if (bUsingLinearInterpol) {
-            /* nothing to do yet */
-        }
+            const int reducedNumberOfBins = (kNumberOfBins-1);
+
+            if (!(cellPHSA>reducedNumberOfBins
+                  || cellPHSB>reducedNumberOfBins
+                  || cellPHSA<0
+                  || cellPHSB<0
+                  || binA<0
+                  || binB<0)) {
+                if (m_areaFilterACounter >= 5000 )
+                    m_areaFilterACounter = 0;
 
-        /* inline time and voltage extrema value estimation */
-        float xMinA = sweep;
-        float xMaxA = 0.0f;
+                if (m_areaFilterBCounter >= 5000 )
+                    m_areaFilterBCounter = 0;
 
-        float xMinB = sweep;
-        float xMaxB = 0.0f;
+                m_areaFilterDataA[m_areaFilterACounter] = QPointF(cellPHSA, binA);
+                m_areaFilterDataB[m_areaFilterBCounter] = QPointF(cellPHSB, binB);
 
-        float yMinA = 500.0f;
-        float yMaxA = -500.0f;
+                m_areaFilterACounter ++;
+                m_areaFilterBCounter ++;
+            }
+        }
 
-        float yMinB = 500.0f;
-        float yMaxB = -500.0f;
+        /* determine start and stop branches */
+        bool bIsStart_A = false;
+        bool bIsStop_A = false;
 
-        /* inline voltage extrema value estimation */
-        int cellYAMin = -1;
-        int cellYAMax = -1;
+        bool bIsStart_B = false;
+        bool bIsStop_B = false;
 
-        int cellYBMin = -1;
-        int cellYBMax = -1;
+        if ( cellPHSA >= config->m_startChannelAMin
+             && cellPHSA <= config->m_startChannelAMax )
+            bIsStart_A = true;
 
-        /* inline CF value estimation */
-        float cfdValueA = 0.0f;
-        float cfdValueB = 0.0f;
+        if ( cellPHSA >= config->m_stopChannelAMin
+             && cellPHSA <= config->m_stopChannelAMax )
+            bIsStop_A = true;
 
-        float cfdValueA_10perc = 0.0f;
-        float cfdValueB_10perc = 0.0f;
+        if ( cellPHSB >= config->m_startChannelBMin
+             && cellPHSB <= config->m_startChannelBMax )
+            bIsStart_B = true;
 
-        float cfdValueA_90perc = 0.0f;
-        float cfdValueB_90perc = 0.0f;
+        if ( cellPHSB >= config->m_stopChannelBMin
+             && cellPHSB <= config->m_stopChannelBMax )
+            bIsStop_B = true;
 
-        /* inline CF cell estimation */
-        int estimCFDACellStart = -1;
-        int estimCFDBCellStart = -1;
+        /* rise-time (10% - 90%): only required for the spectra of the start and stop branches */
+        m_pulsePairKernel.riseTimes(bIsStart_A || bIsStop_A, bIsStart_B || bIsStop_B);
 
-        int estimCFDACellStop = -1;
-        int estimCFDBCellStop = -1;
+        const double timeStampA_10perc = m_pulsePairKernel.m_channelA.m_timeStamp_10perc;
+        const double timeStampB_10perc = m_pulsePairKernel.m_channelB.m_timeStamp_10perc;
 
-        /* inline CF (10%, 90%) cell estimation >> rise-time estimation (delta illumination signal) */
-        int estimCFDACellStart_10perc = -1;
-        int estimCFDBCellStart_10perc = -1;
+        const double timeStampA_90perc = m_pulsePairKernel.m_channelA.m_timeStamp_90perc;
+        const double timeStampB_90perc = m_pulsePairKernel.m_channelB.m_timeStamp_90perc;
 
-        int estimCFDACellStart_90perc = -1;
-        int estimCFDBCellStart_90perc = -1;
+        /* rise-time Filter */
+        if ((int)timeStampA_10perc != -1
+                || (int)timeStampA_90perc != -1) {
+            const int binA = (int)((double)riseTimeFilterABinning*(timeStampA_90perc-timeStampA_10perc)/riseTimeFilterAScale);
 
-        int estimCFDACellStop_10perc = -1;
-        int estimCFDBCellStop_10perc = -1;
+            if ( !(binA < 0 || binA >= riseTimeFilterABinning) ) {
+                if (bIsStart_A || bIsStop_A) {
+                    m_riseTimeFilterDataA[binA] ++;
+                    m_riseTimeFilterACounter ++;
+                    m_maxY_RiseTimeSpectrumA = qMax(m_maxY_RiseTimeSpectrumA, m_riseTimeFilterDataA[binA]);
+                }
+            }
+        }
 
-        int estimCFDACellStop_90perc = -1;
-        int estimCFDBCellStop_90perc = -1;
+        if ((int)timeStampB_10perc != -1
+                || (int)timeStampB_90perc != -1) {
+            const int binB = (int)((double)riseTimeFilterBBinning*(timeStampB_90perc-timeStampB_10perc)/riseTimeFilterBScale);
 
-        int cfdACounter = 0;
-        int cfdBCounter = 0;
+            if ( !(binB < 0 || binB >= riseTimeFilterBBinning) ) {
+                if (bIsStart_B || bIsStop_B) {
+                    m_riseTimeFilterDataB[binB] ++;
+                    m_riseTimeFilterBCounter ++;
+                    m_maxY_RiseTimeSpectrumB = qMax(m_maxY_RiseTimeSpectrumB, m_riseTimeFilterDataB[binB]);
+                }
+            }
+        }
 
-        float areaA = 0.0f;
-        float areaB = 0.0f;
+        /* apply area-filter and reject pulses if one of both appears outside the windows */
+        if (bPulseAreaFilter) {
+            const double indexPHSA = cellPHSA;
+            const double indexPHSB = cellPHSB;
 
-        /* reduce mathematical operations within in the loop */
-        const int reducedEndRange = (endRange - 1);
-        const int reducedCellWidth = (cellWidth - 1);
-        const int extendedStartCell = (startCell + 1);
+            const double yLowerA = (*m_dataExchange->m_areaFilterASlopeLower*indexPHSA+*m_dataExchange->m_areaFilterAInterceptLower);
+            const double yUpperA = (*m_dataExchange->m_areaFilterASlopeUpper*indexPHSA+*m_dataExchange->m_areaFilterAInterceptUpper);
 
+            const double multA = areaA*pulseAreaFilterBinningA;
+            const double multB = areaB*pulseAreaFilterBinningB;
 
-        bool bForceReject = false;
+            const bool y_AInside = (multA >= yLowerA && multA <=yUpperA);
 
-        /* determine min/max and proceed a CF estimation in ROI */
-        for ( int a = reducedEndRange, it = reducedCellWidth ; a >= startCell ; -- a, -- it ) {
-            /* time domain bracket values */
-            xMinA = qMin(xMinA, tChannel0[a]);
-            xMaxA = qMax(xMaxA, tChannel0[a]);
+            const double yLowerB = (*m_dataExchange->m_areaFilterBSlopeLower*indexPHSB+*m_dataExchange->m_areaFilterBInterceptLower);
+            const double yUpperB = (*m_dataExchange->m_areaFilterBSlopeUpper*indexPHSB+*m_dataExchange->m_areaFilterBInterceptUpper);
 
-            xMinB = qMin(xMinB, tChannel1[a]);
-            xMaxB = qMax(xMaxB, tChannel1[a]);
+            const bool y_BInside = (multB >= yLowerB && multB <=yUpperB);
 
-            if ( waveChannel0[a] >= yMaxA ) {
-                yMaxA = waveChannel0[a];
-                cellYAMax = a;
+            if (!y_AInside) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
 
-                if (positiveSignal) {
-                    cfdValueA = cfdA*yMaxA;
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
+                }
+            }
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueA_10perc = 0.1*yMaxA;
-                    cfdValueA_90perc = 0.9*yMaxA;
+            if (!y_BInside) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
 
-                    cfdACounter = 0;
-                }              
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
+                }
             }
 
-            if ( waveChannel1[a] >= yMaxB ) {
-                yMaxB = waveChannel1[a];
-                cellYBMax = a;
+            if (y_AInside) {
+                /* incremental (mean ; stddev) */
+                double meanA  = m_areaFilterCollectedDataA[indexPHSA].x();
+                double stddevA = m_areaFilterCollectedDataA[indexPHSA].y();
 
-                if (positiveSignal) {
-                    cfdValueB = cfdB*yMaxB;
+                m_areaFilterCollectedDataCounterA[indexPHSA] ++;
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueB_10perc = 0.1*yMaxB;
-                    cfdValueB_90perc = 0.9*yMaxB;
+                if (m_areaFilterCollectedDataCounterA[indexPHSA] >= 2) {
+                    stddevA = ((m_areaFilterCollectedDataCounterA[indexPHSA]-2)/(m_areaFilterCollectedDataCounterA[indexPHSA]-1))*stddevA*stddevA + (1.0/m_areaFilterCollectedDataCounterA[indexPHSA])*(areaA-meanA)*(areaA-meanA);
+                    stddevA = sqrt(stddevA);
+                }
+                else
+                    stddevA = 0.0;
 
-                    cfdBCounter = 0;
-                }                
-            }
+                meanA = (1/(float)m_areaFilterCollectedDataCounterA[indexPHSA])*(areaA + float(m_areaFilterCollectedDataCounterA[indexPHSA] - 1)*meanA);
 
-            if ( waveChannel0[a] <= yMinA ) {
-                yMinA = waveChannel0[a];
-                cellYAMin = a;
 
-                if (!positiveSignal) {
-                    cfdValueA = cfdA*yMinA;
+                m_areaFilterCollectedDataA[indexPHSA].setX(meanA);
+                m_areaFilterCollectedDataA[indexPHSA].setY(stddevA);
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueA_10perc = 0.1*yMinA;
-                    cfdValueA_90perc = 0.9*yMinA;
 
-                    cfdACounter = 0;
-                }
-            }
+                /* incremental (mean ; stddev) - raw */
+                double meanA_raw  = m_areaFilterCollectedDataA_raw[indexPHSA];
 
-            if ( waveChannel1[a] <= yMinB ) {
-                yMinB = waveChannel1[a];
-                cellYBMin = a;
+                meanA_raw = (1/(float)m_areaFilterCollectedDataCounterA[indexPHSA])*(areaA_raw + float(m_areaFilterCollectedDataCounterA[indexPHSA] - 1)*meanA_raw);
 
-                if (!positiveSignal) {
-                    cfdValueB = cfdB*yMinB;
+                m_areaFilterCollectedDataA_raw[indexPHSA] = meanA_raw;
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueB_10perc = 0.1*yMinB;
-                    cfdValueB_90perc = 0.9*yMinB;
 
-                    cfdBCounter = 0;
-                }
+                m_areaFilterCollectedACounter ++;
             }
 
-            /* CFD cell estimation/determination */
-            if ( a >= extendedStartCell ) {
-                const int aDecr = (a - 1);
+            if (y_BInside) {
+                /* incremental (mean ; stddev) */
+                double meanB  = m_areaFilterCollectedDataB[indexPHSB].x();
+                double stddevB = m_areaFilterCollectedDataB[indexPHSB].y();
+
+                m_areaFilterCollectedDataCounterB[indexPHSB] ++;
 
-                /* calculate the pulse area of ROI */
-                if (bPulseAreaPlot
-                        || bPulseAreaFilter) {
-                    areaA += abs((waveChannel0[aDecr] + 0.5*(waveChannel0[a] - waveChannel0[aDecr]))*(tChannel0[a] - tChannel0[aDecr]));
-                    areaB += abs((waveChannel1[aDecr] + 0.5*(waveChannel1[a] - waveChannel1[aDecr]))*(tChannel1[a] - tChannel1[aDecr]));
+                if (m_areaFilterCollectedDataCounterB[indexPHSB] >= 2) {
+                    stddevB = ((m_areaFilterCollectedDataCounterB[indexPHSB]-2)/(m_areaFilterCollectedDataCounterB[indexPHSB]-1))*stddevB*stddevB + (1.0/m_areaFilterCollectedDataCounterB[indexPHSB])*(areaB-meanB)*(areaB-meanB);
+                    stddevB = sqrt(stddevB);
                 }
+                else
+                    stddevB = 0.0;
 
-                const double slopeA = (waveChannel0[a] - waveChannel0[aDecr])/(tChannel0[a] - tChannel0[aDecr]);
-                const double slopeB = (waveChannel1[a] - waveChannel1[aDecr])/(tChannel1[a] - tChannel1[aDecr]);
+                meanB = (1/(float)m_areaFilterCollectedDataCounterB[indexPHSB])*(areaB + float(m_areaFilterCollectedDataCounterB[indexPHSB] - 1)*meanB);
 
-                if (!qIsFinite(slopeA) || !qIsFinite(slopeB)) {
-                    bForceReject = true;
-                }
+                m_areaFilterCollectedDataB[indexPHSB].setX(meanB);
+                m_areaFilterCollectedDataB[indexPHSB].setY(stddevB);
 
-                /* CFD on rising edge = positive slope? or falling edge = negative slope?*/
-                const bool bInRangeA = positiveSignal?(slopeA > 1E-6):(slopeA < 1E-6);
-                const bool bInRangeB = positiveSignal?(slopeB > 1E-6):(slopeB < 1E-6);
+                /* incremental (mean ; stddev) - raw */
+                double meanB_raw  = m_areaFilterCollectedDataB_raw[indexPHSB];
 
-                if ( bInRangeA ) {
-                    const bool cfdLevelInRangeA = positiveSignal?(waveChannel0[a] > cfdValueA && waveChannel0[aDecr] < cfdValueA):(waveChannel0[a] < cfdValueA && waveChannel0[aDecr] > cfdValueA);
+                meanB_raw = (1/(float)m_areaFilterCollectedDataCounterB[indexPHSB])*(areaB_raw + float(m_areaFilterCollectedDataCounterB[indexPHSB] - 1)*meanB_raw);
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    const bool cfdLevelInRangeA_10perc = positiveSignal?(waveChannel0[a] > cfdValueA_10perc && waveChannel0[aDecr] < cfdValueA_10perc):(waveChannel0[a] < cfdValueA_10perc && waveChannel0[aDecr] > cfdValueA_10perc);
-                    const bool cfdLevelInRangeA_90perc = positiveSignal?(waveChannel0[a] > cfdValueA_90perc && waveChannel0[aDecr] < cfdValueA_90perc):(waveChannel0[a] < cfdValueA_90perc && waveChannel0[aDecr] > cfdValueA_90perc);
+                m_areaFilterCollectedDataB_raw[indexPHSB] = meanB_raw;
 
-                    if ( cfdLevelInRangeA ) {
-                        estimCFDACellStart = aDecr;
-                        estimCFDACellStop = a;
 
-                        cfdACounter ++;
-                    }
-                    else if ( qFuzzyCompare(waveChannel0[a], cfdValueA) ) {
-                        estimCFDACellStart = a;
-                        estimCFDACellStop = a;
+                m_areaFilterCollectedBCounter ++;
+            }
 
-                        cfdACounter ++;
-                    }
-                    else if ( qFuzzyCompare(waveChannel0[aDecr], cfdValueA) ) {
-                        estimCFDACellStart = aDecr;
-                        estimCFDACellStop = aDecr;
+            if (!rejectCounter.pass(DRS4RejectFilter::areaWindow, y_AInside && y_BInside)) {
+                continue;
+            }
+        }
 
-                        cfdACounter ++;
-                    }
+        /* none of the spectra accepts the pulse heights: the remaining (more expensive) filters are skipped unless their decisions are streamed as 'false' pulses */
+        const bool bLifetimeBranch = (((bIsStart_A && bIsStop_B) || (bIsStart_B && bIsStop_A)) && !bForcePrompt)
+                                     || (bIsStop_A && bIsStop_B);
 
-                    /* 10% CF Level */
-                    if ( cfdLevelInRangeA_10perc ) {
-                        estimCFDACellStart_10perc = aDecr;
-                        estimCFDACellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel0[a], cfdValueA_10perc) ) {
-                        estimCFDACellStart_10perc = a;
-                        estimCFDACellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel0[aDecr], cfdValueA_10perc) ) {
-                        estimCFDACellStart_10perc = aDecr;
-                        estimCFDACellStop_10perc = aDecr;
-                    }
+        if (!rejectCounter.pass(DRS4RejectFilter::phsWindow, bLifetimeBranch || DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()))
+            continue;
 
-                    /* 90% CF Level */
-                    if ( cfdLevelInRangeA_90perc ) {
-                        estimCFDACellStart_90perc = aDecr;
-                        estimCFDACellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel0[a], cfdValueA_90perc) ) {
-                        estimCFDACellStart_90perc = a;
-                        estimCFDACellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel0[aDecr], cfdValueA_90perc) ) {
-                        estimCFDACellStart_90perc = aDecr;
-                        estimCFDACellStop_90perc = aDecr;
-                    }
-                }
+        /* apply rise time-filter and reject pulses if one of both appears outside the windows */
+        if (bPulseRiseTimeFilter) {
+            m_pulsePairKernel.riseTimes(true, true);
 
-                if ( bInRangeB ) {
-                    const bool cfdLevelInRangeB = positiveSignal?(waveChannel1[a] > cfdValueB && waveChannel1[aDecr] < cfdValueB):(waveChannel1[a] < cfdValueB && waveChannel1[aDecr] > cfdValueB);
+            const int binA = (int)((double)riseTimeFilterABinning*(m_pulsePairKernel.m_channelA.m_timeStamp_90perc-m_pulsePairKernel.m_channelA.m_timeStamp_10perc)/riseTimeFilterAScale);
+            const int binB = (int)((double)riseTimeFilterBBinning*(m_pulsePairKernel.m_channelB.m_timeStamp_90perc-m_pulsePairKernel.m_channelB.m_timeStamp_10perc)/riseTimeFilterBScale);
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    const bool cfdLevelInRangeB_10perc = positiveSignal?(waveChannel1[a] > cfdValueB_10perc && waveChannel1[aDecr] < cfdValueB_10perc):(waveChannel1[a] < cfdValueB_10perc && waveChannel1[aDecr] > cfdValueB_10perc);
-                    const bool cfdLevelInRangeB_90perc = positiveSignal?(waveChannel1[a] > cfdValueB_90perc && waveChannel1[aDecr] < cfdValueB_90perc):(waveChannel1[a] < cfdValueB_90perc && waveChannel1[aDecr] > cfdValueB_90perc);
+            bool bAcceptedA = false;
+            bool bAcceptedB = false;
 
-                    if ( cfdLevelInRangeB  ) {
-                        estimCFDBCellStart = aDecr;
-                        estimCFDBCellStop = a;
+            if (binA >= riseTimeFilterWindowLeftA && binA <= riseTimeFilterWindowRightA)
+                bAcceptedA = true;
 
-                        cfdBCounter ++;
-                    }
-                    else if ( qFuzzyCompare(waveChannel1[a], cfdValueB) ) {
-                        estimCFDBCellStart = a;
-                        estimCFDBCellStop = a;
+            if (binB >= riseTimeFilterWindowLeftB && binB <= riseTimeFilterWindowRightB)
+                bAcceptedB = true;
 
-                        cfdBCounter ++;
+            if (!bAcceptedA) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
                     }
-                    else if ( qFuzzyCompare(waveChannel1[aDecr], cfdValueB) ) {
-                        estimCFDBCellStart = aDecr;
-                        estimCFDBCellStop = aDecr;
 
-                        cfdBCounter ++;
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
                     }
+                }
+            }
 
-                    /* 10% CF Level */
-                    if ( cfdLevelInRangeB_10perc ) {
-                        estimCFDBCellStart_10perc = aDecr;
-                        estimCFDBCellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel1[a], cfdValueB_10perc) ) {
-                        estimCFDBCellStart_10perc = a;
-                        estimCFDBCellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel1[aDecr], cfdValueB_10perc) ) {
-                        estimCFDBCellStart_10perc = aDecr;
-                        estimCFDBCellStop_10perc = aDecr;
+            if (!bAcceptedB) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
                     }
 
-                    /* 90% CF Level */
-                    if ( cfdLevelInRangeB_90perc ) {
-                        estimCFDBCellStart_90perc = aDecr;
-                        estimCFDBCellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel1[a], cfdValueB_90perc) ) {
-                        estimCFDBCellStart_90perc = a;
-                        estimCFDBCellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(waveChannel1[aDecr], cfdValueB_90perc) ) {
-                        estimCFDBCellStart_90perc = aDecr;
-                        estimCFDBCellStop_90perc = aDecr;
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
                     }
                 }
             }
 
-            if (bForceReject)
+            if (!rejectCounter.pass(DRS4RejectFilter::riseTimeWindow, bAcceptedA && bAcceptedB)) {
                 continue;
-
-            /* insert pulse-point for visualization*/
-            if (!bBurstMode) {
-                m_pListChannelA[it] = QPointF(tChannel0[a], waveChannel0[a]);
-                m_pListChannelB[it] = QPointF(tChannel1[a], waveChannel1[a]);
             }
+        }
 
-            if (bUsingALGLIB) {
-                /* ALGLIB array */
-                m_arrayDataX_A.ptr->ptr.p_double[it] = tChannel0[a];
-                m_arrayDataX_B.ptr->ptr.p_double[it] = tChannel1[a];
-
-                m_arrayDataY_A.ptr->ptr.p_double[it] = waveChannel0[a];
-                m_arrayDataY_B.ptr->ptr.p_double[it] = waveChannel1[a];
-            }
-            else if (bUsingTinoKluge) {
-                m_arrayDataTKX_A[it] = tChannel0[a];
-                m_arrayDataTKX_B[it] = tChannel1[a];
-
-                m_arrayDataTKY_A[it] = waveChannel0[a];
-                m_arrayDataTKY_B[it] = waveChannel1[a];
-            } else if (bUsingLinearInterpol) {
-                /* nothing yet */
-            }
-        }
-
-        /* min/max was not able to be determined */
-        if (cellYAMax == -1
-                || cellYAMin == -1
-                || cellYBMax == -1
-                || cellYBMin == -1
-                || qFuzzyCompare(yMinA, yMaxA)
-                || qFuzzyCompare(yMinB, yMaxB)
-                || (((int)yMinA == (int)yMaxA) || ((int)yMinB == (int)yMaxB)))
-            continue;
-
-        /* prevent mutex locking: call these functions only once within the loop */
-        const bool bPersistance = DRS4SettingsManager::sharedInstance()->isPersistanceEnabled();
-        const int pulseAreaFilterBinningA = DRS4SettingsManager::sharedInstance()->pulseAreaFilterBinningA();
-        const int pulseAreaFilterBinningB = DRS4SettingsManager::sharedInstance()->pulseAreaFilterBinningB();
-        const double pulseAreaFilterNormA = DRS4SettingsManager::sharedInstance()->pulseAreaFilterNormalizationA();
-        const double pulseAreaFilterNormB = DRS4SettingsManager::sharedInstance()->pulseAreaFilterNormalizationB();
-        const double riseTimeFilterAScale = DRS4SettingsManager::sharedInstance()->riseTimeFilterScaleInNanosecondsOfA();
-        const double riseTimeFilterBScale = DRS4SettingsManager::sharedInstance()->riseTimeFilterScaleInNanosecondsOfB();
-        const int riseTimeFilterABinning = DRS4SettingsManager::sharedInstance()->riseTimeFilterBinningOfA();
-        const int riseTimeFilterBBinning = DRS4SettingsManager::sharedInstance()->riseTimeFilterBinningOfB();
-        const int riseTimeFilterWindowLeftA = DRS4SettingsManager::sharedInstance()->riseTimeFilterLeftWindowOfA();
-        const int riseTimeFilterWindowLeftB = DRS4SettingsManager::sharedInstance()->riseTimeFilterLeftWindowOfB();
-        const int riseTimeFilterWindowRightA = DRS4SettingsManager::sharedInstance()->riseTimeFilterRightWindowOfA();
-        const int riseTimeFilterWindowRightB = DRS4SettingsManager::sharedInstance()->riseTimeFilterRightWindowOfB();
-        const int channelCntAB = DRS4SettingsManager::sharedInstance()->channelCntAB();
-        const int channelCntBA = DRS4SettingsManager::sharedInstance()->channelCntBA();
-        const int channelCntPrompt = DRS4SettingsManager::sharedInstance()->channelCntCoincindence();
-        const int channelCntMerged = DRS4SettingsManager::sharedInstance()->channelCntMerged();
-        const bool bNegativeLT = DRS4SettingsManager::sharedInstance()->isNegativeLTAccepted();
-        const bool bForcePrompt = DRS4SettingsManager::sharedInstance()->isforceCoincidence();
-        const double offsetAB = DRS4SettingsManager::sharedInstance()->offsetInNSAB();
-        const double offsetBA = DRS4SettingsManager::sharedInstance()->offsetInNSBA();
-        const double offsetPrompt = DRS4SettingsManager::sharedInstance()->offsetInNSCoincidence();
-        const double offsetMerged = DRS4SettingsManager::sharedInstance()->offsetInNSMerged();
-        const double scalerAB = DRS4SettingsManager::sharedInstance()->scalerInNSAB();
-        const double scalerBA = DRS4SettingsManager::sharedInstance()->scalerInNSBA();
-        const double scalerPrompt = DRS4SettingsManager::sharedInstance()->scalerInNSCoincidence();
-        const double scalerMerged = DRS4SettingsManager::sharedInstance()->scalerInNSMerged();
-        const double ATS = DRS4SettingsManager::sharedInstance()->meanCableDelay();
-        const bool bStreamInRangeArmed = DRS4TextFileStreamRangeManager::sharedInstance()->isArmed();
-        const bool bStreamWithoutRangeArmed = DRS4TextFileStreamManager::sharedInstance()->isArmed();
-        const bool bOppositePersistanceA = DRS4SettingsManager::sharedInstance()->persistanceUsingCFDBAsRefForA();
-        const bool bOppositePersistanceB = DRS4SettingsManager::sharedInstance()->persistanceUsingCFDAAsRefForB();
-
-        if ( DRS4StreamManager::sharedInstance()->isArmed() ) {
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)tChannel0, sizeOfWave)) {
-                /* nothing yet */
-            }
-
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)(bMedianFilterA?waveChannel0S:waveChannel0), sizeOfWave)) {
-                /* nothing yet */
-            }
-
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)tChannel1, sizeOfWave)) {
-                /* nothing yet */
-            }
-
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)(bMedianFilterA?waveChannel1S:waveChannel1), sizeOfWave)) {
-                /* nothing yet */
-            }
-        }
-
-        /* light-weight filtering of wrong events: */
-        if ( positiveSignal ) {
-            if ( (abs(yMinA) > abs(yMaxA))
-                 || (abs(yMinB) > abs(yMaxB)) )
-                continue;
-
-            if ( abs(cellYAMax - startCell) <= 15
-                 || abs(cellYBMax - startCell) <= 15 )
-                continue;
-
-            if ( qFuzzyCompare(waveChannel0[reducedEndRange], yMaxA)
-                 || qFuzzyCompare(waveChannel1[reducedEndRange], yMaxB)
-                 || qFuzzyCompare(waveChannel0[startCell], yMaxA)
-                 || qFuzzyCompare(waveChannel1[startCell], yMaxB) )
-                continue;
-        }
-        else {
-            if ( (abs(yMinA) < abs(yMaxA))
-                 || (abs(yMinB) < abs(yMaxB)) )
-                continue;
-
-            if ( abs(cellYAMin - startCell) <= 15
-                 || abs(cellYBMin - startCell) <= 15 )
-                continue;
-
-            if ( qFuzzyCompare(waveChannel0[reducedEndRange], yMinA)
-                 || qFuzzyCompare(waveChannel1[reducedEndRange], yMinB)
-                 || qFuzzyCompare(waveChannel0[startCell], yMinA)
-                 || qFuzzyCompare(waveChannel1[startCell], yMinB) )
-                continue;
-        }
-
-        /* reject artifacts */
-        if ( cfdBCounter > 1 || cfdBCounter == 0
-             || cfdACounter > 1 || cfdACounter == 0 )
-            continue;
-
-        /* select interpolation type - obtain interpolant */
-        if (interpolationType == DRS4InterpolationType::type::spline) {
-            if (bUsingALGLIB) {
-                switch (splineInterpolationType) {
-                case DRS4SplineInterpolationType::type::cubic: {
-                    alglib::spline1dbuildcubic(m_arrayDataX_A, m_arrayDataY_A, m_interpolantA);
-                    alglib::spline1dbuildcubic(m_arrayDataX_B, m_arrayDataY_B, m_interpolantB);
-                }
-                    break;
-                case DRS4SplineInterpolationType::type::akima: {
-                    alglib::spline1dbuildakima(m_arrayDataX_A, m_arrayDataY_A, m_interpolantA);
-                    alglib::spline1dbuildakima(m_arrayDataX_B, m_arrayDataY_B, m_interpolantB);
-                }
-                    break;
-                case DRS4SplineInterpolationType::type::catmullRom: {
-                    alglib::spline1dbuildcatmullrom(m_arrayDataX_A, m_arrayDataY_A, m_interpolantA);
-                    alglib::spline1dbuildcatmullrom(m_arrayDataX_B, m_arrayDataY_B, m_interpolantB);
-                }
-                    break;
-                case DRS4SplineInterpolationType::type::monotone: {
-                    alglib::spline1dbuildmonotone(m_arrayDataX_A, m_arrayDataY_A, m_interpolantA);
-                    alglib::spline1dbuildmonotone(m_arrayDataX_B, m_arrayDataY_B, m_interpolantB);
-                }
-                    break;
-                default: {
-                    alglib::spline1dbuildcubic(m_arrayDataX_A, m_arrayDataY_A, m_interpolantA);
-                    alglib::spline1dbuildcubic(m_arrayDataX_B, m_arrayDataY_B, m_interpolantB);
-                }
-                    break;
-                }
-            }
-            else if (bUsingTinoKluge) {
-                tkSplineA.setType(SplineType::Cubic);
-                tkSplineB.setType(SplineType::Cubic);
-
-                tkSplineA.setPoints(m_arrayDataTKX_A, m_arrayDataTKY_A);
-                tkSplineB.setPoints(m_arrayDataTKX_B, m_arrayDataTKY_B);
-            }
-            else if (bUsingLinearInterpol) {
-                /* nothing yet */
-            }
-        }
-        else {
-            alglib::polynomialbuild(m_arrayDataX_A, m_arrayDataY_A, m_baryCentricInterpolantA);
-            alglib::polynomialbuild(m_arrayDataX_B, m_arrayDataY_B, m_baryCentricInterpolantB);
-        }
-
-        /* calculate and normalize pulse area for subsequent area filtering */
-        if (bPulseAreaPlot
-                || bPulseAreaFilter) {
-            const float rat = 5120*((float)cellWidth/((float)kNumberOfBins));
-
-            areaA = areaA/(pulseAreaFilterNormA*rat);
-            areaB = areaB/(pulseAreaFilterNormB*rat);
-        }
-
-        double timeAForYMax = -1;
-        double timeBForYMax = -1;
-
-        if (positiveSignal) {
-            timeAForYMax = tChannel0[cellYAMax];
-            timeBForYMax = tChannel1[cellYBMax];
-        }
-        else {
-            timeAForYMax = tChannel0[cellYAMin];
-            timeBForYMax = tChannel1[cellYBMin];
-        }
-
-        if (qFuzzyCompare(timeAForYMax, -1)
-                || qFuzzyCompare(timeBForYMax, -1))
-            continue;
-
-        /* store/write pulses and interpolations to ASCII file */
-        if (!bBurstMode) {
-            if (bStreamWithoutRangeArmed) {
-                DRS4TextFileStreamManager::sharedInstance()->writePulses(tChannel0, tChannel1, waveChannel0, waveChannel1, kNumberOfBins);
-
-                if ( (DRS4TextFileStreamManager::sharedInstance()->writeInterpolationA() || DRS4TextFileStreamManager::sharedInstance()->writeInterpolationB())
-                     && (m_pListChannelA.size() > 0 && m_pListChannelB.size() > 0) ) {
-                    if (!bUsingLinearInterpol) {
-                        const int points = m_pListChannelA.size()*streamIntraRenderPoints;
-
-                        QVector<QPointF> splineA(points);
-                        QVector<QPointF> splineB(points);
-
-                        const float incrA = (m_pListChannelA.at(m_pListChannelA.size()-1).x() - m_pListChannelA.at(0).x())/(float)points;
-                        const float incrB = (m_pListChannelB.at(m_pListChannelB.size()-1).x() - m_pListChannelB.at(0).x())/(float)points;
-                        const float startXA = m_pListChannelA.at(0).x();
-                        const float startXB = m_pListChannelB.at(0).x();
-
-                        for ( int i = 0 ; i < points ; ++ i ) {
-                            const float valXA = startXA + (float)i*incrA;
-                            const float valXB = startXB + (float)i*incrB;
-
-                            const float valYA = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingTinoKluge?(tkSplineA(valXA)):(alglib::spline1dcalc(m_interpolantA, valXA))):(alglib::barycentriccalc(m_baryCentricInterpolantA, valXA));
-                            const float valYB = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingTinoKluge?(tkSplineB(valXB)):(alglib::spline1dcalc(m_interpolantB, valXB))):(alglib::barycentriccalc(m_baryCentricInterpolantB, valXB));
-
-                            splineA[i] = QPointF(valXA, valYA);
-                            splineB[i] = QPointF(valXB, valYB);
-                        }
-
-                        DRS4TextFileStreamManager::sharedInstance()->writeInterpolations(&splineA, &splineB, interpolationType, splineInterpolationType);
-                    }
-                    else {
-                        DRS4TextFileStreamManager::sharedInstance()->writeInterpolations(&m_pListChannelA, &m_pListChannelB, interpolationType, splineInterpolationType);
-                    }
-                }
-            }
-        }
-
-        /* determine max/min more precisely */
-        if (!bUsingLinearInterpol) {
-            const int cell_interpolRangeA_start = positiveSignal?(cellYAMax-1):(cellYAMin-1);
-            const int cell_interpolRangeA_stop = positiveSignal?(cellYAMax+1):(cellYAMin+1);
-
-            const int cell_interpolRangeB_start = positiveSignal?(cellYBMax-1):(cellYBMin-1);
-            const int cell_interpolRangeB_stop = positiveSignal?(cellYBMax+1):(cellYBMin+1);
-
-            if ( !(cell_interpolRangeA_start >= 0 && cell_interpolRangeA_start < kNumberOfBins)
-                 || !(cell_interpolRangeA_stop >= 0 && cell_interpolRangeA_stop < kNumberOfBins)
-                 || !(cell_interpolRangeB_start >= 0 && cell_interpolRangeB_start < kNumberOfBins)
-                 || !(cell_interpolRangeB_stop >= 0 && cell_interpolRangeB_stop < kNumberOfBins) )
-                continue;
-
-            const double renderIncrementA = (tChannel0[cell_interpolRangeA_stop] - tChannel0[cell_interpolRangeA_start])/((float)intraRenderPoints);
-            const double renderIncrementB = (tChannel1[cell_interpolRangeB_stop] - tChannel1[cell_interpolRangeB_start])/((float)intraRenderPoints);
-
-            for ( int i = 0 ; i <= intraRenderPoints ; ++ i ) {
-                const double t_A = tChannel0[cell_interpolRangeA_start] + (float)i*renderIncrementA;
-                const double t_B = tChannel1[cell_interpolRangeB_start] + (float)i*renderIncrementB;
-
-                const float valYA = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, t_A)):(tkSplineA(t_A))):(alglib::barycentriccalc(m_baryCentricInterpolantA, t_A));
-                const float valYB = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, t_B)):(tkSplineB(t_B))):(alglib::barycentriccalc(m_baryCentricInterpolantB, t_B));
-
-                /* modify min/max to calculate the CF level in high accuracy, subsequently */
-                if (valYA > yMaxA) {
-                    yMaxA = valYA;
-
-                    if (positiveSignal) {
-                        timeAForYMax = t_A;
-                    }
-                }
-
-                if (valYB > yMaxB) {
-                    yMaxB = valYB;
-
-                    if (positiveSignal) {
-                        timeBForYMax = t_B;
-                    }
-                }
-
-                if (valYA < yMinA) {
-                    yMinA = valYA;
-
-                    if (!positiveSignal) {
-                        timeAForYMax = t_A;
-                    }
-                }
-
-                if (valYB < yMinB) {
-                    yMinB = valYB;
-
-                    if (!positiveSignal) {
-                        timeBForYMax = t_B;
-                    }
-                }
-            }
-        }
-
-        /* add modified (interpolated/fitted) pulse height to PHS */
-        float fractPHSA = 0.0f;
-        float fractPHSB = 0.0f;
-
-        const double fkNumberOfBins = (double)kNumberOfBins;
-
-        if (positiveSignal) {
-            fractPHSA = yMaxA*0.002;
-            fractPHSB = yMaxB*0.002;
-        }
-        else {
-            fractPHSA = abs(yMinA)*0.002;
-            fractPHSB = abs(yMinB)*0.002;
-        }
-
-        /* add pulse heights to PHS */
-        const int cellPHSA = ((int)(fractPHSA*fkNumberOfBins))-1;
-        const int cellPHSB = ((int)(fractPHSB*fkNumberOfBins))-1;
-
-        if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-            m_phsA[cellPHSA] ++;
-            m_phsACounts ++;
-        }
-
-        if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-            m_phsB[cellPHSB] ++;
-            m_phsBCounts ++;
-        }
-
-        /* CF levels valid? */
-        if (estimCFDACellStart == -1
-            || estimCFDACellStop == -1
-            || estimCFDBCellStart == -1
-            || estimCFDBCellStop == -1)
-            continue;
-
-        if (positiveSignal) {
-            if ( cfdValueA > 500.0f
-                 || cfdValueB > 500.0f
-                 || qFuzzyCompare(cfdValueA, 0.0f)
-                 || qFuzzyCompare(cfdValueB, 0.0f)
-                 || cfdValueA < 0.0f
-                 || cfdValueB < 0.0f
-                 || ((int)cfdValueA == (int)yMaxA)
-                 || ((int)cfdValueB == (int)yMaxB))
-                continue;
-        }
-        else {
-            if ( cfdValueA < -500.0f
-                 || cfdValueB < -500.0f
-                 || qFuzzyCompare(cfdValueA, 0.0f)
-                 || qFuzzyCompare(cfdValueB, 0.0f)
-                 || cfdValueA > 0.0f
-                 || cfdValueB > 0.0f
-                 || ((int)cfdValueA == (int)yMinA)
-                 || ((int)cfdValueB == (int)yMinB) )
-                continue;
-        }
-
-        double timeStampA = -1.0f;
-        double timeStampB = -1.0f;
-
-        if (!bUsingLinearInterpol) {
-            /* find correct CF level timestamp within the estimated CF bracketed index region */
-            if ( estimCFDACellStart == estimCFDACellStop ) {
-                timeStampA = tChannel0[estimCFDACellStart];
-            }
-            else {
-                const double timeIncr = (tChannel0[estimCFDACellStop] - tChannel0[estimCFDACellStart])/((double)intraRenderPoints);
-                for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = tChannel0[estimCFDACellStart] + (double)i*timeIncr;
-                    const double timeStamp2 = tChannel0[estimCFDACellStart] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, timeStamp1)):(tkSplineA(timeStamp1))):(alglib::barycentriccalc(m_baryCentricInterpolantA, timeStamp1));
-                    const float valY2 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, timeStamp2)):(tkSplineA(timeStamp2))):(alglib::barycentriccalc(m_baryCentricInterpolantA, timeStamp2));
-
-                    if ( (cfdValueA < valY1 && cfdValueA > valY2)
-                         || (cfdValueA > valY1 && cfdValueA < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
-
-                        timeStampA = (cfdValueA - intersect)/slope;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA, valY1) ) {
-                        timeStampA = timeStamp1;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA, valY2) ) {
-                        timeStampA = timeStamp2;
-
-                        break;
-                    }
-                }
-            }
-
-            if ( estimCFDBCellStart == estimCFDBCellStop ) {
-                timeStampB = tChannel1[estimCFDBCellStart];
-            }
-            else {
-                const double timeIncr = (tChannel1[estimCFDBCellStop] - tChannel1[estimCFDBCellStart])/((double)intraRenderPoints);
-                for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = tChannel1[estimCFDBCellStart] + (double)i*timeIncr;
-                    const double timeStamp2 = tChannel1[estimCFDBCellStart] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, timeStamp1)):(tkSplineB(timeStamp1))):(alglib::barycentriccalc(m_baryCentricInterpolantB, timeStamp1));
-                    const float valY2 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, timeStamp2)):(tkSplineB(timeStamp2))):(alglib::barycentriccalc(m_baryCentricInterpolantB, timeStamp2));
-
-                    if ( (cfdValueB < valY1 && cfdValueB > valY2)
-                         || (cfdValueB > valY1 && cfdValueB < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
-
-                        timeStampB = (cfdValueB - intersect)/slope;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB, valY1) ) {
-                        timeStampB = timeStamp1;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB, valY2) ) {
-                        timeStampB = timeStamp2;
-
-                        break;
-                    }
-                }
-            }
-        }
-        /* linear interpolation */
-        else {
-            if ( estimCFDACellStart == estimCFDACellStop ) {
-                timeStampA = tChannel0[estimCFDACellStart];
-            }
-            else {
-                const float timeStamp1 = tChannel0[estimCFDACellStart];
-                const float timeStamp2 = tChannel0[estimCFDACellStop];
-
-                const float valY1 = waveChannel0[estimCFDACellStart];
-                const float valY2 = waveChannel0[estimCFDACellStop];
-
-                if ( (cfdValueA < valY1 && cfdValueA > valY2)
-                     || (cfdValueA > valY1 && cfdValueA < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
-
-                    timeStampA = (cfdValueA - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueA, valY1) ) {
-                    timeStampA = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueA, valY2) ) {
-                    timeStampA = timeStamp2;
-                }
-            }
-
-            if ( estimCFDBCellStart == estimCFDBCellStop ) {
-                timeStampB = tChannel1[estimCFDBCellStart];
-            }
-            else {
-                const float timeStamp1 = tChannel1[estimCFDBCellStart];
-                const float timeStamp2 = tChannel1[estimCFDBCellStop];
-
-                const float valY1 = waveChannel1[estimCFDBCellStart];
-                const float valY2 = waveChannel1[estimCFDBCellStop];
-
-                if ( (cfdValueB < valY1 && cfdValueB > valY2)
-                     || (cfdValueB > valY1 && cfdValueB < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
-
-                    timeStampB = (cfdValueB - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueB, valY1) ) {
-                    timeStampB = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueB, valY2) ) {
-                    timeStampB = timeStamp2;
-                }
-            }
-        }
-
-        double timeStampA_10perc = -1.0f;
-        double timeStampB_10perc = -1.0f;
-
-        if (!bUsingLinearInterpol) {
-            /* finding correct CF (10%) timestamp within the estimated CF (10%) bracketed index region */
-            if ( estimCFDACellStart_10perc == estimCFDACellStop_10perc ) {
-                timeStampA_10perc = tChannel0[estimCFDACellStart_10perc];
-            }
-            else {
-                const double timeIncr = (tChannel0[estimCFDACellStop_10perc] - tChannel0[estimCFDACellStart_10perc])/((double)intraRenderPoints);
-                for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = tChannel0[estimCFDACellStart_10perc] + (double)i*timeIncr;
-                    const double timeStamp2 = tChannel0[estimCFDACellStart_10perc] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, timeStamp1)):(tkSplineA(timeStamp1))):(alglib::barycentriccalc(m_baryCentricInterpolantA, timeStamp1));
-                    const float valY2 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, timeStamp2)):(tkSplineA(timeStamp2))):(alglib::barycentriccalc(m_baryCentricInterpolantA, timeStamp2));
-
-                    if ( (cfdValueA_10perc < valY1 && cfdValueA_10perc > valY2)
-                         || (cfdValueA_10perc > valY1 && cfdValueA_10perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
-
-                        timeStampA_10perc = (cfdValueA_10perc - intersect)/slope;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_10perc, valY1) ) {
-                        timeStampA_10perc = timeStamp1;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_10perc, valY2) ) {
-                        timeStampA_10perc = timeStamp2;
-
-                        break;
-                    }
-                }
-            }
-
-            if ( estimCFDBCellStart_10perc == estimCFDBCellStop_10perc ) {
-                timeStampB_10perc = tChannel1[estimCFDBCellStart_10perc];
-            }
-            else {
-                const double timeIncr = (tChannel1[estimCFDBCellStop_10perc] - tChannel1[estimCFDBCellStart_10perc])/((double)intraRenderPoints);
-                for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = tChannel1[estimCFDBCellStart_10perc] + (double)i*timeIncr;
-                    const double timeStamp2 = tChannel1[estimCFDBCellStart_10perc] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, timeStamp1)):(tkSplineB(timeStamp1))):(alglib::barycentriccalc(m_baryCentricInterpolantB, timeStamp1));
-                    const float valY2 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, timeStamp2)):(tkSplineB(timeStamp2))):(alglib::barycentriccalc(m_baryCentricInterpolantB, timeStamp2));
-
-                    if ( (cfdValueB_10perc < valY1 && cfdValueB_10perc > valY2)
-                         || (cfdValueB_10perc > valY1 && cfdValueB_10perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
-
-                        timeStampB_10perc = (cfdValueB_10perc - intersect)/slope;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB_10perc, valY1) ) {
-                        timeStampB_10perc = timeStamp1;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB_10perc, valY2) ) {
-                        timeStampB_10perc = timeStamp2;
-
-                        break;
-                    }
-                }
-            }
-        }
-        /* linear interpolation */
-        else {
-            if ( estimCFDACellStart_10perc == estimCFDACellStop_10perc ) {
-                timeStampA_10perc = tChannel0[estimCFDACellStart_10perc];
-            }
-            else {
-                const float timeStamp1 = tChannel0[estimCFDACellStart_10perc];
-                const float timeStamp2 = tChannel0[estimCFDACellStop_10perc];
-
-                const float valY1 = waveChannel0[estimCFDACellStart_10perc];
-                const float valY2 = waveChannel0[estimCFDACellStop_10perc];
-
-                if ( (cfdValueA_10perc < valY1 && cfdValueA_10perc > valY2)
-                     || (cfdValueA_10perc > valY1 && cfdValueA_10perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
-
-                    timeStampA_10perc = (cfdValueA_10perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueA_10perc, valY1) ) {
-                    timeStampA_10perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueA_10perc, valY2) ) {
-                    timeStampA_10perc = timeStamp2;
-                }
-            }
-
-            if ( estimCFDBCellStart_10perc == estimCFDBCellStop_10perc ) {
-                timeStampB_10perc = tChannel1[estimCFDBCellStart_10perc];
-            }
-            else {
-                const float timeStamp1 = tChannel1[estimCFDBCellStart_10perc];
-                const float timeStamp2 = tChannel1[estimCFDBCellStop_10perc];
-
-                const float valY1 = waveChannel1[estimCFDBCellStart_10perc];
-                const float valY2 = waveChannel1[estimCFDBCellStop_10perc];
-
-                if ( (cfdValueB_10perc < valY1 && cfdValueB_10perc > valY2)
-                     || (cfdValueB_10perc > valY1 && cfdValueB_10perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
-
-                    timeStampB_10perc = (cfdValueB_10perc - intersect)/slope;
-                } else if ( qFuzzyCompare(cfdValueB_10perc, valY1) ) {
-                    timeStampB_10perc = timeStamp1;
-                } else if ( qFuzzyCompare(cfdValueB_10perc, valY2) ) {
-                    timeStampB_10perc = timeStamp2;
-                }
-            }
-        }
-
-        double timeStampA_90perc = -1.0f;
-        double timeStampB_90perc = -1.0f;
-
-        if (!bUsingLinearInterpol) {
-            /* find correct CF level (90%) timestamp within the estimated CF (90%) bracketed index region */
-            if ( estimCFDACellStart_90perc == estimCFDACellStop_90perc ) {
-                timeStampA_90perc = tChannel0[estimCFDACellStart_90perc];
-            }
-            else {
-                const double timeIncr = (tChannel0[estimCFDACellStop_90perc] - tChannel0[estimCFDACellStart_90perc])/((double)intraRenderPoints);
-                for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = tChannel0[estimCFDACellStart_90perc] + (double)i*timeIncr;
-                    const double timeStamp2 = tChannel0[estimCFDACellStart_90perc] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, timeStamp1)):(tkSplineA(timeStamp1))):(alglib::barycentriccalc(m_baryCentricInterpolantA, timeStamp1));
-                    const float valY2 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantA, timeStamp2)):(tkSplineA(timeStamp2))):(alglib::barycentriccalc(m_baryCentricInterpolantA, timeStamp2));
-
-                    if ( (cfdValueA_90perc < valY1 && cfdValueA_90perc > valY2)
-                         || (cfdValueA_90perc > valY1 && cfdValueA_90perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
-
-                        timeStampA_90perc = (cfdValueA_90perc - intersect)/slope;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_90perc, valY1) ) {
-                        timeStampA_90perc = timeStamp1;
-
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_90perc, valY2) ) {
-                        timeStampA_90perc = timeStamp2;
-
-                        break;
-                    }
-                }
-            }
-
-            if ( estimCFDBCellStart_90perc == estimCFDBCellStop_90perc ) {
-                timeStampB_90perc = tChannel1[estimCFDBCellStart_90perc];
-            }
-            else {
-                const double timeIncr = (tChannel1[estimCFDBCellStop_90perc] - tChannel1[estimCFDBCellStart_90perc])/((double)intraRenderPoints);
-                for ( int i = 0 ; i < intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = tChannel1[estimCFDBCellStart_90perc] + (double)i*timeIncr;
-                    const double timeStamp2 = tChannel1[estimCFDBCellStart_90perc] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, timeStamp1)):(tkSplineB(timeStamp1))):(alglib::barycentriccalc(m_baryCentricInterpolantB, timeStamp1));
-                    const float valY2 = (interpolationType == DRS4InterpolationType::type::spline)?(bUsingALGLIB?(alglib::spline1dcalc(m_interpolantB, timeStamp2)):(tkSplineB(timeStamp2))):(alglib::barycentriccalc(m_baryCentricInterpolantB, timeStamp2));
-
-                    if ( (cfdValueB_90perc < valY1 && cfdValueB_90perc > valY2)
-                         || (cfdValueB_90perc > valY1 && cfdValueB_90perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
-
-                        timeStampB_90perc = (cfdValueB_90perc - intersect)/slope;
-
-                        break;
-                    } else if ( qFuzzyCompare(cfdValueB_90perc, valY1) ) {
-                        timeStampB_90perc = timeStamp1;
-
-                        break;
-                    } else if ( qFuzzyCompare(cfdValueB_90perc, valY2) ) {
-                        timeStampB_90perc = timeStamp2;
-
-                        break;
-                    }
-                }
-            }
-        }
-        /* linear interpolation */
-        else {
-            if ( estimCFDACellStart_90perc == estimCFDACellStop_90perc ) {
-                timeStampA_90perc = tChannel0[estimCFDACellStart_90perc];
-            }
-            else {
-                const float timeStamp1 = tChannel0[estimCFDACellStart_90perc];
-                const float timeStamp2 = tChannel0[estimCFDACellStop_90perc];
-
-                const float valY1 = waveChannel0[estimCFDACellStart_90perc];
-                const float valY2 = waveChannel0[estimCFDACellStop_90perc];
-
-                if ( (cfdValueA_90perc < valY1 && cfdValueA_90perc > valY2)
-                     || (cfdValueA_90perc > valY1 && cfdValueA_90perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
-
-                    timeStampA_90perc = (cfdValueA_90perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueA_90perc, valY1) ) {
-                    timeStampA_90perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueA_90perc, valY2) ) {
-                    timeStampA_90perc = timeStamp2;
-                }
-            }
-
-            if ( estimCFDBCellStart_90perc == estimCFDBCellStop_90perc ) {
-                timeStampB_90perc = tChannel1[estimCFDBCellStart_90perc];
-            }
-            else {
-                const float timeStamp1 = tChannel1[estimCFDBCellStart_90perc];
-                const float timeStamp2 = tChannel1[estimCFDBCellStop_90perc];
-
-                const float valY1 = waveChannel1[estimCFDBCellStart_90perc];
-                const float valY2 = waveChannel1[estimCFDBCellStop_90perc];
-
-                if ( (cfdValueB_90perc < valY1 && cfdValueB_90perc > valY2)
-                     || (cfdValueB_90perc > valY1 && cfdValueB_90perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
-
-                    timeStampB_90perc = (cfdValueB_90perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueB_90perc, valY1) ) {
-                    timeStampB_90perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueB_90perc, valY2) ) {
-                    timeStampB_90perc = timeStamp2;
-                }
-            }
-        }
-
-        if ((int)timeStampA == -1
-           || (int)timeStampB == -1) {
-            if ((int)timeStampA == -1) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if ((int)timeStampB == -1) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            continue;
-        }
-
-        /* area-Filter */
-        double areaA_raw = areaA*(double)pulseAreaFilterBinningA;
-        double areaB_raw = areaB*(double)pulseAreaFilterBinningB;
-
-        if (!bBurstMode
-                && bPulseAreaPlot) {
-            const int binA = areaA*(double)pulseAreaFilterBinningA;
-            const int binB = areaB*(double)pulseAreaFilterBinningB;
-
-            const int reducedNumberOfBins = (kNumberOfBins-1);
-
-            if (!(cellPHSA>reducedNumberOfBins
-                  || cellPHSB>reducedNumberOfBins
-                  || cellPHSA<0
-                  || cellPHSB<0
-                  || binA<0
-                  || binB<0)) {
-                if (m_areaFilterACounter >= 5000 )
-                    m_areaFilterACounter = 0;
-
-                if (m_areaFilterBCounter >= 5000 )
-                    m_areaFilterBCounter = 0;
-
-                m_areaFilterDataA[m_areaFilterACounter] = QPointF(cellPHSA, binA);
-                m_areaFilterDataB[m_areaFilterBCounter] = QPointF(cellPHSB, binB);
-
-                m_areaFilterACounter ++;
-                m_areaFilterBCounter ++;
-            }
-        }
-
-        /* determine start and stop branches */
-        bool bIsStart_A = false;
-        bool bIsStop_A = false;
-
-        bool bIsStart_B = false;
-        bool bIsStop_B = false;
-
-        if ( cellPHSA >= DRS4SettingsManager::sharedInstance()->startChanneAMin()
-             && cellPHSA <= DRS4SettingsManager::sharedInstance()->startChanneAMax() )
-            bIsStart_A = true;
-
-        if ( cellPHSA >= DRS4SettingsManager::sharedInstance()->stopChanneAMin()
-             && cellPHSA <= DRS4SettingsManager::sharedInstance()->stopChanneAMax() )
-            bIsStop_A = true;
-
-        if ( cellPHSB >= DRS4SettingsManager::sharedInstance()->startChanneBMin()
-             && cellPHSB <= DRS4SettingsManager::sharedInstance()->startChanneBMax() )
-            bIsStart_B = true;
-
-        if ( cellPHSB >= DRS4SettingsManager::sharedInstance()->stopChanneBMin()
-             && cellPHSB <= DRS4SettingsManager::sharedInstance()->stopChanneBMax() )
-            bIsStop_B = true;
-
-        /* rise-time Filter */
-        if ((int)timeStampA_10perc != -1
-                || (int)timeStampA_90perc != -1) {
-            const int binA = (int)((double)riseTimeFilterABinning*(timeStampA_90perc-timeStampA_10perc)/riseTimeFilterAScale);
-
-            if ( !(binA < 0 || binA >= riseTimeFilterABinning) ) {
-                if (bIsStart_A || bIsStop_A) {
-                    m_riseTimeFilterDataA[binA] ++;
-                    m_riseTimeFilterACounter ++;
-                    m_maxY_RiseTimeSpectrumA = qMax(m_maxY_RiseTimeSpectrumA, m_riseTimeFilterDataA[binA]);
-                }
-            }
-        }
-
-        if ((int)timeStampB_10perc != -1
-                || (int)timeStampB_90perc != -1) {
-            const int binB = (int)((double)riseTimeFilterBBinning*(timeStampB_90perc-timeStampB_10perc)/riseTimeFilterBScale);
-
-            if ( !(binB < 0 || binB >= riseTimeFilterBBinning) ) {
-                if (bIsStart_B || bIsStop_B) {
-                    m_riseTimeFilterDataB[binB] ++;
-                    m_riseTimeFilterBCounter ++;
-                    m_maxY_RiseTimeSpectrumB = qMax(m_maxY_RiseTimeSpectrumB, m_riseTimeFilterDataB[binB]);
-                }
-            }
-        }
-
-        /* apply area-filter and reject pulses if one of both appears outside the windows */
-        if (bPulseAreaFilter) {
-            const double indexPHSA = cellPHSA;
-            const double indexPHSB = cellPHSB;
-
-            const double yLowerA = (*m_dataExchange->m_areaFilterASlopeLower*indexPHSA+*m_dataExchange->m_areaFilterAInterceptLower);
-            const double yUpperA = (*m_dataExchange->m_areaFilterASlopeUpper*indexPHSA+*m_dataExchange->m_areaFilterAInterceptUpper);
-
-            const double multA = areaA*pulseAreaFilterBinningA;
-            const double multB = areaB*pulseAreaFilterBinningB;
-
-            const bool y_AInside = (multA >= yLowerA && multA <=yUpperA);
-
-            const double yLowerB = (*m_dataExchange->m_areaFilterBSlopeLower*indexPHSB+*m_dataExchange->m_areaFilterBInterceptLower);
-            const double yUpperB = (*m_dataExchange->m_areaFilterBSlopeUpper*indexPHSB+*m_dataExchange->m_areaFilterBInterceptUpper);
-
-            const bool y_BInside = (multB >= yLowerB && multB <=yUpperB);
-
-            if (!y_AInside) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if (!y_BInside) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if (y_AInside) {
-                /* incremental (mean ; stddev) */
-                double meanA  = m_areaFilterCollectedDataA[indexPHSA].x();
-                double stddevA = m_areaFilterCollectedDataA[indexPHSA].y();
-
-                m_areaFilterCollectedDataCounterA[indexPHSA] ++;
-
-                if (m_areaFilterCollectedDataCounterA[indexPHSA] >= 2) {
-                    stddevA = ((m_areaFilterCollectedDataCounterA[indexPHSA]-2)/(m_areaFilterCollectedDataCounterA[indexPHSA]-1))*stddevA*stddevA + (1.0/m_areaFilterCollectedDataCounterA[indexPHSA])*(areaA-meanA)*(areaA-meanA);
-                    stddevA = sqrt(stddevA);
-                }
-                else
-                    stddevA = 0.0;
-
-                meanA = (1/(float)m_areaFilterCollectedDataCounterA[indexPHSA])*(areaA + float(m_areaFilterCollectedDataCounterA[indexPHSA] - 1)*meanA);
-
-
-                m_areaFilterCollectedDataA[indexPHSA].setX(meanA);
-                m_areaFilterCollectedDataA[indexPHSA].setY(stddevA);
-
-
-                /* incremental (mean ; stddev) - raw */
-                double meanA_raw  = m_areaFilterCollectedDataA_raw[indexPHSA];
-
-                meanA_raw = (1/(float)m_areaFilterCollectedDataCounterA[indexPHSA])*(areaA_raw + float(m_areaFilterCollectedDataCounterA[indexPHSA] - 1)*meanA_raw);
-
-                m_areaFilterCollectedDataA_raw[indexPHSA] = meanA_raw;
-
-
-                m_areaFilterCollectedACounter ++;
-            }
-
-            if (y_BInside) {
-                /* incremental (mean ; stddev) */
-                double meanB  = m_areaFilterCollectedDataB[indexPHSB].x();
-                double stddevB = m_areaFilterCollectedDataB[indexPHSB].y();
-
-                m_areaFilterCollectedDataCounterB[indexPHSB] ++;
-
-                if (m_areaFilterCollectedDataCounterB[indexPHSB] >= 2) {
-                    stddevB = ((m_areaFilterCollectedDataCounterB[indexPHSB]-2)/(m_areaFilterCollectedDataCounterB[indexPHSB]-1))*stddevB*stddevB + (1.0/m_areaFilterCollectedDataCounterB[indexPHSB])*(areaB-meanB)*(areaB-meanB);
-                    stddevB = sqrt(stddevB);
-                }
-                else
-                    stddevB = 0.0;
-
-                meanB = (1/(float)m_areaFilterCollectedDataCounterB[indexPHSB])*(areaB + float(m_areaFilterCollectedDataCounterB[indexPHSB] - 1)*meanB);
-
-                m_areaFilterCollectedDataB[indexPHSB].setX(meanB);
-                m_areaFilterCollectedDataB[indexPHSB].setY(stddevB);
-
-                /* incremental (mean ; stddev) - raw */
-                double meanB_raw  = m_areaFilterCollectedDataB_raw[indexPHSB];
-
-                meanB_raw = (1/(float)m_areaFilterCollectedDataCounterB[indexPHSB])*(areaB_raw + float(m_areaFilterCollectedDataCounterB[indexPHSB] - 1)*meanB_raw);
-
-                m_areaFilterCollectedDataB_raw[indexPHSB] = meanB_raw;
-
-
-                m_areaFilterCollectedBCounter ++;
-            }
-
-            if ( !y_AInside || !y_BInside ) {
-                continue;
-            }
-        }
-
-        /* apply rise time-filter and reject pulses if one of both appears outside the windows */
-        if (bPulseRiseTimeFilter) {
-            const int binA = (int)((double)riseTimeFilterABinning*(timeStampA_90perc-timeStampA_10perc)/riseTimeFilterAScale);
-            const int binB = (int)((double)riseTimeFilterBBinning*(timeStampB_90perc-timeStampB_10perc)/riseTimeFilterBScale);
-
-            bool bAcceptedA = false;
-            bool bAcceptedB = false;
-
-            if (binA >= riseTimeFilterWindowLeftA && binA <= riseTimeFilterWindowRightA)
-                bAcceptedA = true;
-
-            if (binB >= riseTimeFilterWindowLeftB && binB <= riseTimeFilterWindowRightB)
-                bAcceptedB = true;
-
-            if (!bAcceptedA) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if (!bAcceptedB) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if (!bAcceptedA || !bAcceptedB) {
-                continue;
-            }
-        }
-
-        /* apply pulse-shape filter */
-        if (bPulseShapeFilterIsEnabledA
-             || bPulseShapeFilterIsEnabledB) {
-            bool bRejectA = false;
-            bool bRejectB = false;
-
-            const float fractYMaxA = 1.0f/yMaxA;
-            const float fractYMaxB = 1.0f/yMaxB;
-
-            const float fractYMinA = 1.0f/yMinA;
-            const float fractYMinB = 1.0f/yMinB;
-
-            const int size = kNumberOfBins;
-
-            const double leftOfRefA = -DRS4SettingsManager::sharedInstance()->pulseShapeFilterROILeftInNsOfA();
-            const double rightOfRefA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterROIRightInNsOfA();
-
-            const double leftOfRefB = -DRS4SettingsManager::sharedInstance()->pulseShapeFilterROILeftInNsOfB();
-            const double rightOfRefB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterROIRightInNsOfB();
-
-            DRS4PulseShapeFilterData *filterDataA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterDataPtrA();
-            DRS4PulseShapeFilterData *filterDataB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterDataPtrB();
-
-            const double lowerStddevFractionA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevLowerFractionA();
-            const double lowerStddevFractionB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevLowerFractionB();
-
-            const double upperStddevFractionA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevUpperFractionA();
-            const double upperStddevFractionB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevUpperFractionB();
-
-            for ( int j = 0 ; j < size ; ++ j ) {
-                const double tA =  (tChannel0[j] - timeAForYMax);
-                const double tB =  (tChannel1[j] - timeBForYMax);
-
-                const bool bROIA = (tA >= leftOfRefA) && (tA <= rightOfRefA);
-                const bool bROIB = (tB >= leftOfRefB) && (tB <= rightOfRefB);
-
-                if (bROIA && bPulseShapeFilterIsEnabledA) {
-                    const float yA = positiveSignal?(waveChannel0[j]*fractYMaxA):(waveChannel0[j]*fractYMinA);
-
-                    if (filterDataA) {
-                        if (!filterDataA->isInsideBounding(tA, yA, lowerStddevFractionA, upperStddevFractionA))
-                            bRejectA = true;
-                    }
-                }
-
-                if (bPulseShapeFilterIsEnabledA && bRejectA)
-                    break;
-
-                if (bROIB && bPulseShapeFilterIsEnabledB) {
-                    const float yB = positiveSignal?(waveChannel1[j]*fractYMaxB):(waveChannel1[j]*fractYMinB);
-
-                    if (filterDataB) {
-                        if (!filterDataB->isInsideBounding(tB, yB, lowerStddevFractionB, upperStddevFractionB))
-                            bRejectB = true;
-                    }
-                }
-
-                if (bPulseShapeFilterIsEnabledB && bRejectB)
-                    break;
-            }
-
-            if (bRejectA) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if (bRejectB) {
-                /* stream as 'false' pulse */
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
-                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-
-                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
-                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                    }
-                }
-            }
-
-            if (bRejectA || bRejectB) {
-                continue;
-            }
-        }
-
-        bool bValidLifetime = false;
-        bool bValidLifetime2 = false;
-
-        /* lifetime: A-B - master */
-        if ( bIsStart_A
-             && bIsStop_B && !bForcePrompt  ) {
-            const double ltdiff = (timeStampB - timeStampA);
-            const int binAB = ((int)round(((((ltdiff)+offsetAB)/scalerAB))*((double)channelCntAB)))-1;
-
-            const int binMerged = ((int)round(((((ltdiff+ATS)+offsetMerged)/scalerMerged))*((double)channelCntMerged)))-1;
-
-            if ( binAB < 0 || binAB >= channelCntAB )
-                continue;
-
-            if ( binAB >= 0
-                 && binAB < channelCntAB ) {
-                if ( bNegativeLT && ltdiff < 0  ) {
-                    m_lifeTimeDataAB[binAB] ++;
-                    m_abCounts ++;
-
-                    m_maxY_ABSpectrum = qMax(m_maxY_ABSpectrum, m_lifeTimeDataAB[binAB]);
-
-                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_AB)
-                        bValidLifetime = true;
-
-                    bValidLifetime2 = true;
-                }
-                else if ( ltdiff >= 0 ) {
-                    m_lifeTimeDataAB[binAB] ++;
-                    m_abCounts ++;
-
-                    m_maxY_ABSpectrum = qMax(m_maxY_ABSpectrum, m_lifeTimeDataAB[binAB]);
-
-                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_AB)
-                        bValidLifetime = true;
-
-                    bValidLifetime2 = true;
-                }
-
-                m_specABCounterCnt ++;
-
-                if ( bStreamInRangeArmed && bValidLifetime2) {
-                    if ( binAB >= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMinAB()
-                         && binAB <= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMaxAB() ) {
-                        if ( DRS4TextFileStreamRangeManager::sharedInstance()->isABEnabled() )
-                            DRS4TextFileStreamRangeManager::sharedInstance()->writePulses(pulseDataA(), pulseDataB(), timeStampA, timeStampB);
-                    }
-                }
-
-                if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-                    m_phsA_post[cellPHSA] ++;
-                    m_phsACounts_post ++;
-                }
-
-                if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-                    m_phsB_post[cellPHSB] ++;
-                    m_phsBCounts_post ++;
-                }
-
-                /* calculate normalized persistance data */
-                if (bPersistance && bValidLifetime2 && !bBurstMode) {
-                    m_persistanceDataA.clear();
-                    m_persistanceDataB.clear();
-
-                    m_persistanceDataA.resize(m_pListChannelA.size());
-                    m_persistanceDataB.resize(m_pListChannelB.size());
-
-                    const float fractYMaxA = 1.0f/yMaxA;
-                    const float fractYMaxB = 1.0f/yMaxB;
-
-                    const float fractYMinA = 1.0f/yMinA;
-                    const float fractYMinB = 1.0f/yMinB;
-
-                    const int size = m_persistanceDataA.size();
-                    for ( int j = 0 ; j < size ; ++ j ) {
-                        const float yA = positiveSignal?(m_pListChannelA.at(j).y()*fractYMaxA):(m_pListChannelA.at(j).y()*fractYMinA);
-                        const float yB = positiveSignal?(m_pListChannelB.at(j).y()*fractYMaxB):(m_pListChannelB.at(j).y()*fractYMinB);
-
-                        m_persistanceDataA[j] = QPointF(m_pListChannelA.at(j).x()-((!bOppositePersistanceA)?timeStampA:timeStampB), yA); // >> shift channel A relative to CFD-%(t0) of A (of B)
-                        m_persistanceDataB[j] = QPointF(m_pListChannelB.at(j).x()-((!bOppositePersistanceB)?timeStampB:timeStampA), yB); // >> shift channel B relative to CFD-%(t0) of B (of A)
-                    }
-                }
-
-                if (bValidLifetime2) {
-                    /* stream as 'false' pulse */
-                    if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()) {
-                        if (DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch() ) {
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel0, sizeOfWave)) {
-                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                            }
-
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel0S, sizeOfWave)) {
-                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
-                            }
-                        }
-                        else {
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel1, sizeOfWave)) {
-                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                            }
-
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel1S, sizeOfWave)) {
-                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
-                            }
-                        }
-                    }
-                }
-
-                /* recording pulse shape data if required */
-                if (!bBurstMode && bValidLifetime)
-                    recordPulseShapeData(positiveSignal, timeAForYMax, timeBForYMax, yMinA, yMaxA, yMinB, yMaxB);
-            }
-
-            if ( binMerged < 0 || binMerged >= channelCntMerged )
-                continue;
-
-            if ( binMerged >= 0
-                 && binMerged < channelCntMerged ) {
-                if ( bNegativeLT && ltdiff < 0  ) {
-                    m_lifeTimeDataMerged[binMerged] ++;
-                    m_mergedCounts ++;
-
-                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
-                }
-                else if ( ltdiff >= 0 ) {
-                    m_lifeTimeDataMerged[binMerged] ++;
-                    m_mergedCounts ++;
-
-                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
-                }
-
-                m_specMergedCounterCnt ++;
-            }
-        }
-        /* lifetime: B-A - master */
-        else if ( bIsStart_B
-                   && bIsStop_A && !bForcePrompt ) {
-            const double ltdiff = (timeStampA - timeStampB);
-            const int binBA = ((int)round(((((ltdiff)+offsetBA)/scalerBA))*((double)channelCntBA)))-1;
-
-            const int binMerged = ((int)round(((((ltdiff-ATS)+offsetMerged)/scalerMerged))*((double)channelCntMerged)))-1;
-
-            if ( binBA < 0 || binBA >= channelCntBA )
-                continue;
-
-            if ( binBA >= 0
-                 && binBA < channelCntBA ) {
-                if ( bNegativeLT && ltdiff < 0 ) {
-                    m_lifeTimeDataBA[binBA] ++;
-                    m_baCounts ++;
-
-                    m_maxY_BASpectrum = qMax(m_maxY_BASpectrum, m_lifeTimeDataBA[binBA]);
-
-                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_BA)
-                        bValidLifetime = true;
-
-                    bValidLifetime2 = true;
-                }
-                else if ( ltdiff >= 0 ) {
-                    m_lifeTimeDataBA[binBA] ++;
-                    m_baCounts ++;
-
-                    m_maxY_BASpectrum = qMax(m_maxY_BASpectrum, m_lifeTimeDataBA[binBA]);
-
-                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_BA)
-                        bValidLifetime = true;
-
-                    bValidLifetime2 = true;
-                }
-
-                m_specBACounterCnt ++;
-
-                if ( bStreamInRangeArmed && bValidLifetime2) {
-                    if ( binBA >= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMinBA()
-                         && binBA <= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMaxBA() ) {
-                        if ( DRS4TextFileStreamRangeManager::sharedInstance()->isBAEnabled() )
-                            DRS4TextFileStreamRangeManager::sharedInstance()->writePulses(pulseDataA(), pulseDataB(), timeStampA, timeStampB);
-                    }
-                }
-
-                /* calculate normalized persistance data */
-                if (bPersistance && bValidLifetime2 && !bBurstMode) {
-                    m_persistanceDataA.clear();
-                    m_persistanceDataB.clear();
-
-                    m_persistanceDataA.resize(m_pListChannelA.size());
-                    m_persistanceDataB.resize(m_pListChannelB.size());
-
-                    const float fractYMaxA = 1.0f/yMaxA;
-                    const float fractYMaxB = 1.0f/yMaxB;
-
-                    const float fractYMinA = 1.0f/yMinA;
-                    const float fractYMinB = 1.0f/yMinB;
-
-                    const int size = m_persistanceDataA.size();
-                    for ( int j = 0 ; j < size ; ++ j ) {
-                        const float yA = positiveSignal?(m_pListChannelA.at(j).y()*fractYMaxA):(m_pListChannelA.at(j).y()*fractYMinA);
-                        const float yB = positiveSignal?(m_pListChannelB.at(j).y()*fractYMaxB):(m_pListChannelB.at(j).y()*fractYMinB);
-
-                        m_persistanceDataA[j] = QPointF(m_pListChannelA.at(j).x()-((!bOppositePersistanceA)?timeStampA:timeStampB), yA); // >> shift channel A relative to CFD-%(t0) of A (of B)
-                        m_persistanceDataB[j] = QPointF(m_pListChannelB.at(j).x()-((!bOppositePersistanceB)?timeStampB:timeStampA), yB); // >> shift channel B relative to CFD-%(t0) of B (of A)
-                    }
-                }
-
-                if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-                    m_phsA_post[cellPHSA] ++;
-                    m_phsACounts_post ++;
-                }
-
-                if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-                    m_phsB_post[cellPHSB] ++;
-                    m_phsBCounts_post ++;
-                }
-
-                if (bValidLifetime2) {
-                    if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()) {
-                        if (DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch() ) {
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel0, sizeOfWave)) {
-                                /* nothing yet */
-                            }
-
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel0S, sizeOfWave)) {
-                                /* nothing yet */
-                            }
-                        }
-                        else {
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel1, sizeOfWave)) {
-                                /* nothing yet */
-                            }
-
-                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel1S, sizeOfWave)) {
-                                /* nothing yet */
-                            }
-                        }
-                    }
-                }
-
-                /* recording pulse shape data if required */
-                if (!bBurstMode && bValidLifetime)
-                    recordPulseShapeData(positiveSignal, timeAForYMax, timeBForYMax, yMinA, yMaxA, yMinB, yMaxB);
-            }
-
-            if ( binMerged < 0 || binMerged >= channelCntMerged )
-                continue;
-
-            if ( binMerged >= 0
-                 && binMerged < channelCntMerged ) {
-                if ( bNegativeLT && ltdiff < 0  ) {
-                    m_lifeTimeDataMerged[binMerged] ++;
-                    m_mergedCounts ++;
-
-                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
-                }
-                else if ( ltdiff >= 0 ) {
-                    m_lifeTimeDataMerged[binMerged] ++;
-                    m_mergedCounts ++;
-
-                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
-                }
-
-                m_specMergedCounterCnt ++;
-            }
-        }
-        /* prompt spectrum: A-B of stop - slave */
-        else if (  bIsStop_B && bIsStop_A ) {
-            const double ltdiff = (timeStampA - timeStampB);
-            const int binBA = ((int)round(((((ltdiff)+offsetPrompt)/scalerPrompt))*((double)channelCntPrompt)))-1;
-
-            if ( binBA < 0 || binBA >= channelCntPrompt )
-                continue;
-
-            if ( binBA >= 0
-                 && binBA < channelCntPrompt ) {
-                m_lifeTimeDataCoincidence[binBA] ++;
-                m_coincidenceCounts ++;
-
-                m_maxY_CoincidenceSpectrum = qMax(m_maxY_CoincidenceSpectrum, m_lifeTimeDataCoincidence[binBA]);
-
-                if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_Prompt)
-                    bValidLifetime = true;
-
-                bValidLifetime2 = true;
-
-                m_specCoincidenceCounterCnt ++;
-
-                /* recording pulse shape data if required */
-                if (!bBurstMode && bValidLifetime)
-                    recordPulseShapeData(positiveSignal, timeAForYMax, timeBForYMax, yMinA, yMaxA, yMinB, yMaxB);
-            }
-
-            if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-                m_phsA_post[cellPHSA] ++;
-                m_phsACounts_post ++;
-            }
-
-            if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-                m_phsB_post[cellPHSB] ++;
-                m_phsBCounts_post ++;
-            }
-
-            if (bValidLifetime2) {
-                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()) {
-                    if (DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch() ) {
-                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel0, sizeOfWave)) {
-                        }
-
-                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel0S, sizeOfWave)) {
-                            /* nothing yet */
-                        }
-                    }
-                    else {
-                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel1, sizeOfWave)) {
-                            /* nothing yet */
-                        }
-
-                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel1S, sizeOfWave)) {
-                            /* nothing yet */
-                        }
-                    }
-                }
-            }
-        } //end prompt
-    }
-}
-
-void DRS4Worker::runMultiThreaded()
-{
-    const int sizeOfWave = sizeof(float)*kNumberOfBins;
-    const int sizeOfFloat = 1/sizeof(float);
-
-    m_isBlocking = false;
-    m_isRunning = true;
-
-    const bool bDemoMode = DRS4BoardManager::sharedInstance()->isDemoModeEnabled();
-    const bool bIgnoreBusyState = DRS4SettingsManager::sharedInstance()->ignoreBusyState(); /* this value is deprecated and for test purposes only */
-    const int pulsePairChunkSize = DRS4ProgramSettingsManager::sharedInstance()->pulsePairChunkSize();
-
-    if (!bDemoMode)
-        DRS4BoardManager::sharedInstance()->currentBoard()->StartDomino();
-
-    time_t start;
-    time_t stop;
-
-    time(&start);
-    time(&stop);
-
-    forever {
-        if ( !m_isRunning ) {
-            m_isBlocking = false;
-
-            return;
-        }
-
-        if (!bIgnoreBusyState) {
-            if ( !bDemoMode ) {
-                while ( !DRS4BoardManager::sharedInstance()->currentBoard()->IsEventAvailable() ) {
-                    while ( !nextSignal() ) {
-                        m_isBlocking = true;
-                    }
-
-                    if ( !m_isRunning ) {
-                        m_isBlocking = false;
-
-                        return;
-                    }
-                }
-            }
-        }
-
-        while ( !nextSignal() ) {
-            m_isBlocking = true;
-        }
-
-        m_isBlocking = false;
-
-        const int chnA = DRS4SettingsManager::sharedInstance()->channelNumberA();
-        const int chnB = DRS4SettingsManager::sharedInstance()->channelNumberB();
-
-        if (!bDemoMode) {
-            try {
-                const int minChn = qMin(chnA, chnB);
-                const int maxChn = qMax(chnA, chnB);
-
-                DRS4BoardManager::sharedInstance()->currentBoard()->TransferWaves(minChn, maxChn);
-            }
-            catch (...) {
-                continue;
-            }
-        }
-
-        /* define concurrent input data */
-        DRS4ConcurrentCopyInputData inputData;
-
-        inputData.m_tChannel0[kNumberOfBins] = {0};
-        inputData.m_tChannel1[kNumberOfBins] = {0};
-
-        inputData.m_waveChannel0[kNumberOfBins] = {0};
-        inputData.m_waveChannel1[kNumberOfBins] = {0};
-
-        std::fill(inputData.m_tChannel0, inputData.m_tChannel0 + sizeof(inputData.m_tChannel0)*sizeOfFloat, 0);
-        std::fill(inputData.m_tChannel1, inputData.m_tChannel1 + sizeof(inputData.m_tChannel1)*sizeOfFloat, 0);
-
-        std::fill(inputData.m_waveChannel0, inputData.m_waveChannel0 + sizeof(inputData.m_waveChannel0)*sizeOfFloat, 0);
-        std::fill(inputData.m_waveChannel1, inputData.m_waveChannel1 + sizeof(inputData.m_waveChannel1)*sizeOfFloat, 0);
-
-        /* the 'S' extension represents the holding as source (original) data set */
-        float waveChannel0S[kNumberOfBins] = {0};
-        float waveChannel1S[kNumberOfBins] = {0};
-
-        std::fill(waveChannel0S, waveChannel0S + sizeof(waveChannel0S)*sizeOfFloat, 0);
-        std::fill(waveChannel1S, waveChannel1S + sizeof(waveChannel1S)*sizeOfFloat, 0);
-
-        if (!bDemoMode) {
-            int retState = 1;
-            int retStateT = 1;
-            int retStateV = kSuccess;
-
-            try {
-                retStateT = DRS4BoardManager::sharedInstance()->currentBoard()->GetTime(0, 2*chnA, DRS4BoardManager::sharedInstance()->currentBoard()->GetTriggerCell(0), inputData.m_tChannel0);
-            }
-            catch ( ... ) {
-                continue;
-            }
-
-            if ( retStateT != 1 ) {
-                continue;
-            }
-
-            try {
-                retStateT = DRS4BoardManager::sharedInstance()->currentBoard()->GetTime(0, 2*chnB ,DRS4BoardManager::sharedInstance()->currentBoard()->GetTriggerCell(0), inputData.m_tChannel1);
-            }
-            catch ( ... ) {
-                continue;
-            }
-
-            if ( retStateT != 1 ) {
-                continue;
-            }
-
-            try {
-                retStateV = DRS4BoardManager::sharedInstance()->currentBoard()->GetWave(0, 2*chnA, inputData.m_waveChannel0);
-            }
-            catch ( ... ) {
-                continue;
-            }
-
-            if ( retStateV != kSuccess ) {
-                continue;
-            }
-
-            try {
-                retStateV = DRS4BoardManager::sharedInstance()->currentBoard()->GetWave(0, 2*chnB, inputData.m_waveChannel1);
-            }
-            catch ( ... ) {
-                continue;
-            }
-
-            if ( retStateV != kSuccess ) {
-                continue;
-            }
-
-            try {
-                retState = DRS4BoardManager::sharedInstance()->currentBoard()->StartDomino(); // returns always 1.
-            }
-            catch ( ... ) {
-            }
-        }
-        else {
-            if ( !DRS4BoardManager::sharedInstance()->usingStreamDataOnDemoMode() ) {
-                if ( !DRS4PulseGenerator::sharedInstance()->receiveGeneratedPulsePair(inputData.m_tChannel0, inputData.m_waveChannel0, inputData.m_tChannel1, inputData.m_waveChannel1) )
-                    continue;
-            }
-            else {
-                if ( !DRS4StreamDataLoader::sharedInstance()->isArmed() )
-                    continue;
-
-                if ( !DRS4StreamDataLoader::sharedInstance()->receiveGeneratedPulsePair(inputData.m_tChannel0, inputData.m_waveChannel0, inputData.m_tChannel1, inputData.m_waveChannel1) ) {
-                    continue;
-                }
-            }
-        }
-
-        /* statistics: */
-        time(&stop);
-        const double diffTime = difftime(stop, start);
-        if ( diffTime >= __STATISTIC_AVG_TIME ) {
-            m_currentPulseCountRateInSeconds = ((double)m_pulseCounterCnt)/diffTime;
-            m_summedPulseCountRateInSeconds += m_currentPulseCountRateInSeconds;
-            m_avgPulseCountRateInSeconds = (m_pulseCounterCntAvg==0)?m_currentPulseCountRateInSeconds:(m_summedPulseCountRateInSeconds/(double)m_pulseCounterCntAvg);
-
-            m_currentABSpecCountRateInSeconds = ((m_specABCounterCnt==0)?0:((double)m_specABCounterCnt)/diffTime);
-            m_summedABSpecCountRateInSeconds += m_currentABSpecCountRateInSeconds;
-            m_avgABSpecCountRateInSeconds = (m_specABCounterCntAvg==0)?m_currentABSpecCountRateInSeconds:(m_summedABSpecCountRateInSeconds/(double)m_specABCounterCntAvg);
-
-            m_currentBASpecCountRateInSeconds = ((m_specBACounterCnt==0)?0:((double)m_specBACounterCnt)/diffTime);
-            m_summedBASpecCountRateInSeconds += m_currentBASpecCountRateInSeconds;
-            m_avgBASpecCountRateInSeconds = (m_specBACounterCntAvg==0)?m_currentBASpecCountRateInSeconds:(m_summedBASpecCountRateInSeconds/(double)m_specBACounterCntAvg);
-
-            m_currentMergedSpecCountRateInSeconds = ((m_specMergedCounterCnt==0)?0:((double)m_specMergedCounterCnt)/diffTime);
-            m_summedMergedSpecCountRateInSeconds += m_currentMergedSpecCountRateInSeconds;
-            m_avgMergedSpecCountRateInSeconds = (m_specMergedCounterCntAvg==0)?m_currentMergedSpecCountRateInSeconds:(m_summedMergedSpecCountRateInSeconds/(double)m_specMergedCounterCntAvg);
-
-            m_currentCoincidenceSpecCountRateInSeconds = ((m_specCoincidenceCounterCnt==0)?0:((double)m_specCoincidenceCounterCnt)/diffTime);
-            m_summedCoincidenceSpecCountRateInSeconds += m_currentCoincidenceSpecCountRateInSeconds;
-            m_avgCoincidenceSpecCountRateInSeconds = (m_specCoincidencCounterCntAvg==0)?m_currentCoincidenceSpecCountRateInSeconds:(m_summedCoincidenceSpecCountRateInSeconds/(double)m_specCoincidencCounterCntAvg);
-
-            time(&start);
-
-            m_pulseCounterCnt = 0;
-            m_pulseCounterCntAvg ++;
-
-            m_specABCounterCnt = 0;
-            m_specBACounterCnt = 0;
-            m_specMergedCounterCnt = 0;
-            m_specCoincidenceCounterCnt = 0;
-
-            m_specABCounterCntAvg ++;
-            m_specBACounterCntAvg ++;
-            m_specMergedCounterCntAvg ++;
-            m_specCoincidencCounterCntAvg ++;
-        }
-
-        m_pulseCounterCnt ++;
-
-        /* ROI variables */
-        inputData.m_startCell = DRS4SettingsManager::sharedInstance()->startCell();
-        inputData.m_endRange = DRS4SettingsManager::sharedInstance()->stopCell();
-        inputData.m_stopCellWidth = (kNumberOfBins - DRS4SettingsManager::sharedInstance()->stopCell());
-        inputData.m_cellWidth = (kNumberOfBins - inputData.m_startCell - inputData.m_stopCellWidth);
-
-        /* prevent mutex locking: call these functions only once within the loop */
-        inputData.m_positiveSignal = DRS4SettingsManager::sharedInstance()->isPositiveSignal();
-        inputData.m_cfdA = DRS4SettingsManager::sharedInstance()->cfdLevelA();
-        inputData.m_cfdB = DRS4SettingsManager::sharedInstance()->cfdLevelB();
-        inputData.m_bBurstMode = DRS4SettingsManager::sharedInstance()->isBurstMode();
-        inputData.m_sweep = DRS4SettingsManager::sharedInstance()->sweepInNanoseconds();
-        inputData.m_bPulseAreaPlot = DRS4SettingsManager::sharedInstance()->isPulseAreaFilterPlotEnabled();
-        inputData.m_bPulseAreaFilter = DRS4SettingsManager::sharedInstance()->isPulseAreaFilterEnabled();
-        inputData.m_bPulseRiseTimeFilter = DRS4SettingsManager::sharedInstance()->isRiseTimeFilterEnabled();
-
-        inputData.m_interpolationType = DRS4SettingsManager::sharedInstance()->interpolationType();
-        inputData.m_splineInterpolationType = DRS4SettingsManager::sharedInstance()->splineInterpolationType();
-        inputData.m_bUsingALGLIB = (inputData.m_splineInterpolationType < 6 && inputData.m_splineInterpolationType > 1);
-        inputData.m_bUsingTinoKluge = ((inputData.m_interpolationType == DRS4InterpolationType::type::spline) && (inputData.m_splineInterpolationType == 6));
-        inputData.m_bUsingLinearInterpol = ((inputData.m_interpolationType == DRS4InterpolationType::type::spline) && (inputData.m_splineInterpolationType == 1));
-        inputData.m_intraRenderPoints = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(DRS4SettingsManager::sharedInstance()->splineIntraSamplingCounts()):(DRS4SettingsManager::sharedInstance()->polynomialSamplingCounts());
-
-        inputData.m_bPersistance = DRS4SettingsManager::sharedInstance()->isPersistanceEnabled();
-
-        inputData.m_pulseAreaFilterBinningA = DRS4SettingsManager::sharedInstance()->pulseAreaFilterBinningA();
-        inputData.m_pulseAreaFilterBinningB = DRS4SettingsManager::sharedInstance()->pulseAreaFilterBinningB();
-        inputData.m_pulseAreaFilterNormA = DRS4SettingsManager::sharedInstance()->pulseAreaFilterNormalizationA();
-        inputData.m_pulseAreaFilterNormB = DRS4SettingsManager::sharedInstance()->pulseAreaFilterNormalizationB();
-
-        inputData.m_areaFilterASlopeUpper = *m_dataExchange->m_areaFilterASlopeUpper;
-        inputData.m_areaFilterAInterceptUpper = *m_dataExchange->m_areaFilterAInterceptUpper;
-
-        inputData.m_areaFilterASlopeLower = *m_dataExchange->m_areaFilterASlopeLower;
-        inputData.m_areaFilterAInterceptLower = *m_dataExchange->m_areaFilterAInterceptLower;
-
-        inputData.m_areaFilterBSlopeUpper = *m_dataExchange->m_areaFilterBSlopeUpper;
-        inputData.m_areaFilterBInterceptUpper = *m_dataExchange->m_areaFilterBInterceptUpper;
-
-        inputData.m_areaFilterBSlopeLower = *m_dataExchange->m_areaFilterBSlopeLower;
-        inputData.m_areaFilterBInterceptLower = *m_dataExchange->m_areaFilterBInterceptLower;
-
-        inputData.m_riseTimeFilterARangeInNanoseconds = DRS4SettingsManager::sharedInstance()->riseTimeFilterScaleInNanosecondsOfA();
-        inputData.m_riseTimeFilterBRangeInNanoseconds = DRS4SettingsManager::sharedInstance()->riseTimeFilterScaleInNanosecondsOfB();
-
-        inputData.m_riseTimeFilterBinningA = DRS4SettingsManager::sharedInstance()->riseTimeFilterBinningOfA();
-        inputData.m_riseTimeFilterBinningB = DRS4SettingsManager::sharedInstance()->riseTimeFilterBinningOfB();
-
-        inputData.m_riseTimeFilterLeftWindowA = DRS4SettingsManager::sharedInstance()->riseTimeFilterLeftWindowOfA();
-        inputData.m_riseTimeFilterLeftWindowB = DRS4SettingsManager::sharedInstance()->riseTimeFilterLeftWindowOfB();
-
-        inputData.m_riseTimeFilterRightWindowA = DRS4SettingsManager::sharedInstance()->riseTimeFilterRightWindowOfA();
-        inputData.m_riseTimeFilterRightWindowB = DRS4SettingsManager::sharedInstance()->riseTimeFilterRightWindowOfB();
-
-        inputData.m_pulseShapeFilterAIsRecording = m_isRecordingForShapeFilterA;
-        inputData.m_pulseShapeFilterBIsRecording = m_isRecordingForShapeFilterB;
-
-        inputData.m_pulseShapeFilterEnabledA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterEnabledA();
-        inputData.m_pulseShapeFilterEnabledB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterEnabledB();
-
-        inputData.m_pulseShapeFilterLeftInNsROIA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterROILeftInNsOfA();
-        inputData.m_pulseShapeFilterRightInNsROIA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterROIRightInNsOfA();
-
-        inputData.m_pulseShapeFilterLeftInNsROIB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterROILeftInNsOfB();
-        inputData.m_pulseShapeFilterRightInNsROIB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterROIRightInNsOfB();
-
-        inputData.m_pulseShapeFilterFractOfStdDevLowerA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevLowerFractionA();
-        inputData.m_pulseShapeFilterFractOfStdDevUpperA = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevUpperFractionA();
-
-        inputData.m_pulseShapeFilterFractOfStdDevLowerB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevLowerFractionB();
-        inputData.m_pulseShapeFilterFractOfStdDevUpperB = DRS4SettingsManager::sharedInstance()->pulseShapeFilterStdDevUpperFractionB();
-
-        inputData.m_rcScheme = DRS4SettingsManager::sharedInstance()->pulseShapeFilterRecordScheme();
-
-        if (inputData.m_pulseShapeFilterEnabledA) {
-            inputData.m_pulseShapeFilterDataMeanTraceA_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataMeanTraceA_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            inputData.m_pulseShapeFilterDataStdDevTraceA_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataStdDevTraceA_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceA_X, inputData.m_pulseShapeFilterDataMeanTraceA_X + sizeof(inputData.m_pulseShapeFilterDataMeanTraceA_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceA_Y, inputData.m_pulseShapeFilterDataMeanTraceA_Y + sizeof(inputData.m_pulseShapeFilterDataMeanTraceA_Y)*sizeOfFloat, 0);
-
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceA_X, inputData.m_pulseShapeFilterDataStdDevTraceA_X + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceA_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceA_Y, inputData.m_pulseShapeFilterDataStdDevTraceA_Y + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceA_Y)*sizeOfFloat, 0);
-
-            DRS4SettingsManager::sharedInstance()->pulseShapeFilterDataPtrA()->meanCpy(inputData.m_pulseShapeFilterDataMeanTraceA_X, inputData.m_pulseShapeFilterDataMeanTraceA_Y);
-            DRS4SettingsManager::sharedInstance()->pulseShapeFilterDataPtrA()->stddevCpy(inputData.m_pulseShapeFilterDataStdDevTraceA_X, inputData.m_pulseShapeFilterDataStdDevTraceA_Y);
-        }
-        else {
-            inputData.m_pulseShapeFilterDataMeanTraceA_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataMeanTraceA_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            inputData.m_pulseShapeFilterDataStdDevTraceA_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataStdDevTraceA_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceA_X, inputData.m_pulseShapeFilterDataMeanTraceA_X + sizeof(inputData.m_pulseShapeFilterDataMeanTraceA_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceA_Y, inputData.m_pulseShapeFilterDataMeanTraceA_Y + sizeof(inputData.m_pulseShapeFilterDataMeanTraceA_Y)*sizeOfFloat, 0);
-
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceA_X, inputData.m_pulseShapeFilterDataStdDevTraceA_X + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceA_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceA_Y, inputData.m_pulseShapeFilterDataStdDevTraceA_Y + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceA_Y)*sizeOfFloat, 0);
-        }
-
-        if (inputData.m_pulseShapeFilterEnabledB) {
-            inputData.m_pulseShapeFilterDataMeanTraceB_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataMeanTraceB_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            inputData.m_pulseShapeFilterDataStdDevTraceB_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataStdDevTraceB_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceB_X, inputData.m_pulseShapeFilterDataMeanTraceB_X + sizeof(inputData.m_pulseShapeFilterDataMeanTraceB_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceB_Y, inputData.m_pulseShapeFilterDataMeanTraceB_Y + sizeof(inputData.m_pulseShapeFilterDataMeanTraceB_Y)*sizeOfFloat, 0);
-
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceB_X, inputData.m_pulseShapeFilterDataStdDevTraceB_X + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceB_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceB_Y, inputData.m_pulseShapeFilterDataStdDevTraceB_Y + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceB_Y)*sizeOfFloat, 0);
-
-            DRS4SettingsManager::sharedInstance()->pulseShapeFilterDataPtrB()->meanCpy(inputData.m_pulseShapeFilterDataMeanTraceB_X, inputData.m_pulseShapeFilterDataMeanTraceB_Y);
-            DRS4SettingsManager::sharedInstance()->pulseShapeFilterDataPtrB()->stddevCpy(inputData.m_pulseShapeFilterDataStdDevTraceB_X, inputData.m_pulseShapeFilterDataStdDevTraceB_Y);
-        }
-        else {
-            inputData.m_pulseShapeFilterDataMeanTraceB_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataMeanTraceB_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            inputData.m_pulseShapeFilterDataStdDevTraceB_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-            inputData.m_pulseShapeFilterDataStdDevTraceB_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER] = {0};
-
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceB_X, inputData.m_pulseShapeFilterDataMeanTraceB_X + sizeof(inputData.m_pulseShapeFilterDataMeanTraceB_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataMeanTraceB_Y, inputData.m_pulseShapeFilterDataMeanTraceB_Y + sizeof(inputData.m_pulseShapeFilterDataMeanTraceB_Y)*sizeOfFloat, 0);
-
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceB_X, inputData.m_pulseShapeFilterDataStdDevTraceB_X + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceB_X)*sizeOfFloat, 0);
-            std::fill(inputData.m_pulseShapeFilterDataStdDevTraceB_Y, inputData.m_pulseShapeFilterDataStdDevTraceB_Y + sizeof(inputData.m_pulseShapeFilterDataStdDevTraceB_Y)*sizeOfFloat, 0);
-        }
-
-        inputData.m_channelCntAB = DRS4SettingsManager::sharedInstance()->channelCntAB();
-        inputData.m_channelCntBA = DRS4SettingsManager::sharedInstance()->channelCntBA();
-        inputData.m_channelCntPrompt = DRS4SettingsManager::sharedInstance()->channelCntCoincindence();
-        inputData.m_channelCntMerged = DRS4SettingsManager::sharedInstance()->channelCntMerged();
-
-        inputData.m_offsetAB = DRS4SettingsManager::sharedInstance()->offsetInNSAB();
-        inputData.m_offsetBA = DRS4SettingsManager::sharedInstance()->offsetInNSBA();
-        inputData.m_offsetPrompt = DRS4SettingsManager::sharedInstance()->offsetInNSCoincidence();
-        inputData.m_offsetMerged = DRS4SettingsManager::sharedInstance()->offsetInNSMerged();
-
-        inputData.m_scalerAB = DRS4SettingsManager::sharedInstance()->scalerInNSAB();
-        inputData.m_scalerBA = DRS4SettingsManager::sharedInstance()->scalerInNSBA();
-        inputData.m_scalerPrompt = DRS4SettingsManager::sharedInstance()->scalerInNSCoincidence();
-        inputData.m_scalerMerged = DRS4SettingsManager::sharedInstance()->scalerInNSMerged();
-
-        inputData.m_ATS = DRS4SettingsManager::sharedInstance()->meanCableDelay();
-
-        inputData.m_bNegativeLT = DRS4SettingsManager::sharedInstance()->isNegativeLTAccepted();
-        inputData.m_bForcePrompt = DRS4SettingsManager::sharedInstance()->isforceCoincidence();
-
-        inputData.m_startAMinPHS = DRS4SettingsManager::sharedInstance()->startChanneAMin();
-        inputData.m_startAMaxPHS = DRS4SettingsManager::sharedInstance()->startChanneAMax();
-        inputData.m_startBMinPHS = DRS4SettingsManager::sharedInstance()->startChanneBMin();
-        inputData.m_startBMaxPHS = DRS4SettingsManager::sharedInstance()->startChanneBMax();
-
-        inputData.m_stopAMinPHS = DRS4SettingsManager::sharedInstance()->stopChanneAMin();
-        inputData.m_stopAMaxPHS = DRS4SettingsManager::sharedInstance()->stopChanneAMax();
-        inputData.m_stopBMinPHS = DRS4SettingsManager::sharedInstance()->stopChanneBMin();
-        inputData.m_stopBMaxPHS = DRS4SettingsManager::sharedInstance()->stopChanneBMax();
-
-        inputData.m_bMedianFilterA = DRS4SettingsManager::sharedInstance()->medianFilterAEnabled();
-        inputData.m_bMedianFilterB = DRS4SettingsManager::sharedInstance()->medianFilterBEnabled();
-        inputData.m_medianFilterWindowSizeA = DRS4SettingsManager::sharedInstance()->medianFilterWindowSizeA();
-        inputData.m_medianFilterWindowSizeB = DRS4SettingsManager::sharedInstance()->medianFilterWindowSizeB();
-
-        /* Baseline - Jitter Corrections */
-        /* Baseline - Jitter Corrections */
-        DRS4BaselineCorrectionType::type blTypeA = DRS4SettingsManager::sharedInstance()->baselineCorrectionMethodA();
-        int bl_peakCellA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartPeakCellA();
-        int bl_windowA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationWindowA();
-        bool bUseBaseLineCorrectionA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationEnabledA();
-        int bl_startCellA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartCellA();
-        int bl_cellRegionA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationRegionA();
-        double bl_valueA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationShiftValueInMVA();
-        bool bUseBaseLineCorrectionRejectionA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitRejectLimitA();
-        double bl_rejectionLimitA = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitInPercentageA();
-
-        DRS4BaselineCorrectionType::type blTypeB = DRS4SettingsManager::sharedInstance()->baselineCorrectionMethodB();
-        int bl_peakCellB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartPeakCellB();
-        int bl_windowB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationWindowB();
-        bool bUseBaseLineCorrectionB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationEnabledB();
-        int bl_startCellB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationStartCellB();
-        int bl_cellRegionB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationRegionB();
-        double bl_valueB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationShiftValueInMVB();
-        bool bUseBaseLineCorrectionRejectionB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitRejectLimitB();
-        double bl_rejectionLimitB = DRS4SettingsManager::sharedInstance()->baselineCorrectionCalculationLimitInPercentageB();
-
-        const bool bIntrinsicFilterA = (inputData.m_bMedianFilterA || bUseBaseLineCorrectionA);
-        const bool bIntrinsicFilterB = (inputData.m_bMedianFilterB || bUseBaseLineCorrectionB);
-
-        if (bIntrinsicFilterA) {
-            copy(inputData.m_waveChannel0, inputData.m_waveChannel0 + kNumberOfBins, waveChannel0S);
-        }
-
-        if (bIntrinsicFilterB) {
-            copy(inputData.m_waveChannel1, inputData.m_waveChannel1 + kNumberOfBins, waveChannel1S);
-        }
-
-        /* apply median filter to remove spikes */
-        if (inputData.m_bMedianFilterA) {
-            if (!DMedianFilter::apply(inputData.m_waveChannel0, kNumberOfBins, inputData.m_medianFilterWindowSizeA))
-                continue;
-        }
-
-        if (inputData.m_bMedianFilterB) {
-            if (!DMedianFilter::apply(inputData.m_waveChannel1, kNumberOfBins, inputData.m_medianFilterWindowSizeB))
-                continue;
-        }
-
-        /* baseline - jitter corrections */
-        if (bUseBaseLineCorrectionA) {
-            if (blTypeA == DRS4BaselineCorrectionType::type::fixed) {
-                const int endRegionA = (bl_startCellA + bl_cellRegionA - 1);
-
-                double blA = 0.0f;
-
-                for (int i = bl_startCellA ; i  < endRegionA ; ++ i )
-                    blA += inputData.m_waveChannel0[i];
-
-                blA /= bl_cellRegionA;
-
-                const bool limitExceededA = (abs(blA - bl_valueA)/500.0) > bl_rejectionLimitA*0.01;
-
-                if (bUseBaseLineCorrectionRejectionA && limitExceededA)
-                    continue;
-
-                for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                    inputData.m_waveChannel0[i] -= blA;
-            }
-            else if (blTypeA == DRS4BaselineCorrectionType::type::dynamic) {
-                float minV = 500.0;
-                float maxV = -500.0;
-
-                int iMinV = -1;
-                int iMaxV = -1;
-
-                int iStart = -1;
-                int iStop = -1;
-
-                for (int i = 0 ; i < kNumberOfBins ; ++ i) {
-                    if (inputData.m_waveChannel0[i] < minV) {
-                        iMinV = i;
-                        minV = inputData.m_waveChannel0[i];
-                    }
-
-                    if (inputData.m_waveChannel0[i] > maxV) {
-                        iMaxV = i;
-                        maxV = inputData.m_waveChannel0[i];
-                    }
-                }
-
-                if (inputData.m_positiveSignal) {
-                    iStop = iMaxV;
-
-                    if (iMaxV - bl_peakCellA < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMaxV - bl_peakCellA;
-                }
-                else {
-                    iStop = iMinV;
-
-                    if (iMinV - bl_peakCellA < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMinV - bl_peakCellA;
-                }
-
-                int lastIndex = -1;
-                for (int i = iStart ; i <  iStop - bl_windowA ; ++ i) {
-                    // mean + stddev
-                    float mean = 0.;
-                    float stddev = 0.;
-
-                    for (int s = 0 ; s < bl_windowA ; ++ s)
-                         mean +=  inputData.m_waveChannel0[i+s];
-
-                    mean /= bl_windowA;
-
-                    for (int s = 0 ; s < bl_windowA ; ++ s)
-                        stddev += (inputData.m_waveChannel0[i+s] - mean)*(inputData.m_waveChannel0[i+s] - mean);
-
-                    stddev /= (bl_windowA-1);
-
-                    if (inputData.m_positiveSignal) {
-                        if (inputData.m_waveChannel0[i+bl_windowA] > mean + stddev
-                                || inputData.m_waveChannel0[i+bl_windowA] < mean - stddev) {
-                            lastIndex = i;
-                            break;
-                        }
-                    }
-                    else {
-                        if (inputData.m_waveChannel0[i+bl_windowA] < mean - stddev
-                                || inputData.m_waveChannel0[i+bl_windowA] > mean + stddev) {
-                            lastIndex = i;
-                            break;
-                        }
-                    }
-                }
-
-                const int length = lastIndex - iStart;
-
-                if (length) {
-                    float mean = 0.;
-                    for (int i = 0 ; i < length ; ++ i)
-                        mean += inputData.m_waveChannel0[iStart + i];
-
-                    mean /= length;
-
-                    const bool limitExceededA = (abs(mean - bl_valueA)/500.0) > bl_rejectionLimitA*0.01;
-
-                    if (bUseBaseLineCorrectionRejectionA && limitExceededA)
-                        continue;
-
-                    for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                        inputData.m_waveChannel0[i] -= mean;
-                }
-                else
-                    continue;
-            }
-        }
-
-        if (bUseBaseLineCorrectionB) {
-            if (blTypeB == DRS4BaselineCorrectionType::type::fixed) {
-                const int endRegionB = (bl_startCellB + bl_cellRegionB - 1);
-
-                double blB = 0.0f;
-
-                for (int i = bl_startCellB ; i  < endRegionB ; ++ i )
-                    blB += inputData.m_waveChannel1[i];
-
-                blB /= bl_cellRegionB;
-
-                const bool limitExceededB = (abs(blB - bl_valueB)/500.0) > bl_rejectionLimitB*0.01;
-
-                if (bUseBaseLineCorrectionRejectionB && limitExceededB)
-                    continue;
-
-                for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                    inputData.m_waveChannel1[i] -= blB;
-            }
-            else if (blTypeB == DRS4BaselineCorrectionType::type::dynamic) {
-                float minV = 500.0;
-                float maxV = -500.0;
-
-                int iMinV = -1;
-                int iMaxV = -1;
-
-                int iStart = -1;
-                int iStop = -1;
-
-                for (int i = 0 ; i < kNumberOfBins ; ++ i) {
-                    if (inputData.m_waveChannel1[i] < minV) {
-                        iMinV = i;
-                        minV = inputData.m_waveChannel1[i];
-                    }
-
-                    if (inputData.m_waveChannel1[i] > maxV) {
-                        iMaxV = i;
-                        maxV = inputData.m_waveChannel1[i];
-                    }
-                }
-
-                if (inputData.m_positiveSignal) {
-                    iStop = iMaxV;
-
-                    if (iMaxV - bl_peakCellB < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMaxV - bl_peakCellB;
-                }
-                else {
-                    iStop = iMinV;
-
-                    if (iMinV - bl_peakCellB < 0)
-                        iStart = 0;
-                    else
-                        iStart = iMinV - bl_peakCellB;
-                }
-
-                int lastIndex = -1;
-                for (int i = iStart ; i <  iStop - bl_windowB ; ++ i) {
-                    // mean + stddev
-                    float mean = 0.;
-                    float stddev = 0.;
-
-                    for (int s = 0 ; s < bl_windowB ; ++ s)
-                         mean +=  inputData.m_waveChannel1[i+s];
-
-                    mean /= bl_windowB;
-
-                    for (int s = 0 ; s < bl_windowB ; ++ s)
-                        stddev += (inputData.m_waveChannel1[i+s] - mean)*(inputData.m_waveChannel1[i+s] - mean);
-
-                    stddev /= (bl_windowB-1);
-
-                    if (inputData.m_positiveSignal) {
-                        if (inputData.m_waveChannel1[i+bl_windowB] > mean + stddev
-                                || inputData.m_waveChannel1[i+bl_windowB] < mean - stddev) {
-                            lastIndex = i;
-                            break;
-                        }
-                    }
-                    else {
-                        if (inputData.m_waveChannel1[i+bl_windowB] < mean - stddev
-                                || inputData.m_waveChannel1[i+bl_windowB] > mean + stddev) {
-                            lastIndex = i;
-                            break;
-                        }
-                    }
-                }
-
-                const int length = lastIndex - iStart;
-
-                if (length) {
-                    float mean = 0.;
-                    for (int i = 0 ; i < length ; ++ i)
-                        mean += inputData.m_waveChannel1[iStart + i];
-
-                    mean /= length;
-
-                    const bool limitExceededB = (abs(mean - bl_valueB)/500.0) > bl_rejectionLimitB*0.01;
-
-                    if (bUseBaseLineCorrectionRejectionB && limitExceededB)
-                        continue;
-
-                    for (int i = 0 ; i < kNumberOfBins ; ++ i)
-                        inputData.m_waveChannel1[i] -= mean;
-                }
-                else
-                    continue;
-            }
-        }
-
-        /* clear pulse-data for new visualization */
-        if (!inputData.m_bBurstMode) {
-            resetPulseA();
-            resetPulseB();
-
-            m_pListChannelA.resize(inputData.m_cellWidth);
-            m_pListChannelB.resize(inputData.m_cellWidth);
-
-            /* reduce mathematical operations within in the loop */
-            const int reducedEndRange = (inputData.m_endRange - 1);
-            const int reducedCellWidth = (inputData.m_cellWidth - 1);
-
-            /* determine min/max and proceed a CFD estimation in ROI */
-            for ( int a = reducedEndRange, it = reducedCellWidth ; a >= inputData.m_startCell ; -- a, -- it ) {
-                m_pListChannelA[it] = QPointF(inputData.m_tChannel0[a], inputData.m_waveChannel0[a]);
-                m_pListChannelB[it] = QPointF(inputData.m_tChannel1[a], inputData.m_waveChannel1[a]);
-            }
-        }
-
-        if ( DRS4StreamManager::sharedInstance()->isArmed() ) {
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)inputData.m_tChannel0, sizeOfWave)) {
-                /* nothing yet */
-            }
-
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)(!bIntrinsicFilterA?inputData.m_waveChannel0:waveChannel0S), sizeOfWave)) {
-                /* nothing yet */
-            }
-
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)inputData.m_tChannel1, sizeOfWave)) {
-                /* nothing yet */
-            }
-
-            if (!DRS4StreamManager::sharedInstance()->write((const char*)(!bIntrinsicFilterB?inputData.m_waveChannel1:waveChannel1S), sizeOfWave)) {
-                /* nothing yet */
-            }
-        }
-
-        m_copyData.append(inputData);
-
-        if ( m_copyData.size() == pulsePairChunkSize ) {
-            m_workerConcurrentManager->add(m_copyData);
-            m_copyData.clear();
-        }
-    } // end forever
-}
-
-DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInputData> &copyDataVec)
-{
-    if ( copyDataVec.size() == 0 )
-        return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
-
-    const int channelCntCoincindence = copyDataVec.first().m_channelCntPrompt;
-    const int channelCntAB = copyDataVec.first().m_channelCntAB;
-    const int channelCntBA = copyDataVec.first().m_channelCntBA;
-    const int channelCntMerged = copyDataVec.first().m_channelCntMerged;
-
-    for ( DRS4ConcurrentCopyInputData copyData : copyDataVec ) {
-        if ( channelCntCoincindence != copyData.m_channelCntPrompt )
-            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
-
-        if ( channelCntAB != copyData.m_channelCntAB )
-            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
-
-        if ( channelCntBA != copyData.m_channelCntBA )
-            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
-
-        if ( channelCntMerged != copyData.m_channelCntMerged )
-            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
-    }
-
-    /* ALGLIB */
-    alglib::real_1d_array arrayDataX_A, arrayDataY_A;
-    alglib::real_1d_array arrayDataX_B, arrayDataY_B;
-
-    alglib::spline1dinterpolant interpolantA;
-    alglib::spline1dinterpolant interpolantB;
-
-    alglib::barycentricinterpolant baryCentricInterpolantA;
-    alglib::barycentricinterpolant baryCentricInterpolantB;
-
-    /* Tino Kluge */
-    std::vector<double> arrayDataTKX_A, arrayDataTKY_A;
-    std::vector<double> arrayDataTKX_B, arrayDataTKY_B;
-
-    DSpline tkSplineA, tkSplineB;
-
-    DRS4ConcurrentCopyOutputData outputData(channelCntCoincindence, channelCntAB, channelCntBA, channelCntMerged, false);
-
-    for ( DRS4ConcurrentCopyInputData inputData : copyDataVec ) {
-        if (inputData.m_bUsingALGLIB) {
-            /* ALGLIB array allocation */
-            arrayDataX_A.setlength(inputData.m_cellWidth);
-            arrayDataY_A.setlength(inputData.m_cellWidth);
-            arrayDataX_B.setlength(inputData.m_cellWidth);
-            arrayDataY_B.setlength(inputData.m_cellWidth);
-        }
-        else if (inputData.m_bUsingTinoKluge) {
-            arrayDataTKX_A.resize(inputData.m_cellWidth);
-            arrayDataTKX_B.resize(inputData.m_cellWidth);
-            arrayDataTKY_A.resize(inputData.m_cellWidth);
-            arrayDataTKY_B.resize(inputData.m_cellWidth);
-        }
-        else if (inputData.m_bUsingLinearInterpol) {
-            /* nothing to do yet */
-        }
-
-        /* inline time and voltage extrema value estimation */
-        float xMinA = inputData.m_sweep;
-        float xMaxA = 0.0f;
-
-        float xMinB = inputData.m_sweep;
-        float xMaxB = 0.0f;
-
-        float yMinA = 500.0f;
-        float yMaxA = -500.0f;
-
-        float yMinB = 500.0f;
-        float yMaxB = -500.0f;
-
-        /* inline voltage extrema value estimation */
-        int cellYAMin = -1;
-        int cellYAMax = -1;
-
-        int cellYBMin = -1;
-        int cellYBMax = -1;
-
-        /* inline CFD value estimation */
-        float cfdValueA = 0.0f;
-        float cfdValueB = 0.0f;
-
-        float cfdValueA_10perc = 0.0f;
-        float cfdValueB_10perc = 0.0f;
-
-        float cfdValueA_90perc = 0.0f;
-        float cfdValueB_90perc = 0.0f;
-
-        /* inline CFD cell estimation */
-        int estimCFDACellStart = -1;
-        int estimCFDBCellStart = -1;
-
-        int estimCFDACellStop = -1;
-        int estimCFDBCellStop = -1;
-
-        /* inline CF (10%, 90%) cell estimation >> rise-time estimation (delta illumination signal) */
-        int estimCFDACellStart_10perc = -1;
-        int estimCFDBCellStart_10perc = -1;
-
-        int estimCFDACellStart_90perc = -1;
-        int estimCFDBCellStart_90perc = -1;
-
-        int estimCFDACellStop_10perc = -1;
-        int estimCFDBCellStop_10perc = -1;
-
-        int estimCFDACellStop_90perc = -1;
-        int estimCFDBCellStop_90perc = -1;
-
-        int cfdACounter = 0;
-        int cfdBCounter = 0;
-
-        float areaA = 0.0f;
-        float areaB = 0.0f;
-
-        /* reduce mathematical operations within in the loop */
-        const int reducedEndRange = (inputData.m_endRange - 1);
-        const int reducedCellWidth = (inputData.m_cellWidth - 1);
-        const int extendedStartCell = (inputData.m_startCell + 1);
-
+        /* apply pulse-shape filter */
+        if (bPulseShapeFilterIsEnabledA
+             || bPulseShapeFilterIsEnabledB) {
+            bool bRejectA = false;
+            bool bRejectB = false;
 
-        bool bForceReject = false;
+            const float fractYMaxA = 1.0f/yMaxA;
+            const float fractYMaxB = 1.0f/yMaxB;
 
-        /* determine min/max and proceed a CFD estimation in ROI */
-        for ( int a = reducedEndRange, it = reducedCellWidth ; a >= inputData.m_startCell ; -- a, -- it ) {
-            /* time domain bracket values */
-            xMinA = qMin(xMinA, inputData.m_tChannel0[a]);
-            xMaxA = qMax(xMaxA, inputData.m_tChannel0[a]);
+            const float fractYMinA = 1.0f/yMinA;
+            const float fractYMinB = 1.0f/yMinB;
 
-            xMinB = qMin(xMinB, inputData.m_tChannel1[a]);
-            xMaxB = qMax(xMaxB, inputData.m_tChannel1[a]);
+            const int size = kNumberOfBins;
 
-            if ( inputData.m_waveChannel0[a] >= yMaxA ) {
-                yMaxA = inputData.m_waveChannel0[a];
-                cellYAMax = a;
+            /* the samples are tested alternately (A before B) and the test stops at the first rejected sample: only the channel rejecting first is marked */
+            const int firstRejectA = bPulseShapeFilterIsEnabledA?config->m_pulseShapeFilterEnvelopeA.firstReject(tChannel0, waveChannel0, size, timeAForYMax, positiveSignal?fractYMaxA:fractYMinA):size;
+            const int firstRejectB = bPulseShapeFilterIsEnabledB?config->m_pulseShapeFilterEnvelopeB.firstReject(tChannel1, waveChannel1, firstRejectA, timeBForYMax, positiveSignal?fractYMaxB:fractYMinB):size;
 
-                if (inputData.m_positiveSignal) {
-                    cfdValueA = inputData.m_cfdA*yMaxA;
+            bRejectA = (firstRejectA < size) && (firstRejectB >= firstRejectA);
+            bRejectB = (firstRejectB < firstRejectA);
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueA_10perc = 0.1*yMaxA;
-                    cfdValueA_90perc = 0.9*yMaxA;
+            if (bRejectA) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel0, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
 
-                    cfdACounter = 0;
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel0S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
                 }
             }
 
-            if ( inputData.m_waveChannel1[a] >= yMaxB ) {
-                yMaxB = inputData.m_waveChannel1[a];
-                cellYBMax = a;
-
-                if (inputData.m_positiveSignal) {
-                    cfdValueB = inputData.m_cfdB*yMaxB;
-
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueB_10perc = 0.1*yMaxB;
-                    cfdValueB_90perc = 0.9*yMaxB;
+            if (bRejectB) {
+                /* stream as 'false' pulse */
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()
+                     && !DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch()) {
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)tChannel1, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
 
-                    cfdBCounter = 0;
+                    if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeFalsePulse((const char*)waveChannel1S, sizeOfWave)) {
+                        // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteFalsePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                    }
                 }
             }
 
-            if ( inputData.m_waveChannel0[a] <= yMinA ) {
-                yMinA = inputData.m_waveChannel0[a];
-                cellYAMin = a;
-
-                if (!inputData.m_positiveSignal) {
-                    cfdValueA = inputData.m_cfdA*yMinA;
-
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueA_10perc = 0.1*yMinA;
-                    cfdValueA_90perc = 0.9*yMinA;
-
-                    cfdACounter = 0;
-                }
+            if (!rejectCounter.pass(DRS4RejectFilter::pulseShape, !(bRejectA || bRejectB))) {
+                continue;
             }
+        }
 
-            if ( inputData.m_waveChannel1[a] <= yMinB ) {
-                yMinB = inputData.m_waveChannel1[a];
-                cellYBMin = a;
+        bool bValidLifetime = false;
+        bool bValidLifetime2 = false;
 
-                if (!inputData.m_positiveSignal) {
-                    cfdValueB = inputData.m_cfdB*yMinB;
+        /* lifetime: A-B - master */
+        if ( bIsStart_A
+             && bIsStop_B && !bForcePrompt  ) {
+            const double ltdiff = (timeStampB - timeStampA);
+            const int binAB = ((int)round(((((ltdiff)+offsetAB)/scalerAB))*((double)channelCntAB)))-1;
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    cfdValueB_10perc = 0.1*yMinB;
-                    cfdValueB_90perc = 0.9*yMinB;
+            const int binMerged = ((int)round(((((ltdiff+ATS)+offsetMerged)/scalerMerged))*((double)channelCntMerged)))-1;
 
-                    cfdBCounter = 0;
-                }
-            }
+            if (!rejectCounter.pass(DRS4RejectFilter::lifetimeRange, !( binAB < 0 || binAB >= channelCntAB )))
+                continue;
 
-            /* CFD cell estimation/determination */
-            if ( a >= extendedStartCell ) {
-                const int aDecr = (a - 1);
+            if ( binAB >= 0
+                 && binAB < channelCntAB ) {
+                if ( bNegativeLT && ltdiff < 0  ) {
+                    m_lifeTimeDataAB[binAB] ++;
+                    m_abCounts ++;
 
-                /* calculate the pulse area of ROI */
-                if (inputData.m_bPulseAreaPlot
-                        || inputData.m_bPulseAreaFilter) {
-                    areaA += abs((inputData.m_waveChannel0[aDecr] + 0.5*(inputData.m_waveChannel0[a] - inputData.m_waveChannel0[aDecr]))*(inputData.m_tChannel0[a] - inputData.m_tChannel0[aDecr]));
-                    areaB += abs((inputData.m_waveChannel1[aDecr] + 0.5*(inputData.m_waveChannel1[a] - inputData.m_waveChannel1[aDecr]))*(inputData.m_tChannel1[a] - inputData.m_tChannel1[aDecr]));
-                }
+                    m_maxY_ABSpectrum = qMax(m_maxY_ABSpectrum, m_lifeTimeDataAB[binAB]);
 
-                const double slopeA = (inputData.m_waveChannel0[a] - inputData.m_waveChannel0[aDecr])/(inputData.m_tChannel0[a] - inputData.m_tChannel0[aDecr]);
-                const double slopeB = (inputData.m_waveChannel1[a] - inputData.m_waveChannel1[aDecr])/(inputData.m_tChannel1[a] - inputData.m_tChannel1[aDecr]);
+                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_AB)
+                        bValidLifetime = true;
 
-                if (!qIsFinite(slopeA) || !qIsFinite(slopeB)) {
-                    bForceReject = true;
+                    bValidLifetime2 = true;
                 }
+                else if ( ltdiff >= 0 ) {
+                    m_lifeTimeDataAB[binAB] ++;
+                    m_abCounts ++;
 
-                /* CFD on rising edge = positive slope? or falling edge = negative slope?*/
-                const bool bInRangeA = inputData.m_positiveSignal?(slopeA > 1E-6):(slopeA < 1E-6);
-                const bool bInRangeB = inputData.m_positiveSignal?(slopeB > 1E-6):(slopeB < 1E-6);
-
-                if ( bInRangeA ) {
-                    const bool cfdLevelInRangeA = inputData.m_positiveSignal?(inputData.m_waveChannel0[a] > cfdValueA && inputData.m_waveChannel0[aDecr] < cfdValueA):(inputData.m_waveChannel0[a] < cfdValueA && inputData.m_waveChannel0[aDecr] > cfdValueA);
-
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    const bool cfdLevelInRangeA_10perc = inputData.m_positiveSignal?(inputData.m_waveChannel0[a] > cfdValueA_10perc && inputData.m_waveChannel0[aDecr] < cfdValueA_10perc):(inputData.m_waveChannel0[a] < cfdValueA_10perc && inputData.m_waveChannel0[aDecr] > cfdValueA_10perc);
-                    const bool cfdLevelInRangeA_90perc = inputData.m_positiveSignal?(inputData.m_waveChannel0[a] > cfdValueA_90perc && inputData.m_waveChannel0[aDecr] < cfdValueA_90perc):(inputData.m_waveChannel0[a] < cfdValueA_90perc && inputData.m_waveChannel0[aDecr] > cfdValueA_90perc);
+                    m_maxY_ABSpectrum = qMax(m_maxY_ABSpectrum, m_lifeTimeDataAB[binAB]);
 
-                    if ( cfdLevelInRangeA ) {
-                        estimCFDACellStart = aDecr;
-                        estimCFDACellStop = a;
+                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_AB)
+                        bValidLifetime = true;
 
-                        cfdACounter ++;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel0[a], cfdValueA) ) {
-                        estimCFDACellStart = a;
-                        estimCFDACellStop = a;
+                    bValidLifetime2 = true;
+                }
 
-                        cfdACounter ++;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel0[aDecr], cfdValueA) ) {
-                        estimCFDACellStart = aDecr;
-                        estimCFDACellStop = aDecr;
+                m_specABCounterCnt ++;
 
-                        cfdACounter ++;
+                if ( bStreamInRangeArmed && bValidLifetime2) {
+                    if ( binAB >= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMinAB()
+                         && binAB <= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMaxAB() ) {
+                        if ( DRS4TextFileStreamRangeManager::sharedInstance()->isABEnabled() )
+                            DRS4TextFileStreamRangeManager::sharedInstance()->writePulses(pulseDataA(), pulseDataB(), timeStampA, timeStampB);
                     }
+                }
 
-                    /* 10% CF Level */
-                    if ( cfdLevelInRangeA_10perc ) {
-                        estimCFDACellStart_10perc = aDecr;
-                        estimCFDACellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel0[a], cfdValueA_10perc) ) {
-                        estimCFDACellStart_10perc = a;
-                        estimCFDACellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel0[aDecr], cfdValueA_10perc) ) {
-                        estimCFDACellStart_10perc = aDecr;
-                        estimCFDACellStop_10perc = aDecr;
-                    }
+                if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
+                    m_phsA_post[cellPHSA] ++;
+                    m_phsACounts_post ++;
+                }
 
-                    /* 90% CF Level */
-                    if ( cfdLevelInRangeA_90perc ) {
-                        estimCFDACellStart_90perc = aDecr;
-                        estimCFDACellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel0[a], cfdValueA_90perc) ) {
-                        estimCFDACellStart_90perc = a;
-                        estimCFDACellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel0[aDecr], cfdValueA_90perc) ) {
-                        estimCFDACellStart_90perc = aDecr;
-                        estimCFDACellStop_90perc = aDecr;
-                    }
+                if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
+                    m_phsB_post[cellPHSB] ++;
+                    m_phsBCounts_post ++;
                 }
 
-                if ( bInRangeB ) {
-                    const bool cfdLevelInRangeB = inputData.m_positiveSignal?(inputData.m_waveChannel1[a] > cfdValueB && inputData.m_waveChannel1[aDecr] < cfdValueB):(inputData.m_waveChannel1[a] < cfdValueB && inputData.m_waveChannel1[aDecr] > cfdValueB);
+                /* calculate normalized persistance data */
+                if (bPersistance && bValidLifetime2 && !bBurstMode) {
+                    m_persistanceDataA.clear();
+                    m_persistanceDataB.clear();
 
-                    /* t - rise according to the spec definition of a delta illumination signal */
-                    const bool cfdLevelInRangeB_10perc = inputData.m_positiveSignal?(inputData.m_waveChannel1[a] > cfdValueB_10perc && inputData.m_waveChannel1[aDecr] < cfdValueB_10perc):(inputData.m_waveChannel1[a] < cfdValueB_10perc && inputData.m_waveChannel1[aDecr] > cfdValueB_10perc);
-                    const bool cfdLevelInRangeB_90perc = inputData.m_positiveSignal?(inputData.m_waveChannel1[a] > cfdValueB_90perc && inputData.m_waveChannel1[aDecr] < cfdValueB_90perc):(inputData.m_waveChannel1[a] < cfdValueB_90perc && inputData.m_waveChannel1[aDecr] > cfdValueB_90perc);
+                    m_persistanceDataA.resize(m_pListChannelA.size());
+                    m_persistanceDataB.resize(m_pListChannelB.size());
 
-                    if ( cfdLevelInRangeB  ) {
-                        estimCFDBCellStart = aDecr;
-                        estimCFDBCellStop = a;
+                    const float fractYMaxA = 1.0f/yMaxA;
+                    const float fractYMaxB = 1.0f/yMaxB;
 
-                        cfdBCounter ++;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel1[a], cfdValueB) ) {
-                        estimCFDBCellStart = a;
-                        estimCFDBCellStop = a;
+                    const float fractYMinA = 1.0f/yMinA;
+                    const float fractYMinB = 1.0f/yMinB;
 
-                        cfdBCounter ++;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel1[aDecr], cfdValueB) ) {
-                        estimCFDBCellStart = aDecr;
-                        estimCFDBCellStop = aDecr;
+                    const int size = m_persistanceDataA.size();
+                    for ( int j = 0 ; j < size ; ++ j ) {
+                        const float yA = positiveSignal?(m_pListChannelA.at(j).y()*fractYMaxA):(m_pListChannelA.at(j).y()*fractYMinA);
+                        const float yB = positiveSignal?(m_pListChannelB.at(j).y()*fractYMaxB):(m_pListChannelB.at(j).y()*fractYMinB);
 
-                        cfdBCounter ++;
+                        m_persistanceDataA[j] = QPointF(m_pListChannelA.at(j).x()-((!bOppositePersistanceA)?timeStampA:timeStampB), yA); // >> shift channel A relative to CFD-%(t0) of A (of B)
+                        m_persistanceDataB[j] = QPointF(m_pListChannelB.at(j).x()-((!bOppositePersistanceB)?timeStampB:timeStampA), yB); // >> shift channel B relative to CFD-%(t0) of B (of A)
                     }
+                }
 
-                    /* 10% CF Level */
-                    if ( cfdLevelInRangeB_10perc ) {
-                        estimCFDBCellStart_10perc = aDecr;
-                        estimCFDBCellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel1[a], cfdValueB_10perc) ) {
-                        estimCFDBCellStart_10perc = a;
-                        estimCFDBCellStop_10perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel1[aDecr], cfdValueB_10perc) ) {
-                        estimCFDBCellStart_10perc = aDecr;
-                        estimCFDBCellStop_10perc = aDecr;
-                    }
+                if (bValidLifetime2) {
+                    /* stream as 'false' pulse */
+                    if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()) {
+                        if (DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch() ) {
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel0, sizeOfWave)) {
+                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream time(0): size(" + QVariant(sizeOfWave).toString() + ")"));
+                            }
 
-                    /* 90% CF Level */
-                    if ( cfdLevelInRangeB_90perc ) {
-                        estimCFDBCellStart_90perc = aDecr;
-                        estimCFDBCellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel1[a], cfdValueB_90perc) ) {
-                        estimCFDBCellStart_90perc = a;
-                        estimCFDBCellStop_90perc = a;
-                    }
-                    else if ( qFuzzyCompare(inputData.m_waveChannel1[aDecr], cfdValueB_90perc) ) {
-                        estimCFDBCellStart_90perc = aDecr;
-                        estimCFDBCellStop_90perc = aDecr;
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel0S, sizeOfWave)) {
+                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream volt(0): size(" + QVariant(sizeOfWave).toString() + ")"));
+                            }
+                        }
+                        else {
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel1, sizeOfWave)) {
+                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream time(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                            }
+
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel1S, sizeOfWave)) {
+                                // DRS4BoardManager::sharedInstance()->log(QString(QDateTime::currentDateTime().toString() + "\twriteTruePulseStream volt(1): size(" + QVariant(sizeOfWave).toString() + ")"));
+                            }
+                        }
                     }
                 }
+
+                /* recording pulse shape data if required */
+                if (!bBurstMode && bValidLifetime)
+                    recordPulseShapeData(positiveSignal, timeAForYMax, timeBForYMax, yMinA, yMaxA, yMinB, yMaxB);
             }
 
-            if (bForceReject)
+            if ( binMerged < 0 || binMerged >= channelCntMerged )
                 continue;
 
-            if (inputData.m_bUsingALGLIB) {
-                /* ALGLIB array */
-                arrayDataX_A.ptr->ptr.p_double[it] = inputData.m_tChannel0[a];
-                arrayDataX_B.ptr->ptr.p_double[it] = inputData.m_tChannel1[a];
+            if ( binMerged >= 0
+                 && binMerged < channelCntMerged ) {
+                if ( bNegativeLT && ltdiff < 0  ) {
+                    m_lifeTimeDataMerged[binMerged] ++;
+                    m_mergedCounts ++;
 
-                arrayDataY_A.ptr->ptr.p_double[it] = inputData.m_waveChannel0[a];
-                arrayDataY_B.ptr->ptr.p_double[it] = inputData.m_waveChannel1[a];
-            }
-            else if (inputData.m_bUsingTinoKluge) {
-                arrayDataTKX_A[it] = inputData.m_tChannel0[a];
-                arrayDataTKX_B[it] = inputData.m_tChannel1[a];
+                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
+                }
+                else if ( ltdiff >= 0 ) {
+                    m_lifeTimeDataMerged[binMerged] ++;
+                    m_mergedCounts ++;
 
-                arrayDataTKY_A[it] = inputData.m_waveChannel0[a];
-                arrayDataTKY_B[it] = inputData.m_waveChannel1[a];
-            } else if (inputData.m_bUsingLinearInterpol) {
-                /* nothing yet */
+                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
+                }
+
+                m_specMergedCounterCnt ++;
             }
         }
+        /* lifetime: B-A - master */
+        else if ( bIsStart_B
+                   && bIsStop_A && !bForcePrompt ) {
+            const double ltdiff = (timeStampA - timeStampB);
+            const int binBA = ((int)round(((((ltdiff)+offsetBA)/scalerBA))*((double)channelCntBA)))-1;
 
-        /* min/max was not able to be determined */
-        if (cellYAMax == -1
-                || cellYAMin == -1
-                || cellYBMax == -1
-                || cellYBMin == -1
-                || qFuzzyCompare(yMinA, yMaxA)
-                || qFuzzyCompare(yMinB, yMaxB)
-                || (((int)yMinA == (int)yMaxA) || ((int)yMinB == (int)yMaxB)))
-            continue;
-
-        /* light-weight filtering of wrong events: */
-        if ( inputData.m_positiveSignal ) {
-            if ( (abs(yMinA) > abs(yMaxA))
-                 || (abs(yMinB) > abs(yMaxB)) )
-                continue;
-
-            if ( abs(cellYAMax - inputData.m_startCell) <= 15
-                 || abs(cellYBMax - inputData.m_startCell) <= 15 )
-                continue;
+            const int binMerged = ((int)round(((((ltdiff-ATS)+offsetMerged)/scalerMerged))*((double)channelCntMerged)))-1;
 
-            if ( qFuzzyCompare(inputData.m_waveChannel0[reducedEndRange], yMaxA)
-                 || qFuzzyCompare(inputData.m_waveChannel1[reducedEndRange], yMaxB)
-                 || qFuzzyCompare(inputData.m_waveChannel0[inputData.m_startCell], yMaxA)
-                 || qFuzzyCompare(inputData.m_waveChannel1[inputData.m_startCell], yMaxB) )
-                continue;
-        }
-        else {
-            if ( (abs(yMinA) < abs(yMaxA))
-                 || (abs(yMinB) < abs(yMaxB)) )
+            if (!rejectCounter.pass(DRS4RejectFilter::lifetimeRange, !( binBA < 0 || binBA >= channelCntBA )))
                 continue;
 
-            if ( abs(cellYAMin - inputData.m_startCell) <= 15
-                 || abs(cellYBMin - inputData.m_startCell) <= 15 )
-                continue;
+            if ( binBA >= 0
+                 && binBA < channelCntBA ) {
+                if ( bNegativeLT && ltdiff < 0 ) {
+                    m_lifeTimeDataBA[binBA] ++;
+                    m_baCounts ++;
 
-            if ( qFuzzyCompare(inputData.m_waveChannel0[reducedEndRange], yMinA)
-                 || qFuzzyCompare(inputData.m_waveChannel1[reducedEndRange], yMinB)
-                 || qFuzzyCompare(inputData.m_waveChannel0[inputData.m_startCell], yMinA)
-                 || qFuzzyCompare(inputData.m_waveChannel1[inputData.m_startCell], yMinB) )
-                continue;
-        }
+                    m_maxY_BASpectrum = qMax(m_maxY_BASpectrum, m_lifeTimeDataBA[binBA]);
 
-        /* reject artifacts */
-        if ( cfdBCounter > 1 || cfdBCounter == 0
-             || cfdACounter > 1 || cfdACounter == 0 )
-            continue;
+                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_BA)
+                        bValidLifetime = true;
 
-        /* select interpolation type - obtain interpolant */
-        if (inputData.m_interpolationType == DRS4InterpolationType::type::spline) {
-            if (inputData.m_bUsingALGLIB) {
-                switch (inputData.m_splineInterpolationType) {
-                case DRS4SplineInterpolationType::type::cubic: {
-                    alglib::spline1dbuildcubic(arrayDataX_A, arrayDataY_A, interpolantA);
-                    alglib::spline1dbuildcubic(arrayDataX_B, arrayDataY_B, interpolantB);
-                }
-                    break;
-                case DRS4SplineInterpolationType::type::akima: {
-                    alglib::spline1dbuildakima(arrayDataX_A, arrayDataY_A, interpolantA);
-                    alglib::spline1dbuildakima(arrayDataX_B, arrayDataY_B, interpolantB);
-                }
-                    break;
-                case DRS4SplineInterpolationType::type::catmullRom: {
-                    alglib::spline1dbuildcatmullrom(arrayDataX_A, arrayDataY_A, interpolantA);
-                    alglib::spline1dbuildcatmullrom(arrayDataX_B, arrayDataY_B, interpolantB);
-                }
-                    break;
-                case DRS4SplineInterpolationType::type::monotone: {
-                    alglib::spline1dbuildmonotone(arrayDataX_A, arrayDataY_A, interpolantA);
-                    alglib::spline1dbuildmonotone(arrayDataX_B, arrayDataY_B, interpolantB);
-                }
-                    break;
-                default: {
-                    alglib::spline1dbuildcubic(arrayDataX_A, arrayDataY_A, interpolantA);
-                    alglib::spline1dbuildcubic(arrayDataX_B, arrayDataY_B, interpolantB);
-                }
-                    break;
+                    bValidLifetime2 = true;
                 }
-            }
-            else if (inputData.m_bUsingTinoKluge) {
-                tkSplineA.setType(SplineType::Cubic);
-                tkSplineB.setType(SplineType::Cubic);
-
-                tkSplineA.setPoints(arrayDataTKX_A, arrayDataTKY_A);
-                tkSplineB.setPoints(arrayDataTKX_B, arrayDataTKY_B);
-            }
-            else if (inputData.m_bUsingLinearInterpol) {
-                /* nothing yet */
-            }
-        }
-        else {
-            alglib::polynomialbuild(arrayDataX_A, arrayDataY_A, baryCentricInterpolantA);
-            alglib::polynomialbuild(arrayDataX_B, arrayDataY_B, baryCentricInterpolantB);
-        }
-
-        /* calculate and normalize pulse area for subsequent area filtering */
-        if (inputData.m_bPulseAreaPlot
-                || inputData.m_bPulseAreaFilter) {
-            const float rat = 5120*((float)inputData.m_cellWidth/((float)kNumberOfBins));
-
-            areaA = areaA/(inputData.m_pulseAreaFilterNormA*rat);
-            areaB = areaB/(inputData.m_pulseAreaFilterNormB*rat);
-        }
+                else if ( ltdiff >= 0 ) {
+                    m_lifeTimeDataBA[binBA] ++;
+                    m_baCounts ++;
 
-        double timeAForYMax = -1;
-        double timeBForYMax = -1;
+                    m_maxY_BASpectrum = qMax(m_maxY_BASpectrum, m_lifeTimeDataBA[binBA]);
 
-        if (inputData.m_positiveSignal) {
-            timeAForYMax = inputData.m_tChannel0[cellYAMax];
-            timeBForYMax = inputData.m_tChannel1[cellYBMax];
-        }
-        else {
-            timeAForYMax = inputData.m_tChannel0[cellYAMin];
-            timeBForYMax = inputData.m_tChannel1[cellYBMin];
-        }
+                    if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_BA)
+                        bValidLifetime = true;
 
-        if (qFuzzyCompare(timeAForYMax, -1)
-                || qFuzzyCompare(timeBForYMax, -1))
-            continue;
+                    bValidLifetime2 = true;
+                }
 
-        /* determine max/min more precisely */
-        if (!inputData.m_bUsingLinearInterpol) {
-            const int cell_interpolRangeA_start = inputData.m_positiveSignal?(cellYAMax-1):(cellYAMin-1);
-            const int cell_interpolRangeA_stop = inputData.m_positiveSignal?(cellYAMax+1):(cellYAMin+1);
+                m_specBACounterCnt ++;
 
-            const int cell_interpolRangeB_start = inputData.m_positiveSignal?(cellYBMax-1):(cellYBMin-1);
-            const int cell_interpolRangeB_stop = inputData.m_positiveSignal?(cellYBMax+1):(cellYBMin+1);
+                if ( bStreamInRangeArmed && bValidLifetime2) {
+                    if ( binBA >= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMinBA()
+                         && binBA <= DRS4TextFileStreamRangeManager::sharedInstance()->ltRangeMaxBA() ) {
+                        if ( DRS4TextFileStreamRangeManager::sharedInstance()->isBAEnabled() )
+                            DRS4TextFileStreamRangeManager::sharedInstance()->writePulses(pulseDataA(), pulseDataB(), timeStampA, timeStampB);
+                    }
+                }
 
-            if ( !(cell_interpolRangeA_start >= 0 && cell_interpolRangeA_start < kNumberOfBins)
-                 || !(cell_interpolRangeA_stop >= 0 && cell_interpolRangeA_stop < kNumberOfBins)
-                 || !(cell_interpolRangeB_start >= 0 && cell_interpolRangeB_start < kNumberOfBins)
-                 || !(cell_interpolRangeB_stop >= 0 && cell_interpolRangeB_stop < kNumberOfBins) )
-                continue;
+                /* calculate normalized persistance data */
+                if (bPersistance && bValidLifetime2 && !bBurstMode) {
+                    m_persistanceDataA.clear();
+                    m_persistanceDataB.clear();
 
-            const double renderIncrementA = (inputData.m_tChannel0[cell_interpolRangeA_stop] - inputData.m_tChannel0[cell_interpolRangeA_start])/((float)inputData.m_intraRenderPoints);
-            const double renderIncrementB = (inputData.m_tChannel1[cell_interpolRangeB_stop] - inputData.m_tChannel1[cell_interpolRangeB_start])/((float)inputData.m_intraRenderPoints);
+                    m_persistanceDataA.resize(m_pListChannelA.size());
+                    m_persistanceDataB.resize(m_pListChannelB.size());
 
-            for ( int i = 0 ; i <= inputData.m_intraRenderPoints ; ++ i ) {
-                const double t_A = inputData.m_tChannel0[cell_interpolRangeA_start] + (float)i*renderIncrementA;
-                const double t_B = inputData.m_tChannel1[cell_interpolRangeB_start] + (float)i*renderIncrementB;
+                    const float fractYMaxA = 1.0f/yMaxA;
+                    const float fractYMaxB = 1.0f/yMaxB;
 
-                const float valYA = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, t_A)):(tkSplineA(t_A))):(alglib::barycentriccalc(baryCentricInterpolantA, t_A));
-                const float valYB = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, t_B)):(tkSplineB(t_B))):(alglib::barycentriccalc(baryCentricInterpolantB, t_B));
+                    const float fractYMinA = 1.0f/yMinA;
+                    const float fractYMinB = 1.0f/yMinB;
 
-                /* modify min/max to calculate the CF level in high accuracy, subsequently */
-                if (valYA > yMaxA) {
-                    yMaxA = valYA;
+                    const int size = m_persistanceDataA.size();
+                    for ( int j = 0 ; j < size ; ++ j ) {
+                        const float yA = positiveSignal?(m_pListChannelA.at(j).y()*fractYMaxA):(m_pListChannelA.at(j).y()*fractYMinA);
+                        const float yB = positiveSignal?(m_pListChannelB.at(j).y()*fractYMaxB):(m_pListChannelB.at(j).y()*fractYMinB);
 
-                    if (inputData.m_positiveSignal) {
-                        timeAForYMax = t_A;
+                        m_persistanceDataA[j] = QPointF(m_pListChannelA.at(j).x()-((!bOppositePersistanceA)?timeStampA:timeStampB), yA); // >> shift channel A relative to CFD-%(t0) of A (of B)
+                        m_persistanceDataB[j] = QPointF(m_pListChannelB.at(j).x()-((!bOppositePersistanceB)?timeStampB:timeStampA), yB); // >> shift channel B relative to CFD-%(t0) of B (of A)
                     }
                 }
 
-                if (valYB > yMaxB) {
-                    yMaxB = valYB;
-
-                    if (inputData.m_positiveSignal) {
-                        timeBForYMax = t_B;
-                    }
+                if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
+                    m_phsA_post[cellPHSA] ++;
+                    m_phsACounts_post ++;
                 }
 
-                if (valYA < yMinA) {
-                    yMinA = valYA;
-
-                    if (!inputData.m_positiveSignal) {
-                        timeAForYMax = t_A;
-                    }
+                if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
+                    m_phsB_post[cellPHSB] ++;
+                    m_phsBCounts_post ++;
                 }
 
-                if (valYB < yMinB) {
-                    yMinB = valYB;
+                if (bValidLifetime2) {
+                    if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()) {
+                        if (DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch() ) {
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel0, sizeOfWave)) {
+                                /* nothing yet */
+                            }
+
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel0S, sizeOfWave)) {
+                                /* nothing yet */
+                            }
+                        }
+                        else {
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel1, sizeOfWave)) {
+                                /* nothing yet */
+                            }
 
-                    if (!inputData.m_positiveSignal) {
-                        timeBForYMax = t_B;
+                            if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel1S, sizeOfWave)) {
+                                /* nothing yet */
+                            }
+                        }
                     }
                 }
+
+                /* recording pulse shape data if required */
+                if (!bBurstMode && bValidLifetime)
+                    recordPulseShapeData(positiveSignal, timeAForYMax, timeBForYMax, yMinA, yMaxA, yMinB, yMaxB);
             }
-        }
 
-        /* add modified (interpolated/fitted) pulse height to PHS */
-        float fractPHSA = 0.0f;
-        float fractPHSB = 0.0f;
+            if ( binMerged < 0 || binMerged >= channelCntMerged )
+                continue;
 
-        const double fkNumberOfBins = (double)kNumberOfBins;
+            if ( binMerged >= 0
+                 && binMerged < channelCntMerged ) {
+                if ( bNegativeLT && ltdiff < 0  ) {
+                    m_lifeTimeDataMerged[binMerged] ++;
+                    m_mergedCounts ++;
 
-        if (inputData.m_positiveSignal) {
-            fractPHSA = yMaxA*0.002;
-            fractPHSB = yMaxB*0.002;
-        }
-        else {
-            fractPHSA = abs(yMinA)*0.002;
-            fractPHSB = abs(yMinB)*0.002;
-        }
+                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
+                }
+                else if ( ltdiff >= 0 ) {
+                    m_lifeTimeDataMerged[binMerged] ++;
+                    m_mergedCounts ++;
 
-        /* add pulse heights to PHS */
-        const int cellPHSA = ((int)(fractPHSA*fkNumberOfBins))-1;
-        const int cellPHSB = ((int)(fractPHSB*fkNumberOfBins))-1;
+                    m_maxY_MergedSpectrum = qMax(m_maxY_MergedSpectrum, m_lifeTimeDataMerged[binMerged]);
+                }
 
-        if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-            outputData.m_phsA.append(cellPHSA);
+                m_specMergedCounterCnt ++;
+            }
         }
+        /* prompt spectrum: A-B of stop - slave */
+        else if (  bIsStop_B && bIsStop_A ) {
+            const double ltdiff = (timeStampA - timeStampB);
+            const int binBA = ((int)round(((((ltdiff)+offsetPrompt)/scalerPrompt))*((double)channelCntPrompt)))-1;
 
-        if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-            outputData.m_phsB.append(cellPHSB);
-        }
+            if (!rejectCounter.pass(DRS4RejectFilter::lifetimeRange, !( binBA < 0 || binBA >= channelCntPrompt )))
+                continue;
 
-        /* CF levels valid? */
-        if (estimCFDACellStart == -1
-                || estimCFDACellStop == -1
-                || estimCFDBCellStart == -1
-                || estimCFDBCellStop == -1)
-            continue;
+            if ( binBA >= 0
+                 && binBA < channelCntPrompt ) {
+                m_lifeTimeDataCoincidence[binBA] ++;
+                m_coincidenceCounts ++;
 
-        if (inputData.m_positiveSignal) {
-            if ( cfdValueA > 500.0f
-                 || cfdValueB > 500.0f
-                 || qFuzzyCompare(cfdValueA, 0.0f)
-                 || qFuzzyCompare(cfdValueB, 0.0f)
-                 || cfdValueA < 0.0f
-                 || cfdValueB < 0.0f
-                 || ((int)cfdValueA == (int)yMaxA)
-                 || ((int)cfdValueB == (int)yMaxB))
-                continue;
-        }
-        else {
-            if ( cfdValueA < -500.0f
-                 || cfdValueB < -500.0f
-                 || qFuzzyCompare(cfdValueA, 0.0f)
-                 || qFuzzyCompare(cfdValueB, 0.0f)
-                 || cfdValueA > 0.0f
-                 || cfdValueB > 0.0f
-                 || ((int)cfdValueA == (int)yMinA)
-                 || ((int)cfdValueB == (int)yMinB) )
-                continue;
-        }
+                m_maxY_CoincidenceSpectrum = qMax(m_maxY_CoincidenceSpectrum, m_lifeTimeDataCoincidence[binBA]);
+
+                if (rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_Prompt)
+                    bValidLifetime = true;
 
-        double timeStampA = -1.0f;
-        double timeStampB = -1.0f;
+                bValidLifetime2 = true;
 
-        if (!inputData.m_bUsingLinearInterpol) {
-            /* find correct CF level timestamp within the estimated CFD bracket index region */
-            if ( estimCFDACellStart == estimCFDACellStop ) {
-                timeStampA = inputData.m_tChannel0[estimCFDACellStart];
-            }
-            else {
-                const double timeIncr = (inputData.m_tChannel0[estimCFDACellStop] - inputData.m_tChannel0[estimCFDACellStart])/((double)inputData.m_intraRenderPoints);
-                for ( int i = 0 ; i < inputData.m_intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = inputData.m_tChannel0[estimCFDACellStart] + (double)i*timeIncr;
-                    const double timeStamp2 = inputData.m_tChannel0[estimCFDACellStart] + (double)(i+1)*timeIncr;
+                m_specCoincidenceCounterCnt ++;
 
-                    const float valY1 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, timeStamp1)):(tkSplineA(timeStamp1))):(alglib::barycentriccalc(baryCentricInterpolantA, timeStamp1));
-                    const float valY2 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, timeStamp2)):(tkSplineA(timeStamp2))):(alglib::barycentriccalc(baryCentricInterpolantA, timeStamp2));
+                /* recording pulse shape data if required */
+                if (!bBurstMode && bValidLifetime)
+                    recordPulseShapeData(positiveSignal, timeAForYMax, timeBForYMax, yMinA, yMaxA, yMinB, yMaxB);
+            }
 
-                    if ( (cfdValueA < valY1 && cfdValueA > valY2)
-                         || (cfdValueA > valY1 && cfdValueA < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
+            if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
+                m_phsA_post[cellPHSA] ++;
+                m_phsACounts_post ++;
+            }
 
-                        timeStampA = (cfdValueA - intersect)/slope;
+            if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
+                m_phsB_post[cellPHSB] ++;
+                m_phsBCounts_post ++;
+            }
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA, valY1) ) {
-                        timeStampA = timeStamp1;
+            if (bValidLifetime2) {
+                if ( DRS4FalseTruePulseStreamManager::sharedInstance()->isArmed()) {
+                    if (DRS4FalseTruePulseStreamManager::sharedInstance()->isStreamingForABranch() ) {
+                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel0, sizeOfWave)) {
+                        }
 
-                        break;
+                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel0S, sizeOfWave)) {
+                            /* nothing yet */
+                        }
                     }
-                    else if ( qFuzzyCompare(cfdValueA, valY2) ) {
-                        timeStampA = timeStamp2;
+                    else {
+                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)tChannel1, sizeOfWave)) {
+                            /* nothing yet */
+                        }
 
-                        break;
+                        if (!DRS4FalseTruePulseStreamManager::sharedInstance()->writeTruePulse((const char*)waveChannel1S, sizeOfWave)) {
+                            /* nothing yet */
+                        }
                     }
                 }
             }
+        } //end prompt
+    }
+}
 
-            if ( estimCFDBCellStart == estimCFDBCellStop ) {
-                timeStampB = inputData.m_tChannel1[estimCFDBCellStart];
-            }
-            else {
-                const double timeIncr = (inputData.m_tChannel1[estimCFDBCellStop] - inputData.m_tChannel1[estimCFDBCellStart])/((double)inputData.m_intraRenderPoints);
-                for ( int i = 0 ; i < inputData.m_intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = inputData.m_tChannel1[estimCFDBCellStart] + (double)i*timeIncr;
-                    const double timeStamp2 = inputData.m_tChannel1[estimCFDBCellStart] + (double)(i+1)*timeIncr;
-
-                    const float valY1 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, timeStamp1)):(tkSplineB(timeStamp1))):(alglib::barycentriccalc(baryCentricInterpolantB, timeStamp1));
-                    const float valY2 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, timeStamp2)):(tkSplineB(timeStamp2))):(alglib::barycentriccalc(baryCentricInterpolantB, timeStamp2));
+void DRS4Worker::runMultiThreaded()
+{
+    {
+        QMutexLocker locker(&m_mutex);
 
-                    if ( (cfdValueB < valY1 && cfdValueB > valY2)
-                         || (cfdValueB > valY1 && cfdValueB < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
+        /* setBusy(true): the GUI may not access the worker before each stage touching it is paused */
+        m_stagesToPark = __WORKER_PIPELINE_PARKED_STAGES;
+        m_isRunning = true;
+    }
 
-                        timeStampB = (cfdValueB - intersect)/slope;
+    const bool bDemoMode = DRS4BoardManager::sharedInstance()->isDemoModeEnabled();
+    const int pulsePairChunkSize = DRS4ProgramSettingsManager::sharedInstance()->pulsePairChunkSize();
+    const bool bAdaptiveChunkSize = DRS4ProgramSettingsManager::sharedInstance()->isPulsePairChunkSizeAdaptive();
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB, valY1) ) {
-                        timeStampB = timeStamp1;
+    /* adaptive: the chosen chunk size is the start value */
+    m_workerConcurrentManager->start(pulsePairChunkSize, bAdaptiveChunkSize);
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB, valY2) ) {
-                        timeStampB = timeStamp2;
+    /* the board is armed by the readout stage */
+    time_t start;
+    time_t stop;
 
-                        break;
-                    }
-                }
-            }
-        }
-        /* linear interpolation */
-        else {
-            if ( estimCFDACellStart == estimCFDACellStop ) {
-                timeStampA = inputData.m_tChannel0[estimCFDACellStart];
-            }
-            else {
-                const float timeStamp1 = inputData.m_tChannel0[estimCFDACellStart];
-                const float timeStamp2 = inputData.m_tChannel0[estimCFDACellStop];
+    time(&start);
+    time(&stop);
 
-                const float valY1 = inputData.m_waveChannel0[estimCFDACellStart];
-                const float valY2 = inputData.m_waveChannel0[estimCFDACellStop];
+    /* readout, decode and persist run on their own threads: this loop is the histogram stage */
+    m_pipeline->start(bDemoMode);
 
-                if ( (cfdValueA < valY1 && cfdValueA > valY2)
-                     || (cfdValueA > valY1 && cfdValueA < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
+    DRS4PipelineStageStatistics& statistics = m_pipeline->m_statistics[DRS4PipelineStageType::histogram];
 
-                    timeStampA = (cfdValueA - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueA, valY1) ) {
-                    timeStampA = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueA, valY2) ) {
-                    timeStampA = timeStamp2;
-                }
-            }
+    forever {
+        if ( !m_isRunning ) {
+            /* the decode stage is the producer of the event ring: stop it before the analysis threads */
+            m_pipeline->stop();
 
-            if ( estimCFDBCellStart == estimCFDBCellStop ) {
-                timeStampB = inputData.m_tChannel1[estimCFDBCellStart];
-            }
-            else {
-                const float timeStamp1 = inputData.m_tChannel1[estimCFDBCellStart];
-                const float timeStamp2 = inputData.m_tChannel1[estimCFDBCellStop];
+            m_workerConcurrentManager->cancel();
+            m_workerConcurrentManager->merge();
 
-                const float valY1 = inputData.m_waveChannel1[estimCFDBCellStart];
-                const float valY2 = inputData.m_waveChannel1[estimCFDBCellStop];
+            m_pipeline->takePulseData(&m_pListChannelA, &m_pListChannelB);
 
-                if ( (cfdValueB < valY1 && cfdValueB > valY2)
-                     || (cfdValueB > valY1 && cfdValueB < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
+            publishSnapshot();
 
-                    timeStampB = (cfdValueB - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueB, valY1) ) {
-                    timeStampB = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueB, valY2) ) {
-                    timeStampB = timeStamp2;
-                }
-            }
+            return;
         }
 
-        double timeStampA_10perc = -1.0f;
-        double timeStampB_10perc = -1.0f;
+        /* merge() writes the spectra, PHS and shape-filter data of the worker */
+        waitForNextSignal();
 
-        if (!inputData.m_bUsingLinearInterpol) {
-            /* finding correct CF (10%) timestamp within the estimated CF (10%) bracketed index region */
-            if ( estimCFDACellStart_10perc == estimCFDACellStop_10perc ) {
-                timeStampA_10perc = inputData.m_tChannel0[estimCFDACellStart_10perc];
-            }
-            else {
-                const double timeIncr = (inputData.m_tChannel0[estimCFDACellStop_10perc] - inputData.m_tChannel0[estimCFDACellStart_10perc])/((double)inputData.m_intraRenderPoints);
-                for ( int i = 0 ; i < inputData.m_intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = inputData.m_tChannel0[estimCFDACellStart_10perc] + (double)i*timeIncr;
-                    const double timeStamp2 = inputData.m_tChannel0[estimCFDACellStart_10perc] + (double)(i+1)*timeIncr;
+        if ( !m_isRunning )
+            continue;
 
-                    const float valY1 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, timeStamp1)):(tkSplineA(timeStamp1))):(alglib::barycentriccalc(baryCentricInterpolantA, timeStamp1));
-                    const float valY2 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, timeStamp2)):(tkSplineA(timeStamp2))):(alglib::barycentriccalc(baryCentricInterpolantA, timeStamp2));
+        /* collect the results of the analysis threads */
+        statistics.updateHighWaterMark(m_workerConcurrentManager->pendingHistograms());
 
-                    if ( (cfdValueA_10perc < valY1 && cfdValueA_10perc > valY2)
-                         || (cfdValueA_10perc > valY1 && cfdValueA_10perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
+        DRS4HotPathStageTimer hotPathTimer(DRS4HotPathStage::merge);
 
-                        timeStampA_10perc = (cfdValueA_10perc - intersect)/slope;
+        const int merged = m_workerConcurrentManager->merge();
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_10perc, valY1) ) {
-                        timeStampA_10perc = timeStamp1;
+        hotPathTimer.stop();
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_10perc, valY2) ) {
-                        timeStampA_10perc = timeStamp2;
+        if ( merged )
+            statistics.addProcessed(merged);
+        else
+            statistics.addIdleCycle();
 
-                        break;
-                    }
-                }
-            }
+        m_workerConcurrentManager->adaptChunkSize();
 
-            if ( estimCFDBCellStart_10perc == estimCFDBCellStop_10perc ) {
-                timeStampB_10perc = inputData.m_tChannel1[estimCFDBCellStart_10perc];
-            }
-            else {
-                const double timeIncr = (inputData.m_tChannel1[estimCFDBCellStop_10perc] - inputData.m_tChannel1[estimCFDBCellStart_10perc])/((double)inputData.m_intraRenderPoints);
-                for ( int i = 0 ; i < inputData.m_intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = inputData.m_tChannel1[estimCFDBCellStart_10perc] + (double)i*timeIncr;
-                    const double timeStamp2 = inputData.m_tChannel1[estimCFDBCellStart_10perc] + (double)(i+1)*timeIncr;
+        m_pulseCounterCnt += m_pipeline->takeDecodedEvents();
+        m_boardTemperature = m_pipeline->boardTemperature();
+
+        m_pipeline->takePulseData(&m_pListChannelA, &m_pListChannelB);
+
+        /* statistics: */
+        time(&stop);
+        const double diffTime = difftime(stop, start);
+        if ( diffTime >= __STATISTIC_AVG_TIME ) {
+            m_currentPulseCountRateInSeconds = ((double)m_pulseCounterCnt)/diffTime;
+            m_summedPulseCountRateInSeconds += m_currentPulseCountRateInSeconds;
+            m_avgPulseCountRateInSeconds = (m_pulseCounterCntAvg==0)?m_currentPulseCountRateInSeconds:(m_summedPulseCountRateInSeconds/(double)m_pulseCounterCntAvg);
 
-                    const float valY1 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, timeStamp1)):(tkSplineB(timeStamp1))):(alglib::barycentriccalc(baryCentricInterpolantB, timeStamp1));
-                    const float valY2 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, timeStamp2)):(tkSplineB(timeStamp2))):(alglib::barycentriccalc(baryCentricInterpolantB, timeStamp2));
+            m_currentABSpecCountRateInSeconds = ((m_specABCounterCnt==0)?0:((double)m_specABCounterCnt)/diffTime);
+            m_summedABSpecCountRateInSeconds += m_currentABSpecCountRateInSeconds;
+            m_avgABSpecCountRateInSeconds = (m_specABCounterCntAvg==0)?m_currentABSpecCountRateInSeconds:(m_summedABSpecCountRateInSeconds/(double)m_specABCounterCntAvg);
 
-                    if ( (cfdValueB_10perc < valY1 && cfdValueB_10perc > valY2)
-                         || (cfdValueB_10perc > valY1 && cfdValueB_10perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
+            m_currentBASpecCountRateInSeconds = ((m_specBACounterCnt==0)?0:((double)m_specBACounterCnt)/diffTime);
+            m_summedBASpecCountRateInSeconds += m_currentBASpecCountRateInSeconds;
+            m_avgBASpecCountRateInSeconds = (m_specBACounterCntAvg==0)?m_currentBASpecCountRateInSeconds:(m_summedBASpecCountRateInSeconds/(double)m_specBACounterCntAvg);
 
-                        timeStampB_10perc = (cfdValueB_10perc - intersect)/slope;
+            m_currentMergedSpecCountRateInSeconds = ((m_specMergedCounterCnt==0)?0:((double)m_specMergedCounterCnt)/diffTime);
+            m_summedMergedSpecCountRateInSeconds += m_currentMergedSpecCountRateInSeconds;
+            m_avgMergedSpecCountRateInSeconds = (m_specMergedCounterCntAvg==0)?m_currentMergedSpecCountRateInSeconds:(m_summedMergedSpecCountRateInSeconds/(double)m_specMergedCounterCntAvg);
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB_10perc, valY1) ) {
-                        timeStampB_10perc = timeStamp1;
+            m_currentCoincidenceSpecCountRateInSeconds = ((m_specCoincidenceCounterCnt==0)?0:((double)m_specCoincidenceCounterCnt)/diffTime);
+            m_summedCoincidenceSpecCountRateInSeconds += m_currentCoincidenceSpecCountRateInSeconds;
+            m_avgCoincidenceSpecCountRateInSeconds = (m_specCoincidencCounterCntAvg==0)?m_currentCoincidenceSpecCountRateInSeconds:(m_summedCoincidenceSpecCountRateInSeconds/(double)m_specCoincidencCounterCntAvg);
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB_10perc, valY2) ) {
-                        timeStampB_10perc = timeStamp2;
+            time(&start);
 
-                        break;
-                    }
-                }
-            }
+            m_pulseCounterCnt = 0;
+            m_pulseCounterCntAvg ++;
+
+            m_specABCounterCnt = 0;
+            m_specBACounterCnt = 0;
+            m_specMergedCounterCnt = 0;
+            m_specCoincidenceCounterCnt = 0;
+
+            m_specABCounterCntAvg ++;
+            m_specBACounterCntAvg ++;
+            m_specMergedCounterCntAvg ++;
+            m_specCoincidencCounterCntAvg ++;
         }
-        /* linear interpolation */
-        else {
-            if ( estimCFDACellStart_10perc == estimCFDACellStop_10perc ) {
-                timeStampA_10perc = inputData.m_tChannel0[estimCFDACellStart_10perc];
-            }
-            else {
-                const float timeStamp1 = inputData.m_tChannel0[estimCFDACellStart_10perc];
-                const float timeStamp2 = inputData.m_tChannel0[estimCFDACellStop_10perc];
 
-                const float valY1 = inputData.m_waveChannel0[estimCFDACellStart_10perc];
-                const float valY2 = inputData.m_waveChannel0[estimCFDACellStop_10perc];
+        publishSnapshotOnInterval();
 
-                if ( (cfdValueA_10perc < valY1 && cfdValueA_10perc > valY2)
-                     || (cfdValueA_10perc > valY1 && cfdValueA_10perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
+        QThread::msleep(__WORKER_PIPELINE_HISTOGRAM_INTERVAL);
+    } // end forever
+}
 
-                    timeStampA_10perc = (cfdValueA_10perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueA_10perc, valY1) ) {
-                    timeStampA_10perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueA_10perc, valY2) ) {
-                    timeStampA_10perc = timeStamp2;
-                }
-            }
+DRS4ConcurrentCopyOutputData runCalculation(const QVector<const DRS4ConcurrentCopyInputData*> &copyDataVec, DRS4ConcurrentHistograms *histograms)
+{
+    if ( copyDataVec.size() == 0 )
+        return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
 
-            if ( estimCFDBCellStart_10perc == estimCFDBCellStop_10perc ) {
-                timeStampB_10perc = inputData.m_tChannel1[estimCFDBCellStart_10perc];
-            }
-            else {
-                const float timeStamp1 = inputData.m_tChannel1[estimCFDBCellStart_10perc];
-                const float timeStamp2 = inputData.m_tChannel1[estimCFDBCellStop_10perc];
+    const int channelCntCoincindence = copyDataVec.first()->m_sharedData->m_channelCntPrompt;
+    const int channelCntAB = copyDataVec.first()->m_sharedData->m_channelCntAB;
+    const int channelCntBA = copyDataVec.first()->m_sharedData->m_channelCntBA;
+    const int channelCntMerged = copyDataVec.first()->m_sharedData->m_channelCntMerged;
 
-                const float valY1 = inputData.m_waveChannel1[estimCFDBCellStart_10perc];
-                const float valY2 = inputData.m_waveChannel1[estimCFDBCellStop_10perc];
+    /* the event slots are accessed in place (no copy) */
+    for ( const DRS4ConcurrentCopyInputData *copyDataPtr : copyDataVec ) {
+        const DRS4ConcurrentCopyInputData& copyData = *copyDataPtr;
 
-                if ( (cfdValueB_10perc < valY1 && cfdValueB_10perc > valY2)
-                     || (cfdValueB_10perc > valY1 && cfdValueB_10perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
+        if ( channelCntCoincindence != copyData.m_sharedData->m_channelCntPrompt )
+            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
 
-                    timeStampB_10perc = (cfdValueB_10perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueB_10perc, valY1) ) {
-                    timeStampB_10perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueB_10perc, valY2) ) {
-                    timeStampB_10perc = timeStamp2;
-                }
-            }
-        }
+        if ( channelCntAB != copyData.m_sharedData->m_channelCntAB )
+            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
 
-        double timeStampA_90perc = -1.0f;
-        double timeStampB_90perc = -1.0f;
+        if ( channelCntBA != copyData.m_sharedData->m_channelCntBA )
+            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
 
-        if (!inputData.m_bUsingLinearInterpol) {
-            /* find correct CF level (90%) timestamp within the estimated CF (90%) bracketed index region */
-            if ( estimCFDACellStart_90perc == estimCFDACellStop_90perc ) {
-                timeStampA_90perc = inputData.m_tChannel0[estimCFDACellStart_90perc];
-            }
-            else {
-                const double timeIncr = (inputData.m_tChannel0[estimCFDACellStop_90perc] - inputData.m_tChannel0[estimCFDACellStart_90perc])/((double)inputData.m_intraRenderPoints);
-                for ( int i = 0 ; i < inputData.m_intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = inputData.m_tChannel0[estimCFDACellStart_90perc] + (double)i*timeIncr;
-                    const double timeStamp2 = inputData.m_tChannel0[estimCFDACellStart_90perc] + (double)(i+1)*timeIncr;
+        if ( channelCntMerged != copyData.m_sharedData->m_channelCntMerged )
+            return DRS4ConcurrentCopyOutputData(0, 0, 0, 0);
+    }
+
+    DRS4PulsePairKernel kernel;
+    const DRS4ConcurrentSharedInputData *kernelSharedData = DNULLPTR;
+
+    DRS4RejectFilterCounter rejectCounter;
 
-                    const float valY1 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, timeStamp1)):(tkSplineA(timeStamp1))):(alglib::barycentriccalc(baryCentricInterpolantA, timeStamp1));
-                    const float valY2 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantA, timeStamp2)):(tkSplineA(timeStamp2))):(alglib::barycentriccalc(baryCentricInterpolantA, timeStamp2));
+    DRS4ConcurrentCopyOutputData outputData(channelCntCoincindence, channelCntAB, channelCntBA, channelCntMerged, false);
 
-                    if ( (cfdValueA_90perc < valY1 && cfdValueA_90perc > valY2)
-                         || (cfdValueA_90perc > valY1 && cfdValueA_90perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
+    for ( const DRS4ConcurrentCopyInputData *inputDataPtr : copyDataVec ) {
+        const DRS4ConcurrentCopyInputData& inputData = *inputDataPtr;
+        const DRS4ConcurrentSharedInputData& sharedData = *inputData.m_sharedData;
 
-                        timeStampA_90perc = (cfdValueA_90perc - intersect)/slope;
+        histograms->prepare(sharedData);
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_90perc, valY1) ) {
-                        timeStampA_90perc = timeStamp1;
+        /* the pulse-pair kernel is instantiated for the interpolation type and the signal polarity: select it once per shared data */
+        if ( kernelSharedData != &sharedData ) {
+            kernel.select(sharedData.m_interpolationType, sharedData.m_splineInterpolationType, sharedData.m_positiveSignal);
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueA_90perc, valY2) ) {
-                        timeStampA_90perc = timeStamp2;
+            kernel.m_startCell = sharedData.m_startCell;
+            kernel.m_endRange = sharedData.m_endRange;
+            kernel.m_cellWidth = sharedData.m_cellWidth;
+            kernel.m_sweep = sharedData.m_sweep;
 
-                        break;
-                    }
-                }
-            }
+            kernel.m_bPulseArea = (sharedData.m_bPulseAreaPlot || sharedData.m_bPulseAreaFilter);
+            kernel.m_pulseAreaFilterNormA = sharedData.m_pulseAreaFilterNormA;
+            kernel.m_pulseAreaFilterNormB = sharedData.m_pulseAreaFilterNormB;
 
-            if ( estimCFDBCellStart_90perc == estimCFDBCellStop_90perc ) {
-                timeStampB_90perc = inputData.m_tChannel1[estimCFDBCellStart_90perc];
-            }
-            else {
-                const double timeIncr = (inputData.m_tChannel1[estimCFDBCellStop_90perc] - inputData.m_tChannel1[estimCFDBCellStart_90perc])/((double)inputData.m_intraRenderPoints);
-                for ( int i = 0 ; i < inputData.m_intraRenderPoints ; ++ i ) {
-                    const double timeStamp1 = inputData.m_tChannel1[estimCFDBCellStart_90perc] + (double)i*timeIncr;
-                    const double timeStamp2 = inputData.m_tChannel1[estimCFDBCellStart_90perc] + (double)(i+1)*timeIncr;
+            kernel.m_intraRenderPoints = sharedData.m_intraRenderPoints;
 
-                    const float valY1 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, timeStamp1)):(tkSplineB(timeStamp1))):(alglib::barycentriccalc(baryCentricInterpolantB, timeStamp1));
-                    const float valY2 = (inputData.m_interpolationType == DRS4InterpolationType::type::spline)?(inputData.m_bUsingALGLIB?(alglib::spline1dcalc(interpolantB, timeStamp2)):(tkSplineB(timeStamp2))):(alglib::barycentriccalc(baryCentricInterpolantB, timeStamp2));
+            kernel.m_channelA.m_cfdLevel = sharedData.m_cfdA;
+            kernel.m_channelB.m_cfdLevel = sharedData.m_cfdB;
 
-                    if ( (cfdValueB_90perc < valY1 && cfdValueB_90perc > valY2)
-                         || (cfdValueB_90perc > valY1 && cfdValueB_90perc < valY2) ) {
-                        const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                        const double intersect = valY1 - slope*timeStamp1;
+            kernelSharedData = &sharedData;
+        }
 
-                        timeStampB_90perc = (cfdValueB_90perc - intersect)/slope;
+        kernel.setWaveforms(inputData.m_tChannel0, inputData.m_waveChannel0, inputData.m_tChannel1, inputData.m_waveChannel1);
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB_90perc, valY1) ) {
-                        timeStampB_90perc = timeStamp1;
+        rejectCounter.nextEvent();
 
-                        break;
-                    }
-                    else if ( qFuzzyCompare(cfdValueB_90perc, valY2) ) {
-                        timeStampB_90perc = timeStamp2;
+        /* determine min/max and proceed a CF estimation in ROI */
+        if (!rejectCounter.pass(DRS4RejectFilter::extrema, kernel.scan()))
+            continue;
 
-                        break;
-                    }
-                }
-            }
-        }
-        /* linear interpolation */
-        else {
-            if ( estimCFDACellStart_90perc == estimCFDACellStop_90perc ) {
-                timeStampA_90perc = inputData.m_tChannel0[estimCFDACellStart_90perc];
-            }
-            else {
-                const float timeStamp1 = inputData.m_tChannel0[estimCFDACellStart_90perc];
-                const float timeStamp2 = inputData.m_tChannel0[estimCFDACellStop_90perc];
+        /* light-weight filtering (raw samples), obtain interpolant and normalize the pulse area */
+        if (!rejectCounter.pass(DRS4RejectFilter::artifact, kernel.interpolate()))
+            continue;
 
-                const float valY1 = inputData.m_waveChannel0[estimCFDACellStart_90perc];
-                const float valY2 = inputData.m_waveChannel0[estimCFDACellStop_90perc];
+        /* determine max/min more precisely */
+        if (!rejectCounter.pass(DRS4RejectFilter::refine, kernel.refine()))
+            continue;
 
-                if ( (cfdValueA_90perc < valY1 && cfdValueA_90perc > valY2)
-                     || (cfdValueA_90perc > valY1 && cfdValueA_90perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
+        const float areaA = kernel.m_channelA.m_area;
+        const float areaB = kernel.m_channelB.m_area;
 
-                    timeStampA_90perc = (cfdValueA_90perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueA_90perc, valY1) ) {
-                    timeStampA_90perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueA_90perc, valY2) ) {
-                    timeStampA_90perc = timeStamp2;
-                }
-            }
+        const float yMinA = kernel.m_channelA.m_yMin;
+        const float yMaxA = kernel.m_channelA.m_yMax;
+        const float yMinB = kernel.m_channelB.m_yMin;
+        const float yMaxB = kernel.m_channelB.m_yMax;
 
-            if ( estimCFDBCellStart_90perc == estimCFDBCellStop_90perc ) {
-                timeStampB_90perc = inputData.m_tChannel1[estimCFDBCellStart_90perc];
-            }
-            else {
-                const float timeStamp1 = inputData.m_tChannel1[estimCFDBCellStart_90perc];
-                const float timeStamp2 = inputData.m_tChannel1[estimCFDBCellStop_90perc];
+        const double timeAForYMax = kernel.m_channelA.m_timeForYMax;
+        const double timeBForYMax = kernel.m_channelB.m_timeForYMax;
 
-                const float valY1 = inputData.m_waveChannel1[estimCFDBCellStart_90perc];
-                const float valY2 = inputData.m_waveChannel1[estimCFDBCellStop_90perc];
+        /* add modified (interpolated/fitted) pulse heights to PHS */
+        const int cellPHSA = kernel.m_channelA.m_cellPHS;
+        const int cellPHSB = kernel.m_channelB.m_cellPHS;
 
-                if ( (cfdValueB_90perc < valY1 && cfdValueB_90perc > valY2)
-                     || (cfdValueB_90perc > valY1 && cfdValueB_90perc < valY2) ) {
-                    const double slope = (valY2 - valY1)/(timeStamp2 - timeStamp1);
-                    const double intersect = valY1 - slope*timeStamp1;
+        if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
+            histograms->m_phsA[cellPHSA] ++;
+            histograms->m_phsACounts ++;
+        }
 
-                    timeStampB_90perc = (cfdValueB_90perc - intersect)/slope;
-                }
-                else if ( qFuzzyCompare(cfdValueB_90perc, valY1) ) {
-                    timeStampB_90perc = timeStamp1;
-                }
-                else if ( qFuzzyCompare(cfdValueB_90perc, valY2) ) {
-                    timeStampB_90perc = timeStamp2;
-                }
-            }
+        if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
+            histograms->m_phsB[cellPHSB] ++;
+            histograms->m_phsBCounts ++;
         }
 
-        if ((int)timeStampA == -1
-                || (int)timeStampB == -1)
+        /* CF levels valid? find the CFD timestamps */
+        const bool bTimeStamps = kernel.timeStamps();
+
+        const double timeStampA = kernel.m_channelA.m_timeStamp;
+        const double timeStampB = kernel.m_channelB.m_timeStamp;
+
+        if (!rejectCounter.pass(DRS4RejectFilter::cfLevel, bTimeStamps && !((int)timeStampA == -1 || (int)timeStampB == -1)))
             continue;
 
-        const double areaA_raw = areaA*(double)inputData.m_pulseAreaFilterBinningA;
-        const double areaB_raw = areaB*(double)inputData.m_pulseAreaFilterBinningB;
+        const double areaA_raw = areaA*(double)sharedData.m_pulseAreaFilterBinningA;
+        const double areaB_raw = areaB*(double)sharedData.m_pulseAreaFilterBinningB;
 
         /* area-Filter */
-        if (!inputData.m_bBurstMode
-                && inputData.m_bPulseAreaPlot) {
-            const int binA = areaA*(double)inputData.m_pulseAreaFilterBinningA;
-            const int binB = areaB*(double)inputData.m_pulseAreaFilterBinningB;
+        if (!sharedData.m_bBurstMode
+                && sharedData.m_bPulseAreaPlot) {
+            const int binA = areaA*(double)sharedData.m_pulseAreaFilterBinningA;
+            const int binB = areaB*(double)sharedData.m_pulseAreaFilterBinningB;
 
             const int reducedNumberOfBins = (kNumberOfBins-1);
 
@@ -4982,60 +2941,71 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
         bool bIsStart_B = false;
         bool bIsStop_B = false;
 
-        if ( cellPHSA >= inputData.m_startAMinPHS
-             && cellPHSA <= inputData.m_startAMaxPHS )
+        if ( cellPHSA >= sharedData.m_startAMinPHS
+             && cellPHSA <= sharedData.m_startAMaxPHS )
             bIsStart_A = true;
 
-        if ( cellPHSA >= inputData.m_stopAMinPHS
-             && cellPHSA <= inputData.m_stopAMaxPHS )
+        if ( cellPHSA >= sharedData.m_stopAMinPHS
+             && cellPHSA <= sharedData.m_stopAMaxPHS )
             bIsStop_A = true;
 
-        if ( cellPHSB >= inputData.m_startBMinPHS
-             && cellPHSB <= inputData.m_startBMaxPHS )
+        if ( cellPHSB >= sharedData.m_startBMinPHS
+             && cellPHSB <= sharedData.m_startBMaxPHS )
             bIsStart_B = true;
 
-        if ( cellPHSB >= inputData.m_stopBMinPHS
-             && cellPHSB <= inputData.m_stopBMaxPHS )
+        if ( cellPHSB >= sharedData.m_stopBMinPHS
+             && cellPHSB <= sharedData.m_stopBMaxPHS )
             bIsStop_B = true;
 
+        /* rise-time (10% - 90%): only required for the spectra of the start and stop branches */
+        kernel.riseTimes(bIsStart_A || bIsStop_A, bIsStart_B || bIsStop_B);
+
+        const double timeStampA_10perc = kernel.m_channelA.m_timeStamp_10perc;
+        const double timeStampB_10perc = kernel.m_channelB.m_timeStamp_10perc;
+
+        const double timeStampA_90perc = kernel.m_channelA.m_timeStamp_90perc;
+        const double timeStampB_90perc = kernel.m_channelB.m_timeStamp_90perc;
+
         /* rise-time Filter */
         if ((int)timeStampA_10perc != -1
                 || (int)timeStampA_90perc != -1) {
-            const int binA = (int)((double)inputData.m_riseTimeFilterBinningA*(timeStampA_90perc-timeStampA_10perc)/inputData.m_riseTimeFilterARangeInNanoseconds);
+            const int binA = (int)((double)sharedData.m_riseTimeFilterBinningA*(timeStampA_90perc-timeStampA_10perc)/sharedData.m_riseTimeFilterARangeInNanoseconds);
 
-            if ( !(binA < 0 || binA >= inputData.m_riseTimeFilterBinningA) ) {
+            if ( !(binA < 0 || binA >= sharedData.m_riseTimeFilterBinningA) ) {
                 if (bIsStart_A || bIsStop_A) {
-                    outputData.m_riseTimeFilterDataA.append(binA);
+                    histograms->m_riseTimeFilterDataA[binA] ++;
+                    histograms->m_riseTimeFilterACounter ++;
                 }
             }
         }
 
         if ((int)timeStampB_10perc != -1
                 || (int)timeStampB_90perc != -1) {
-            const int binB = (int)((double)inputData.m_riseTimeFilterBinningB*(timeStampB_90perc-timeStampB_10perc)/inputData.m_riseTimeFilterBRangeInNanoseconds);
+            const int binB = (int)((double)sharedData.m_riseTimeFilterBinningB*(timeStampB_90perc-timeStampB_10perc)/sharedData.m_riseTimeFilterBRangeInNanoseconds);
 
-            if ( !(binB < 0 || binB >= inputData.m_riseTimeFilterBinningB) ) {
+            if ( !(binB < 0 || binB >= sharedData.m_riseTimeFilterBinningB) ) {
                 if (bIsStart_B || bIsStop_B) {
-                    outputData.m_riseTimeFilterDataB.append(binB);
+                    histograms->m_riseTimeFilterDataB[binB] ++;
+                    histograms->m_riseTimeFilterBCounter ++;
                 }
             }
         }
 
         /* apply area-filter and reject pulses if one of both appears outside the windows */
-        if (inputData.m_bPulseAreaFilter) {
+        if (sharedData.m_bPulseAreaFilter) {
             const double indexPHSA = cellPHSA;
             const double indexPHSB = cellPHSB;
 
-            const double yLowerA = (inputData.m_areaFilterASlopeLower*indexPHSA+inputData.m_areaFilterAInterceptLower);
-            const double yUpperA = (inputData.m_areaFilterASlopeUpper*indexPHSA+inputData.m_areaFilterAInterceptUpper);
+            const double yLowerA = (sharedData.m_areaFilterASlopeLower*indexPHSA+sharedData.m_areaFilterAInterceptLower);
+            const double yUpperA = (sharedData.m_areaFilterASlopeUpper*indexPHSA+sharedData.m_areaFilterAInterceptUpper);
 
-            const double multA = areaA*inputData.m_pulseAreaFilterBinningA;
-            const double multB = areaB*inputData.m_pulseAreaFilterBinningB;
+            const double multA = areaA*sharedData.m_pulseAreaFilterBinningA;
+            const double multB = areaB*sharedData.m_pulseAreaFilterBinningB;
 
             const bool y_AInside = (multA >= yLowerA && multA <=yUpperA);
 
-            const double yLowerB = (inputData.m_areaFilterBSlopeLower*indexPHSB+inputData.m_areaFilterBInterceptLower);
-            const double yUpperB = (inputData.m_areaFilterBSlopeUpper*indexPHSB+inputData.m_areaFilterBInterceptUpper);
+            const double yLowerB = (sharedData.m_areaFilterBSlopeLower*indexPHSB+sharedData.m_areaFilterBInterceptLower);
+            const double yUpperB = (sharedData.m_areaFilterBSlopeUpper*indexPHSB+sharedData.m_areaFilterBInterceptUpper);
 
             const bool y_BInside = (multB >= yLowerB && multB <= yUpperB);
 
@@ -5051,31 +3021,40 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                 outputData.m_areaFilterCollectionDataB_raw.append(areaB_raw);
             }
 
-            if ( !y_AInside || !y_BInside )
+            if (!rejectCounter.pass(DRS4RejectFilter::areaWindow, y_AInside && y_BInside))
                 continue;
         }
 
+        /* none of the spectra accepts the pulse heights: the remaining (more expensive) filters are skipped */
+        const bool bLifetimeBranch = (((bIsStart_A && bIsStop_B) || (bIsStart_B && bIsStop_A)) && !sharedData.m_bForcePrompt)
+                                     || (bIsStop_A && bIsStop_B);
+
+        if (!rejectCounter.pass(DRS4RejectFilter::phsWindow, bLifetimeBranch))
+            continue;
+
         /* apply rise time-filter and reject pulses if one of both appears outside the windows */
-        if (inputData.m_bPulseRiseTimeFilter) {
-            const int binA = (int)((double)inputData.m_riseTimeFilterBinningA*(timeStampA_90perc-timeStampA_10perc)/inputData.m_riseTimeFilterARangeInNanoseconds);
-            const int binB = (int)((double)inputData.m_riseTimeFilterBinningB*(timeStampB_90perc-timeStampB_10perc)/inputData.m_riseTimeFilterBRangeInNanoseconds);
+        if (sharedData.m_bPulseRiseTimeFilter) {
+            kernel.riseTimes(true, true);
+
+            const int binA = (int)((double)sharedData.m_riseTimeFilterBinningA*(kernel.m_channelA.m_timeStamp_90perc-kernel.m_channelA.m_timeStamp_10perc)/sharedData.m_riseTimeFilterARangeInNanoseconds);
+            const int binB = (int)((double)sharedData.m_riseTimeFilterBinningB*(kernel.m_channelB.m_timeStamp_90perc-kernel.m_channelB.m_timeStamp_10perc)/sharedData.m_riseTimeFilterBRangeInNanoseconds);
 
             bool bAcceptedA = false;
             bool bAcceptedB = false;
 
-            if (binA >= inputData.m_riseTimeFilterLeftWindowA && binA <= inputData.m_riseTimeFilterRightWindowA)
+            if (binA >= sharedData.m_riseTimeFilterLeftWindowA && binA <= sharedData.m_riseTimeFilterRightWindowA)
                 bAcceptedA = true;
 
-            if (binB >= inputData.m_riseTimeFilterLeftWindowB && binB <= inputData.m_riseTimeFilterRightWindowB)
+            if (binB >= sharedData.m_riseTimeFilterLeftWindowB && binB <= sharedData.m_riseTimeFilterRightWindowB)
                 bAcceptedB = true;
 
-            if (!bAcceptedA || !bAcceptedB)
+            if (!rejectCounter.pass(DRS4RejectFilter::riseTimeWindow, bAcceptedA && bAcceptedB))
                 continue;
         }
 
         /* apply pulse-shape filter */
-        if (inputData.m_pulseShapeFilterEnabledA
-             || inputData.m_pulseShapeFilterEnabledB) {
+        if (sharedData.m_pulseShapeFilterEnabledA
+             || sharedData.m_pulseShapeFilterEnabledB) {
             bool bRejectA = false;
             bool bRejectB = false;
 
@@ -5087,76 +3066,13 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
 
             const int size = kNumberOfBins;
 
-            DSpline splineMeanA, splineMeanB;
-            DSpline splineStdDevA, splineStdDevB;
-
-            if (inputData.m_pulseShapeFilterEnabledA) {
-                splineMeanA.setType(SplineType::Cubic);
-                splineMeanA.setPointsArray(inputData.m_pulseShapeFilterDataMeanTraceA_X, inputData.m_pulseShapeFilterDataMeanTraceA_Y, __PULSESHAPEFILTER_SPLINE_TRACE_NUMBER);
-
-                splineStdDevA.setType(SplineType::Cubic);
-                splineStdDevA.setPointsArray(inputData.m_pulseShapeFilterDataStdDevTraceA_X, inputData.m_pulseShapeFilterDataStdDevTraceA_Y, __PULSESHAPEFILTER_SPLINE_TRACE_NUMBER);
-            }
-
-            if (inputData.m_pulseShapeFilterEnabledB) {
-                splineMeanB.setType(SplineType::Cubic);
-                splineMeanB.setPointsArray(inputData.m_pulseShapeFilterDataMeanTraceB_X, inputData.m_pulseShapeFilterDataMeanTraceB_Y, __PULSESHAPEFILTER_SPLINE_TRACE_NUMBER);
-
-                splineStdDevB.setType(SplineType::Cubic);
-                splineStdDevB.setPointsArray(inputData.m_pulseShapeFilterDataStdDevTraceB_X, inputData.m_pulseShapeFilterDataStdDevTraceB_Y, __PULSESHAPEFILTER_SPLINE_TRACE_NUMBER);
-            }
-
-            for ( int j = 0 ; j < size ; ++ j ) {
-                const double tA = (inputData.m_tChannel0[j] - timeAForYMax);
-                const double tB = (inputData.m_tChannel1[j] - timeBForYMax);
-
-                const bool bROIA = (tA >= -inputData.m_pulseShapeFilterLeftInNsROIA) && (tA <= inputData.m_pulseShapeFilterRightInNsROIA);
-                const bool bROIB = (tB >= -inputData.m_pulseShapeFilterLeftInNsROIB) && (tB <= inputData.m_pulseShapeFilterRightInNsROIB);
-
-                if (bROIA && inputData.m_pulseShapeFilterEnabledA) {
-                    const float yA = inputData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
-
-                    const double mean = splineMeanA(tA);
-                    const double val = splineStdDevA(tA);
-
-                    const double stddevUpper = inputData.m_pulseShapeFilterFractOfStdDevUpperA*val;
-                    const double stddevLower = inputData.m_pulseShapeFilterFractOfStdDevLowerA*val;
-
-                    const double upperLimit = (mean + stddevUpper);
-                    const double lowerLimit = (mean - stddevLower);
-
-                    const bool inside = (yA <= upperLimit) && (yA >= lowerLimit);
+            if (sharedData.m_pulseShapeFilterEnabledA)
+                bRejectA = (sharedData.m_pulseShapeFilterEnvelopeA.firstReject(inputData.m_tChannel0, inputData.m_waveChannel0, size, timeAForYMax, sharedData.m_positiveSignal?fractYMaxA:fractYMinA) < size);
 
-                    if (!inside)
-                        bRejectA = true;
-                }
-
-                if (inputData.m_pulseShapeFilterEnabledA && bRejectA)
-                    break;
-
-                if (bROIB && inputData.m_pulseShapeFilterEnabledB) {
-                    const float yB = inputData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
-
-                    const double mean = splineMeanB(tB);
-                    const double val = splineStdDevB(tB);
-
-                    const double stddevUpper = inputData.m_pulseShapeFilterFractOfStdDevUpperB*val;
-                    const double stddevLower = inputData.m_pulseShapeFilterFractOfStdDevLowerB*val;
-
-                    const double upperLimit = (mean + stddevUpper);
-                    const double lowerLimit = (mean - stddevLower);
-
-                    const bool inside = (yB <= upperLimit) && (yB >= lowerLimit);
-
-                    if (!inside)
-                        bRejectB = true;
-                }
-
-                if (inputData.m_pulseShapeFilterEnabledB && bRejectB)
-                    break;
-            }
+            if (sharedData.m_pulseShapeFilterEnabledB && !bRejectA)
+                bRejectB = (sharedData.m_pulseShapeFilterEnvelopeB.firstReject(inputData.m_tChannel1, inputData.m_waveChannel1, size, timeBForYMax, sharedData.m_positiveSignal?fractYMaxB:fractYMinB) < size);
 
-            if (bRejectA || bRejectB)
+            if (!rejectCounter.pass(DRS4RejectFilter::pulseShape, !(bRejectA || bRejectB)))
                 continue;
         }
 
@@ -5165,38 +3081,44 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
 
         /* lifetime: A-B - master */
         if ( bIsStart_A
-             && bIsStop_B && !inputData.m_bForcePrompt  ) {
+             && bIsStop_B && !sharedData.m_bForcePrompt  ) {
             const double ltdiff = (timeStampB - timeStampA);
-            const int binAB = ((int)round(((((ltdiff)+inputData.m_offsetAB)/inputData.m_scalerAB))*((double)inputData.m_channelCntAB)))-1;
+            const int binAB = ((int)round(((((ltdiff)+sharedData.m_offsetAB)/sharedData.m_scalerAB))*((double)sharedData.m_channelCntAB)))-1;
 
-            const int binMerged = ((int)round(((((ltdiff+inputData.m_ATS)+inputData.m_offsetMerged)/inputData.m_scalerMerged))*((double)inputData.m_channelCntMerged)))-1;
+            const int binMerged = ((int)round(((((ltdiff+sharedData.m_ATS)+sharedData.m_offsetMerged)/sharedData.m_scalerMerged))*((double)sharedData.m_channelCntMerged)))-1;
 
-            if ( binAB < 0 || binAB >= inputData.m_channelCntAB )
+            if (!rejectCounter.pass(DRS4RejectFilter::lifetimeRange, !( binAB < 0 || binAB >= sharedData.m_channelCntAB )))
                 continue;
 
             if ( binAB >= 0
-                 && binAB < inputData.m_channelCntAB ) {
-                if ( inputData.m_bNegativeLT && ltdiff < 0  )
-                    outputData.m_lifeTimeDataAB.append(binAB);
-                else if ( ltdiff >= 0 )
-                    outputData.m_lifeTimeDataAB.append(binAB);
+                 && binAB < sharedData.m_channelCntAB ) {
+                if ( sharedData.m_bNegativeLT && ltdiff < 0  ) {
+                    histograms->m_lifeTimeDataAB[binAB] ++;
+                    histograms->m_abCounts ++;
+                }
+                else if ( ltdiff >= 0 ) {
+                    histograms->m_lifeTimeDataAB[binAB] ++;
+                    histograms->m_abCounts ++;
+                }
 
-                if (inputData.m_rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_AB)
+                if (sharedData.m_rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_AB)
                     bValidLifetime = true;
 
                 bValidLifetime2 = true;
 
                 if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-                    outputData.m_phsA_post.append(cellPHSA);
+                    histograms->m_phsA_post[cellPHSA] ++;
+                    histograms->m_phsACounts_post ++;
                 }
 
                 if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-                    outputData.m_phsB_post.append(cellPHSB);
+                    histograms->m_phsB_post[cellPHSB] ++;
+                    histograms->m_phsBCounts_post ++;
                 }
             }
 
             /* pulse-shape filter: record */
-            if (inputData.m_pulseShapeFilterAIsRecording && bValidLifetime) {
+            if (sharedData.m_pulseShapeFilterAIsRecording && bValidLifetime) {
                 const float fractYMaxA = 1.0f/yMaxA;
                 const float fractYMinA = 1.0f/yMinA;
 
@@ -5213,7 +3135,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                     const bool bROIA = (tA >= __PULSESHAPEFILTER_LEFT_MAX) && (tA <= __PULSESHAPEFILTER_RIGHT_MAX);
 
                     if (bROIA) {
-                        const float yA = inputData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
+                        const float yA = sharedData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
 
                         pVecA.append(QPointF(tA, yA));
 
@@ -5230,7 +3152,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                 }
             }
 
-            if (inputData.m_pulseShapeFilterBIsRecording && bValidLifetime) {
+            if (sharedData.m_pulseShapeFilterBIsRecording && bValidLifetime) {
                 const float fractYMinB = 1.0f/yMinB;
                 const float fractYMaxB = 1.0f/yMaxB;
 
@@ -5247,7 +3169,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                     const bool bROIB = (tB >= __PULSESHAPEFILTER_LEFT_MAX) && (tB <= __PULSESHAPEFILTER_RIGHT_MAX);
 
                     if (bROIB) {
-                        const float yB = inputData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
+                        const float yB = sharedData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
 
                         pVecB.append(QPointF(tB, yB));
 
@@ -5264,51 +3186,61 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                 }
             }
 
-            if ( binMerged < 0 || binMerged >= inputData.m_channelCntMerged )
+            if ( binMerged < 0 || binMerged >= sharedData.m_channelCntMerged )
                 continue;
 
             if ( binMerged >= 0
-                 && binMerged < inputData.m_channelCntMerged ) {
-                if ( inputData.m_bNegativeLT && ltdiff < 0  )
-                    outputData.m_lifeTimeDataMerged.append(binMerged);
-                else if ( ltdiff >= 0 )
-                    outputData.m_lifeTimeDataMerged.append(binMerged);
+                 && binMerged < sharedData.m_channelCntMerged ) {
+                if ( sharedData.m_bNegativeLT && ltdiff < 0  ) {
+                    histograms->m_lifeTimeDataMerged[binMerged] ++;
+                    histograms->m_mergedCounts ++;
+                }
+                else if ( ltdiff >= 0 ) {
+                    histograms->m_lifeTimeDataMerged[binMerged] ++;
+                    histograms->m_mergedCounts ++;
+                }
             }
         }
         /* lifetime: B-A - master */
         else if ( bIsStart_B
-                  && bIsStop_A && !inputData.m_bForcePrompt ) {
+                  && bIsStop_A && !sharedData.m_bForcePrompt ) {
             const double ltdiff = (timeStampA - timeStampB);
-            const int binBA = ((int)round(((((ltdiff)+inputData.m_offsetBA)/inputData.m_scalerBA))*((double)inputData.m_channelCntBA)))-1;
+            const int binBA = ((int)round(((((ltdiff)+sharedData.m_offsetBA)/sharedData.m_scalerBA))*((double)sharedData.m_channelCntBA)))-1;
 
-            const int binMerged = ((int)round(((((ltdiff-inputData.m_ATS)+inputData.m_offsetMerged)/inputData.m_scalerMerged))*((double)inputData.m_channelCntMerged)))-1;
+            const int binMerged = ((int)round(((((ltdiff-sharedData.m_ATS)+sharedData.m_offsetMerged)/sharedData.m_scalerMerged))*((double)sharedData.m_channelCntMerged)))-1;
 
-            if ( binBA < 0 || binBA >= inputData.m_channelCntBA )
+            if (!rejectCounter.pass(DRS4RejectFilter::lifetimeRange, !( binBA < 0 || binBA >= sharedData.m_channelCntBA )))
                 continue;
 
             if ( binBA >= 0
-                 && binBA < inputData.m_channelCntBA ) {
-                if ( inputData.m_bNegativeLT && ltdiff < 0 )
-                    outputData.m_lifeTimeDataBA.append(binBA);
-                else if ( ltdiff >= 0 )
-                    outputData.m_lifeTimeDataBA.append(binBA);
+                 && binBA < sharedData.m_channelCntBA ) {
+                if ( sharedData.m_bNegativeLT && ltdiff < 0 ) {
+                    histograms->m_lifeTimeDataBA[binBA] ++;
+                    histograms->m_baCounts ++;
+                }
+                else if ( ltdiff >= 0 ) {
+                    histograms->m_lifeTimeDataBA[binBA] ++;
+                    histograms->m_baCounts ++;
+                }
 
-                if (inputData.m_rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_BA)
+                if (sharedData.m_rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_BA)
                     bValidLifetime = true;
 
                 bValidLifetime2 = true;
 
                 if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-                    outputData.m_phsA_post.append(cellPHSA);
+                    histograms->m_phsA_post[cellPHSA] ++;
+                    histograms->m_phsACounts_post ++;
                 }
 
                 if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-                    outputData.m_phsB_post.append(cellPHSB);
+                    histograms->m_phsB_post[cellPHSB] ++;
+                    histograms->m_phsBCounts_post ++;
                 }
             }
 
             /* pulse-shape filter: record */
-            if (inputData.m_pulseShapeFilterAIsRecording && bValidLifetime) {
+            if (sharedData.m_pulseShapeFilterAIsRecording && bValidLifetime) {
                 const float fractYMaxA = 1.0f/yMaxA;
                 const float fractYMinA = 1.0f/yMinA;
 
@@ -5325,7 +3257,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                     const bool bROIA = (tA >= __PULSESHAPEFILTER_LEFT_MAX) && (tA <= __PULSESHAPEFILTER_RIGHT_MAX);
 
                     if (bROIA) {
-                        const float yA = inputData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
+                        const float yA = sharedData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
 
                         pVecA.append(QPointF(tA, yA));
 
@@ -5342,7 +3274,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                 }
             }
 
-            if (inputData.m_pulseShapeFilterBIsRecording && bValidLifetime) {
+            if (sharedData.m_pulseShapeFilterBIsRecording && bValidLifetime) {
                 const float fractYMinB = 1.0f/yMinB;
                 const float fractYMaxB = 1.0f/yMaxB;
 
@@ -5359,7 +3291,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                     const bool bROIB = (tB >= __PULSESHAPEFILTER_LEFT_MAX) && (tB <= __PULSESHAPEFILTER_RIGHT_MAX);
 
                     if (bROIB) {
-                        const float yB = inputData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
+                        const float yB = sharedData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
 
                         pVecB.append(QPointF(tB, yB));
 
@@ -5376,45 +3308,52 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                 }
             }
 
-            if ( binMerged < 0 || binMerged >= inputData.m_channelCntMerged )
+            if ( binMerged < 0 || binMerged >= sharedData.m_channelCntMerged )
                 continue;
 
             if ( binMerged >= 0
-                 && binMerged < inputData.m_channelCntMerged ) {
-                if ( inputData.m_bNegativeLT && ltdiff < 0  )
-                    outputData.m_lifeTimeDataMerged.append(binMerged);
-                else if ( ltdiff >= 0 )
-                    outputData.m_lifeTimeDataMerged.append(binMerged);
+                 && binMerged < sharedData.m_channelCntMerged ) {
+                if ( sharedData.m_bNegativeLT && ltdiff < 0  ) {
+                    histograms->m_lifeTimeDataMerged[binMerged] ++;
+                    histograms->m_mergedCounts ++;
+                }
+                else if ( ltdiff >= 0 ) {
+                    histograms->m_lifeTimeDataMerged[binMerged] ++;
+                    histograms->m_mergedCounts ++;
+                }
             }
         }
         /* prompt spectrum: A-B of stop - slave */
         else if (  bIsStop_B && bIsStop_A ) {
             const double ltdiff = (timeStampA - timeStampB);
-            const int binBA = ((int)round(((((ltdiff)+inputData.m_offsetPrompt)/inputData.m_scalerPrompt))*((double)inputData.m_channelCntPrompt)))-1;
+            const int binBA = ((int)round(((((ltdiff)+sharedData.m_offsetPrompt)/sharedData.m_scalerPrompt))*((double)sharedData.m_channelCntPrompt)))-1;
 
-            if ( binBA < 0 || binBA >= inputData.m_channelCntPrompt )
+            if (!rejectCounter.pass(DRS4RejectFilter::lifetimeRange, !( binBA < 0 || binBA >= sharedData.m_channelCntPrompt )))
                 continue;
 
             if ( binBA >= 0
-                 && binBA < inputData.m_channelCntPrompt ) {
-                outputData.m_lifeTimeDataCoincidence.append(binBA);
+                 && binBA < sharedData.m_channelCntPrompt ) {
+                histograms->m_lifeTimeDataCoincidence[binBA] ++;
+                histograms->m_coincidenceCounts ++;
 
-                if (inputData.m_rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_Prompt)
+                if (sharedData.m_rcScheme == DRS4PulseShapeFilterRecordScheme::Scheme::RC_Prompt)
                     bValidLifetime = true;
 
                 bValidLifetime2 = true;
 
                 if ( cellPHSA < kNumberOfBins && cellPHSA >= 0 ) {
-                    outputData.m_phsA_post.append(cellPHSA);
+                    histograms->m_phsA_post[cellPHSA] ++;
+                    histograms->m_phsACounts_post ++;
                 }
 
                 if ( cellPHSB < kNumberOfBins && cellPHSB >= 0 ) {
-                    outputData.m_phsB_post.append(cellPHSB);
+                    histograms->m_phsB_post[cellPHSB] ++;
+                    histograms->m_phsBCounts_post ++;
                 }
             }
 
             /* pulse-shape filter: record */
-            if (inputData.m_pulseShapeFilterAIsRecording && bValidLifetime) {
+            if (sharedData.m_pulseShapeFilterAIsRecording && bValidLifetime) {
                 const float fractYMaxA = 1.0f/yMaxA;
                 const float fractYMinA = 1.0f/yMinA;
 
@@ -5431,7 +3370,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                     const bool bROIA = (tA >= __PULSESHAPEFILTER_LEFT_MAX) && (tA <= __PULSESHAPEFILTER_RIGHT_MAX);
 
                     if (bROIA) {
-                        const float yA = inputData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
+                        const float yA = sharedData.m_positiveSignal?(inputData.m_waveChannel0[j]*fractYMaxA):(inputData.m_waveChannel0[j]*fractYMinA);
 
                         pVecA.append(QPointF(tA, yA));
 
@@ -5448,7 +3387,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                 }
             }
 
-            if (inputData.m_pulseShapeFilterBIsRecording && bValidLifetime) {
+            if (sharedData.m_pulseShapeFilterBIsRecording && bValidLifetime) {
                 const float fractYMinB = 1.0f/yMinB;
                 const float fractYMaxB = 1.0f/yMaxB;
 
@@ -5465,7 +3404,7 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
                     const bool bROIB = (tB >= __PULSESHAPEFILTER_LEFT_MAX) && (tB <= __PULSESHAPEFILTER_RIGHT_MAX);
 
                     if (bROIB) {
-                        const float yB = inputData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
+                        const float yB = sharedData.m_positiveSignal?(inputData.m_waveChannel1[j]*fractYMaxB):(inputData.m_waveChannel1[j]*fractYMinB);
 
                         pVecB.append(QPointF(tB, yB));
 
@@ -5487,102 +3426,492 @@ DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInpu
     return outputData;
 }
 
-bool DRS4WorkerConcurrentManager::add(const QVector<DRS4ConcurrentCopyInputData> &copyData)
+void DRS4ConcurrentHistograms::prepare(const DRS4ConcurrentSharedInputData &sharedData)
+{
+    /* QVector::resize(): appended bins are zero */
+    if ( m_lifeTimeDataAB.size() != sharedData.m_channelCntAB )
+        m_lifeTimeDataAB.resize(sharedData.m_channelCntAB);
+
+    if ( m_lifeTimeDataBA.size() != sharedData.m_channelCntBA )
+        m_lifeTimeDataBA.resize(sharedData.m_channelCntBA);
+
+    if ( m_lifeTimeDataCoincidence.size() != sharedData.m_channelCntPrompt )
+        m_lifeTimeDataCoincidence.resize(sharedData.m_channelCntPrompt);
+
+    if ( m_lifeTimeDataMerged.size() != sharedData.m_channelCntMerged )
+        m_lifeTimeDataMerged.resize(sharedData.m_channelCntMerged);
+
+    if ( m_riseTimeFilterDataA.size() != sharedData.m_riseTimeFilterBinningA )
+        m_riseTimeFilterDataA.resize(sharedData.m_riseTimeFilterBinningA);
+
+    if ( m_riseTimeFilterDataB.size() != sharedData.m_riseTimeFilterBinningB )
+        m_riseTimeFilterDataB.resize(sharedData.m_riseTimeFilterBinningB);
+}
+
+void DRS4ConcurrentHistograms::resetCounts()
+{
+    m_phsACounts = 0;
+    m_phsBCounts = 0;
+    m_phsACounts_post = 0;
+    m_phsBCounts_post = 0;
+
+    m_abCounts = 0;
+    m_baCounts = 0;
+    m_coincidenceCounts = 0;
+    m_mergedCounts = 0;
+
+    m_riseTimeFilterACounter = 0;
+    m_riseTimeFilterBCounter = 0;
+}
+
+void DRS4ConcurrentHistograms::clear(int types)
+{
+    if ( types & DRS4ConcurrentHistogramsType::phsA ) {
+        m_phsA.fill(0);
+        m_phsA_post.fill(0);
+
+        m_phsACounts = 0;
+        m_phsACounts_post = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::phsB ) {
+        m_phsB.fill(0);
+        m_phsB_post.fill(0);
+
+        m_phsBCounts = 0;
+        m_phsBCounts_post = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::abSpectrum ) {
+        m_lifeTimeDataAB.fill(0);
+        m_abCounts = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::baSpectrum ) {
+        m_lifeTimeDataBA.fill(0);
+        m_baCounts = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::coincidenceSpectrum ) {
+        m_lifeTimeDataCoincidence.fill(0);
+        m_coincidenceCounts = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::mergedSpectrum ) {
+        m_lifeTimeDataMerged.fill(0);
+        m_mergedCounts = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::riseTimeFilterA ) {
+        m_riseTimeFilterDataA.fill(0);
+        m_riseTimeFilterACounter = 0;
+    }
+
+    if ( types & DRS4ConcurrentHistogramsType::riseTimeFilterB ) {
+        m_riseTimeFilterDataB.fill(0);
+        m_riseTimeFilterBCounter = 0;
+    }
+}
+
+bool DRS4ConcurrentHistogramsExchange::handOver()
 {
-    if (copyData.isEmpty())
+    if ( m_current->isEmpty() )
+        return true;
+
+    if ( m_handOverTimer.elapsed() < __WORKER_HISTOGRAM_MERGE_INTERVAL )
+        return true;
+
+    /* the previous histograms are not merged yet: keep on filling the current ones */
+    if ( m_filled.load(std::memory_order_acquire) )
+        return false;
+
+    DRS4ConcurrentHistograms *empty = m_empty.exchange(DNULLPTR, std::memory_order_acq_rel);
+
+    if ( !empty )
         return false;
 
-    m_copyData.append(copyData);
+    m_filled.store(m_current, std::memory_order_release);
+    m_current = empty;
+
+    m_handOverTimer.restart();
+
+    return true;
+}
+
+/* adds the bins of an analysis thread to the spectrum and clears them (plain loops over contiguous arrays: vectorized by the compiler) */
+static inline void mergeHistogramBins(QVector<int>& spectrum, QVector<int>& bins, int *maxY = DNULLPTR)
+{
+    const int size = qMin(spectrum.size(), bins.size());
+
+    int *dst = spectrum.data();
+    int *src = bins.data();
+
+    if ( maxY ) {
+        int max = *maxY;
+
+        for ( int i = 0 ; i < size ; ++ i ) {
+            dst[i] += src[i];
+            max = qMax(max, dst[i]);
+        }
+
+        *maxY = max;
+    }
+    else {
+        for ( int i = 0 ; i < size ; ++ i )
+            dst[i] += src[i];
+    }
+
+    std::fill(src, src + bins.size(), 0);
+}
+
+void DRS4WorkerConcurrentManager::start(int chunkSize, bool bAdaptiveChunkSize)
+{
+    cancel();
+
+    m_eventRing->resetStatistics();
+    m_statistics.reset();
+
+    m_chunkSize.store(qMax(1, chunkSize));
+
+    m_bAdaptiveChunkSize.store(bAdaptiveChunkSize);
+    m_chunkTimeInNs.store(0);
+    m_chunkEvents.store(0);
+    m_chunks.store(0);
+
+    m_lastChunkSizeAdaption = 0;
+    m_chunkSizeTimer.start();
+
+    {
+        QMutexLocker locker(&m_chunkSizeMutex);
+
+        m_chunkSizeHistory.clear();
+    }
+
+    for ( DRS4ConcurrentHistogramsExchange *exchange : m_histograms )
+        exchange->m_handOverTimer.start();
+
+    DRS4AnalysisThreadPool::sharedInstance()->setThreadAffinityEnabled(DRS4ProgramSettingsManager::sharedInstance()->isAnalysisThreadPinningEnabled());
+
+    /* the drain tasks are posted by the decode stage as soon as the events are published */
+    m_isDraining.store(true, std::memory_order_release);
+}
+
+void DRS4WorkerConcurrentManager::cancel()
+{
+    m_isDraining.store(false, std::memory_order_release);
+
+    while ( m_runningDrainTasks.load(std::memory_order_acquire) > 0 )
+        QThread::usleep(__WORKER_EVENT_RING_IDLE_SLEEP);
+
+    /* pending (not yet analysed) events are discarded */
+    m_eventRing->clear();
+}
+
+void DRS4WorkerConcurrentManager::scheduleDrain(int preferredThread)
+{
+    if ( !m_isDraining.load(std::memory_order_acquire) )
+        return;
+
+    /* enough tasks queued: each of them posts its successor if events are left behind */
+    if ( m_queuedDrainTasks.fetch_add(1, std::memory_order_acq_rel) >= m_recommendedThreads*__WORKER_DRAIN_TASKS_PER_THREAD ) {
+        m_queuedDrainTasks.fetch_sub(1, std::memory_order_acq_rel);
+
+        return;
+    }
+
+    m_runningDrainTasks.fetch_add(1, std::memory_order_acq_rel);
+
+    DRS4AnalysisThreadPool::sharedInstance()->start(new DRS4WorkerConcurrentDrainTask(this), preferredThread);
+}
+
+void DRS4WorkerConcurrentManager::drain()
+{
+    m_queuedDrainTasks.fetch_sub(1, std::memory_order_acq_rel);
+
+    /* the histograms belong to the executing thread: a stolen task fills those of the thief */
+    const int threadIndex = DRS4AnalysisThreadPool::currentThreadIndex();
+
+    if ( !m_isDraining.load(std::memory_order_acquire)
+         || threadIndex < 0
+         || threadIndex >= m_histograms.size() ) {
+        m_runningDrainTasks.fetch_sub(1, std::memory_order_release);
+
+        return;
+    }
+
+    DRS4ConcurrentHistogramsExchange *histograms = m_histograms.at(threadIndex);
+
+    histograms->claim();
+
+    /* the histogram stage lags behind */
+    if (!histograms->handOver())
+        m_statistics.addStall();
+
+    quint64 firstPosition = 0;
 
-    if (!m_future.isRunning() && m_future.isFinished()) {
-        merge();
-        start();
+    const int count = m_eventRing->claimReadSlots(m_chunkSize.load(std::memory_order_relaxed), &firstPosition);
+
+    if ( !count ) {
+        m_statistics.addIdleCycle();
+    }
+    else {
+        m_busyDrainTasks.fetch_add(1);
+
+        QVector<const DRS4ConcurrentCopyInputData*>& events = histograms->m_events;
+
+        events.resize(count);
+
+        for ( int i = 0 ; i < count ; ++ i )
+            events[i] = m_eventRing->slotAt(firstPosition + i);
+
+        QElapsedTimer chunkTimer;
+        chunkTimer.start();
+
+        const DRS4ConcurrentCopyOutputData outputData = runCalculation(events, histograms->m_current);
+
+        m_chunkTimeInNs.fetch_add(chunkTimer.nsecsElapsed(), std::memory_order_relaxed);
+        m_chunkEvents.fetch_add(count, std::memory_order_relaxed);
+        m_chunks.fetch_add(1, std::memory_order_relaxed);
+
+        m_eventRing->releaseReadSlots(firstPosition, count);
+
+        m_busyDrainTasks.fetch_sub(1);
+
+        m_statistics.addProcessed(count);
+
+        /* area-filter and pulse-shape data only */
+        if ( !outputData.rejectData()
+             && !(outputData.m_areaFilterDataA.isEmpty()
+                  && outputData.m_areaFilterCollectionDataA.isEmpty()
+                  && outputData.m_areaFilterCollectionDataB.isEmpty()
+                  && outputData.m_pulseShapeDataA.isEmpty()
+                  && outputData.m_pulseShapeDataB.isEmpty()) ) {
+            QMutexLocker locker(&m_resultMutex);
+
+            m_results.append(outputData);
+        }
     }
 
+    histograms->release();
+
+    /* successor onto the own deque: the owner takes it next (LIFO), idle threads steal it */
+    if ( m_eventRing->size() > 0 )
+        scheduleDrain(threadIndex);
+
+    m_runningDrainTasks.fetch_sub(1, std::memory_order_release);
+}
+
+bool DRS4WorkerConcurrentManager::mergeHistograms(DRS4ConcurrentHistograms *histograms)
+{
+    if ( histograms->isEmpty() )
+        return false;
+
+    /* PHS */
+    if ( histograms->m_phsACounts )
+        mergeHistogramBins(m_worker->m_phsA, histograms->m_phsA);
+
+    if ( histograms->m_phsBCounts )
+        mergeHistogramBins(m_worker->m_phsB, histograms->m_phsB);
+
+    if ( histograms->m_phsACounts_post )
+        mergeHistogramBins(m_worker->m_phsA_post, histograms->m_phsA_post);
+
+    if ( histograms->m_phsBCounts_post )
+        mergeHistogramBins(m_worker->m_phsB_post, histograms->m_phsB_post);
+
+    m_worker->m_phsACounts += histograms->m_phsACounts;
+    m_worker->m_phsBCounts += histograms->m_phsBCounts;
+    m_worker->m_phsACounts_post += histograms->m_phsACounts_post;
+    m_worker->m_phsBCounts_post += histograms->m_phsBCounts_post;
+
+    /* Lifetime-Spectrum */
+    if ( histograms->m_abCounts )
+        mergeHistogramBins(m_worker->m_lifeTimeDataAB, histograms->m_lifeTimeDataAB, &m_worker->m_maxY_ABSpectrum);
+
+    if ( histograms->m_baCounts )
+        mergeHistogramBins(m_worker->m_lifeTimeDataBA, histograms->m_lifeTimeDataBA, &m_worker->m_maxY_BASpectrum);
+
+    if ( histograms->m_coincidenceCounts )
+        mergeHistogramBins(m_worker->m_lifeTimeDataCoincidence, histograms->m_lifeTimeDataCoincidence, &m_worker->m_maxY_CoincidenceSpectrum);
+
+    if ( histograms->m_mergedCounts )
+        mergeHistogramBins(m_worker->m_lifeTimeDataMerged, histograms->m_lifeTimeDataMerged, &m_worker->m_maxY_MergedSpectrum);
+
+    m_worker->m_abCounts += histograms->m_abCounts;
+    m_worker->m_baCounts += histograms->m_baCounts;
+    m_worker->m_coincidenceCounts += histograms->m_coincidenceCounts;
+    m_worker->m_mergedCounts += histograms->m_mergedCounts;
+
+    /* Statistics */
+    m_worker->m_specABCounterCnt += histograms->m_abCounts;
+    m_worker->m_specBACounterCnt += histograms->m_baCounts;
+    m_worker->m_specCoincidenceCounterCnt += histograms->m_coincidenceCounts;
+    m_worker->m_specMergedCounterCnt += histograms->m_mergedCounts;
+
+    /* Rise - Time Filter */
+    if ( histograms->m_riseTimeFilterACounter )
+        mergeHistogramBins(m_worker->m_riseTimeFilterDataA, histograms->m_riseTimeFilterDataA, &m_worker->m_maxY_RiseTimeSpectrumA);
+
+    if ( histograms->m_riseTimeFilterBCounter )
+        mergeHistogramBins(m_worker->m_riseTimeFilterDataB, histograms->m_riseTimeFilterDataB, &m_worker->m_maxY_RiseTimeSpectrumB);
+
+    m_worker->m_riseTimeFilterACounter += histograms->m_riseTimeFilterACounter;
+    m_worker->m_riseTimeFilterBCounter += histograms->m_riseTimeFilterBCounter;
+
+    histograms->resetCounts();
+
     return true;
 }
 
-void DRS4WorkerConcurrentManager::start()
+void DRS4WorkerConcurrentManager::adaptChunkSize()
+{
+    if ( !m_bAdaptiveChunkSize.load(std::memory_order_relaxed) )
+        return;
+
+    const qint64 now = m_chunkSizeTimer.elapsed();
+
+    if ( now - m_lastChunkSizeAdaption < __WORKER_CHUNK_ADAPT_INTERVAL )
+        return;
+
+    m_lastChunkSizeAdaption = now;
+
+    const quint64 timeInNs = m_chunkTimeInNs.exchange(0, std::memory_order_relaxed);
+    const quint64 events = m_chunkEvents.exchange(0, std::memory_order_relaxed);
+    const quint64 chunks = m_chunks.exchange(0, std::memory_order_relaxed);
+
+    /* nothing analysed within the interval: keep the chunk size */
+    if ( !events || !chunks )
+        return;
+
+    const int currentChunkSize = m_chunkSize.load(std::memory_order_relaxed);
+    const int queueDepth = m_eventRing->size();
+
+    const double timePerEventInMs = 1E-6*double(timeInNs)/double(events);
+    const double chunkLatencyInMs = 1E-6*double(timeInNs)/double(chunks);
+
+    /* each analysis thread should still find a chunk within the event ring */
+    const int maxChunkSize = qMax(1, m_eventRing->capacity()/qMax(1, m_recommendedThreads));
+
+    int chunkSize = qRound(qMin(double(maxChunkSize), __WORKER_CHUNK_TARGET_LATENCY/qMax(timePerEventInMs, 1E-6)));
+
+    /* the analysis lags behind: larger chunks reduce the dispatching */
+    if ( queueDepth > m_eventRing->capacity()/2 )
+        chunkSize = qMax(chunkSize, 2*currentChunkSize);
+
+    /* damped: halfway towards the new value */
+    chunkSize = qBound(1, (currentChunkSize + chunkSize + 1)/2, maxChunkSize);
+
+    m_chunkSize.store(chunkSize, std::memory_order_relaxed);
+
+    DRS4ChunkSizeSample sample;
+
+    sample.m_timeInMs = now;
+    sample.m_chunkSize = chunkSize;
+    sample.m_chunkLatencyInMs = chunkLatencyInMs;
+    sample.m_queueDepth = queueDepth;
+
+    QMutexLocker locker(&m_chunkSizeMutex);
+
+    if ( m_chunkSizeHistory.size() >= __WORKER_CHUNK_HISTORY_SIZE )
+        m_chunkSizeHistory.removeFirst();
+
+    m_chunkSizeHistory.append(sample);
+}
+
+int DRS4WorkerConcurrentManager::chunkSize() const
+{
+    return m_chunkSize.load(std::memory_order_relaxed);
+}
+
+bool DRS4WorkerConcurrentManager::isChunkSizeAdaptive() const
+{
+    return m_bAdaptiveChunkSize.load(std::memory_order_relaxed);
+}
+
+QVector<DRS4ChunkSizeSample> DRS4WorkerConcurrentManager::chunkSizeHistory() const
 {
-    m_copyMetaData.clear();
-    m_copyMetaData.swap(m_copyData);
+    QMutexLocker locker(&m_chunkSizeMutex);
 
-    m_future = QtConcurrent::mapped(m_copyMetaData, runCalculation);
+    return m_chunkSizeHistory;
 }
 
-void DRS4WorkerConcurrentManager::cancel()
+int DRS4WorkerConcurrentManager::pendingHistograms() const
 {
-    if (m_future.isRunning() ) {
-        m_future.cancel();
-        m_future.waitForFinished();
+    int pending = 0;
+
+    for ( const DRS4ConcurrentHistogramsExchange *exchange : m_histograms ) {
+        if ( exchange->m_filled.load(std::memory_order_relaxed) )
+            pending ++;
     }
+
+    return pending;
 }
 
-void DRS4WorkerConcurrentManager::merge()
+void DRS4WorkerConcurrentManager::resetHistograms(int types)
 {
-    if (m_future.isRunning()
-            && !m_future.isFinished())
-        return;
-
-    for ( DRS4ConcurrentCopyOutputData outputData : m_future.results()  ) {
-        if (outputData.rejectData())
-            continue;
+    for ( DRS4ConcurrentHistogramsExchange *exchange : m_histograms ) {
+        /* the drain task of the thread may still analyse its chunk */
+        exchange->claim();
 
-        /* PHS */
-        for ( int index : outputData.m_phsA )
-            m_worker->m_phsA[index] ++;
+        exchange->m_current->clear(types);
 
-        m_worker->m_phsACounts += outputData.m_phsA.size();
+        /* owned by the histogram stage, which is parked */
+        DRS4ConcurrentHistograms *filled = exchange->m_filled.load(std::memory_order_acquire);
 
-        for ( int index : outputData.m_phsB )
-            m_worker->m_phsB[index] ++;
+        if ( filled )
+            filled->clear(types);
 
-        m_worker->m_phsBCounts += outputData.m_phsB.size();
-
-        for ( int index : outputData.m_phsA_post )
-            m_worker->m_phsA_post[index] ++;
+        exchange->release();
+    }
+}
 
-        m_worker->m_phsACounts_post += outputData.m_phsA_post.size();
+int DRS4WorkerConcurrentManager::merge()
+{
+    /* dense histograms: after cancel() the analysis threads are finished and their current histograms are merged as well */
+    const bool bThreadsFinished = (!m_isDraining.load(std::memory_order_acquire)
+                                   && m_runningDrainTasks.load(std::memory_order_acquire) == 0);
+
+    int merged = 0;
+
+    for ( DRS4ConcurrentHistogramsExchange *exchange : m_histograms ) {
+        /* an idle analysis thread would keep its current histograms until its next drain task: hand them over on its behalf */
+        if ( !bThreadsFinished
+             && exchange->tryClaim() ) {
+            exchange->handOver();
+            exchange->release();
+        }
 
-        for ( int index : outputData.m_phsB_post )
-            m_worker->m_phsB_post[index] ++;
+        DRS4ConcurrentHistograms *filled = exchange->m_filled.load(std::memory_order_acquire);
 
-        m_worker->m_phsBCounts_post += outputData.m_phsB_post.size();
+        if ( filled ) {
+            if (mergeHistograms(filled))
+                merged ++;
 
-        /* Lifetime-Spectrum */
-        for ( int index : outputData.m_lifeTimeDataAB ) {
-            m_worker->m_lifeTimeDataAB[index] ++;
-            m_worker->m_maxY_ABSpectrum = qMax(m_worker->m_maxY_ABSpectrum, m_worker->m_lifeTimeDataAB[index]);
+            exchange->m_empty.store(filled, std::memory_order_release);
+            exchange->m_filled.store(DNULLPTR, std::memory_order_release);
         }
 
-        m_worker->m_abCounts += outputData.m_lifeTimeDataAB.size();
-
-        for ( int index : outputData.m_lifeTimeDataBA ) {
-            m_worker->m_lifeTimeDataBA[index] ++;
-            m_worker->m_maxY_BASpectrum = qMax(m_worker->m_maxY_BASpectrum, m_worker->m_lifeTimeDataBA[index]);
-        }
+        if ( bThreadsFinished
+             && mergeHistograms(exchange->m_current) )
+            merged ++;
+    }
 
-        m_worker->m_baCounts += outputData.m_lifeTimeDataBA.size();
+    QVector<DRS4ConcurrentCopyOutputData> results;
 
-        for ( int index : outputData.m_lifeTimeDataCoincidence ) {
-            m_worker->m_lifeTimeDataCoincidence[index] ++;
-            m_worker->m_maxY_CoincidenceSpectrum = qMax(m_worker->m_maxY_CoincidenceSpectrum, m_worker->m_lifeTimeDataCoincidence[index]);
-        }
+    {
+        QMutexLocker locker(&m_resultMutex);
 
-        m_worker->m_coincidenceCounts += outputData.m_lifeTimeDataCoincidence.size();
+        if ( m_results.isEmpty() )
+            return merged;
 
-        for ( int index : outputData.m_lifeTimeDataMerged ) {
-            m_worker->m_lifeTimeDataMerged[index] ++;
-            m_worker->m_maxY_MergedSpectrum = qMax(m_worker->m_maxY_MergedSpectrum, m_worker->m_lifeTimeDataMerged[index]);
-        }
+        results.swap(m_results);
+    }
 
-        m_worker->m_mergedCounts += outputData.m_lifeTimeDataMerged.size();
+    merged += results.size();
 
-        /* Statistics */
-        m_worker->m_specABCounterCnt += outputData.m_lifeTimeDataAB.size();
-        m_worker->m_specBACounterCnt += outputData.m_lifeTimeDataBA.size();
-        m_worker->m_specCoincidenceCounterCnt += outputData.m_lifeTimeDataCoincidence.size();
-        m_worker->m_specMergedCounterCnt += outputData.m_lifeTimeDataMerged.size();
+    for ( const DRS4ConcurrentCopyOutputData& outputData : results ) {
+        if (outputData.rejectData())
+            continue;
 
         /* Area - Filter */
         int index = 0;
@@ -5664,23 +3993,6 @@ void DRS4WorkerConcurrentManager::merge()
             m_worker->m_areaFilterCollectedBCounter ++;
         }
 
-        /* Rise - Time Filter */
-        for ( int i = 0 ; i < outputData.m_riseTimeFilterDataA.size() ; ++ i ) {
-            m_worker->m_riseTimeFilterDataA[outputData.m_riseTimeFilterDataA[i]] ++;
-
-            m_worker->m_maxY_RiseTimeSpectrumA = qMax(m_worker->m_maxY_RiseTimeSpectrumA, m_worker->m_riseTimeFilterDataA[outputData.m_riseTimeFilterDataA[i]]);
-        }
-
-        m_worker->m_riseTimeFilterACounter += outputData.m_riseTimeFilterDataA.size();
-
-        for ( int i = 0 ; i < outputData.m_riseTimeFilterDataB.size() ; ++ i ) {
-            m_worker->m_riseTimeFilterDataB[outputData.m_riseTimeFilterDataB[i]] ++;
-
-            m_worker->m_maxY_RiseTimeSpectrumB = qMax(m_worker->m_maxY_RiseTimeSpectrumB, m_worker->m_riseTimeFilterDataB[outputData.m_riseTimeFilterDataB[i]]);
-        }
-
-        m_worker->m_riseTimeFilterBCounter += outputData.m_riseTimeFilterDataB.size();
-
         /* Pulse - Shape Filter (during record) */
         if (m_worker->m_isRecordingForShapeFilterA
                 || m_worker->m_isRecordingForShapeFilterB) {
@@ -5762,11 +4074,13 @@ void DRS4WorkerConcurrentManager::merge()
             }
         }
     }
+
+    return merged;
 }
 
 int DRS4WorkerConcurrentManager::activeThreads() const
 {
-    const int threadCount = QThreadPool::globalInstance()->activeThreadCount();
+    const int threadCount = m_busyDrainTasks.load(std::memory_order_relaxed);
 
     return (threadCount==0?1:threadCount);
 }
@@ -5775,3 +4089,475 @@ int DRS4WorkerConcurrentManager::maxThreads() const
 {
     return m_recommendedThreads;
 }
+
+DRS4WorkerPipeline::DRS4WorkerPipeline(DRS4Worker *worker) :
+    m_worker(worker),
+    m_readoutQueue(new DRS4PipelineReadoutQueue(__WORKER_PIPELINE_READOUT_QUEUE_CAPACITY)),
+    m_persistQueue(new DRS4PipelinePersistQueue(__WORKER_PIPELINE_PERSIST_QUEUE_CAPACITY)),
+    m_isRunning(false),
+    m_bDemoMode(false),
+    m_decodedEvents(0),
+    m_boardTemperature(-1.),
+    m_bPulseDataUpdated(false) {}
+
+DRS4WorkerPipeline::~DRS4WorkerPipeline()
+{
+    stop();
+
+    DDELETE_SAFETY(m_readoutQueue);
+    DDELETE_SAFETY(m_persistQueue);
+}
+
+void DRS4WorkerPipeline::start(bool bDemoMode)
+{
+    stop();
+
+    m_bDemoMode = bDemoMode;
+
+    m_readoutQueue->resetStatistics();
+    m_persistQueue->resetStatistics();
+
+    for ( int i = 0 ; i < __WORKER_PIPELINE_STAGES ; ++ i )
+        m_statistics[i].reset();
+
+    m_decodedEvents.store(0, std::memory_order_relaxed);
+
+    m_isRunning.store(true, std::memory_order_release);
+
+    m_threads.append(new DRS4WorkerPipelineStageThread(this, DRS4PipelineStageType::persist));
+    m_threads.append(new DRS4WorkerPipelineStageThread(this, DRS4PipelineStageType::decode));
+    m_threads.append(new DRS4WorkerPipelineStageThread(this, DRS4PipelineStageType::readout));
+
+    for ( DRS4WorkerPipelineStageThread *thread : m_threads )
+        thread->start();
+}
+
+void DRS4WorkerPipeline::stop()
+{
+    m_isRunning.store(false, std::memory_order_release);
+
+    /* in reverse order of the start: readout, decode and persist (writes the pending events) */
+    for ( int i = m_threads.size() - 1 ; i >= 0 ; -- i )
+        m_threads.at(i)->wait();
+
+    qDeleteAll(m_threads);
+    m_threads.clear();
+
+    /* the readout queue is written by the readout stage only */
+    m_readoutQueue->clear();
+}
+
+void DRS4WorkerPipelineStageThread::run()
+{
+    switch (m_stage) {
+    case DRS4PipelineStageType::readout:
+        m_pipeline->readout();
+        break;
+    case DRS4PipelineStageType::decode:
+        m_pipeline->decode();
+        break;
+    case DRS4PipelineStageType::persist:
+        m_pipeline->persist();
+        break;
+    default:
+        break;
+    }
+}
+
+void DRS4WorkerPipeline::readout()
+{
+    const bool bIgnoreBusyState = DRS4SettingsManager::sharedInstance()->ignoreBusyState(); /* this value is deprecated and for test purposes only */
+    const bool bMultiBuffer = DRS4ProgramSettingsManager::sharedInstance()->isMultiBufferReadoutEnabled();
+
+    DRS4PipelineStageStatistics& statistics = m_statistics[DRS4PipelineStageType::readout];
+
+    DRS4AnalysisConfigPtr config;
+
+    QElapsedTimer temperatureTimer;
+
+    /* the analysis threads leave the reserved core(s) to the readout: the stage thread is discarded on stop() */
+    if ( DRS4AnalysisThreadPool::sharedInstance()->isThreadAffinityEnabled() )
+        DRS4AnalysisThreadPool::pinCurrentThreadToReservedCores(true);
+
+    /* demo mode: the software stand-in of the board delivers the generated pulse pairs */
+    DRS4ReadoutDevice *device = DNULLPTR;
+
+    if (!m_bDemoMode)
+        device = new DRS4BoardReadoutDevice(DRS4BoardManager::sharedInstance()->currentBoard(), bIgnoreBusyState);
+    else
+        device = new DRS4SoftwareBoard;
+
+    try {
+        device->arm(bMultiBuffer);
+    }
+    catch ( ... ) {
+    }
+
+    DRS4PipelineRawEvent *rawEvents[__READOUT_DEVICE_MAX_BATCH];
+
+    while ( m_isRunning.load(std::memory_order_acquire) ) {
+        int pendingEvents = 0;
+
+        try {
+            pendingEvents = device->pendingEvents();
+        }
+        catch ( ... ) {
+        }
+
+        if ( pendingEvents <= 0 ) {
+            m_worker->waitForNextSignal();
+
+            continue;
+        }
+
+        m_worker->waitForNextSignal();
+
+        if ( !m_isRunning.load(std::memory_order_acquire) )
+            break;
+
+        /* the board is accessed by this stage only: the temperature is sampled here */
+        if ( !temperatureTimer.isValid()
+             || temperatureTimer.elapsed() >= __STATISTIC_AVG_TIME*1000 ) {
+            if ( m_bDemoMode ) {
+                m_boardTemperature.store(-1., std::memory_order_relaxed);
+            }
+            else {
+                try {
+                    m_boardTemperature.store(DRS4BoardManager::sharedInstance()->currentBoard()->GetTemperature(), std::memory_order_relaxed);
+                }
+                catch ( ... ) {
+                }
+            }
+
+            temperatureTimer.restart();
+        }
+
+        const int count = m_readoutQueue->acquireWriteSlots(qMin(pendingEvents, __READOUT_DEVICE_MAX_BATCH));
+
+        if (!count) {
+            /* the decode stage cannot keep up: drop the pending events of the board but keep the loop running */
+            statistics.addStall();
+
+            m_readoutQueue->markDropped(pendingEvents);
+
+            try {
+                device->dropEvents();
+            }
+            catch ( ... ) {
+            }
+
+            if (m_bDemoMode)
+                QThread::usleep(__WORKER_PIPELINE_IDLE_SLEEP);
+
+            continue;
+        }
+
+        /* settings are taken from an immutable copy: no xml-node access within the loop */
+        if ( !config
+             || config->m_version != DRS4SettingsManager::sharedInstance()->settingsVersion() )
+            config = DRS4SettingsManager::sharedInstance()->analysisConfig();
+
+        const int chnA = config->m_channelNumberA;
+        const int chnB = config->m_channelNumberB;
+
+        for ( int i = 0 ; i < count ; ++ i )
+            rawEvents[i] = m_readoutQueue->writeSlotAt(i);
+
+        /* all pending events with one bulk transfer (multi-buffer), otherwise one event */
+        int transferred = 0;
+
+        try {
+            transferred = device->transferEvents(rawEvents, count, chnA, chnB);
+        }
+        catch (...) {
+            continue;
+        }
+
+        if (!transferred)
+            continue;
+
+        for ( int i = 0 ; i < transferred ; ++ i ) {
+            rawEvents[i]->m_chnA = chnA;
+            rawEvents[i]->m_chnB = chnB;
+            rawEvents[i]->m_config = config;
+        }
+
+        m_readoutQueue->publishWriteSlots(transferred);
+
+        statistics.addProcessed(transferred);
+    }
+
+    try {
+        device->disarm();
+    }
+    catch ( ... ) {
+    }
+
+    DDELETE_SAFETY(device);
+}
+
+/* time and voltage calibration of the raw copy: the calibration data of the board is not modified by the readout stage */
+static bool decodeRawEvent(DRS4PipelineRawEvent *rawEvent, DRS4ConcurrentCopyInputData *inputData)
+{
+    if ( rawEvent->m_bDecoded ) {
+        std::copy(rawEvent->m_tChannel0, rawEvent->m_tChannel0 + kNumberOfBins, inputData->m_tChannel0);
+        std::copy(rawEvent->m_tChannel1, rawEvent->m_tChannel1 + kNumberOfBins, inputData->m_tChannel1);
+
+        std::copy(rawEvent->m_waveChannel0, rawEvent->m_waveChannel0 + kNumberOfBins, inputData->m_waveChannel0);
+        std::copy(rawEvent->m_waveChannel1, rawEvent->m_waveChannel1 + kNumberOfBins, inputData->m_waveChannel1);
+
+        return true;
+    }
+
+    DRSBoard *board = DRS4BoardManager::sharedInstance()->currentBoard();
+
+    const int chnA = 2*rawEvent->m_chnA;
+    const int chnB = 2*rawEvent->m_chnB;
+    const int triggerCell = rawEvent->m_triggerCell;
+
+    try {
+        if ( board->GetTime(0, chnA, triggerCell, inputData->m_tChannel0) != 1 )
+            return false;
+
+        if ( board->GetTime(0, chnB, triggerCell, inputData->m_tChannel1) != 1 )
+            return false;
+
+        /* both channels are decoded and calibrated in place into the slot of the event ring */
+        if ( board->GetWaves(rawEvent->m_raw, 0, chnA, chnB, inputData->m_waveChannel0, inputData->m_waveChannel1, true, triggerCell, 0, true) != kSuccess )
+            return false;
+    }
+    catch ( ... ) {
+        return false;
+    }
+
+    return true;
+}
+
+void DRS4WorkerPipeline::decode()
+{
+    DRS4PipelineStageStatistics& statistics = m_statistics[DRS4PipelineStageType::decode];
+
+    DRS4WorkerConcurrentManager *manager = m_worker->m_workerConcurrentManager;
+
+    /* the 'S' extension represents the holding as source (original) data set */
+    float waveChannel0S[kNumberOfBins] = {0};
+    float waveChannel1S[kNumberOfBins] = {0};
+
+    DRS4RejectFilterCounter rejectCounter;
+
+    while ( m_isRunning.load(std::memory_order_acquire) ) {
+        quint64 position = 0;
+
+        /* the shared input data and the calibration of the board are taken from the worker */
+        m_worker->waitForNextSignal();
+
+        if ( !m_readoutQueue->claimReadSlots(1, &position) ) {
+            statistics.addIdleCycle();
+
+            QThread::usleep(__WORKER_PIPELINE_IDLE_SLEEP);
+
+            continue;
+        }
+
+        DRS4PipelineRawEvent *rawEvent = m_readoutQueue->slotAt(position);
+
+        /* define concurrent input data: it is filled in place within the next free slot of the event ring */
+        DRS4ConcurrentCopyInputData *inputDataSlot = manager->acquireEvent();
+
+        if (!inputDataSlot) {
+            /* the analysis threads cannot keep up: drop the event */
+            statistics.addStall();
+
+            manager->dropEvent();
+            m_readoutQueue->releaseReadSlots(position, 1);
+
+            continue;
+        }
+
+        DRS4ConcurrentCopyInputData& inputData = *inputDataSlot;
+
+        const DRS4AnalysisConfigPtr configPtr = rawEvent->m_config;
+        const DRS4AnalysisConfig *config = configPtr.data();
+
+        DRS4HotPathStageTimer hotPathTimer(DRS4HotPathStage::decode);
+
+        const bool bDecoded = decodeRawEvent(rawEvent, &inputData);
+
+        hotPathTimer.stop();
+
+        m_readoutQueue->releaseReadSlots(position, 1);
+
+        if (!bDecoded)
+            continue;
+
+        m_decodedEvents.fetch_add(1, std::memory_order_relaxed);
+
+        rejectCounter.nextEvent();
+
+        /* the settings are shared by reference between the events (renewed only on change) */
+        inputData.m_sharedData = m_worker->updateConcurrentSharedInputData(config);
+
+        const DRS4ConcurrentSharedInputData& sharedData = *inputData.m_sharedData;
+
+        /* Baseline - Jitter Corrections */
+        const DRS4BaselineCorrection baselineCorrectionA = DRS4BaselineCorrection::channelA(config);
+        const DRS4BaselineCorrection baselineCorrectionB = DRS4BaselineCorrection::channelB(config);
+
+        const bool bIntrinsicFilterA = (sharedData.m_bMedianFilterA || baselineCorrectionA.m_bEnabled);
+        const bool bIntrinsicFilterB = (sharedData.m_bMedianFilterB || baselineCorrectionB.m_bEnabled);
+
+        /* the source data set is only required by the stream */
+        const bool bStreamSourceWaveforms = DRS4StreamManager::sharedInstance()->isArmed();
+
+        if (bIntrinsicFilterA && bStreamSourceWaveforms) {
+            copy(inputData.m_waveChannel0, inputData.m_waveChannel0 + kNumberOfBins, waveChannel0S);
+        }
+
+        if (bIntrinsicFilterB && bStreamSourceWaveforms) {
+            copy(inputData.m_waveChannel1, inputData.m_waveChannel1 + kNumberOfBins, waveChannel1S);
+        }
+
+        /* processing windows: the filtered waveforms are not streamed */
+        int firstCellA = 0, lastCellA = kNumberOfBins;
+        int firstCellB = 0, lastCellB = kNumberOfBins;
+
+        processingWindow(inputData.m_tChannel0, sharedData.m_startCell, sharedData.m_endRange, false, baselineCorrectionA,
+                         sharedData.m_pulseShapeFilterEnabledA?&sharedData.m_pulseShapeFilterEnvelopeA:DNULLPTR, sharedData.m_pulseShapeFilterAIsRecording, &firstCellA, &lastCellA);
+        processingWindow(inputData.m_tChannel1, sharedData.m_startCell, sharedData.m_endRange, false, baselineCorrectionB,
+                         sharedData.m_pulseShapeFilterEnabledB?&sharedData.m_pulseShapeFilterEnvelopeB:DNULLPTR, sharedData.m_pulseShapeFilterBIsRecording, &firstCellB, &lastCellB);
+
+        /* apply median filter to remove spikes */
+        hotPathTimer.start(DRS4HotPathStage::medianFilter);
+
+        if (sharedData.m_bMedianFilterA) {
+            if (!DMedianFilter::apply(inputData.m_waveChannel0, kNumberOfBins, sharedData.m_medianFilterWindowSizeA, firstCellA, lastCellA))
+                continue;
+        }
+
+        if (sharedData.m_bMedianFilterB) {
+            if (!DMedianFilter::apply(inputData.m_waveChannel1, kNumberOfBins, sharedData.m_medianFilterWindowSizeB, firstCellB, lastCellB))
+                continue;
+        }
+
+        /* baseline - jitter corrections */
+        hotPathTimer.start(DRS4HotPathStage::baselineCorrection);
+
+        if (!rejectCounter.pass(DRS4RejectFilter::baselineLimit, baselineCorrectionA.apply(inputData.m_waveChannel0, firstCellA, lastCellA, sharedData.m_positiveSignal)
+                                && baselineCorrectionB.apply(inputData.m_waveChannel1, firstCellB, lastCellB, sharedData.m_positiveSignal)))
+            continue;
+
+        hotPathTimer.stop();
+
+        /* insert pulse-points for visualization */
+        if (!sharedData.m_bBurstMode) {
+            QMutexLocker locker(&m_pulseMutex);
+
+            m_pulseDataA.resize(sharedData.m_cellWidth);
+            m_pulseDataB.resize(sharedData.m_cellWidth);
+
+            for ( int a = sharedData.m_startCell, it = 0 ; a < sharedData.m_endRange ; ++ a, ++ it ) {
+                m_pulseDataA[it] = QPointF(inputData.m_tChannel0[a], inputData.m_waveChannel0[a]);
+                m_pulseDataB[it] = QPointF(inputData.m_tChannel1[a], inputData.m_waveChannel1[a]);
+            }
+
+            m_bPulseDataUpdated = true;
+        }
+
+        if ( DRS4StreamManager::sharedInstance()->isArmed() ) {
+            DRS4PipelinePersistEvent *persistEvent = m_persistQueue->acquireWriteSlot();
+
+            /* the stream has no gaps: wait for the persist stage */
+            while ( !persistEvent
+                    && m_isRunning.load(std::memory_order_acquire) ) {
+                statistics.addStall();
+
+                QThread::usleep(__WORKER_PIPELINE_IDLE_SLEEP);
+
+                persistEvent = m_persistQueue->acquireWriteSlot();
+            }
+
+            if ( persistEvent ) {
+                std::copy(inputData.m_tChannel0, inputData.m_tChannel0 + kNumberOfBins, persistEvent->m_tChannel0);
+                std::copy(inputData.m_tChannel1, inputData.m_tChannel1 + kNumberOfBins, persistEvent->m_tChannel1);
+
+                const float *waveChannel0 = (!bIntrinsicFilterA?inputData.m_waveChannel0:waveChannel0S);
+                const float *waveChannel1 = (!bIntrinsicFilterB?inputData.m_waveChannel1:waveChannel1S);
+
+                std::copy(waveChannel0, waveChannel0 + kNumberOfBins, persistEvent->m_waveChannel0);
+                std::copy(waveChannel1, waveChannel1 + kNumberOfBins, persistEvent->m_waveChannel1);
+
+                m_persistQueue->publishWriteSlot();
+            }
+        }
+
+        manager->publishEvent();
+
+        statistics.addProcessed();
+    }
+}
+
+void DRS4WorkerPipeline::persist()
+{
+    const int sizeOfWave = sizeof(float)*kNumberOfBins;
+
+    DRS4PipelineStageStatistics& statistics = m_statistics[DRS4PipelineStageType::persist];
+
+    /* the pending events are written after the stop as well */
+    while ( m_isRunning.load(std::memory_order_acquire)
+            || m_persistQueue->size() > 0 ) {
+        quint64 position = 0;
+
+        if ( !m_persistQueue->claimReadSlots(1, &position) ) {
+            statistics.addIdleCycle();
+
+            QThread::usleep(__WORKER_PIPELINE_IDLE_SLEEP);
+
+            continue;
+        }
+
+        const DRS4PipelinePersistEvent *persistEvent = m_persistQueue->slotAt(position);
+
+        if ( DRS4StreamManager::sharedInstance()->isArmed() ) {
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)persistEvent->m_tChannel0, sizeOfWave)) {
+                /* nothing yet */
+            }
+
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)persistEvent->m_waveChannel0, sizeOfWave)) {
+                /* nothing yet */
+            }
+
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)persistEvent->m_tChannel1, sizeOfWave)) {
+                /* nothing yet */
+            }
+
+            if (!DRS4StreamManager::sharedInstance()->write((const char*)persistEvent->m_waveChannel1, sizeOfWave)) {
+                /* nothing yet */
+            }
+        }
+
+        m_persistQueue->releaseReadSlots(position, 1);
+
+        statistics.addProcessed();
+    }
+}
+
+int DRS4WorkerPipeline::takeDecodedEvents()
+{
+    return m_decodedEvents.exchange(0, std::memory_order_relaxed);
+}
+
+bool DRS4WorkerPipeline::takePulseData(QVector<QPointF> *pulseDataA, QVector<QPointF> *pulseDataB)
+{
+    QMutexLocker locker(&m_pulseMutex);
+
+    if (!m_bPulseDataUpdated)
+        return false;
+
+    /* implicitly shared: the decode stage detaches on its next write */
+    *pulseDataA = m_pulseDataA;
+    *pulseDataB = m_pulseDataB;
+
+    m_bPulseDataUpdated = false;
+
+    return true;
+}
@@ -64,10 +64,12 @@
 
 #include <QRunnable>
 #include <QThread>
-#include <QThreadPool>
 #include <QtConcurrent>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <QElapsedTimer>
 
 #include <random>
 #include <stdio.h>
@@ -88,20 +90,55 @@
 
 #include "Fit/dspline.h"
 
+#include "drs4eventring.h"
+#include "drs4pulsepairkernel.h"
+#include "drs4baselinecorrection.h"
+#include "drs4analysisthreadpool.h"
+#include "drs4readoutdevice.h"
+
 #define __STATISTIC_AVG_TIME 4.0f // [s]
 
+#define __WORKER_SNAPSHOT_INTERVAL 50 // [ms]
+
+#define __WORKER_EVENT_RING_CAPACITY 256
+#define __WORKER_EVENT_RING_IDLE_SLEEP 100 // [us]
+#define __WORKER_DRAIN_TASKS_PER_THREAD 2 // [#] queued (not yet started) drain tasks per analysis thread
+
+#define __WORKER_HISTOGRAM_MERGE_INTERVAL 25 // [ms]
+
+#define __WORKER_CHUNK_TARGET_LATENCY 2.0 // [ms] analysis time of one chunk (adaptive chunk size)
+#define __WORKER_CHUNK_ADAPT_INTERVAL 250 // [ms]
+#define __WORKER_CHUNK_HISTORY_SIZE 120 // [#] samples
+
+#define __WORKER_PIPELINE_READOUT_QUEUE_CAPACITY 16
+#define __WORKER_PIPELINE_PERSIST_QUEUE_CAPACITY 64
+#define __WORKER_PIPELINE_IDLE_SLEEP 100 // [us]
+#define __WORKER_PIPELINE_HISTOGRAM_INTERVAL 5 // [ms]
+#define __WORKER_PIPELINE_PARKED_STAGES 3 // [#] readout, decode and histogram stage pause on setBusy(true)
+
 using namespace QtConcurrent;
 
 class DSpline;
 
 class DRS4WorkerConcurrentManager;
+class DRS4WorkerConcurrentDrainTask;
+class DRS4ConcurrentSharedInputData;
 class DRS4ConcurrentCopyInputData;
+class DRS4ConcurrentHistograms;
+class DRS4ConcurrentHistogramsExchange;
 class DRS4ConcurrentCopyOutputData;
 class DRS4WorkerDataExchange;
+class DRS4WorkerSnapshot;
+class DRS4WorkerPipeline;
+class DRS4WorkerPipelineStageThread;
 class DRS4Worker;
 
-class DRS4ConcurrentCopyInputData final {
+/* settings and filter traces which are constant for many events: shared by reference between the slots of the event ring.
+ * The decode stage creates a new instance only if the analysis config, the area-filter limits or the recording state have changed. */
+class DRS4ConcurrentSharedInputData final {
 public:
+    quint64 m_configVersion;
+
     int m_startCell;
     int m_endRange;
     int m_stopCellWidth;
@@ -118,9 +155,6 @@ public:
 
     DRS4InterpolationType::type m_interpolationType;
     DRS4SplineInterpolationType::type m_splineInterpolationType;
-    bool m_bUsingALGLIB;
-    bool m_bUsingTinoKluge;
-    bool m_bUsingLinearInterpol;
     int m_intraRenderPoints;
 
     bool m_bPersistance;
@@ -174,17 +208,8 @@ public:
 
     DRS4PulseShapeFilterRecordScheme::Scheme m_rcScheme;
 
-    float m_pulseShapeFilterDataMeanTraceA_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-    float m_pulseShapeFilterDataMeanTraceA_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-
-    float m_pulseShapeFilterDataMeanTraceB_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-    float m_pulseShapeFilterDataMeanTraceB_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-
-    float m_pulseShapeFilterDataStdDevTraceA_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-    float m_pulseShapeFilterDataStdDevTraceA_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-
-    float m_pulseShapeFilterDataStdDevTraceB_X[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
-    float m_pulseShapeFilterDataStdDevTraceB_Y[__PULSESHAPEFILTER_SPLINE_TRACE_NUMBER];
+    DRS4PulseShapeFilterEnvelope m_pulseShapeFilterEnvelopeA;
+    DRS4PulseShapeFilterEnvelope m_pulseShapeFilterEnvelopeB;
 
     bool m_bMedianFilterA;
     bool m_bMedianFilterB;
@@ -217,12 +242,20 @@ public:
 
     bool m_bNegativeLT;
     bool m_bForcePrompt;
+};
+
+typedef QSharedPointer<const DRS4ConcurrentSharedInputData> DRS4ConcurrentSharedInputDataPtr;
 
-    float m_tChannel0[kNumberOfBins];
-    float m_tChannel1[kNumberOfBins];
+/* per-event block of the event ring: the waveforms (structure of arrays) plus a reference on the shared input data */
+class DRS4ConcurrentCopyInputData final {
+public:
+    alignas(__EVENT_RING_CACHE_LINE) float m_tChannel0[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_tChannel1[kNumberOfBins];
 
-    float m_waveChannel0[kNumberOfBins];
-    float m_waveChannel1[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_waveChannel0[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_waveChannel1[kNumberOfBins];
+
+    DRS4ConcurrentSharedInputDataPtr m_sharedData;
 };
 
 class DRS4WorkerDataExchange final
@@ -263,41 +296,229 @@ public:
     DRS4WorkerDataExchange::~DRS4WorkerDataExchange() {}
 };
 
+/* stages of the acquisition pipeline (multi-core mode), see DRS4WorkerPipeline */
+typedef struct {
+public:
+    static QStringList typeList() {
+        QStringList list;
+        list.append("readout");
+        list.append("decode");
+        list.append("analyze");
+        list.append("histogram");
+        list.append("persist");
+
+        return list;
+    }
+
+    enum type : int {
+        readout = 0,
+        decode = 1,
+        analyze = 2,
+        histogram = 3,
+        persist = 4
+    };
+} DRS4PipelineStageType;
+
+#define __WORKER_PIPELINE_STAGES 5
+
+/* counters of a pipeline stage: written by the stage, read by any thread */
+class DRS4PipelineStageStatistics final {
+public:
+    std::atomic<quint64> m_processedEvents;
+    std::atomic<quint64> m_stalls; /* the output queue was full */
+    std::atomic<quint64> m_idleCycles; /* the input queue was empty */
+    std::atomic<int> m_highWaterMark; /* stages without an event ring as input queue only */
+
+    DRS4PipelineStageStatistics() :
+        m_processedEvents(0),
+        m_stalls(0),
+        m_idleCycles(0),
+        m_highWaterMark(0) {}
+
+    inline void reset() {
+        m_processedEvents.store(0, std::memory_order_relaxed);
+        m_stalls.store(0, std::memory_order_relaxed);
+        m_idleCycles.store(0, std::memory_order_relaxed);
+        m_highWaterMark.store(0, std::memory_order_relaxed);
+    }
+
+    inline void addProcessed(int count = 1) {
+        m_processedEvents.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    inline void addStall() {
+        m_stalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void addIdleCycle() {
+        m_idleCycles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void updateHighWaterMark(int occupancy) {
+        if (occupancy > m_highWaterMark.load(std::memory_order_relaxed))
+            m_highWaterMark.store(occupancy, std::memory_order_relaxed);
+    }
+};
+
+/* state of a pipeline stage and its input queue at the time of the request */
+class DRS4PipelineStageInfo final {
+public:
+    int m_queueCapacity; /* 0: no input queue (readout) */
+    int m_queueOccupancy;
+    int m_queueHighWaterMark;
+
+    quint64 m_processedEvents;
+    quint64 m_stalls;
+    quint64 m_idleCycles;
+    quint64 m_droppedEvents; /* dropped because the output queue was full */
+
+    DRS4PipelineStageInfo() :
+        m_queueCapacity(0),
+        m_queueOccupancy(0),
+        m_queueHighWaterMark(0),
+        m_processedEvents(0),
+        m_stalls(0),
+        m_idleCycles(0),
+        m_droppedEvents(0) {}
+};
+
+/* one step of the adaptive chunk size: measured over the last __WORKER_CHUNK_ADAPT_INTERVAL */
+class DRS4ChunkSizeSample final {
+public:
+    qint64 m_timeInMs; /* since the start of the acquisition */
+
+    int m_chunkSize; /* chosen for the next interval */
+
+    double m_chunkLatencyInMs; /* mean analysis time of one chunk */
+    int m_queueDepth; /* occupancy of the event ring */
+
+    DRS4ChunkSizeSample() :
+        m_timeInMs(0),
+        m_chunkSize(1),
+        m_chunkLatencyInMs(0.),
+        m_queueDepth(0) {}
+};
+
+/* immutable copy of the data visualized by the GUI, the web server and the remote control server:
+ * the worker publishes a new version every __WORKER_SNAPSHOT_INTERVAL. Readers hold a reference on the latest version and never pause the acquisition loop. */
+class DRS4WorkerSnapshot final
+{
+public:
+    quint64 m_version;
+
+    double m_boardTemperature; /* -1 in demo mode */
+
+    /* Pulse-Scope */
+    QVector<QPointF> m_pulseDataA, m_pulseDataB;
+    QVector<QPointF> m_pulseSplineDataA, m_pulseSplineDataB;
+
+    /* PHS */
+    QVector<int> m_phsA, m_phsB;
+    QVector<int> m_phsA_post, m_phsB_post;
+
+    int m_phsACounts, m_phsBCounts;
+    int m_phsACounts_post, m_phsBCounts_post;
+
+    double m_avgPulseCountRateInHz;
+    double m_currentPulseCountRateInHz;
+
+    /* Area-Filter */
+    QVector<QPointF> m_areaFilterDataA, m_areaFilterDataB;
+    QVector<double> m_areaFilterCollectedDataA_raw, m_areaFilterCollectedDataB_raw;
+
+    int m_areaFilterCollectedACounter, m_areaFilterCollectedBCounter;
+
+    /* Rise-Time Filter */
+    QVector<int> m_riseTimeFilterDataA, m_riseTimeFilterDataB;
+
+    int m_maxY_RiseTimeSpectrumA, m_maxY_RiseTimeSpectrumB;
+
+    /* Lifetime-Spectra */
+    QVector<int> m_lifeTimeDataAB, m_lifeTimeDataBA, m_lifeTimeDataCoincidence, m_lifeTimeDataMerged;
+
+    int m_abCounts, m_baCounts, m_mergedCounts, m_coincidenceCounts;
+    int m_maxY_ABSpectrum, m_maxY_BASpectrum, m_maxY_CoincidenceSpectrum, m_maxY_MergedSpectrum;
+
+    double m_avgABSpecCountRateInHz, m_avgBASpecCountRateInHz, m_avgMergedSpecCountRateInHz, m_avgCoincidenceSpecCountRateInHz;
+    double m_currentABSpecCountRateInHz, m_currentBASpecCountRateInHz, m_currentMergedSpecCountRateInHz, m_currentCoincidenceSpecCountRateInHz;
+
+    /* Persistance - Data */
+    QVector<QPointF> m_persistanceDataA, m_persistanceDataB;
+
+    DRS4WorkerSnapshot() :
+        m_version(0),
+        m_boardTemperature(-1.),
+        m_phsACounts(0),
+        m_phsBCounts(0),
+        m_phsACounts_post(0),
+        m_phsBCounts_post(0),
+        m_avgPulseCountRateInHz(0.),
+        m_currentPulseCountRateInHz(0.),
+        m_areaFilterCollectedACounter(0),
+        m_areaFilterCollectedBCounter(0),
+        m_maxY_RiseTimeSpectrumA(0),
+        m_maxY_RiseTimeSpectrumB(0),
+        m_abCounts(0),
+        m_baCounts(0),
+        m_mergedCounts(0),
+        m_coincidenceCounts(0),
+        m_maxY_ABSpectrum(0),
+        m_maxY_BASpectrum(0),
+        m_maxY_CoincidenceSpectrum(0),
+        m_maxY_MergedSpectrum(0),
+        m_avgABSpecCountRateInHz(0.),
+        m_avgBASpecCountRateInHz(0.),
+        m_avgMergedSpecCountRateInHz(0.),
+        m_avgCoincidenceSpecCountRateInHz(0.),
+        m_currentABSpecCountRateInHz(0.),
+        m_currentBASpecCountRateInHz(0.),
+        m_currentMergedSpecCountRateInHz(0.),
+        m_currentCoincidenceSpecCountRateInHz(0.) {}
+};
+
+typedef QSharedPointer<const DRS4WorkerSnapshot> DRS4WorkerSnapshotPtr;
+
 class DRS4Worker : public QObject
 {
     Q_OBJECT
 
     friend class DRS4WorkerConcurrentManager;
+    friend class DRS4WorkerPipeline;
 
 
     bool m_nextSignal;
-    bool m_isBlocking;
+    int m_parkedStages; /* threads waiting within waitForNextSignal() */
+    int m_stagesToPark; /* isBlocking() if all of them wait */
     bool m_isRunning;
 
     DRS4WorkerDataExchange *m_dataExchange;
 
     mutable QMutex m_mutex;
+    QWaitCondition m_nextSignalCondition;
+
+    /* published data (see DRS4WorkerSnapshot) */
+    DRS4WorkerSnapshotPtr m_snapshot;
+    mutable QMutex m_snapshotMutex;
+    std::atomic<quint64> m_snapshotVersion;
+    QElapsedTimer m_snapshotTimer;
+
+    double m_boardTemperature;
+
+    /* settings of the acquisition loop: renewed if DRS4SettingsManager::settingsVersion() changes */
+    DRS4AnalysisConfigPtr m_analysisConfig;
+
+    /* input data shared by the events of the event ring (multi-core mode) */
+    DRS4ConcurrentSharedInputDataPtr m_concurrentSharedInputData;
 
     DRS4WorkerConcurrentManager *m_workerConcurrentManager;
-    QVector<DRS4ConcurrentCopyInputData> m_copyData;
+    DRS4WorkerPipeline *m_pipeline;
 
     /* Pulse-Scope */
     QVector<QPointF> m_pListChannelA, m_pListChannelB;
     QVector<QPointF> m_pListChannelASpline, m_pListChannelBSpline;
 
-    /* ALGLIB */
-    alglib::real_1d_array m_arrayDataX_A, m_arrayDataY_A;
-    alglib::real_1d_array m_arrayDataX_B, m_arrayDataY_B;
-
-    alglib::spline1dinterpolant m_interpolantA;
-    alglib::spline1dinterpolant m_interpolantB;
-
-    alglib::barycentricinterpolant m_baryCentricInterpolantA;
-    alglib::barycentricinterpolant m_baryCentricInterpolantB;
-
-    /* Tino Kluge */
-    std::vector<double> m_arrayDataTKX_A, m_arrayDataTKY_A;
-    std::vector<double> m_arrayDataTKX_B, m_arrayDataTKY_B;
+    /* pulse-pair analysis (single-core mode) */
+    DRS4PulsePairKernel m_pulsePairKernel;
 
 public:
     /* PHS */
@@ -381,8 +602,9 @@ public:
     int m_pulseShapeDataAmountA;
     int m_pulseShapeDataAmountB;
 
-    bool m_isRecordingForShapeFilterA;
-    bool m_isRecordingForShapeFilterB;
+    /* written by the histogram stage (merge) and the GUI, read by the decode stage */
+    std::atomic<bool> m_isRecordingForShapeFilterA;
+    std::atomic<bool> m_isRecordingForShapeFilterB;
 
 public:
     explicit DRS4Worker(DRS4WorkerDataExchange *dataExchange, QObject *parent = 0);
@@ -392,6 +614,9 @@ public:
     bool nextSignal() const;
     bool isBlocking() const;
 
+    /* latest published data: never pauses the acquisition loop */
+    DRS4WorkerSnapshotPtr snapshot() const;
+
     bool isRunning() const;
 
 signals:
@@ -439,6 +664,14 @@ private:
     void runSingleThreaded();
     void runMultiThreaded();
 
+    void waitForNextSignal();
+
+    void publishSnapshot();
+    void publishSnapshotOnInterval();
+    const DRS4AnalysisConfig *updateAnalysisConfig();
+    const DRS4ConcurrentSharedInputDataPtr& updateConcurrentSharedInputData(const DRS4AnalysisConfig *config);
+    void updateBoardTemperature(bool bDemoMode);
+
 #ifdef __DEPRECATED_WORKER
     void calcLifetimesInBurstMode(DRS4LifetimeData *ltData, QVector<QPointF> *persistanceA, QVector<QPointF> *persistanceB);
 #endif
@@ -555,27 +788,143 @@ public:
 
     int activeThreads() const;
     int maxThreads() const;
+
+    /* Event-Ring (acquisition >> analysis threads) */
+    int eventRingCapacity() const;
+    int eventRingOccupancy() const;
+    int eventRingHighWaterMark() const;
+
+    quint64 eventRingPublishedEvents() const;
+    quint64 eventRingDroppedEvents() const;
+
+    /* Pipeline (multi-core mode) */
+    DRS4PipelineStageInfo pipelineStageInfo(DRS4PipelineStageType::type stage) const;
+
+    /* Pulse-Pair Chunk Size (multi-core mode) */
+    int pulsePairChunkSize() const;
+    bool isPulsePairChunkSizeAdaptive() const;
+
+    QVector<DRS4ChunkSizeSample> pulsePairChunkSizeHistory() const;
 };
 
-class DRS4ConcurrentCopyOutputData final {
+/* histograms of the analysis threads cleared by a reset of the worker (combinable) */
+typedef struct {
+public:
+    enum type : int {
+        phsA = 0x01,
+        phsB = 0x02,
+        abSpectrum = 0x04,
+        baSpectrum = 0x08,
+        coincidenceSpectrum = 0x10,
+        mergedSpectrum = 0x20,
+        riseTimeFilterA = 0x40,
+        riseTimeFilterB = 0x80
+    };
+} DRS4ConcurrentHistogramsType;
+
+/* dense histograms of one analysis thread: runCalculation() increments the bins in place (no index lists).
+ * The filled accumulator is handed over to the acquisition loop, which adds it bin by bin to the spectra of the worker. */
+class DRS4ConcurrentHistograms final {
 public:
-    /* data to be manipulated */
-
     /* PHS */
-    QVector<int> m_phsA, m_phsB; /* stores the index */
-    QVector<int> m_phsA_post, m_phsB_post; /* stores the index */
+    QVector<int> m_phsA, m_phsB;
+    QVector<int> m_phsA_post, m_phsB_post;
+
+    int m_phsACounts, m_phsBCounts;
+    int m_phsACounts_post, m_phsBCounts_post;
 
     /* Lifetime-Spectra */
-    QVector<int> m_lifeTimeDataAB, m_lifeTimeDataBA, m_lifeTimeDataCoincidence, m_lifeTimeDataMerged; /* stores the index */
+    QVector<int> m_lifeTimeDataAB, m_lifeTimeDataBA, m_lifeTimeDataCoincidence, m_lifeTimeDataMerged;
+
+    int m_abCounts, m_baCounts, m_coincidenceCounts, m_mergedCounts;
+
+    /* Rise-Time Filter */
+    QVector<int> m_riseTimeFilterDataA, m_riseTimeFilterDataB;
+
+    int m_riseTimeFilterACounter, m_riseTimeFilterBCounter;
+
+    DRS4ConcurrentHistograms() {
+        m_phsA.fill(0, kNumberOfBins);
+        m_phsB.fill(0, kNumberOfBins);
+        m_phsA_post.fill(0, kNumberOfBins);
+        m_phsB_post.fill(0, kNumberOfBins);
+
+        resetCounts();
+    }
+
+    /* adapts the bin numbers to the settings of the chunk */
+    void prepare(const DRS4ConcurrentSharedInputData& sharedData);
+
+    void resetCounts();
+
+    /* clears the bins and counts of DRS4ConcurrentHistogramsType::type 'types' */
+    void clear(int types);
+
+    inline bool isEmpty() const {
+        return !(m_phsACounts || m_phsBCounts || m_phsACounts_post || m_phsBCounts_post
+                 || m_abCounts || m_baCounts || m_coincidenceCounts || m_mergedCounts
+                 || m_riseTimeFilterACounter || m_riseTimeFilterBCounter);
+    }
+};
+
+/* lock-free hand-over of the histograms between one analysis thread and the histogram stage (double buffering):
+ *
+ * - the analysis thread fills 'm_current'. If 'm_filled' is empty and the merge interval has elapsed, it publishes 'm_current' as 'm_filled' and continues with 'm_empty'.
+ * - the histogram stage adds 'm_filled' to the spectra, clears it and returns it as 'm_empty'.
+ * - 'm_current' belongs to whoever claimed the exchange: a drain task while it runs, otherwise the histogram stage, which hands over the histograms of an idle thread itself. */
+class DRS4ConcurrentHistogramsExchange final {
+    std::atomic<bool> m_isClaimed;
+
+public:
+    DRS4ConcurrentHistograms *m_current; /* owned by the claiming thread */
+    QVector<const DRS4ConcurrentCopyInputData*> m_events; /* chunk of the analysis thread */
+
+    std::atomic<DRS4ConcurrentHistograms*> m_filled;
+    std::atomic<DRS4ConcurrentHistograms*> m_empty;
+
+    QElapsedTimer m_handOverTimer;
+
+    DRS4ConcurrentHistogramsExchange() :
+        m_isClaimed(false),
+        m_current(new DRS4ConcurrentHistograms),
+        m_filled(DNULLPTR),
+        m_empty(new DRS4ConcurrentHistograms) {}
+
+    ~DRS4ConcurrentHistogramsExchange() {
+        delete m_current;
+        delete m_filled.load();
+        delete m_empty.load();
+    }
+
+    /* the claiming thread: returns false if the previous histograms are not merged yet */
+    bool handOver();
+
+    inline bool tryClaim() {
+        bool expected = false;
+
+        return m_isClaimed.compare_exchange_strong(expected, true, std::memory_order_acquire);
+    }
+
+    /* held by the histogram stage for a hand-over only: yield instead of sleeping */
+    inline void claim() {
+        while ( !tryClaim() )
+            QThread::yieldCurrentThread();
+    }
+
+    inline void release() {
+        m_isClaimed.store(false, std::memory_order_release);
+    }
+};
+
+class DRS4ConcurrentCopyOutputData final {
+public:
+    /* data to be manipulated */
 
     /* Area-Filter */
     QVector<QPointF> m_areaFilterDataA, m_areaFilterDataB;
     QVector<QPointF> m_areaFilterCollectionDataA, m_areaFilterCollectionDataB; /*mean and stddev calculation */
     QVector<double> m_areaFilterCollectionDataA_raw, m_areaFilterCollectionDataB_raw; /*mean calculation */
 
-    /* Rise-Time Filter */
-    QVector<int> m_riseTimeFilterDataA, m_riseTimeFilterDataB;
-
     /* Pulse Shape - Data */
     QVector<QVector<QPointF> > m_pulseShapeDataA;
     QVector<QVector<QPointF> > m_pulseShapeDataB;
@@ -606,7 +955,9 @@ public:
     }
 };
 
-DRS4ConcurrentCopyOutputData runCalculation(const QVector<DRS4ConcurrentCopyInputData>& copyDataVec);
+DRS4ConcurrentCopyOutputData runCalculation(const QVector<const DRS4ConcurrentCopyInputData*>& copyDataVec, DRS4ConcurrentHistograms *histograms);
+
+typedef DRS4EventRing<DRS4ConcurrentCopyInputData> DRS4ConcurrentEventRing;
 
 class DRS4WorkerConcurrentManager : public QObject
 {
@@ -614,32 +965,214 @@ class DRS4WorkerConcurrentManager : public QObject
 
     friend class DRS4Worker;
     friend class DRS4WorkerDataExchange;
+    friend class DRS4WorkerConcurrentDrainTask;
+    friend class DRS4WorkerPipeline;
 
     DRS4Worker *m_worker;
 
-    QVector<QVector<DRS4ConcurrentCopyInputData> > m_copyData;
-    QVector<QVector<DRS4ConcurrentCopyInputData> > m_copyMetaData;
+    /* the decode stage fills the slots in place, the drain tasks analyse them in place */
+    DRS4ConcurrentEventRing *m_eventRing;
 
-    QFuture<DRS4ConcurrentCopyOutputData> m_future;
+    QVector<DRS4ConcurrentCopyOutputData> m_results;
+    mutable QMutex m_resultMutex;
+
+    /* one per analysis thread */
+    QVector<DRS4ConcurrentHistogramsExchange*> m_histograms;
+
+    std::atomic<bool> m_isDraining;
+    std::atomic<int> m_queuedDrainTasks; /* posted, not yet started */
+    std::atomic<int> m_runningDrainTasks; /* posted or running */
+    std::atomic<int> m_busyDrainTasks;
+    std::atomic<int> m_chunkSize;
+
+    /* adaptive chunk size: analysis time and events of the chunks since the last adaption */
+    std::atomic<bool> m_bAdaptiveChunkSize;
+    std::atomic<quint64> m_chunkTimeInNs;
+    std::atomic<quint64> m_chunkEvents;
+    std::atomic<quint64> m_chunks;
+
+    QElapsedTimer m_chunkSizeTimer;
+    qint64 m_lastChunkSizeAdaption;
+
+    QVector<DRS4ChunkSizeSample> m_chunkSizeHistory;
+    mutable QMutex m_chunkSizeMutex;
 
     int m_recommendedThreads;
 
+    /* analyze stage of the pipeline */
+    DRS4PipelineStageStatistics m_statistics;
+
     DRS4WorkerConcurrentManager(DRS4Worker *worker) :
         m_worker(worker),
-        m_recommendedThreads(QThread::idealThreadCount()) {
-        QThreadPool::globalInstance()->setMaxThreadCount(m_recommendedThreads);
+        m_eventRing(new DRS4ConcurrentEventRing(__WORKER_EVENT_RING_CAPACITY)),
+        m_isDraining(false),
+        m_queuedDrainTasks(0),
+        m_runningDrainTasks(0),
+        m_busyDrainTasks(0),
+        m_chunkSize(1),
+        m_bAdaptiveChunkSize(false),
+        m_chunkTimeInNs(0),
+        m_chunkEvents(0),
+        m_chunks(0),
+        m_lastChunkSizeAdaption(0),
+        m_recommendedThreads(DRS4AnalysisThreadPool::sharedInstance()->maxThreadCount()) {
+        for ( int i = 0 ; i < m_recommendedThreads ; ++ i )
+            m_histograms.append(new DRS4ConcurrentHistogramsExchange);
     }
 
-    virtual ~DRS4WorkerConcurrentManager() {}
+    virtual ~DRS4WorkerConcurrentManager() {
+        cancel();
 
-    bool add(const QVector<DRS4ConcurrentCopyInputData>& copyData);
+        qDeleteAll(m_histograms);
+        m_histograms.clear();
 
-    void start();
+        DDELETE_SAFETY(m_eventRing);
+    }
+
+    /* producer (decode stage) */
+    inline DRS4ConcurrentCopyInputData *acquireEvent() {
+        return m_eventRing->acquireWriteSlot();
+    }
+
+    inline void publishEvent() {
+        m_eventRing->publishWriteSlot();
+
+        scheduleDrain();
+    }
+
+    inline void dropEvent() {
+        m_eventRing->markDropped();
+    }
+
+    void start(int chunkSize, bool bAdaptiveChunkSize = false);
     void cancel();
-    void merge();
+
+    /* histogram stage: adapts the chunk size towards __WORKER_CHUNK_TARGET_LATENCY every __WORKER_CHUNK_ADAPT_INTERVAL */
+    void adaptChunkSize();
+
+    int chunkSize() const;
+    bool isChunkSizeAdaptive() const;
+
+    QVector<DRS4ChunkSizeSample> chunkSizeHistory() const;
+    /* histogram stage: returns the number of merged histograms and results */
+    int merge();
+    bool mergeHistograms(DRS4ConcurrentHistograms *histograms);
+
+    int pendingHistograms() const;
+
+    /* worker parked: clears DRS4ConcurrentHistogramsType::type 'types' in the current and filled histograms of every analysis thread,
+     * otherwise they were merged into the reset spectra afterwards */
+    void resetHistograms(int types);
+
+    /* consumer (threads of the DRS4AnalysisThreadPool): one drain task analyses one chunk of the event ring.
+     * The decode stage posts the tasks round robin, a task leaving published events behind posts its successor onto the deque of its own thread: idle threads steal them. */
+    void scheduleDrain(int preferredThread = -1);
+    void drain();
 
     int activeThreads() const;
     int maxThreads() const;
 };
 
+class DRS4WorkerConcurrentDrainTask final : public QRunnable
+{
+    DRS4WorkerConcurrentManager *m_manager;
+
+public:
+    DRS4WorkerConcurrentDrainTask(DRS4WorkerConcurrentManager *manager) :
+        m_manager(manager) {
+        setAutoDelete(true);
+    }
+
+    virtual ~DRS4WorkerConcurrentDrainTask() {}
+
+    virtual void run() {
+        m_manager->drain();
+    }
+};
+
+/* staged acquisition (multi-core mode): every stage runs on its own thread, the stages are decoupled by bounded queues.
+ *
+ * - readout (pipeline thread): waits for the board (DRS4ReadoutDevice), transfers all pending raw events into the readout queue at once and rearms the board immediately.
+ * - decode (pipeline thread): time and voltage calibration of the raw copy (GetTime/GetWave), median filter, baseline correction and pulse-scope. Fills the event ring.
+ * - analyze (DRS4AnalysisThreadPool): drain tasks of the DRS4WorkerConcurrentManager, one chunk of the event ring each.
+ * - histogram (worker thread): merges the histograms and results of the analysis threads, calculates the rates and publishes the snapshots.
+ * - persist (pipeline thread): writes the streamed events to disk.
+ *
+ * A stage stalls if its output queue is full: readout and decode drop the event then (the board keeps on running), decode waits for persist (the stream has no gaps). */
+
+/* slot of the persist queue: the unfiltered event as written to the stream */
+class DRS4PipelinePersistEvent final {
+public:
+    alignas(__EVENT_RING_CACHE_LINE) float m_tChannel0[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_waveChannel0[kNumberOfBins];
+
+    alignas(__EVENT_RING_CACHE_LINE) float m_tChannel1[kNumberOfBins];
+    alignas(__EVENT_RING_CACHE_LINE) float m_waveChannel1[kNumberOfBins];
+};
+
+typedef DRS4EventRing<DRS4PipelineRawEvent> DRS4PipelineReadoutQueue;
+typedef DRS4EventRing<DRS4PipelinePersistEvent> DRS4PipelinePersistQueue;
+
+class DRS4WorkerPipeline final
+{
+    friend class DRS4Worker;
+    friend class DRS4WorkerPipelineStageThread;
+
+    DRS4Worker *m_worker;
+
+    DRS4PipelineReadoutQueue *m_readoutQueue; /* readout >> decode */
+    DRS4PipelinePersistQueue *m_persistQueue; /* decode >> persist */
+
+    QVector<DRS4WorkerPipelineStageThread*> m_threads;
+
+    DRS4PipelineStageStatistics m_statistics[__WORKER_PIPELINE_STAGES];
+
+    std::atomic<bool> m_isRunning;
+    bool m_bDemoMode;
+
+    /* taken by the histogram stage */
+    std::atomic<int> m_decodedEvents;
+    std::atomic<double> m_boardTemperature;
+
+    /* Pulse-Scope: latest event of the decode stage */
+    QMutex m_pulseMutex;
+    QVector<QPointF> m_pulseDataA, m_pulseDataB;
+    bool m_bPulseDataUpdated;
+
+    DRS4WorkerPipeline(DRS4Worker *worker);
+    ~DRS4WorkerPipeline();
+
+    void start(bool bDemoMode);
+    void stop();
+
+    /* stages */
+    void readout();
+    void decode();
+    void persist();
+
+    int takeDecodedEvents();
+    bool takePulseData(QVector<QPointF> *pulseDataA, QVector<QPointF> *pulseDataB);
+
+    inline double boardTemperature() const {
+        return m_boardTemperature.load(std::memory_order_relaxed);
+    }
+};
+
+class DRS4WorkerPipelineStageThread final : public QThread
+{
+    DRS4WorkerPipeline *m_pipeline;
+    DRS4PipelineStageType::type m_stage;
+
+public:
+    DRS4WorkerPipelineStageThread(DRS4WorkerPipeline *pipeline, DRS4PipelineStageType::type stage) :
+        QThread(),
+        m_pipeline(pipeline),
+        m_stage(stage) {}
+
+    virtual ~DRS4WorkerPipelineStageThread() {}
+
+protected:
+    virtual void run();
+};
+
 #endif // DRS4WORKER_H